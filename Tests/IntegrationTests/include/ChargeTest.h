@@ -3,7 +3,7 @@
 double solveOML(double a, double guess, double iontemp, double etemp){
         C_Debug("\tIn ChargingModel::solveOML(double a, double guess)\n\n");
         if( a >= 1.0 ){
-		static bool runOnce;
+		static std::atomic<bool> runOnce;
 		WarnOnce(runOnce,"DeltaTot >= 1.0. DeltaTot being set equal to unity.");
 		a = 1.0;
 	}
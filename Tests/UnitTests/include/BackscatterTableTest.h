@@ -0,0 +1,80 @@
+#include "BackscatterTable.h"
+#include "Functions.h"
+#include "Constants.h"
+#include <iostream>
+#include <thread>
+#include <random>
+#include <cmath>
+
+// This test checks the interpolation of BackscatterTable against the
+// backscatter() function it tabulates, at random plasma conditions within the
+// range for which the error is documented, and that threads filling a table
+// concurrently find bitwise the same values as a single thread.
+
+struct BackscatterTablePoint{
+	double Te, Ti, Potential;
+};
+
+int BackscatterTableTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+
+	// Temperatures of 1eV to 100eV and potentials below 5, as documented
+	const double eV = echarge/Kb;
+	std::mt19937 Generator(42);
+	std::uniform_real_distribution<double> LogT(log10(eV),log10(100*eV));
+	std::uniform_real_distribution<double> Potential(0.0,5.0);
+	std::vector<BackscatterTablePoint> Points(16);
+	for( BackscatterTablePoint &Point : Points )
+		Point = { pow(10.0,LogT(Generator)), pow(10.0,LogT(Generator)),
+			Potential(Generator) };
+
+	const double MaxErrorRE = 3e-5, MaxErrorRN = 1.2e-4;
+	BackscatterTable Serial('W');
+	std::vector<double> SerialRE(Points.size()), SerialRN(Points.size());
+	for( unsigned int n = 0; n < Points.size(); n ++ ){
+		const BackscatterTablePoint &P = Points[n];
+		double re(0.0), rn(0.0);
+		backscatter(P.Te,P.Ti,Mp,P.Potential,'W',re,rn);
+		Serial.lookup(P.Te,P.Ti,P.Potential,SerialRE[n],SerialRN[n]);
+		bool Close = fabs(SerialRE[n]-re) <= MaxErrorRE
+			&& fabs(SerialRN[n]-rn) <= MaxErrorRN;
+		std::cout << "\nTe = " << P.Te/eV << "eV, Ti = " << P.Ti/eV
+			<< "eV, Potential = " << P.Potential << ": RE error "
+			<< SerialRE[n]-re << ", RN error " << SerialRN[n]-rn << ": "
+			<< (Close ? "PASS" : "FAIL");
+		Pass = Pass && Close;
+	}
+
+	// Threads share one table, each looking up every point from its own start
+	const unsigned int Threads = 4;
+	BackscatterTable Shared('W');
+	std::vector<std::vector<double>> ThreadRE(Threads), ThreadRN(Threads);
+	std::vector<std::thread> Pool;
+	for( unsigned int t = 0; t < Threads; t ++ ){
+		ThreadRE[t].resize(Points.size());
+		ThreadRN[t].resize(Points.size());
+		Pool.push_back(std::thread([&,t](){
+			for( unsigned int m = 0; m < Points.size(); m ++ ){
+				unsigned int n = (m+t*Points.size()/Threads)%Points.size();
+				const BackscatterTablePoint &P = Points[n];
+				Shared.lookup(P.Te,P.Ti,P.Potential,ThreadRE[t][n],
+					ThreadRN[t][n]);
+			}
+		}));
+	}
+	for( auto &Worker : Pool ) Worker.join();
+
+	bool Same = Shared.computed() == Serial.computed();
+	for( unsigned int t = 0; t < Threads; t ++ )
+		Same = Same && ThreadRE[t] == SerialRE && ThreadRN[t] == SerialRN;
+	std::cout << "\n" << Threads << " threads, " << Shared.computed()
+		<< " nodes computed: " << (Same ? "PASS" : "FAIL");
+	Pass = Pass && Same;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nBackscatterTable "
+		<< (Pass ? "PASSED" : "FAILED") << " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
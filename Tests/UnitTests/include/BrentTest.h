@@ -0,0 +1,134 @@
+#include "ChargingModel.h"
+#include "Tungsten.h"
+#include <iostream>
+#include <cstdio>
+#include <sys/stat.h>
+
+// This test charges a grain with current terms whose roots are known and
+// checks that the Brent root finding of ChargingModel::Charge() finds them to
+// the requested accuracy, starting from potentials on either side of the
+// root, and that the potential is left unchanged when no root can be
+// bracketed in the range searched.
+
+// Current decreasing linearly through Root
+struct BrentTestLinear:CurrentTerm{
+	double Root;
+	BrentTestLinear(double root):Root(root){}
+	double Evaluate(const Matter*, const PlasmaData&, const double Potential){
+		return 3.0*(Root-Potential);
+	}
+	std::string PrintName(){ return "BrentTestLinear"; }
+};
+
+// Current flat at Root, so that interpolation converges slowly
+struct BrentTestCubic:CurrentTerm{
+	double Root;
+	BrentTestCubic(double root):Root(root){}
+	double Evaluate(const Matter*, const PlasmaData&, const double Potential){
+		return pow(Root-Potential,3);
+	}
+	std::string PrintName(){ return "BrentTestCubic"; }
+};
+
+// Current with constant ion and exponential electron parts, with a root at
+// Potential = -ln(Ratio)
+struct BrentTestExponential:CurrentTerm{
+	double Ratio;
+	BrentTestExponential(double ratio):Ratio(ratio){}
+	double Evaluate(const Matter*, const PlasmaData&, const double Potential){
+		return Ratio-exp(-Potential);
+	}
+	std::string PrintName(){ return "BrentTestExponential"; }
+};
+
+// Current with no root at all
+struct BrentTestNoRoot:CurrentTerm{
+	double Evaluate(const Matter*, const PlasmaData&, const double Potential){
+		return 1.0+Potential*Potential;
+	}
+	std::string PrintName(){ return "BrentTestNoRoot"; }
+};
+
+// Charge a grain starting at normalised potential Start, returning the
+// potential found
+static double BrentTestCharge(std::vector<CurrentTerm*> Terms, float Accuracy,
+double Start){
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	threevector Position(0.0,0.0,0.0), Velocity(0.0,0.0,0.0);
+	Matter *Sample = new Tungsten(1e-6,300,ConstModels,Position,Velocity);
+	Sample->update_charge(0.0,Start,0.0,0.0);
+	PlasmaData Pdata = PlasmaDataDefaults;
+	ChargingModel *Model = new ChargingModel("Data/BrentTest_cm.txt",Accuracy,
+		Terms,Sample,Pdata);
+	Model->Charge(1e-100);
+	double Potential = Sample->get_potential();
+	delete Model;
+	delete Sample;
+	std::remove("Data/BrentTest_cm.txt");
+	return Potential;
+}
+
+// Brent's method stops once the root lies within 2*Tolerance of its estimate
+static bool BrentTestCheck(std::string name, double found, double root,
+float accuracy){
+	double Bound = accuracy+4.0*std::numeric_limits<double>::epsilon()*
+		fabs(root);
+	bool Pass = fabs(found-root) <= Bound;
+	std::cout << "\n" << name << ", accuracy " << accuracy << ": found "
+		<< found << ", expected " << root << ": " << (Pass ? "PASS" : "FAIL");
+	return Pass;
+}
+
+int BrentTest(){
+	clock_t begin = clock();
+	mkdir("Data",0755);
+	bool Pass = true;
+
+	const double Roots[] = { -4.9, -0.7, 0.3, 2.5, 9.99 };
+	const double Starts[] = { -5.0, 0.0, 10.0 };
+	const float Accuracies[] = { 1e-2, 1e-5, 1e-7 };
+	for( double Root : Roots ){
+		BrentTestLinear Linear(Root);
+		BrentTestCubic Cubic(Root);
+		for( double Start : Starts ){
+			for( float Accuracy : Accuracies ){
+				std::string Case = "from " + std::to_string(Start);
+				Pass = BrentTestCheck("Linear "+Case,
+					BrentTestCharge({&Linear},Accuracy,Start),Root,Accuracy)
+					&& Pass;
+				Pass = BrentTestCheck("Cubic "+Case,
+					BrentTestCharge({&Cubic},Accuracy,Start),Root,Accuracy)
+					&& Pass;
+			}
+		}
+	}
+
+	const double Ratios[] = { 0.05, 0.5, 2.0 };
+	for( double Ratio : Ratios ){
+		BrentTestExponential Exponential(Ratio);
+		for( float Accuracy : Accuracies ){
+			Pass = BrentTestCheck("Exponential, ratio "+std::to_string(Ratio),
+				BrentTestCharge({&Exponential},Accuracy,0.0),-log(Ratio),
+				Accuracy) && Pass;
+		}
+	}
+
+	// The root of the sum of several terms
+	BrentTestLinear Half(1.0), Other(3.0);
+	Pass = BrentTestCheck("Two linear terms",
+		BrentTestCharge({&Half,&Other},1e-7,0.0),2.0,1e-7) && Pass;
+
+	// Without a root the potential must be left as it was
+	BrentTestNoRoot NoRoot;
+	double Unchanged = BrentTestCharge({&NoRoot},1e-5,1.5);
+	bool Same = Unchanged == 1.5;
+	std::cout << "\nNo root in range: potential " << Unchanged << ": "
+		<< (Same ? "PASS" : "FAIL");
+	Pass = Pass && Same;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nBrent " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
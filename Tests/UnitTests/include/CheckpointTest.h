@@ -0,0 +1,226 @@
+#include "DTOKSU.h"
+#include "Checkpoint.h"
+#include "PlasmaGridReader.h"
+#include "GridInterpolation.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// This test simulates a grain once without stopping, and once in a child
+// process taking frequent checkpoints which is killed half way through its
+// run. The killed run is restarted from its last checkpoint in this process
+// and every data file it writes must match that of the whole run byte for
+// byte, as must the mass deposited by the grain, which is recorded apart from
+// the plasma grid as breakup branches record theirs. The rocket force holds
+// the temperature it was last evaluated at, which must be restored too.
+
+// Uniform plasma of the default plasma data, on a 1m square grid of 0.1m
+// cells with no electric field, which the grain crosses as it cools and
+// evaporates. The magnetic field gives the rocket force a direction.
+static std::shared_ptr<const PlasmaGrid_Data> CheckpointTestGrid(){
+	PlasmaGrid_Data Pgrid;
+	Pgrid.gridx = 11;
+	Pgrid.gridz = 11;
+	Pgrid.gridtheta = 0;
+	Pgrid.gridxmin = 1.0;
+	Pgrid.gridxmax = 2.0;
+	Pgrid.gridzmin = -1.0;
+	Pgrid.gridzmax = 0.0;
+	Pgrid.dlx = 0.1;
+	Pgrid.dlz = 0.1;
+	Pgrid.mi = PlasmaDataDefaults.mi;
+	Pgrid.device = 'j';
+	Pgrid.interpolation = Interpolation::Nearest;
+	allocate_plasmafields(Pgrid);
+	Pgrid.Er = Pgrid.po;
+	Pgrid.Ez = Pgrid.po;
+	Pgrid.vpx = Pgrid.po;
+	Pgrid.vpy = Pgrid.po;
+	Pgrid.vpz = Pgrid.po;
+	for( int i = 0; i < Pgrid.gridx; i ++ ){
+		for( int k = 0; k < Pgrid.gridz; k ++ ){
+			Pgrid.Te[i][k] = PlasmaDataDefaults.ElectronTemp;
+			Pgrid.Ti[i][k] = PlasmaDataDefaults.IonTemp;
+			Pgrid.Tn[i][k] = PlasmaDataDefaults.NeutralTemp;
+			Pgrid.Ta[i][k] = PlasmaDataDefaults.AmbientTemp;
+			Pgrid.na0[i][k] = PlasmaDataDefaults.IonDensity;
+			Pgrid.na1[i][k] = PlasmaDataDefaults.ElectronDensity;
+			Pgrid.na2[i][k] = PlasmaDataDefaults.NeutralDensity;
+			Pgrid.x[i][k] = Pgrid.gridxmin+i*Pgrid.dlx;
+			Pgrid.z[i][k] = Pgrid.gridzmin+k*Pgrid.dlz;
+			Pgrid.bz[i][k] = 1.0;
+			Pgrid.gridflag[i][k] = 1;
+		}
+	}
+	pack_plasmacells(Pgrid);
+	build_stencils(Pgrid);
+	Pgrid.dm = std::make_shared<MassDeposition>(Pgrid.gridx,Pgrid.gridz);
+	return std::make_shared<const PlasmaGrid_Data>(std::move(Pgrid));
+}
+
+// Whether the depositions of a and b are bitwise the same and not empty
+static bool CheckpointTestSameDeposition(const MassDeposition &a,
+const MassDeposition &b){
+	bool Same(true), Empty(true);
+	for( int i = 0; i < a.get_gridx(); i ++ ){
+		for( int k = 0; k < a.get_gridz(); k ++ ){
+			Same = Same && a.get(i,k) == b.get(i,k);
+			Empty = Empty && a.get(i,k) == 0.0;
+		}
+	}
+	return Same && !Empty;
+}
+
+static const std::vector<std::string> CheckpointTestFiles = { "_df_0.txt",
+	"_hm_0.txt", "_fm_0.txt", "_cm_0.txt" };
+
+// A simulation of the grain of the test, writing files named after prefix
+static DTOKSU *CheckpointTestSim(Matter *&sample, std::string prefix,
+std::shared_ptr<const PlasmaGrid_Data> pgrid,
+std::vector<HeatTerm*> &HeatTerms, std::vector<ForceTerm*> &ForceTerms,
+std::vector<CurrentTerm*> &CurrentTerms){
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	threevector Position(0.55,0.0,-0.05), Velocity(0.0,0.0,-2.0);
+	sample = new Tungsten(2e-6,4000,ConstModels,Position,Velocity);
+	PlasmaData Pdata = PlasmaDataDefaults;
+	std::array<float,DTOKSU::MN> Accuracy = {0.01,1.0,0.01};
+	DTOKSU *Sim = new DTOKSU(Accuracy,sample,pgrid,Pdata,HeatTerms,
+		ForceTerms,CurrentTerms,prefix,0);
+	Sim->set_plasmadatafile(prefix.substr(5)+"_pd_0");
+	return Sim;
+}
+
+static std::string CheckpointTestRead(std::string filename){
+	std::ifstream File(filename,std::ifstream::binary);
+	std::stringstream Contents;
+	Contents << File.rdbuf();
+	return Contents.str();
+}
+
+static void CheckpointTestRemove(std::string prefix){
+	for( const std::string &Name : CheckpointTestFiles )
+		std::remove((prefix+Name).c_str());
+	std::remove(("Data/"+prefix.substr(5)+"_pd_0.txt").c_str());
+}
+
+int CheckpointTest(){
+	clock_t begin = clock();
+	mkdir("Data",0755);
+	const std::string Whole = "Data/CheckpointTest_whole";
+	const std::string Killed = "Data/CheckpointTest_killed";
+	const std::string Dummy = "Data/CheckpointTest_dummy";
+	const std::string CheckpointFile = Killed+".chk";
+	std::remove(CheckpointFile.c_str());
+
+	std::shared_ptr<const PlasmaGrid_Data> Pgrid = CheckpointTestGrid();
+	std::vector<HeatTerm*> HeatTerms = { new Term::EmissivityModel(),
+		new Term::EvaporationModel(), new Term::NeutralHeatFlux() };
+	std::vector<ForceTerm*> ForceTerms = { new Term::Gravity(),
+		new Term::RocketForce() };
+	std::vector<CurrentTerm*> CurrentTerms = { new Term::OMLe(),
+		new Term::OMLi() };
+
+	// The run without stopping
+	Matter *Sample;
+	DTOKSU *Sim = CheckpointTestSim(Sample,Whole,Pgrid,HeatTerms,
+		ForceTerms,CurrentTerms);
+	std::shared_ptr<MassDeposition> WholeDeposition =
+		std::make_shared<MassDeposition>(Pgrid->gridx,Pgrid->gridz);
+	Sim->set_deposition(WholeDeposition);
+	int WholeStatus = Sim->Run();
+	Sim->CloseFiles();
+	delete Sim;
+	delete Sample;
+	struct stat Buffer;
+	stat((Whole+"_hm_0.txt").c_str(),&Buffer);
+	off_t WholeSize = Buffer.st_size;
+
+	// The child checkpoints every few milliseconds until it is killed
+	std::cout.flush();
+	pid_t Child = fork();
+	if( Child == 0 ){
+		Matter *Sample;
+		DTOKSU *Sim = CheckpointTestSim(Sample,Killed,Pgrid,HeatTerms,
+			ForceTerms,CurrentTerms);
+		Sim->set_deposition(std::make_shared<MassDeposition>(Pgrid->gridx,
+			Pgrid->gridz));
+		Sim->set_checkpoint(CheckpointFile,0.005,true);
+		Sim->checkpoint();
+		Sim->Run();
+		Sim->CloseFiles();
+		Checkpoints::wait();
+		_exit(0);
+	}
+
+	// Kill the child half way through, once it has written half the heating
+	// data of the whole run
+	int Status(0);
+	bool Exited(false);
+	while( !(Exited = waitpid(Child,&Status,WNOHANG) == Child)
+		&& !(stat((Killed+"_hm_0.txt").c_str(),&Buffer) == 0
+		&& Buffer.st_size >= WholeSize/2) )
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	if( !Exited ){
+		kill(Child,SIGKILL);
+		waitpid(Child,&Status,0);
+	}
+	bool WasKilled = WIFSIGNALED(Status);
+	std::cout << "\nRun " << (WasKilled ? "killed" : "not killed")
+		<< " before the end";
+
+	// Restart from the last checkpoint of the killed run
+	Sim = CheckpointTestSim(Sample,Dummy,Pgrid,HeatTerms,ForceTerms,
+		CurrentTerms);
+	std::shared_ptr<MassDeposition> RestartDeposition =
+		std::make_shared<MassDeposition>(Pgrid->gridx,Pgrid->gridz);
+	Sim->set_deposition(RestartDeposition);
+	int ReadStatus = Sim->read_checkpoint(CheckpointFile);
+	int RestartStatus = ReadStatus == 0 ? Sim->Run() : -1;
+	Sim->CloseFiles();
+	delete Sim;
+	delete Sample;
+
+	bool Pass = ReadStatus == 0 && RestartStatus == WholeStatus;
+	std::cout << "\nRestart, read status " << ReadStatus << ", run status "
+		<< RestartStatus << ": " << (Pass ? "PASS" : "FAIL");
+	std::vector<std::string> Files = CheckpointTestFiles;
+	Files.push_back("_pd_0.txt");
+	for( const std::string &Name : Files ){
+		std::string WholeName = Whole+Name, KilledName = Killed+Name;
+		if( Name == "_pd_0.txt" ){
+			WholeName = "Data/"+Whole.substr(5)+Name;
+			KilledName = "Data/"+Killed.substr(5)+Name;
+		}
+		std::string Contents = CheckpointTestRead(WholeName);
+		bool Same = !Contents.empty()
+			&& Contents == CheckpointTestRead(KilledName);
+		std::cout << "\n" << KilledName << ", " << Contents.size()
+			<< " bytes: " << (Same ? "PASS" : "FAIL");
+		Pass = Pass && Same;
+	}
+	bool SameDeposition = CheckpointTestSameDeposition(*WholeDeposition,
+		*RestartDeposition);
+	std::cout << "\nMass deposited: " << (SameDeposition ? "PASS" : "FAIL");
+	Pass = Pass && SameDeposition;
+
+	CheckpointTestRemove(Whole);
+	CheckpointTestRemove(Killed);
+	CheckpointTestRemove(Dummy);
+	std::remove(CheckpointFile.c_str());
+	for( HeatTerm *Term : HeatTerms ) delete Term;
+	for( ForceTerm *Term : ForceTerms ) delete Term;
+	for( CurrentTerm *Term : CurrentTerms ) delete Term;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nCheckpoint " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+#include "DataSink.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+// This test writes the same rows, with a column of every type, through a text
+// and a binary DataSink and converts the binary file to text, which must be
+// identical to the text file. Copies of the binary file which end part way
+// through the header, claim more columns than the file holds, end part way
+// through a row or are not a DataSink file must be refused with the status
+// given for each.
+
+// Read the whole of \p filename into \p contents
+static void DataSinkTestRead(const std::string &filename,
+std::string &contents){
+	std::ifstream File(filename,std::ifstream::binary);
+	std::ostringstream Contents;
+	Contents << File.rdbuf();
+	contents = Contents.str();
+}
+
+// Write \p contents to \p filename and return the status of converting it
+static int DataSinkTestConvert(const std::string &filename,
+const std::string &contents){
+	std::ofstream(filename,std::ofstream::binary) << contents;
+	std::ostringstream Text;
+	return convert_to_text(filename,Text);
+}
+
+int DataSinkTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+	const std::vector<DataColumn> Columns = { {"Time",Column::Scalar},
+		{"Step",Column::Integer}, {"Charge",Column::Sign},
+		{"Position",Column::Vector} };
+	const std::string TextFile = "DataSinkTest.txt";
+	const std::string BinaryFile = "DataSinkTest.bin";
+	const std::string CopyFile = "DataSinkTest_copy.bin";
+
+	// Flush part way through the rows so that both are written in pieces
+	DataSink Text, Binary;
+	Text.configure(Output::Text,7);
+	Binary.configure(Output::Binary,7);
+	Text.open(TextFile,Columns);
+	Binary.open(BinaryFile,Columns);
+	for( unsigned int n = 0; n < 50; n ++ ){
+		double Time = 1e-7*n*n+1.0/3.0;
+		threevector Position(1.0+0.01*n,-0.5*n,1.0/(n+1.0));
+		double Charge = n%3 == 0 ? -1.0 : 1.0;
+		Text << Time << n << Charge << Position;
+		Binary << Time << n << Charge << Position;
+		Text.end_row();
+		Binary.end_row();
+	}
+	Text.close();
+	Binary.close();
+
+	std::string Expected, Converted;
+	DataSinkTestRead(TextFile,Expected);
+	std::ostringstream Out;
+	int Status = convert_to_text(BinaryFile,Out);
+	Converted = Out.str();
+	bool Same = Status == 0 && Converted == Expected && !Expected.empty();
+	std::cout << "\nConverted binary file matches text file: "
+		<< (Same ? "PASS" : "FAIL");
+	Pass = Pass && Same;
+
+	// The header is the magic, version, byte order and number of columns,
+	// followed by the type, name length and name of each column
+	std::string Contents;
+	DataSinkTestRead(BinaryFile,Contents);
+	const size_t ColumnsAt = 8+2*sizeof(uint32_t);
+	const size_t FirstName = ColumnsAt+sizeof(uint32_t)+1+sizeof(uint32_t);
+
+	Status = DataSinkTestConvert(CopyFile,Contents.substr(0,FirstName+2));
+	std::cout << "\nFile ending within a column name, status " << Status
+		<< ": " << (Status == 4 ? "PASS" : "FAIL");
+	Pass = Pass && Status == 4;
+
+	Status = DataSinkTestConvert(CopyFile,Contents.substr(0,ColumnsAt+2));
+	std::cout << "\nFile ending within the number of columns, status "
+		<< Status << ": " << (Status == 4 ? "PASS" : "FAIL");
+	Pass = Pass && Status == 4;
+
+	std::string Corrupt = Contents;
+	const uint32_t TooMany = 0xFFFFFFFF;
+	std::memcpy(&Corrupt[ColumnsAt],&TooMany,sizeof(TooMany));
+	Status = DataSinkTestConvert(CopyFile,Corrupt);
+	std::cout << "\nMore columns than the file holds, status " << Status
+		<< ": " << (Status == 4 ? "PASS" : "FAIL");
+	Pass = Pass && Status == 4;
+
+	Corrupt = Contents;
+	std::memcpy(&Corrupt[FirstName-sizeof(uint32_t)],&TooMany,
+		sizeof(TooMany));
+	Status = DataSinkTestConvert(CopyFile,Corrupt);
+	std::cout << "\nName longer than the file, status " << Status << ": "
+		<< (Status == 4 ? "PASS" : "FAIL");
+	Pass = Pass && Status == 4;
+
+	Status = DataSinkTestConvert(CopyFile,
+		Contents.substr(0,Contents.size()-sizeof(double)));
+	std::cout << "\nFile ending within a row, status " << Status << ": "
+		<< (Status == 3 ? "PASS" : "FAIL");
+	Pass = Pass && Status == 3;
+
+	Status = DataSinkTestConvert(CopyFile,Expected);
+	std::cout << "\nText file refused, status " << Status << ": "
+		<< (Status == 2 ? "PASS" : "FAIL");
+	Pass = Pass && Status == 2;
+
+	std::remove(TextFile.c_str());
+	std::remove(BinaryFile.c_str());
+	std::remove(CopyFile.c_str());
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nDataSink " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#include "ForceModel.h"
+#include "Tungsten.h"
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <sys/stat.h>
+
+// This test integrates the gyration of a charged grain in a uniform toroidal
+// magnetic field, which stays in the poloidal plane and has a known circular
+// orbit, over five periods with the classical Runge-Kutta method at unit
+// accuracy and the adaptive Dormand-Prince method at an accuracy of 0.01, a
+// tolerance of 1e-6 per step. The final position and velocity must match the
+// analytic orbit, and the evaluations of the force per metre travelled are
+// compared between the methods. Once a Dormand-Prince step has been taken the
+// next step is that proposed by its error control, which must still shorten
+// when charging of the grain doubles the force.
+
+// The Lorentz force, counting its evaluations. Not a registered term list, so
+// every evaluation is through Evaluate()
+struct DormandPrinceTestLorentz:Term::LorentzForce{
+	unsigned long Evaluations;
+	DormandPrinceTestLorentz():Evaluations(0){}
+	threevector Evaluate(const Matter* Sample, const PlasmaData &Pdata,
+	const threevector velocity){
+		Evaluations ++;
+		return Term::LorentzForce::Evaluate(Sample,Pdata,velocity);
+	}
+};
+
+// Difference of the final state from the analytic orbit relative to the
+// gyroradius and speed, and the evaluations per metre travelled
+struct DormandPrinceTestResult{
+	double PositionError;
+	double VelocityError;
+	double EvaluationsPerMetre;
+	double ProbeRatio;
+};
+
+static DormandPrinceTestResult DormandPrinceTestOrbit(char method,
+float accuracy){
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	const threevector Position(5.0,0.0,0.0), Velocity(1.0,0.0,0.5);
+	Matter *Sample = new Tungsten(1e-6,300,ConstModels,Position,Velocity);
+	Sample->set_potential(2.0);
+	// The constructor adds the position to the default position
+	const threevector Start = Sample->get_position();
+	PlasmaData Pdata = PlasmaDataDefaults;
+	Pdata.ElectricField = threevector(0.0,0.0,0.0);
+
+	// Choose the field so that the gyrofrequency is one radian per second
+	DormandPrinceTestLorentz *Lorentz = new DormandPrinceTestLorentz();
+	Pdata.MagneticField = threevector(0.0,1.0,0.0);
+	double qtom = Lorentz->Evaluate(Sample,Pdata,threevector(1.0,0.0,0.0))
+		.getz();
+	Pdata.MagneticField = threevector(0.0,1.0/qtom,0.0);
+	Lorentz->Evaluations = 0;
+	const double Omega = 1.0;
+	const double Period = 2.0*PI/Omega;
+
+	DormandPrinceTestResult Result = { 0.0, 0.0, 0.0, 1.0 };
+	{
+		std::vector<ForceTerm*> ForceTerms = { Lorentz };
+		ForceModel FM("Data/DormandPrinceTest_fm.txt",accuracy,ForceTerms,
+			Sample,Pdata);
+		FM.set_integrator(method);
+		double t = 0.0;
+		unsigned long Steps = 0;
+		while( t < 5.0*Period ){
+			double dt = std::min(FM.UpdateTimeStep(),5.0*Period-t);
+			FM.Force(dt);
+			t += dt;
+			Steps ++;
+		}
+
+		// Exact orbit, the angle of the velocity advances by Omega*t
+		double vx = Velocity.getx(), vz = Velocity.getz();
+		double c = cos(Omega*t), s = sin(Omega*t);
+		threevector x(Start.getx()+(vx*s+vz*(c-1.0))/Omega,0.0,
+			Start.getz()+(vx*(1.0-c)+vz*s)/Omega);
+		threevector v(vx*c-vz*s,0.0,vx*s+vz*c);
+		double Speed = Velocity.mag3();
+		Result.PositionError = (Sample->get_position()-x).mag3()*Omega/Speed;
+		Result.VelocityError = (Sample->get_velocity()-v).mag3()/Speed;
+		// Print() evaluates each term once a step
+		Result.EvaluationsPerMetre = (Lorentz->Evaluations-Steps)/(Speed*t);
+
+		// Doubling the potential doubles the charge and the force
+		double Before = FM.ProbeTimeStep();
+		Sample->set_potential(4.0);
+		Result.ProbeRatio = FM.ProbeTimeStep()/Before;
+	}
+	std::remove("Data/DormandPrinceTest_fm.txt");
+	delete Lorentz;
+	delete Sample;
+	return Result;
+}
+
+int DormandPrinceTest(){
+	clock_t begin = clock();
+	mkdir("Data",0755);
+	bool Pass = true;
+	const double Tolerance = 1e-4;
+
+	DormandPrinceTestResult RK4 = DormandPrinceTestOrbit(
+		Integrator::RungeKutta4,1.0);
+	DormandPrinceTestResult DP = DormandPrinceTestOrbit(
+		Integrator::DormandPrince,0.01);
+	const char *Names[2] = { "RungeKutta4", "DormandPrince" };
+	const DormandPrinceTestResult *Results[2] = { &RK4, &DP };
+	for( unsigned int n = 0; n < 2; n ++ ){
+		const DormandPrinceTestResult &R = *Results[n];
+		bool Accurate = R.PositionError < Tolerance
+			&& R.VelocityError < Tolerance;
+		std::cout << "\n" << Names[n] << " gyration error, position "
+			<< R.PositionError << ", velocity " << R.VelocityError
+			<< ", evaluations per metre " << R.EvaluationsPerMetre << ": "
+			<< (Accurate ? "PASS" : "FAIL");
+		Pass = Pass && Accurate;
+	}
+
+	bool Fewer = DP.EvaluationsPerMetre < RK4.EvaluationsPerMetre;
+	std::cout << "\nDormandPrince evaluates the force "
+		<< RK4.EvaluationsPerMetre/DP.EvaluationsPerMetre
+		<< " times less per metre: " << (Fewer ? "PASS" : "FAIL");
+	Pass = Pass && Fewer;
+
+	bool Shortened = fabs(DP.ProbeRatio-0.5) < 1e-6;
+	std::cout << "\nProposed step halved when the force doubles, ratio "
+		<< DP.ProbeRatio << ": " << (Shortened ? "PASS" : "FAIL");
+	Pass = Pass && Shortened;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nDormandPrince " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#include "EmissivityTable.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// This test writes emissivity files for a few temperatures, tabulating
+// different radii and skipping some temperatures, and checks the values
+// interpolated by EmissivityTable against the function the files were made
+// from. The function is bilinear in temperature and radius, so must be
+// recovered to rounding error inside the table and from its edges outside.
+
+// Emissivity used to write the files, with radius in m
+static double EmissivityTableFunction(double temperature, double radius){
+	double t = temperature-300.0, r = radius*1e6;
+	return 0.1+0.002*t+0.05*r+0.001*t*r;
+}
+
+static bool EmissivityTableCheck(const EmissivityTable &table,
+double temperature, double radius, double expected){
+	double Value = table.interpolate(temperature,radius);
+	bool Pass = fabs(Value-expected) <= 1e-12*fabs(expected);
+	std::cout << "\nT = " << temperature << "K, r = " << radius << "m: "
+		<< Value << ", expected " << expected << ": "
+		<< (Pass ? "PASS" : "FAIL");
+	return Pass;
+}
+
+int EmissivityTableTest(){
+	clock_t begin = clock();
+	const std::string DirName = "EmissivityTableTest";
+	mkdir(DirName.c_str(),0755);
+
+	// Each temperature tabulates its own radii, in no particular order
+	const int Temps[] = { 300, 302, 305 };
+	const std::vector<std::vector<double>> FileRadii = {
+		{ 4e-6, 1e-6, 2e-6 }, { 1e-6, 3e-6, 4e-6 },
+		{ 1e-6, 2e-6, 3e-6, 4e-6 } };
+	for( unsigned int n = 0; n < 3; n ++ ){
+		std::ofstream File(DirName+"/Temp_"+std::to_string(Temps[n])+".txt");
+		for( double Radius : FileRadii[n] ){
+			char Line[64];
+			snprintf(Line,sizeof(Line),"%.17g,%.17g\n",Radius,
+				EmissivityTableFunction(Temps[n],Radius));
+			File << Line;
+		}
+	}
+
+	bool Pass = true;
+	EmissivityTable Table;
+	int Status = Table.read(DirName,275,310);
+	bool Read = Status == 0 && !Table.empty();
+	std::cout << "\nRead files, status " << Status << ": "
+		<< (Read ? "PASS" : "FAIL");
+	Pass = Pass && Read;
+
+	if( Read ){
+		// On the points of the files, and between them
+		for( int T : Temps )
+			for( double Radius : { 1e-6, 2e-6, 3e-6, 4e-6 } )
+				Pass = EmissivityTableCheck(Table,T,Radius,
+					EmissivityTableFunction(T,Radius)) && Pass;
+		for( double T : { 300.5, 301.0, 303.7, 304.99 } )
+			for( double Radius : { 1.25e-6, 2.5e-6, 3.9e-6 } )
+				Pass = EmissivityTableCheck(Table,T,Radius,
+					EmissivityTableFunction(T,Radius)) && Pass;
+
+		// Outside the table the value at its edge is used
+		Pass = EmissivityTableCheck(Table,280.0,2.5e-6,
+			EmissivityTableFunction(300.0,2.5e-6)) && Pass;
+		Pass = EmissivityTableCheck(Table,350.0,2.5e-6,
+			EmissivityTableFunction(305.0,2.5e-6)) && Pass;
+		Pass = EmissivityTableCheck(Table,303.0,1e-8,
+			EmissivityTableFunction(303.0,1e-6)) && Pass;
+		Pass = EmissivityTableCheck(Table,290.0,1e-4,
+			EmissivityTableFunction(300.0,4e-6)) && Pass;
+	}
+
+	// A directory without files gives an empty table
+	EmissivityTable Missing;
+	Status = Missing.read(DirName+"/Missing",275,310);
+	bool Empty = Status == 1 && Missing.empty();
+	std::cout << "\nMissing directory, status " << Status << ": "
+		<< (Empty ? "PASS" : "FAIL");
+	Pass = Pass && Empty;
+
+	// Every call for an element shares one table, empty without data
+	std::shared_ptr<const EmissivityTable> First =
+		EmissivityTable::shared('X',3000.0);
+	std::shared_ptr<const EmissivityTable> Second =
+		EmissivityTable::shared('x',3000.0);
+	bool Shared = First == Second && First->empty();
+	std::cout << "\nShared table of element without data: "
+		<< (Shared ? "PASS" : "FAIL");
+	Pass = Pass && Shared;
+
+	for( int T : Temps )
+		std::remove((DirName+"/Temp_"+std::to_string(T)+".txt").c_str());
+	rmdir(DirName.c_str());
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nEmissivityTable " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
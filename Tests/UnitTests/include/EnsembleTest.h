@@ -0,0 +1,182 @@
+#include "DTOKSU.h"
+#include <iostream>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <sys/stat.h>
+
+// This test simulates a small ensemble of grains twice, once one after the
+// other and once on several threads sharing the term objects as the ensemble
+// runner of DTOKSU_Manager does, and checks that every grain ends in bitwise
+// the same state. The rocket force holds the temperature it was last
+// evaluated at, so force models built from the same terms must each evaluate
+// their own copy of it.
+
+struct EnsembleTestGrain{
+	char Element;
+	double Size;
+	double Temperature;
+};
+
+struct EnsembleTestResult{
+	int RunStatus;
+	GrainData FinalState;
+};
+
+static EnsembleTestResult EnsembleTestRun(const EnsembleTestGrain &grain,
+std::string prefix, unsigned int n, std::vector<HeatTerm*> &HeatTerms,
+std::vector<ForceTerm*> &ForceTerms, std::vector<CurrentTerm*> &CurrentTerms){
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	threevector Position(0.0,0.0,0.0), Velocity(0.0,0.0,0.0);
+	Matter *Sample;
+	if( grain.Element == 'W' )
+		Sample = new Tungsten(grain.Size,grain.Temperature,ConstModels,
+			Position,Velocity);
+	else
+		Sample = new Beryllium(grain.Size,grain.Temperature,ConstModels,
+			Position,Velocity);
+	PlasmaData Pdata = PlasmaDataDefaults;
+	std::array<float,DTOKSU::MN> Accuracy = {0.01,1.0,0.01};
+	DTOKSU *Sim = new DTOKSU(Accuracy,Sample,Pdata,HeatTerms,ForceTerms,
+		CurrentTerms,prefix,n);
+	Sim->set_plasmadatafile(prefix.substr(5)+"_pd_"+std::to_string(n));
+
+	EnsembleTestResult Result;
+	Result.RunStatus = Sim->Run();
+	Result.FinalState = Sample->get_graindata();
+	Sim->CloseFiles();
+	delete Sim;
+	delete Sample;
+
+	std::remove((prefix+"_df_"+std::to_string(n)+".txt").c_str());
+	std::remove((prefix+"_hm_"+std::to_string(n)+".txt").c_str());
+	std::remove((prefix+"_fm_"+std::to_string(n)+".txt").c_str());
+	std::remove((prefix+"_cm_"+std::to_string(n)+".txt").c_str());
+	std::remove((prefix+"_pd_"+std::to_string(n)+".txt").c_str());
+	return Result;
+}
+
+static bool EnsembleTestSame(const EnsembleTestResult &a,
+const EnsembleTestResult &b){
+	const GrainData &x = a.FinalState, &y = b.FinalState;
+	return a.RunStatus == b.RunStatus && x.Mass == y.Mass
+		&& x.Radius == y.Radius && x.Temperature == y.Temperature
+		&& x.Potential == y.Potential
+		&& x.DustPosition.getx() == y.DustPosition.getx()
+		&& x.DustPosition.gety() == y.DustPosition.gety()
+		&& x.DustPosition.getz() == y.DustPosition.getz()
+		&& x.DustVelocity.getx() == y.DustVelocity.getx()
+		&& x.DustVelocity.gety() == y.DustVelocity.gety()
+		&& x.DustVelocity.getz() == y.DustVelocity.getz();
+}
+
+// Step a liquid grain alone and, taking turns, two grains at different
+// temperatures whose models are built from the same terms, falling in a
+// magnetic field so that the rocket force acts, then the first of the pair
+// and a grain stepped by a copy of its model. The first grain must move as the
+// grain alone does.
+static bool EnsembleTestOwnTerms(std::vector<ForceTerm*> &ForceTerms){
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	threevector Position(0.0,0.0,0.0), Velocity(0.0,0.0,0.0);
+	PlasmaData Pdata = PlasmaDataDefaults;
+	Pdata.MagneticField = threevector(0.0,0.0,1.0);
+	Pdata.Gravity = threevector(0.0,0.0,-9.81);
+	Matter *Alone = new Tungsten(1e-6,4000,ConstModels,Position,Velocity);
+	Matter *First = new Tungsten(1e-6,4000,ConstModels,Position,Velocity);
+	Matter *Second = new Tungsten(1e-6,3800,ConstModels,Position,Velocity);
+	Matter *Third = new Tungsten(1e-6,3600,ConstModels,Position,Velocity);
+	bool Same(true);
+	{
+		ForceModel AloneModel("Data/EnsembleTest_alone_fm.txt",1.0,
+			ForceTerms,Alone,Pdata);
+		ForceModel FirstModel("Data/EnsembleTest_first_fm.txt",1.0,
+			ForceTerms,First,Pdata);
+		ForceModel SecondModel("Data/EnsembleTest_second_fm.txt",1.0,
+			ForceTerms,Second,Pdata);
+		for( unsigned int n = 0; n < 3; n ++ ){
+			AloneModel.Force(AloneModel.UpdateTimeStep());
+			FirstModel.Force(FirstModel.UpdateTimeStep());
+			SecondModel.Force(SecondModel.UpdateTimeStep());
+		}
+		// A copy of a model, as a breakup branch makes, stepping a grain of
+		// its own must not share the state of the original either
+		ForceModel ThirdModel(FirstModel);
+		ThirdModel.set_sample(Third);
+		ThirdModel.CreateFile("Data/EnsembleTest_third_fm.txt");
+		for( unsigned int n = 0; n < 3; n ++ ){
+			AloneModel.Force(AloneModel.UpdateTimeStep());
+			FirstModel.Force(FirstModel.UpdateTimeStep());
+			ThirdModel.Force(ThirdModel.UpdateTimeStep());
+		}
+		threevector x = Alone->get_velocity(), y = First->get_velocity();
+		Same = x.getx() == y.getx() && x.gety() == y.gety()
+			&& x.getz() == y.getz() && x.mag3() > 0.0;
+	}
+	std::remove("Data/EnsembleTest_alone_fm.txt");
+	std::remove("Data/EnsembleTest_first_fm.txt");
+	std::remove("Data/EnsembleTest_second_fm.txt");
+	std::remove("Data/EnsembleTest_third_fm.txt");
+	delete Alone;
+	delete First;
+	delete Second;
+	delete Third;
+	return Same;
+}
+
+int EnsembleTest(){
+	clock_t begin = clock();
+	mkdir("Data",0755);
+	const std::vector<EnsembleTestGrain> Grains = {
+		{'W',1e-6,2000}, {'W',2e-6,1500}, {'B',1e-6,900},
+		{'B',5e-7,1200}, {'W',5e-7,2500}, {'B',2e-6,600} };
+	const unsigned int Threads = 3;
+
+	// Term objects are shared by every grain, as in the ensemble runner
+	std::vector<HeatTerm*> HeatTerms = { new Term::EmissivityModel(),
+		new Term::EvaporationModel(), new Term::NeutralHeatFlux() };
+	std::vector<ForceTerm*> ForceTerms = { new Term::Gravity(),
+		new Term::RocketForce() };
+	std::vector<CurrentTerm*> CurrentTerms = { new Term::OMLe(),
+		new Term::OMLi() };
+
+	std::vector<EnsembleTestResult> Serial(Grains.size());
+	for( unsigned int n = 0; n < Grains.size(); n ++ )
+		Serial[n] = EnsembleTestRun(Grains[n],"Data/EnsembleTest_serial",n,
+			HeatTerms,ForceTerms,CurrentTerms);
+
+	std::vector<EnsembleTestResult> Threaded(Grains.size());
+	std::atomic<unsigned int> NextGrain(0);
+	std::vector<std::thread> Pool;
+	for( unsigned int t = 0; t < Threads; t ++ ){
+		Pool.push_back(std::thread([&](){
+			for( unsigned int n = NextGrain++; n < Grains.size();
+				n = NextGrain++ )
+				Threaded[n] = EnsembleTestRun(Grains[n],
+					"Data/EnsembleTest_threaded",n,HeatTerms,ForceTerms,
+					CurrentTerms);
+		}));
+	}
+	for( auto &Worker : Pool ) Worker.join();
+
+	bool Pass = true;
+	for( unsigned int n = 0; n < Grains.size(); n ++ ){
+		bool Same = EnsembleTestSame(Serial[n],Threaded[n]);
+		std::cout << "\nGrain " << n << " (" << Grains[n].Element << ", "
+			<< Grains[n].Size << "m), status " << Serial[n].RunStatus
+			<< ": " << (Same ? "PASS" : "FAIL");
+		Pass = Pass && Same;
+	}
+	bool OwnTerms = EnsembleTestOwnTerms(ForceTerms);
+	std::cout << "\nModels sharing terms keep their own state: "
+		<< (OwnTerms ? "PASS" : "FAIL");
+	Pass = Pass && OwnTerms;
+	for( HeatTerm *Term : HeatTerms ) delete Term;
+	for( ForceTerm *Term : ForceTerms ) delete Term;
+	for( CurrentTerm *Term : CurrentTerms ) delete Term;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nEnsemble " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+#include "GridInterpolation.h"
+#include "PlasmaGridReader.h"
+#include <iostream>
+#include <cmath>
+
+// This test fills a plasma grid with unequal spacings in x and z with fields
+// which are linear in x and z. Bilinear and Catmull-Rom interpolation both
+// reproduce linear fields exactly, so every interpolated parameter must equal
+// the field at the point, away from the grid edge where the bicubic stencil is
+// valid and next to it where bicubic falls back to bilinear. Points outside
+// the grid and grids without interpolation must be refused.
+
+// The linear field of index n at (x,z)
+static double GridInterpolationField(int n, double x, double z){
+	return 10.0*(n+1)+(3.0+n)*x-(2.0-0.5*n)*z;
+}
+
+// Fill a 12 by 7 grid with dlx = 0.05 and dlz = 0.2 from the linear fields
+static void GridInterpolationGrid(PlasmaGrid_Data &pgrid, char scheme){
+	pgrid.gridx = 12;
+	pgrid.gridz = 7;
+	pgrid.gridtheta = 0;
+	pgrid.gridxmin = 1.0;
+	pgrid.gridxmax = 1.55;
+	pgrid.gridzmin = -0.6;
+	pgrid.gridzmax = 0.6;
+	pgrid.dlx = 0.05;
+	pgrid.dlz = 0.2;
+	pgrid.interpolation = scheme;
+	allocate_plasmafields(pgrid);
+	pgrid.Er  = pgrid.Te;
+	pgrid.Ez  = pgrid.Te;
+	pgrid.vpx = pgrid.Te;
+	pgrid.vpy = pgrid.Te;
+	pgrid.vpz = pgrid.Te;
+	GridField<double> *Fields[13] = { &pgrid.Te, &pgrid.Ti, &pgrid.na0,
+		&pgrid.na1, &pgrid.na2, &pgrid.bx, &pgrid.by, &pgrid.bz, &pgrid.Er,
+		&pgrid.Ez, &pgrid.vpx, &pgrid.vpy, &pgrid.vpz };
+	for( int i = 0; i < pgrid.gridx; i ++ ){
+		for( int k = 0; k < pgrid.gridz; k ++ ){
+			double x = pgrid.gridxmin+i*pgrid.dlx;
+			double z = pgrid.gridzmin+k*pgrid.dlz;
+			for( int n = 0; n < 13; n ++ )
+				(*Fields[n])[i][k] = GridInterpolationField(n,x,z);
+			pgrid.gridflag[i][k] = 1;
+		}
+	}
+	pack_plasmacells(pgrid);
+	build_stencils(pgrid);
+}
+
+// Largest relative difference of the interpolated cell from the fields
+static double GridInterpolationError(const PlasmaCell &cell, double x,
+double z){
+	const double Values[13] = { cell.Te, cell.Ti, cell.na0, cell.na1,
+		cell.na2, cell.bx, cell.by, cell.bz, cell.Er, cell.Ez, cell.vpx,
+		cell.vpy, cell.vpz };
+	double Error = 0.0;
+	for( int n = 0; n < 13; n ++ ){
+		double Expected = GridInterpolationField(n,x,z);
+		Error = std::max(Error,fabs(Values[n]-Expected)/fabs(Expected));
+	}
+	return Error;
+}
+
+int GridInterpolationTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+	const double Tolerance = 1e-12;
+
+	// Points inside the bicubic stencils and points in the outermost cells,
+	// where only the bilinear stencil is valid
+	const double Points[6][2] = { {1.2137,-0.05}, {1.3311,0.237},
+		{1.1502,0.3999}, {1.0123,-0.5432}, {1.5321,0.5111}, {1.26,-0.58} };
+	const char Schemes[2] = { Interpolation::Bilinear,
+		Interpolation::Bicubic };
+	const char *Names[2] = { "Bilinear", "Bicubic" };
+	for( int s = 0; s < 2; s ++ ){
+		PlasmaGrid_Data Pgrid;
+		GridInterpolationGrid(Pgrid,Schemes[s]);
+		double Error = 0.0;
+		bool Found = true;
+		for( const auto &Point : Points ){
+			PlasmaCell Cell = {};
+			double x = Point[0], z = Point[1];
+			Found = Found && interpolate_plasmacell(Pgrid,x,z,Cell);
+			Error = std::max(Error,GridInterpolationError(Cell,x,z));
+		}
+		bool Exact = Found && Error < Tolerance;
+		std::cout << "\n" << Names[s] << " linear field, largest relative "
+			<< "error " << Error << ": " << (Exact ? "PASS" : "FAIL");
+		Pass = Pass && Exact;
+
+		// Outside the grid nothing is interpolated
+		PlasmaCell Cell = {};
+		bool Outside = !interpolate_plasmacell(Pgrid,0.99,0.0,Cell)
+			&& !interpolate_plasmacell(Pgrid,1.2,0.61,Cell);
+		std::cout << "\n" << Names[s] << " outside the grid refused: "
+			<< (Outside ? "PASS" : "FAIL");
+		Pass = Pass && Outside;
+	}
+
+	PlasmaGrid_Data Pgrid;
+	GridInterpolationGrid(Pgrid,Interpolation::Nearest);
+	PlasmaCell Cell = {};
+	bool Nearest = !interpolate_plasmacell(Pgrid,1.2137,-0.05,Cell);
+	std::cout << "\nNearest cell grid not interpolated: "
+		<< (Nearest ? "PASS" : "FAIL");
+	Pass = Pass && Nearest;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nGridInterpolation "
+		<< (Pass ? "PASSED" : "FAILED") << " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
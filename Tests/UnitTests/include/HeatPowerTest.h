@@ -0,0 +1,124 @@
+#include "HeatingModel.h"
+#include "Tungsten.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+
+// This test writes a row of the heat file of a heating model on tungsten,
+// which records the power of each heat term, then changes the temperature,
+// potential, mass or plasma or melts the sample and writes another row. Each
+// term column of the row must be bitwise the same as a fresh Evaluate() of the
+// term in the new state, with evaporation printed in W from a liquid and as
+// zero from a solid, so that no power recorded before the change is printed
+// after it. Both a registered list of terms, evaluated by its kernel, and one
+// evaluated term by term are checked.
+
+// Read the values of the last row of the text file \p filename
+static std::vector<double> HeatPowerTestRow(const std::string &filename){
+	std::ifstream File(filename);
+	std::string Line, Last;
+	while( std::getline(File,Line) )
+		if( !Line.empty() ) Last = Line;
+	std::vector<double> Values;
+	std::istringstream Row(Last);
+	std::string Value;
+	while( std::getline(Row,Value,'\t') )
+		Values.push_back(strtod(Value.c_str(),NULL));
+	return Values;
+}
+
+// Write a row of the heat file and compare its term columns with \p heatterms
+// evaluated afresh
+static bool HeatPowerTestCompare(HeatingModel &model,
+const std::vector<HeatTerm*> &heatterms, const Matter *sample,
+const PlasmaData &pdata, const std::string &filename,
+const std::string &change){
+	model.CreateFile(filename);
+	model.close_file();
+	std::vector<double> Row = HeatPowerTestRow(filename);
+	bool Same = Row.size() >= heatterms.size();
+	size_t First = Row.size()-heatterms.size();
+	for( size_t n = 0; Same && n < heatterms.size(); n ++ ){
+		double Expected = heatterms[n]->Evaluate(sample,pdata,
+			sample->get_temperature());
+		if( heatterms[n]->PrintName() == "EvaporationModel" )
+			Expected = sample->is_liquid() ? 1000*Expected : 0.0;
+		Same = Row[First+n] == Expected;
+	}
+	std::cout << "\n" << change << ", printed powers as evaluated: "
+		<< (Same ? "PASS" : "FAIL");
+	return Same;
+}
+
+static bool HeatPowerTestList(std::vector<HeatTerm*> heatterms,
+const std::string &name){
+	const std::string FileName = "Data/HeatPowerTest_hm.txt";
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	Matter *Sample = new Tungsten(1e-6,1500,ConstModels);
+	Sample->set_potential(2.0);
+	PlasmaData Pdata = PlasmaDataDefaults;
+	derive_plasmadata(Pdata);
+	bool Pass = true;
+	std::cout << "\n\n" << name;
+	{
+		HeatingModel HM(FileName,1.0,heatterms,Sample,Pdata);
+		Sample->update_temperature(0.05*Sample->get_temperature()
+			*Sample->get_mass()*Sample->get_heatcapacity());
+		Sample->update();
+		Pass = HeatPowerTestCompare(HM,heatterms,Sample,Pdata,FileName,
+			"Temperature raised") && Pass;
+
+		Sample->set_potential(-1.0);
+		Pass = HeatPowerTestCompare(HM,heatterms,Sample,Pdata,FileName,
+			"Potential changed") && Pass;
+
+		Sample->update_mass(0.01*Sample->get_mass());
+		Sample->update();
+		Pass = HeatPowerTestCompare(HM,heatterms,Sample,Pdata,FileName,
+			"Mass lost") && Pass;
+
+		Pdata.ElectronTemp *= 2.0;
+		Pdata.IonDensity *= 3.0;
+		Pdata.NeutralDensity *= 0.5;
+		derive_plasmadata(Pdata);
+		HM.set_plasmadata(Pdata);
+		Pass = HeatPowerTestCompare(HM,heatterms,Sample,Pdata,FileName,
+			"Plasma changed") && Pass;
+
+		for( unsigned int n = 0; n < 100 && !Sample->is_liquid(); n ++ )
+			Sample->update_temperature(0.05*Sample->get_temperature()
+				*Sample->get_mass()*Sample->get_heatcapacity());
+		Sample->update();
+		bool Liquid = Sample->is_liquid();
+		Pass = HeatPowerTestCompare(HM,heatterms,Sample,Pdata,FileName,
+			"Melted") && Liquid && Pass;
+	}
+	std::remove(FileName.c_str());
+	for( HeatTerm *Term : heatterms ) delete Term;
+	delete Sample;
+	return Pass;
+}
+
+int HeatPowerTest(){
+	clock_t begin = clock();
+	mkdir("Data",0755);
+	bool Pass = true;
+
+	using namespace Term;
+	Pass = HeatPowerTestList({ new EmissivityModel(), new EvaporationModel(),
+		new NeutralHeatFlux(), new OMLElectronHeatFlux(),
+		new DTOKSIonHeatFlux(), new DTOKSNeutralRecombination(),
+		new DTOKSSEE(), new DTOKSTEE() },"Registered terms") && Pass;
+	Pass = HeatPowerTestList({ new EvaporationModel(), new EmissivityModel(),
+		new NeutralHeatFlux(), new OMLElectronHeatFlux() },
+		"Terms without a kernel") && Pass;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nHeatPower " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
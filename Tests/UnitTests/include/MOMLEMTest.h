@@ -1,79 +1,76 @@
+#include "Constants.h"
 #include "solveMOMLEM.h"
 #include <iostream>
 #include <limits>
+#include <math.h>
 
-// Test orbital motion limited theory
-void MOMLEMTest(){
-	clock_t begin = clock();
+// This test checks the MOML-EM potentials against known roots.
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou, A. P. L. Robinson, M. Coppins, and M. Bacharis, Phys. Plasmas 21, (2014).
+// Without a well the potential must be the wall potential of equation (24). With a well it
+// must be the wall potential of a root of equations [53-55] satisfying phiw < phis < 0 and
+// phiw < phic, which is checked by evaluating the residuals of the equations at the root.
 
-	/* CASE 1
-	REPLICATING FIGURE 3.
-	Finding Critical Emmitted temperature ratio with fixed:
-		Emitted density ratio 		= 0.3
-		Temperature Ratio 		= 1.0
-	*/
-	double guess = -1.0;	// Initial guess at potential
-	double EmittedDensityRatio = 0.3;
-	double TiTe = 1.0;
-//	for( double TiTe(0.01); TiTe < 100; TiTe *= 1.5 ){
+struct MOMLEMTestCase{
+	double Tau, Chi, Delta;
+	bool Well;
+};
 
-  	std::cout.precision(std::numeric_limits<double>::max_digits10);
-	std::cout << "\n* CRITICAL EMITTED TEMPERATURE RATIO *";
-	double CritVal = FindCriticalVal(TiTe,EmittedDensityRatio,Mp/Me,'d');
-	std::cout << "\n" << CritVal;
+static bool MOMLEMTestCheck(const MOMLEMTestCase &c, std::string result, bool pass){
+	std::cout << "\nTau = " << c.Tau << ", Chi = " << c.Chi << ", Delta = " << c.Delta
+		<< ": " << result << ": " << (pass ? "PASS" : "FAIL");
+	return pass;
+}
 
-	double EmittedTemperatureRatio = CritVal;
-	exploreWellCase(TiTe,0.2,EmittedTemperatureRatio,1.0/(Mp/Me));
-	for( EmittedTemperatureRatio = CritVal; EmittedTemperatureRatio < 0.201; EmittedTemperatureRatio += 0.01 ){
-//		double Potential = solveMOMLEM(TiTe,Mp/Me,EmittedDensityRatio,EmittedTemperatureRatio);
+int MOMLEMTest(){
+	clock_t begin = clock();
+	std::cout.precision(10);
+	const double Mu = Me/Mp;
+	bool Pass = true;
 
-//		std::cout << "\n" << TiTe << "\t" << Mp/Me << "\t" << EmittedDensityRatio 
-//			<< "\t" << EmittedTemperatureRatio << "\t" << Potential 
-//			<< "\t" << log(sqrt(TiTe/(Mp/Me))+EmittedDensityRatio*sqrt(EmittedTemperatureRatio));
-	}
+	const MOMLEMTestCase Cases[] = {
+		{ 0.5, 0.1, 0.2, false }, { 1.0, 0.1, 1.0, false }, { 1.0, 0.3, 0.05, false },
+		{ 2.0, 0.3, 0.2, false }, { 1.0, 1.0, 1.0, false },
+		{ 0.5, 0.3, 0.5, true }, { 0.5, 1.0, 0.5, true }, { 1.0, 0.3, 0.2, true },
+		{ 1.0, 0.3, 1.0, true }, { 1.0, 1.0, 0.5, true }, { 2.0, 0.3, 0.5, true },
+		{ 2.0, 1.0, 0.05, true } };
 
-	/* CASE 2
-	REPLICATING FIGURE 2.
-	Finding Critical Emitted Density Ratio with fixed:
-		Emitted temperature ratio 	= 0.5
-		Temperature Ratio 		= 1.0
-	*/
-	TiTe = 1.0;
+	for( const MOMLEMTestCase &c : Cases ){
+		int Iterations(0);
+		double Potential = solveMOMLEM(c.Tau,1.0/Mu,c.Chi,c.Delta,Iterations);
+		double Phic = log(sqrt(c.Tau*Mu)+c.Chi*sqrt(c.Delta));
+		if( !c.Well ){
+			// Equation (24)
+			Pass = MOMLEMTestCheck(c,"no well, phiw = phic",
+				Iterations == 0 && Potential == Phic) && Pass;
+			continue;
+		}
 
-//	std::cout << "\n* CRITICAL EMITTED DENSITY RATIO *";
-//	CritVal = FindCriticalVal(TiTe,EmittedTemperatureRatio,Mp/Me,'c');
-//	std::cout << "\n" << CritVal;
-/*
-	for( TiTe = 0.5; TiTe < 7.0; TiTe += 0.1 ){
-		double Potential = solveMOMLEM(TiTe,Mp/Me,EmittedDensityRatio,EmittedTemperatureRatio);
-//		std::cout << "\n" << TiTe << "\t" << Mp/Me << "\t" << EmittedDensityRatio 
-//			<< "\t" << EmittedTemperatureRatio << "\t" << guess << "\t" << Potential
-//			<< "\t" << log(sqrt(TiTe/(Mp/Me))+EmittedDensityRatio*sqrt(EmittedTemperatureRatio));
-//		std::cout << "\t" << Potential;
+		// Solve for the whole root from the first guess of solveMOMLEM()
+		double Wall = log(sqrt(c.Tau*Mu))-0.05;
+		double phis = std::max(-0.5,Wall+0.1), phic = phis+0.1, phiw = Wall;
+		int WellIterations(0);
+		double s = solveWellCase(phis,phic,phiw,c.Tau,c.Chi,c.Delta,Mu,WellIterations);
+		double Residuals[3] = { WDB_f(phis,phic,phiw,c.Tau,c.Chi,c.Delta),
+			WIB_f(phis,phiw,c.Tau,c.Chi,c.Delta), WFB_f(phic,phiw,c.Tau,c.Chi,c.Delta,Mu) };
+		bool Root = Iterations > 0 && s < 1e-9 && phiw < phis && phis < 0.0 && phiw < phic
+			&& fabs(Residuals[0]) < 1e-9 && fabs(Residuals[1]) < 1e-9
+			&& fabs(Residuals[2]) < 1e-9 && fabs(Potential-phiw) < 1e-9;
+		Pass = MOMLEMTestCheck(c,"well, phiw = "+std::to_string(Potential),Root) && Pass;
 	}
-*/
-	/* CASE 3
-	REPLICATING FIGURE 4.
-	Finding Critical Temperature Ratio with fixed:
-		Emitted density ratio 		= 0.3
-		EittedTemperature Ratio 	= 0.5
-	*/
-	EmittedTemperatureRatio = 0.5;
 
-//	std::cout << "\n* CRITICAL TEMPERATURE RATIO *";
-//	CritVal = FindCriticalVal(EmittedDensityRatio,EmittedTemperatureRatio,Mp/Me,'t');
-//	std::cout << "\n" << CritVal;
-/*
-	for( EmittedDensityRatio = 0.01; EmittedDensityRatio < 0.5; EmittedDensityRatio += 0.01 ){
-		double Potential = solveMOMLEM(TiTe,Mp/Me,EmittedDensityRatio,EmittedTemperatureRatio);
-//		std::cout << "\n" << TiTe << "\t" << Mp/Me << "\t" << EmittedDensityRatio 
-//			<< "\t" << EmittedTemperatureRatio << "\t" << guess << "\t" << Potential
-//			<< "\t" << log(sqrt(TiTe/(Mp/Me))+EmittedDensityRatio*sqrt(EmittedTemperatureRatio));
-//		std::cout << "\t" << Potential;
-	}
-*/
+	// A guess breaking the constraints is rejected and left unchanged
+	double phis(-0.5), phic(-0.4), phiw(-0.2);
+	int Iterations(0);
+	double s = solveWellCase(phis,phic,phiw,1.0,0.3,0.5,Mu,Iterations);
+	bool Rejected = s == HUGE_VAL && Iterations == 0 && phis == -0.5 && phic == -0.4
+		&& phiw == -0.2;
+	std::cout << "\nGuess with phiw > phis: " << (Rejected ? "PASS" : "FAIL");
+	Pass = Pass && Rejected;
+
 	clock_t end = clock();
 	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
-		
-//	std::cout << "\n\n*****\n\nMOMLEM UnitTest completed in " << elapsd_secs << "s\n";
+	std::cout << "\n\n*****\n\nMOMLEM " << (Pass ? "PASSED" : "FAILED") << " in " << elapsd_secs
+		<< "s\n";
+	return Pass ? 0 : 1;
 }
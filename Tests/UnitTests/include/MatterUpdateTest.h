@@ -0,0 +1,99 @@
+#include "Tungsten.h"
+#include <iostream>
+
+// This test heats a tungsten grain with variable thermal expansion and heat
+// capacity in small steps, losing mass every few steps, and calls update()
+// after each as a run does. With the default tolerance of zero, every
+// property must be bitwise the same as those of a grain with the same history
+// whose properties are all refreshed by every update(), as they were before
+// changes were tracked. With a nonzero tolerance, changes of the
+// temperature within the tolerance must leave the properties as they were and
+// larger changes must refresh them as with no tolerance.
+
+// Whether the properties refreshed by update() are the same for \p a and \p b
+static bool MatterUpdateSame(const Matter *a, const Matter *b){
+	return a->get_radius() == b->get_radius()
+		&& a->get_density() == b->get_density()
+		&& a->get_heatcapacity() == b->get_heatcapacity()
+		&& a->get_emissivity() == b->get_emissivity()
+		&& a->get_vapourpressure() == b->get_vapourpressure()
+		&& a->get_superboilingtemp() == b->get_superboilingtemp();
+}
+
+// Refresh every property of \p sample, as update() did before it tracked
+// changes
+static void MatterUpdateAll(Matter *sample){
+	GrainData Data = sample->get_graindata();
+	sample->set_graindata(Data);
+	sample->update();
+}
+
+// Heat \p sample by the fraction \p rise of its temperature
+static void MatterUpdateHeat(Matter *sample, double rise){
+	sample->update_temperature(rise*sample->get_temperature()
+		*sample->get_mass()*sample->get_heatcapacity());
+}
+
+int MatterUpdateTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+	std::array<char,CM> ConstModels = {'c','v','v','y','n'};
+
+	Matter *Sample = new Tungsten(1e-6,300,ConstModels);
+	Matter *Reference = new Tungsten(1e-6,300,ConstModels);
+	bool Same = true;
+	for( unsigned int n = 0; n < 200 && Same; n ++ ){
+		MatterUpdateHeat(Sample,0.005);
+		MatterUpdateHeat(Reference,0.005);
+		if( n%3 == 0 ){
+			Sample->update_mass(1e-4*Sample->get_mass());
+			Reference->update_mass(1e-4*Reference->get_mass());
+		}
+		Sample->update();
+		MatterUpdateAll(Reference);
+		Same = MatterUpdateSame(Sample,Reference);
+	}
+	std::cout << "\nZero tolerance, properties as if all refreshed, T = "
+		<< Sample->get_temperature() << "K: " << (Same ? "PASS" : "FAIL");
+	Pass = Pass && Same;
+	delete Reference;
+	delete Sample;
+
+	const double Tolerance = 1e-2;
+	Sample = new Tungsten(1e-6,1000,ConstModels);
+	Sample->set_updatetolerance(Tolerance);
+	Matter *Before = Sample->clone();
+	const double Radius = Sample->get_radius();
+
+	// Two rises stay within the tolerance of the temperature the properties
+	// were last refreshed at, a third takes it beyond
+	MatterUpdateHeat(Sample,0.004);
+	Sample->update();
+	MatterUpdateHeat(Sample,0.004);
+	Sample->update();
+	bool Skipped = MatterUpdateSame(Sample,Before)
+		&& Sample->get_temperature() != Before->get_temperature();
+	std::cout << "\nChanges within the tolerance keep the properties: "
+		<< (Skipped ? "PASS" : "FAIL");
+	Pass = Pass && Skipped;
+
+	MatterUpdateHeat(Sample,0.004);
+	Sample->update();
+	MatterUpdateHeat(Before,0.004);
+	MatterUpdateHeat(Before,0.004);
+	MatterUpdateHeat(Before,0.004);
+	MatterUpdateAll(Before);
+	bool Updated = MatterUpdateSame(Sample,Before)
+		&& Sample->get_radius() != Radius;
+	std::cout << "\nChanges beyond the tolerance refresh the properties: "
+		<< (Updated ? "PASS" : "FAIL");
+	Pass = Pass && Updated;
+	delete Before;
+	delete Sample;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nMatterUpdate " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+#include "PlasmaGridCache.h"
+#include "PlasmaGridReader.h"
+#include "PlasmaGridFields.h"
+#include "GridInterpolation.h"
+#include "Model.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+// This test builds a small plasma grid of random values, derives its fields,
+// packs its cells and builds its stencils as a run does, writes it to a grid
+// cache and maps the cache back into a grid configured the same way. Every
+// field of the mapped grid must be bitwise the same as the original and be a
+// read-only view of the cache. The cache must then be refused once a source
+// file is touched within the same second and once its data is corrupted.
+
+// The dimensions and spacing of the grid, as configured before it is read
+static void PlasmaGridCacheConfigure(PlasmaGrid_Data &pgrid){
+	pgrid.gridx = 13;
+	pgrid.gridz = 9;
+	pgrid.gridtheta = 0;
+	pgrid.gridxmin = 1.0;
+	pgrid.gridxmax = 2.2;
+	pgrid.gridzmin = -0.4;
+	pgrid.gridzmax = 0.4;
+	pgrid.dlx = 0.1;
+	pgrid.dlz = 0.1;
+	pgrid.mi = PlasmaDataDefaults.mi;
+	pgrid.device = 'j';
+	pgrid.interpolation = Interpolation::Bilinear;
+}
+
+template<typename T> static bool PlasmaGridCacheSame(const GridField<T> &a,
+const GridField<T> &b, const char *name){
+	bool Same = a.size() == b.size() && b.is_view() && !a.is_view()
+		&& std::memcmp(a.data(),b.data(),a.size()*sizeof(T)) == 0;
+	if( !Same ) std::cout << "\n\t" << name << " differs";
+	return Same;
+}
+
+int PlasmaGridCacheTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+	std::mt19937 Generator(1618);
+	std::uniform_real_distribution<double> Uniform(0.0,1.0);
+	const std::string Source = "PlasmaGridCacheTest.dat";
+	const std::string CacheFile = "PlasmaGridCacheTest.grd";
+	std::ofstream(Source) << "b2processed data the grid was read from\n";
+	const std::vector<std::string> Sources = { Source };
+	PlasmaData Pdata = PlasmaDataDefaults;
+
+	// The grid as read from the plasma files
+	PlasmaGrid_Data Pgrid;
+	PlasmaGridCacheConfigure(Pgrid);
+	allocate_plasmafields(Pgrid);
+	for( int i = 0; i < Pgrid.gridx; i ++ ){
+		for( int k = 0; k < Pgrid.gridz; k ++ ){
+			Pgrid.x[i][k] = Pgrid.gridxmin+i*Pgrid.dlx;
+			Pgrid.z[i][k] = Pgrid.gridzmin+k*Pgrid.dlz;
+			Pgrid.Te[i][k] = 10.0+100.0*Uniform(Generator);
+			Pgrid.Ti[i][k] = 10.0+100.0*Uniform(Generator);
+			Pgrid.Tn[i][k] = Pdata.NeutralTemp;
+			Pgrid.Ta[i][k] = Pdata.AmbientTemp;
+			Pgrid.na0[i][k] = 1e19*(0.5+Uniform(Generator));
+			Pgrid.na1[i][k] = 1e19*(0.5+Uniform(Generator));
+			Pgrid.na2[i][k] = Pdata.NeutralDensity;
+			Pgrid.po[i][k] = -50.0+100.0*Uniform(Generator);
+			Pgrid.ua0[i][k] = -1e4+2e4*Uniform(Generator);
+			Pgrid.ua1[i][k] = -1e4+2e4*Uniform(Generator);
+			Pgrid.bx[i][k] = 1.0+Uniform(Generator);
+			Pgrid.by[i][k] = -1.0-Uniform(Generator);
+			Pgrid.bz[i][k] = 0.5-Uniform(Generator);
+			Pgrid.gridflag[i][k] = Uniform(Generator) < 0.8 ? 1 : 0;
+		}
+	}
+	derive_plasmafields(Pgrid);
+	pack_plasmacells(Pgrid);
+	build_stencils(Pgrid);
+
+	int Written = write_gridcache(Pgrid,Pdata,1,Sources,CacheFile);
+	int ReadStatus(-1), Mapped(-1);
+	{
+		PlasmaGrid_Data Cached;
+		PlasmaGridCacheConfigure(Cached);
+		Mapped = read_gridcache(Cached,Pdata,ReadStatus,Sources,CacheFile);
+		const PlasmaGrid_Data &Original = Pgrid, &Copy = Cached;
+		bool Same = Written == 0 && Mapped == 0 && ReadStatus == 1
+			&& PlasmaGridCacheSame(Original.Te,Copy.Te,"Te")
+			&& PlasmaGridCacheSame(Original.Ti,Copy.Ti,"Ti")
+			&& PlasmaGridCacheSame(Original.Tn,Copy.Tn,"Tn")
+			&& PlasmaGridCacheSame(Original.Ta,Copy.Ta,"Ta")
+			&& PlasmaGridCacheSame(Original.na0,Copy.na0,"na0")
+			&& PlasmaGridCacheSame(Original.na1,Copy.na1,"na1")
+			&& PlasmaGridCacheSame(Original.na2,Copy.na2,"na2")
+			&& PlasmaGridCacheSame(Original.po,Copy.po,"po")
+			&& PlasmaGridCacheSame(Original.ua0,Copy.ua0,"ua0")
+			&& PlasmaGridCacheSame(Original.ua1,Copy.ua1,"ua1")
+			&& PlasmaGridCacheSame(Original.bx,Copy.bx,"bx")
+			&& PlasmaGridCacheSame(Original.by,Copy.by,"by")
+			&& PlasmaGridCacheSame(Original.bz,Copy.bz,"bz")
+			&& PlasmaGridCacheSame(Original.x,Copy.x,"x")
+			&& PlasmaGridCacheSame(Original.z,Copy.z,"z")
+			&& PlasmaGridCacheSame(Original.Er,Copy.Er,"Er")
+			&& PlasmaGridCacheSame(Original.Ez,Copy.Ez,"Ez")
+			&& PlasmaGridCacheSame(Original.vpx,Copy.vpx,"vpx")
+			&& PlasmaGridCacheSame(Original.vpy,Copy.vpy,"vpy")
+			&& PlasmaGridCacheSame(Original.vpz,Copy.vpz,"vpz")
+			&& PlasmaGridCacheSame(Original.gridflag,Copy.gridflag,"gridflag")
+			&& PlasmaGridCacheSame(Original.Cells,Copy.Cells,"Cells")
+			&& PlasmaGridCacheSame(Original.Stencils,Copy.Stencils,"Stencils");
+		std::cout << "\nWrite status " << Written << ", map status " << Mapped
+			<< ", grid read status " << ReadStatus << ": "
+			<< (Same ? "PASS" : "FAIL");
+		Pass = Pass && Same;
+	}
+
+	// Touching the source a nanosecond apart leaves its size and the second
+	// of its modification time unchanged, but the cache is out of date
+	struct stat Status;
+	stat(Source.c_str(),&Status);
+	struct timespec Times[2] = { Status.st_atim, Status.st_mtim };
+	Times[1].tv_nsec = Times[1].tv_nsec == 0 ? 1 : Times[1].tv_nsec-1;
+	utimensat(AT_FDCWD,Source.c_str(),Times,0);
+	{
+		PlasmaGrid_Data Cached;
+		PlasmaGridCacheConfigure(Cached);
+		Mapped = read_gridcache(Cached,Pdata,ReadStatus,Sources,CacheFile);
+	}
+	std::cout << "\nSource touched in the same second, map status " << Mapped
+		<< ": " << (Mapped == 3 ? "PASS" : "FAIL");
+	Pass = Pass && Mapped == 3;
+
+	// A cache whose data is corrupted is not mapped
+	write_gridcache(Pgrid,Pdata,1,Sources,CacheFile);
+	stat(CacheFile.c_str(),&Status);
+	{
+		std::fstream Cache(CacheFile,std::fstream::in|std::fstream::out
+			|std::fstream::binary);
+		Cache.seekp(Status.st_size-1);
+		Cache.put('\x55');
+	}
+	{
+		PlasmaGrid_Data Cached;
+		PlasmaGridCacheConfigure(Cached);
+		Mapped = read_gridcache(Cached,Pdata,ReadStatus,Sources,CacheFile);
+	}
+	std::cout << "\nCorrupted cache, map status " << Mapped << ": "
+		<< (Mapped == 2 ? "PASS" : "FAIL");
+	Pass = Pass && Mapped == 2;
+
+	std::remove(Source.c_str());
+	std::remove(CacheFile.c_str());
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nPlasmaGridCache "
+		<< (Pass ? "PASSED" : "FAILED") << " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
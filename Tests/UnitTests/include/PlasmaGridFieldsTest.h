@@ -0,0 +1,146 @@
+#include "PlasmaGridFields.h"
+#include "PlasmaGridReader.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+// This test derives the fields of a small plasma grid, writes them to a
+// fields file and reads them back into a grid with no derived fields, which
+// must then be bitwise the same. Files written for a grid whose potential has
+// since changed, for a grid of another spacing or cut short must be refused
+// without changing the grid, then loading the fields must derive them afresh
+// and write them in place of the file, so that it is read by the next run. A
+// file is not replaced unless asked, and a file which can't be written is
+// reported.
+
+// Fill an 11 by 8 grid, outside the plasma at one corner, with smooth fields
+static void PlasmaGridFieldsGrid(PlasmaGrid_Data &pgrid){
+	pgrid.gridx = 11;
+	pgrid.gridz = 8;
+	pgrid.gridtheta = 0;
+	pgrid.gridxmin = 1.0;
+	pgrid.gridxmax = 2.0;
+	pgrid.gridzmin = -0.35;
+	pgrid.gridzmax = 0.35;
+	pgrid.dlx = 0.1;
+	pgrid.dlz = 0.1;
+	allocate_plasmafields(pgrid);
+	for( int i = 0; i < pgrid.gridx; i ++ ){
+		for( int k = 0; k < pgrid.gridz; k ++ ){
+			pgrid.po[i][k] = 20.0*sin(0.7*i)*cos(0.3*k)-5.0;
+			pgrid.na0[i][k] = 1e19*(1.5+sin(0.4*i+0.9*k));
+			pgrid.na1[i][k] = 1e19*(1.5+cos(0.5*i-0.2*k));
+			pgrid.ua0[i][k] = 1e4*sin(0.3*i*k);
+			pgrid.ua1[i][k] = -5e3*cos(0.6*i+k);
+			pgrid.bx[i][k] = 0.2+0.01*i;
+			pgrid.by[i][k] = -2.0+0.05*k;
+			pgrid.bz[i][k] = 0.1*sin(i+k);
+			pgrid.gridflag[i][k] = i+k < 3 ? 0 : 1;
+		}
+	}
+}
+
+// Whether the derived fields of \p a and \p b are bitwise the same
+static bool PlasmaGridFieldsSame(const PlasmaGrid_Data &a,
+const PlasmaGrid_Data &b){
+	const GridField<double> *A[5] = { &a.Er, &a.Ez, &a.vpx, &a.vpy, &a.vpz };
+	const GridField<double> *B[5] = { &b.Er, &b.Ez, &b.vpx, &b.vpy, &b.vpz };
+	for( int n = 0; n < 5; n ++ ){
+		if( A[n]->size() != B[n]->size() || std::memcmp(A[n]->data(),
+			B[n]->data(),A[n]->size()*sizeof(double)) != 0 )
+			return false;
+	}
+	return true;
+}
+
+static std::string PlasmaGridFieldsRead(const std::string &filename){
+	std::ifstream File(filename);
+	std::ostringstream Contents;
+	Contents << File.rdbuf();
+	return Contents.str();
+}
+
+// Refuse \p filename for \p pgrid, leaving its fields, then rebuild the file
+static bool PlasmaGridFieldsRebuilt(PlasmaGrid_Data &pgrid,
+const std::string &filename, int status, const std::string &change){
+	PlasmaGrid_Data Before = pgrid;
+	int Read = read_derivedfields(pgrid,filename);
+	bool Refused = Read == status && PlasmaGridFieldsSame(pgrid,Before);
+
+	PlasmaGrid_Data Derived = pgrid;
+	derive_plasmafields(Derived);
+	int Loaded = load_derivedfields(pgrid,filename,true);
+	PlasmaGrid_Data Reread = Before;
+	bool Rebuilt = Loaded == status && PlasmaGridFieldsSame(pgrid,Derived)
+		&& read_derivedfields(Reread,filename) == 0
+		&& PlasmaGridFieldsSame(Reread,Derived);
+	std::cout << "\n" << change << ", refused with status " << Read
+		<< " and rebuilt: " << (Refused && Rebuilt ? "PASS" : "FAIL");
+	return Refused && Rebuilt;
+}
+
+int PlasmaGridFieldsTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+	const std::string FieldsFile = "PlasmaGridFieldsTest.txt";
+
+	PlasmaGrid_Data Pgrid;
+	PlasmaGridFieldsGrid(Pgrid);
+	derive_plasmafields(Pgrid);
+	PlasmaGrid_Data Empty;
+	PlasmaGridFieldsGrid(Empty);
+	bool RoundTrip = write_derivedfields(Pgrid,FieldsFile) == 0
+		&& read_derivedfields(Empty,FieldsFile) == 0
+		&& PlasmaGridFieldsSame(Empty,Pgrid);
+	PlasmaGridFieldsGrid(Empty);
+	RoundTrip = RoundTrip && load_derivedfields(Empty,FieldsFile,true) == 0
+		&& PlasmaGridFieldsSame(Empty,Pgrid);
+	std::cout << "\nFields read back bitwise: "
+		<< (RoundTrip ? "PASS" : "FAIL");
+	Pass = Pass && RoundTrip;
+
+	// Loading for another plasma must not replace the file unless asked
+	PlasmaGrid_Data Stale = Pgrid;
+	Stale.po[5][4] += 1.0;
+	const std::string Written = PlasmaGridFieldsRead(FieldsFile);
+	PlasmaGrid_Data Kept = Stale;
+	bool NotSaved = load_derivedfields(Kept,FieldsFile,false) == 3
+		&& PlasmaGridFieldsRead(FieldsFile) == Written
+		&& Kept.Er[4][4] != Pgrid.Er[4][4];
+	std::cout << "\nOut of date file not replaced unless saved: "
+		<< (NotSaved ? "PASS" : "FAIL");
+	Pass = Pass && NotSaved;
+
+	Pass = PlasmaGridFieldsRebuilt(Stale,FieldsFile,3,"Potential changed")
+		&& Pass;
+
+	PlasmaGrid_Data Spacing = Pgrid;
+	Spacing.dlz = 0.05;
+	Pass = PlasmaGridFieldsRebuilt(Spacing,FieldsFile,2,"Spacing changed")
+		&& Pass;
+
+	PlasmaGrid_Data Truncated = Pgrid;
+	write_derivedfields(Truncated,FieldsFile);
+	const std::string Full = PlasmaGridFieldsRead(FieldsFile);
+	std::ofstream(FieldsFile) << Full.substr(0,Full.size()/2);
+	Pass = PlasmaGridFieldsRebuilt(Truncated,FieldsFile,2,"File cut short")
+		&& Pass;
+
+	PlasmaGrid_Data Unwritable = Pgrid;
+	bool Reported = load_derivedfields(Unwritable,
+		"PlasmaGridFieldsTest/missing/fields.txt",true) == 4
+		&& PlasmaGridFieldsSame(Unwritable,Pgrid);
+	std::cout << "\nUnwritable file reported: " << (Reported ? "PASS" : "FAIL");
+	Pass = Pass && Reported;
+
+	std::remove(FieldsFile.c_str());
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nPlasmaGridFields "
+		<< (Pass ? "PASSED" : "FAILED") << " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
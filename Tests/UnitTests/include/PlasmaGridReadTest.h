@@ -0,0 +1,144 @@
+#include "PlasmaGridReader.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+// This test writes a small set of b2processed files, formatting the numbers
+// in the different ways found in the plasma data, and checks that the
+// threaded reader gives bitwise the same fields and status as the reference
+// reader using file streams.
+
+// Format one value as a particular producer of the files might have
+static std::string PlasmaGridReadFormat(double value, unsigned int style){
+	char Buffer[64];
+	switch( style%6 ){
+		case 0: snprintf(Buffer,sizeof(Buffer),"%.8e",value);	break;
+		case 1: snprintf(Buffer,sizeof(Buffer),"%g",value);	break;
+		case 2: snprintf(Buffer,sizeof(Buffer),"%.17g",value);	break;
+		case 3: snprintf(Buffer,sizeof(Buffer),"%+.3E",value);	break;
+		case 4: snprintf(Buffer,sizeof(Buffer),"%.25e",value);	break;
+		default:
+			// Leading point without a zero, e.g. ".5" or "-.25e-3"
+			snprintf(Buffer,sizeof(Buffer),"%.6e",value);
+			std::string Text(Buffer);
+			size_t Zero = Text.find("0.");
+			if( Zero != std::string::npos
+				&& (Zero == 0 || Text[Zero-1] == '-') )
+				Text.erase(Zero,1);
+			return Text;
+	}
+	return std::string(Buffer);
+}
+
+static bool PlasmaGridReadSame(const GridField<double> &a,
+const GridField<double> &b, const char *name){
+	if( a.size() == b.size()
+		&& std::memcmp(a.data(),b.data(),a.size()*sizeof(double)) == 0 )
+		return true;
+	std::cout << "\n\t" << name << " differs";
+	return false;
+}
+
+int PlasmaGridReadTest(){
+	clock_t begin = clock();
+	const int Nx = 37, Nz = 23;
+	std::mt19937 Generator(1729);
+	std::uniform_real_distribution<double> Uniform(0.0,1.0);
+	const char *Spaces[] = { " ", "  ", "\t", "   " };
+
+	std::ofstream Scalars("b2processed.dat");
+	std::ofstream Vectors("b2processed2.dat");
+	std::ofstream Flags("locate.dat");
+	Scalars << "x z Te Ti na0 na1 po ua0 ua1\n";
+	Vectors << "dum1 dum2 bxxx bzzz byyy\n";
+	unsigned int Style = 0;
+	for( int k = 0; k < Nz; k ++ ){
+		for( int i = 0; i < Nx; i ++ ){
+			// Temperatures in J, to lie in range for JET but not for MAST
+			double Row[9] = { 1.5+i*0.01, -2.0+k*0.02,
+				1.6e-18*(1+10*Uniform(Generator)),
+				1.6e-18*(1+10*Uniform(Generator)),
+				1e19*(0.5+Uniform(Generator)), 1e19*(0.5+Uniform(Generator)),
+				-50+100*Uniform(Generator), -1e4+2e4*Uniform(Generator),
+				-1e4+2e4*Uniform(Generator) };
+			for( unsigned int c = 0; c < 9; c ++ ){
+				Scalars << Spaces[(Style+c)%4]
+					<< PlasmaGridReadFormat(Row[c],Style+c);
+			}
+			Scalars << ((k+i)%5 == 0 ? "\r\n" : "\n");
+			double Field[5] = { Row[0], Row[1], 1+Uniform(Generator),
+				-1-Uniform(Generator), 0.5-Uniform(Generator) };
+			for( unsigned int c = 0; c < 5; c ++ ){
+				Vectors << Spaces[(Style+c)%4]
+					<< PlasmaGridReadFormat(Field[c],Style+c);
+			}
+			Vectors << "\n";
+			Flags << i << " " << k << " " << (Uniform(Generator) < 0.8 ? 1 : 0)
+				<< "\n";
+			Style ++;
+		}
+	}
+	Scalars.close();
+	Vectors.close();
+	Flags.close();
+
+	PlasmaData Pdata;
+	Pdata.AmbientTemp = 300;
+	Pdata.NeutralTemp = 400;
+	Pdata.NeutralDensity = 1e18;
+
+	bool Pass = true;
+	const char Devices[] = { 'j', 'm' };
+	const unsigned int Threads[] = { 1, 3, 8 };
+	for( char Device : Devices ){
+		PlasmaGrid_Data Reference;
+		Reference.gridx = Nx;
+		Reference.gridz = Nz;
+		Reference.device = Device;
+		int ReferenceStatus = read_b2processed_reference(Reference,Pdata,"");
+		for( unsigned int Thread : Threads ){
+			PlasmaGrid_Data Pgrid;
+			Pgrid.gridx = Nx;
+			Pgrid.gridz = Nz;
+			Pgrid.device = Device;
+			int Status = read_b2processed(Pgrid,Pdata,"",Thread);
+			bool Same = Status == ReferenceStatus;
+			if( !Same ) std::cout << "\n\tstatus differs";
+			Same = PlasmaGridReadSame(Pgrid.x,Reference.x,"x") && Same;
+			Same = PlasmaGridReadSame(Pgrid.z,Reference.z,"z") && Same;
+			Same = PlasmaGridReadSame(Pgrid.Te,Reference.Te,"Te") && Same;
+			Same = PlasmaGridReadSame(Pgrid.Ti,Reference.Ti,"Ti") && Same;
+			Same = PlasmaGridReadSame(Pgrid.Tn,Reference.Tn,"Tn") && Same;
+			Same = PlasmaGridReadSame(Pgrid.Ta,Reference.Ta,"Ta") && Same;
+			Same = PlasmaGridReadSame(Pgrid.na0,Reference.na0,"na0") && Same;
+			Same = PlasmaGridReadSame(Pgrid.na1,Reference.na1,"na1") && Same;
+			Same = PlasmaGridReadSame(Pgrid.na2,Reference.na2,"na2") && Same;
+			Same = PlasmaGridReadSame(Pgrid.po,Reference.po,"po") && Same;
+			Same = PlasmaGridReadSame(Pgrid.ua0,Reference.ua0,"ua0") && Same;
+			Same = PlasmaGridReadSame(Pgrid.ua1,Reference.ua1,"ua1") && Same;
+			Same = PlasmaGridReadSame(Pgrid.bx,Reference.bx,"bx") && Same;
+			Same = PlasmaGridReadSame(Pgrid.by,Reference.by,"by") && Same;
+			Same = PlasmaGridReadSame(Pgrid.bz,Reference.bz,"bz") && Same;
+			if( std::memcmp(Pgrid.gridflag.data(),Reference.gridflag.data(),
+				Nx*Nz*sizeof(int)) != 0 ){
+				std::cout << "\n\tgridflag differs";
+				Same = false;
+			}
+			std::cout << "\nDevice " << Device << ", " << Thread
+				<< " threads, status " << Status << ": "
+				<< (Same ? "PASS" : "FAIL");
+			Pass = Pass && Same;
+		}
+	}
+	std::remove("b2processed.dat");
+	std::remove("b2processed2.dat");
+	std::remove("locate.dat");
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nPlasmaGridRead " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+#include "PotentialTable.h"
+#include "solveMOMLEM.h"
+#include "Functions.h"
+#include "Constants.h"
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+
+// This test tabulates the MOMLWEM and MOMLEM potentials on coarse grids the
+// way the dtokstable tool does, invalidating cells whose corners are in
+// different regimes or which interpolate the solution at their centre
+// poorly, and compares PotentialTable::lookup() with the direct solution at
+// random points over the range of each table. Every point must either be
+// refused by the table or lie close to the solution. The table must survive
+// being written and read back, and PotentialTable::local() must return the
+// shared table of the plasma.
+
+// Solve the tabulated model at x, setting regime as the generator does
+static double PotentialTableSolve(char model, const double *x,
+unsigned char &regime){
+	double Potential(0.0);
+	regime = 0;
+	if( model == PotentialTables::MOMLEM ){
+		int Iterations(0);
+		Potential = solveMOMLEM(x[0],Mp/Me,x[1],x[2],Iterations);
+		double NoWell = log(sqrt(x[0]*Me/Mp)+x[1]*sqrt(x[2]));
+		if( Iterations > 0 ) regime = Potential != NoWell ? 1 : 2;
+	}else{
+		try{
+			Potential = solveMOMLWEM(x[0],Mp/Me,1.0,x[1]);
+		}catch( LambertWFailure &e ){
+			Potential = NAN;
+		}
+	}
+	return std::isfinite(Potential) ? Potential : NAN;
+}
+
+// Tabulate model on axes, marking cells valid as the generator does
+static PotentialTable PotentialTableBuild(char model,
+const std::vector<std::vector<double>> &axes){
+	PotentialTable Table(model,Mp/Me,1.0,axes);
+	std::vector<unsigned char> Regimes(Table.size());
+	std::vector<double> Potentials(Table.size());
+	double x[3];
+	for( size_t n = 0; n < Table.size(); n ++ ){
+		Table.node(n,x);
+		Potentials[n] = PotentialTableSolve(model,x,Regimes[n]);
+		Table.set(n,Potentials[n]);
+	}
+	for( size_t c = 0; c < Table.cells(); c ++ ){
+		size_t Lower[3], Index(c);
+		for( size_t d = axes.size(); d-- > 0; ){
+			Lower[d] = Index%(axes[d].size()-1);
+			Index /= axes[d].size()-1;
+		}
+		bool Valid(true);
+		unsigned char Regime(0);
+		for( size_t k = 0; k < (1u<<axes.size()) && Valid; k ++ ){
+			size_t Node(0);
+			for( size_t d = 0; d < axes.size(); d ++ )
+				Node = Node*axes[d].size() + Lower[d] + ((k>>d)&1);
+			if( k == 0 ) Regime = Regimes[Node];
+			Valid = Regimes[Node] == Regime && Regime != 2
+				&& !std::isnan(Potentials[Node]);
+		}
+		Table.set_valid(c,Valid);
+	}
+	for( size_t c = 0; c < Table.cells(); c ++ ){
+		double Interpolated(0.0);
+		unsigned char Regime(0);
+		Table.centre(c,x);
+		if( Table.lookup(x,Interpolated)
+			&& !(fabs(Interpolated-PotentialTableSolve(model,x,Regime))
+			<= PotentialTables::Tolerance) )
+			Table.set_valid(c,false);
+	}
+	return Table;
+}
+
+static std::vector<double> PotentialTableAxis(double min, double max,
+size_t n, bool logarithmic){
+	std::vector<double> Axis(n);
+	for( size_t i = 0; i < n; i ++ )
+		Axis[i] = logarithmic ? min*pow(max/min,(double)i/(n-1))
+			: min+(max-min)*i/(n-1);
+	return Axis;
+}
+
+// Compare lookup() with the solution at random points in the table's range
+static bool PotentialTableCompare(std::string name, char model,
+const PotentialTable &table, const std::vector<std::vector<double>> &axes,
+std::mt19937 &generator){
+	unsigned int Answered(0), Points(2000);
+	double MaxError(0.0);
+	for( unsigned int n = 0; n < Points; n ++ ){
+		double x[3], Interpolated(0.0);
+		for( size_t d = 0; d < axes.size(); d ++ ){
+			std::uniform_real_distribution<double> Coordinate(axes[d].front(),
+				axes[d].back());
+			x[d] = Coordinate(generator);
+		}
+		if( !table.lookup(x,Interpolated) ) continue;
+		unsigned char Regime(0);
+		double Solution = PotentialTableSolve(model,x,Regime);
+		double Error = fabs(Interpolated-Solution);
+		MaxError = std::isnan(Error) ? HUGE_VAL : std::max(MaxError,Error);
+		Answered ++;
+	}
+	// Away from their centres, cells may interpolate somewhat worse than the
+	// tolerance they are checked to, but a table must answer for most of its
+	// range
+	bool Pass = MaxError <= 2.0*PotentialTables::Tolerance
+		&& Answered >= Points/2;
+	std::cout << "\n" << name << ": " << Answered << " of " << Points
+		<< " points tabulated, largest error " << MaxError << ": "
+		<< (Pass ? "PASS" : "FAIL");
+	return Pass;
+}
+
+int PotentialTableTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+	std::mt19937 Generator(2718);
+
+	// Against (Tau, DeltaTot), gathering towards DeltaTot = 1
+	std::vector<std::vector<double>> WEMAxes;
+	WEMAxes.push_back(PotentialTableAxis(0.1,10.0,21,true));
+	std::vector<double> DeltaTot = PotentialTableAxis(0.01,1.0,21,true);
+	for( double &Yield : DeltaTot ) Yield = 1.0-Yield;
+	std::reverse(DeltaTot.begin(),DeltaTot.end());
+	WEMAxes.push_back(DeltaTot);
+	PotentialTable WEM = PotentialTableBuild(PotentialTables::MOMLWEM,WEMAxes);
+	Pass = PotentialTableCompare("MOMLWEM",PotentialTables::MOMLWEM,WEM,
+		WEMAxes,Generator) && Pass;
+
+	// Against (Tau, Chi, Delta)
+	std::vector<std::vector<double>> EMAxes;
+	EMAxes.push_back(PotentialTableAxis(0.1,10.0,21,true));
+	EMAxes.push_back(PotentialTableAxis(0.0,5.0,51,false));
+	EMAxes.push_back(PotentialTableAxis(0.01,1.0,21,true));
+	PotentialTable EM = PotentialTableBuild(PotentialTables::MOMLEM,EMAxes);
+	Pass = PotentialTableCompare("MOMLEM",PotentialTables::MOMLEM,EM,EMAxes,
+		Generator) && Pass;
+
+	// Outside the range of the table the solver is left to answer
+	double Outside[3] = { 20.0, 1.0, 0.5 }, Value(0.0);
+	bool Refused = !EM.lookup(Outside,Value);
+	std::cout << "\nOutside the table: " << (Refused ? "PASS" : "FAIL");
+	Pass = Pass && Refused;
+
+	// Written and read back, the table interpolates bitwise the same
+	const std::string FileName = "PotentialTableTest.tab";
+	PotentialTable Read;
+	bool Same = EM.write(FileName) == 0 && Read.read(FileName) == 0
+		&& Read.matches(PotentialTables::MOMLEM,Mp/Me,1.0)
+		&& Read.size() == EM.size() && Read.cells() == EM.cells();
+	for( size_t c = 0; c < EM.cells() && Same; c ++ ){
+		double x[3], Original(0.0), Copy(0.0);
+		EM.centre(c,x);
+		bool Answered = EM.lookup(x,Original);
+		Same = Read.lookup(x,Copy) == Answered && Copy == Original;
+	}
+	std::remove(FileName.c_str());
+	std::cout << "\nWrite and read: " << (Same ? "PASS" : "FAIL");
+	Pass = Pass && Same;
+
+	// Each thread finds the shared table of the plasma through local()
+	const PotentialTable &Local = PotentialTable::local(
+		PotentialTables::MOMLWEM,Mp/Me,1.0);
+	bool Shared = &Local == PotentialTable::shared(PotentialTables::MOMLWEM,
+		Mp/Me,1.0).get() && Local.matches(PotentialTables::MOMLWEM,Mp/Me,1.0)
+		&& &PotentialTable::local(PotentialTables::MOMLWEM,Mp/Me,1.0) == &Local;
+	std::cout << "\nLocal table is the shared table: "
+		<< (Shared ? "PASS" : "FAIL");
+	Pass = Pass && Shared;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nPotentialTable "
+		<< (Pass ? "PASSED" : "FAILED") << " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
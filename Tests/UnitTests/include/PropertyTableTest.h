@@ -0,0 +1,162 @@
+#include "PropertyTable.h"
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <limits>
+
+// This test tabulates models of the form used by the elements, a heat
+// capacity changing form at a phase change and a vapour pressure tabulated
+// on the Arrhenius scale, and checks that the tables agree with the models to
+// within Tabulation::Tolerance everywhere inside their pieces. Temperatures
+// exactly on a bound, outside the bounds or in a piece where the model cannot
+// be tabulated must not be tabulated, so that the caller uses the model.
+
+// Shomate heat capacity (J/(mol K)), with a change of form at 1000K
+static double PropertyTableHeatCapacity(double T){
+	double t = T/1000.0;
+	if( T < 1000.0 )
+		return 24.0+7.9*t-2.5*t*t+1.1*t*t*t-0.05/(t*t);
+	return 28.0+2.0*t+1.3*t*t-0.4*t*t*t+0.6/(t*t);
+}
+
+// Vapour pressure (Pa), with a change of form at 3000K
+static double PropertyTableVapourPressure(double T){
+	if( T < 3000.0 )
+		return pow(10.0,11.4-45000.0/T+0.35*log10(T));
+	return pow(10.0,10.9-43500.0/T+0.42*log10(T));
+}
+
+// Model which is negative between 500K and 600K, where it cannot be tabulated
+// on the Arrhenius scale
+static double PropertyTableSignChange(double T){
+	return T > 500.0 && T < 600.0 ? -1.0 : exp(-2000.0/T);
+}
+
+// The value an element takes, from the table where it is tabulated
+static double PropertyTableValue(const PropertyTable &table,
+double (*model)(double), double T){
+	double Value(0.0);
+	if( !table.lookup(T,Value) ) Value = model(T);
+	return Value;
+}
+
+// Largest relative error between table and model at random temperatures
+// strictly inside each piece of bounds
+static double PropertyTableError(const PropertyTable &table,
+double (*model)(double), const std::vector<double> &bounds,
+std::mt19937 &generator){
+	double MaxError(0.0);
+	for( size_t b = 0; b+1 < bounds.size(); b ++ ){
+		std::uniform_real_distribution<double> T(bounds[b],bounds[b+1]);
+		for( unsigned int n = 0; n < 100000; n ++ ){
+			double Temperature = T(generator), Value(0.0);
+			if( !table.lookup(Temperature,Value) ) return HUGE_VAL;
+			double Model = model(Temperature);
+			MaxError = std::max(MaxError,fabs(Value-Model)/fabs(Model));
+		}
+	}
+	return MaxError;
+}
+
+static bool PropertyTableCheck(std::string name, bool pass){
+	std::cout << "\n" << name << ": " << (pass ? "PASS" : "FAIL");
+	return pass;
+}
+
+int PropertyTableTest(){
+	clock_t begin = clock();
+	bool Pass = true;
+	std::mt19937 Generator(314);
+	const double Inf = std::numeric_limits<double>::infinity();
+
+	const std::vector<double> HeatBounds = { 300.0, 1000.0, 3000.0 };
+	const std::vector<double> VapourBounds = { 1500.0, 3000.0, 6000.0 };
+	PropertyTable Heat(PropertyTableHeatCapacity,HeatBounds,
+		Tabulation::Linear);
+	PropertyTable Vapour(PropertyTableVapourPressure,VapourBounds,
+		Tabulation::Arrhenius);
+
+	// Error bound, as estimated on construction and at random temperatures
+	double HeatError = PropertyTableError(Heat,PropertyTableHeatCapacity,
+		HeatBounds,Generator);
+	double VapourError = PropertyTableError(Vapour,
+		PropertyTableVapourPressure,VapourBounds,Generator);
+	std::cout << "\nHeat capacity error " << HeatError << ", estimated "
+		<< Heat.max_error() << "\nVapour pressure error " << VapourError
+		<< ", estimated " << Vapour.max_error();
+	Pass = PropertyTableCheck("Heat capacity tabulated",
+		Heat.pieces() == 2) && Pass;
+	Pass = PropertyTableCheck("Vapour pressure tabulated",
+		Vapour.pieces() == 2) && Pass;
+	Pass = PropertyTableCheck("Heat capacity within tolerance",
+		Heat.max_error() <= Tabulation::Tolerance
+		&& HeatError <= Tabulation::Tolerance) && Pass;
+	Pass = PropertyTableCheck("Vapour pressure within tolerance",
+		Vapour.max_error() <= Tabulation::Tolerance
+		&& VapourError <= Tabulation::Tolerance) && Pass;
+
+	// Exactly on a bound the model is used, either side of it the table of
+	// that side matches the form of the model on that side
+	bool OnBounds(true), BesideBounds(true);
+	for( double T : HeatBounds ){
+		double Value(0.0);
+		OnBounds = OnBounds && !Heat.lookup(T,Value)
+			&& PropertyTableValue(Heat,PropertyTableHeatCapacity,T)
+			== PropertyTableHeatCapacity(T);
+	}
+	for( double T : VapourBounds ){
+		double Value(0.0);
+		OnBounds = OnBounds && !Vapour.lookup(T,Value)
+			&& PropertyTableValue(Vapour,PropertyTableVapourPressure,T)
+			== PropertyTableVapourPressure(T);
+	}
+	for( double Direction : { -Inf, Inf } ){
+		double T = nextafter(1000.0,Direction), Value(0.0);
+		BesideBounds = BesideBounds && Heat.lookup(T,Value)
+			&& fabs(Value/PropertyTableHeatCapacity(T)-1.0)
+			<= Tabulation::Tolerance;
+		T = nextafter(3000.0,Direction);
+		BesideBounds = BesideBounds && Vapour.lookup(T,Value)
+			&& fabs(Value/PropertyTableVapourPressure(T)-1.0)
+			<= Tabulation::Tolerance;
+	}
+	Pass = PropertyTableCheck("Model used on bounds",OnBounds) && Pass;
+	Pass = PropertyTableCheck("Table matches beside a change of model",
+		BesideBounds) && Pass;
+
+	// Outside the bounds the model is used
+	bool Outside(true);
+	for( double T : { 100.0, 299.9, 3000.1, 1e4 } ){
+		double Value(0.0);
+		Outside = Outside && !Heat.lookup(T,Value)
+			&& PropertyTableValue(Heat,PropertyTableHeatCapacity,T)
+			== PropertyTableHeatCapacity(T);
+	}
+	for( double T : { 1000.0, 1499.9, 6000.1, 2e4 } ){
+		double Value(0.0);
+		Outside = Outside && !Vapour.lookup(T,Value)
+			&& PropertyTableValue(Vapour,PropertyTableVapourPressure,T)
+			== PropertyTableVapourPressure(T);
+	}
+	Pass = PropertyTableCheck("Model used outside bounds",Outside) && Pass;
+
+	// A piece on which the model cannot be tabulated is left to the model,
+	// the others are still tabulated
+	PropertyTable SignChange(PropertyTableSignChange,
+		{ 300.0, 450.0, 650.0, 900.0 },Tabulation::Arrhenius);
+	double Value(0.0);
+	bool Untabulated = SignChange.pieces() == 2
+		&& PropertyTableValue(SignChange,PropertyTableSignChange,520.0) == -1.0;
+	for( double T : { 400.0, 700.0 } )
+		Untabulated = Untabulated && SignChange.lookup(T,Value)
+			&& fabs(Value/PropertyTableSignChange(T)-1.0)
+			<= Tabulation::Tolerance;
+	Pass = PropertyTableCheck("Model used where it cannot be tabulated",
+		Untabulated) && Pass;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nPropertyTable "
+		<< (Pass ? "PASSED" : "FAILED") << " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
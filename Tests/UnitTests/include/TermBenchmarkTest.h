@@ -0,0 +1,70 @@
+#include "CurrentTerms.h"
+#include "Tungsten.h"
+#include <iostream>
+#include <memory>
+
+// This benchmark evaluates the OMLe, OMLi, SEEcharge and TEEcharge current
+// terms on tungsten through CurrentTerm pointers, as the charging model does,
+// and reports the time per evaluation. The plasma data is passed by const
+// reference, as the terms now take it, and by std::shared_ptr copied by value
+// twice per evaluation, as the term and the flux function it called each
+// copied it before the terms took a reference. Both must give the same sum.
+
+// Pass the plasma data by value to the term, as the flux functions did
+static double TermBenchmarkByValueFlux(CurrentTerm *term, const Matter *sample,
+std::shared_ptr<PlasmaData> pdata, double potential){
+	return term->Evaluate(sample,*pdata,potential);
+}
+
+// Pass the plasma data by value, as Evaluate() did
+static double TermBenchmarkByValue(CurrentTerm *term, const Matter *sample,
+std::shared_ptr<PlasmaData> pdata, double potential){
+	return TermBenchmarkByValueFlux(term,sample,pdata,potential);
+}
+
+int TermBenchmarkTest(){
+	clock_t begin = clock();
+	const unsigned int Loops = 1000000;
+	Matter *Sample = new Tungsten(1e-6,1000);
+	std::shared_ptr<PlasmaData> Pdata =
+		std::make_shared<PlasmaData>(PlasmaDataDefaults);
+	derive_plasmadata(*Pdata);
+	std::vector<CurrentTerm*> CurrentTerms = { new Term::OMLe(),
+		new Term::OMLi(), new Term::SEEcharge(), new Term::TEEcharge() };
+	const unsigned long Evaluations = Loops*CurrentTerms.size();
+
+	// The potential is varied so that no evaluation can be hoisted
+	double ByReference(0.0);
+	clock_t Start = clock();
+	for( unsigned int n = 0; n < Loops; n ++ ){
+		double Potential = 1.0+1e-6*(n%1000);
+		for( CurrentTerm *Term : CurrentTerms )
+			ByReference += Term->Evaluate(Sample,*Pdata,Potential);
+	}
+	double ReferenceTime = double(clock()-Start)/CLOCKS_PER_SEC;
+
+	double ByValue(0.0);
+	Start = clock();
+	for( unsigned int n = 0; n < Loops; n ++ ){
+		double Potential = 1.0+1e-6*(n%1000);
+		for( CurrentTerm *Term : CurrentTerms )
+			ByValue += TermBenchmarkByValue(Term,Sample,Pdata,Potential);
+	}
+	double ValueTime = double(clock()-Start)/CLOCKS_PER_SEC;
+
+	std::cout << "\nconst PlasmaData& : " << 1e9*ReferenceTime/Evaluations
+		<< " ns per Evaluate"
+		<< "\nshared_ptr by value: " << 1e9*ValueTime/Evaluations
+		<< " ns per Evaluate";
+	bool Same = ByReference == ByValue;
+	std::cout << "\nSame evaluations: " << (Same ? "PASS" : "FAIL");
+
+	for( CurrentTerm *Term : CurrentTerms ) delete Term;
+	delete Sample;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nTermBenchmark " << (Same ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Same ? 0 : 1;
+}
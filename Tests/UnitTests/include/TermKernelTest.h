@@ -0,0 +1,169 @@
+#include "ForceModel.h"
+#include "HeatTerms.h"
+#include "CurrentTerms.h"
+#include "Tungsten.h"
+#include <iostream>
+#include <cstdio>
+#include <sys/stat.h>
+
+// This test evaluates every registered list of heat, force and current terms
+// through the kernel found for it and term by term through the virtual
+// Evaluate(), at several arguments and skipping each term in turn, and checks
+// every value is bitwise the same. Lists which are reordered, incomplete or
+// hold a type derived from a registered term must find no kernel, and a force
+// model holding such a list must move the dust bitwise as the model with the
+// registered list does.
+
+// Gravity by another type, so that its list is not registered
+struct TermKernelTestGravity:Term::Gravity{};
+
+static bool TermKernelTestEqual(double a, double b){
+	return a == b || (a != a && b != b);
+}
+
+static bool TermKernelTestEqual(const threevector &a, const threevector &b){
+	return TermKernelTestEqual(a.getx(),b.getx())
+		&& TermKernelTestEqual(a.gety(),b.gety())
+		&& TermKernelTestEqual(a.getz(),b.getz());
+}
+
+// Compare the kernel of \p terms with the virtual path, deleting the terms
+template<class Base, typename Arg, typename Result>
+static bool TermKernelTestList(const std::vector<Base*> &terms,
+const TermKernel<Base,Arg,Result> *kernel, const Matter *Sample,
+const PlasmaData &Pdata, const std::vector<Arg> &args){
+	bool Same = kernel != NULL;
+	std::vector<Result> Results(terms.size());
+	for( const Arg &arg : args ){
+		for( int skip = -1; Same && skip < (int)terms.size(); skip ++ ){
+			kernel->Evaluate(terms,Sample,Pdata,arg,skip,Results.data());
+			for( size_t n = 0; n < terms.size(); n ++ ){
+				Result Expected = (int)n == skip ? Result()
+					: terms[n]->Evaluate(Sample,Pdata,arg);
+				Same = Same && TermKernelTestEqual(Results[n],Expected);
+			}
+		}
+	}
+	std::cout << "\n";
+	for( size_t n = 0; n < terms.size(); n ++ )
+		std::cout << (n > 0 ? "," : "") << terms[n]->PrintName();
+	std::cout << ": " << (Same ? "PASS" : "FAIL");
+	for( Base *Term : terms ) delete Term;
+	return Same;
+}
+
+// Step the dust with \p forceterms and return its final velocity
+static threevector TermKernelTestMotion(std::vector<ForceTerm*> &forceterms,
+const PlasmaData &pdata){
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	Matter *Sample = new Tungsten(1e-6,1500,ConstModels,
+		threevector(1.0,0.0,0.0),threevector(10.0,-5.0,3.0));
+	Sample->set_potential(2.0);
+	PlasmaData Pdata = pdata;
+	threevector Velocity;
+	{
+		ForceModel FM("Data/TermKernelTest_fm.txt",1.0,forceterms,Sample,
+			Pdata);
+		FM.set_integrator(Integrator::RungeKutta4);
+		for( unsigned int n = 0; n < 20; n ++ ) FM.Force(FM.UpdateTimeStep());
+		Velocity = Sample->get_velocity();
+	}
+	std::remove("Data/TermKernelTest_fm.txt");
+	delete Sample;
+	return Velocity;
+}
+
+int TermKernelTest(){
+	clock_t begin = clock();
+	mkdir("Data",0755);
+	bool Pass = true;
+	std::array<char,CM> ConstModels = {'c','c','c','y','n'};
+	Matter *Sample = new Tungsten(1e-6,1500,ConstModels,
+		threevector(1.0,0.0,0.0),threevector(10.0,-5.0,3.0));
+	Sample->set_potential(2.0);
+	PlasmaData Pdata = PlasmaDataDefaults;
+	Pdata.PlasmaVel = threevector(1e3,2e3,-5e2);
+	Pdata.Gravity = threevector(0.0,0.0,-9.81);
+	Pdata.ElectricField = threevector(10.0,0.0,-5.0);
+	Pdata.MagneticField = threevector(0.1,2.0,0.3);
+	derive_plasmadata(Pdata);
+
+	using namespace Term;
+	const std::vector<double> Temperatures = { 300.0, 1500.0, 3000.0 };
+	const std::vector<std::vector<HeatTerm*>> HeatLists = {
+		{ new EmissivityModel(), new EvaporationModel(),
+		new NeutralHeatFlux(), new OMLElectronHeatFlux(),
+		new DTOKSIonHeatFlux(), new DTOKSNeutralRecombination(),
+		new DTOKSSEE(), new DTOKSTEE() },
+		{ new EmissivityModel(), new EvaporationModel(),
+		new NeutralHeatFlux(), new DTOKSElectronHeatFlux(),
+		new DTOKSIonHeatFlux(), new DTOKSNeutralRecombination(),
+		new DTOKSSEE(), new DTOKSTEE() },
+		{ new EmissivityModel(), new EvaporationModel(),
+		new NeutralHeatFlux(), new OMLElectronHeatFlux(),
+		new SMOMLIonHeatFlux(), new SMOMLNeutralRecombination(), new SEE(),
+		new TEE() } };
+	for( const std::vector<HeatTerm*> &Terms : HeatLists )
+		Pass = TermKernelTestList(Terms,find_heatkernel(Terms),Sample,Pdata,
+			Temperatures) && Pass;
+
+	const std::vector<threevector> Velocities = { threevector(0.0,0.0,0.0),
+		threevector(10.0,-5.0,3.0), threevector(-2e3,1e3,4e2) };
+	const std::vector<std::vector<ForceTerm*>> ForceLists = {
+		{ new Gravity(), new LorentzForce(), new HybridIonDrag(),
+		new LloydIonDrag(), new NeutralDrag() },
+		{ new Gravity(), new LorentzForce(), new DTOKSIonDrag(),
+		new NeutralDrag() },
+		{ new Gravity(), new LorentzForce(), new SMOMLIonDrag(),
+		new NeutralDrag() } };
+	for( const std::vector<ForceTerm*> &Terms : ForceLists )
+		Pass = TermKernelTestList(Terms,find_forcekernel(Terms),Sample,Pdata,
+			Velocities) && Pass;
+
+	const std::vector<double> Potentials = { -1.0, 0.5, 2.0, 3.5 };
+	const std::vector<std::vector<CurrentTerm*>> CurrentLists = {
+		{ new OMLe(), new OMLi() }, { new OMLe(), new MOMLi() },
+		{ new OMLe(), new SMOMLi() },
+		{ new OMLe(), new OMLi(), new TEEcharge(), new SEEcharge() },
+		{ new DTOKSe(), new DTOKSi(), new TEEcharge(), new SEEcharge() },
+		{ new MOMLWEM() }, { new MOMLEM() } };
+	for( const std::vector<CurrentTerm*> &Terms : CurrentLists )
+		Pass = TermKernelTestList(Terms,find_currentkernel(Terms),Sample,
+			Pdata,Potentials) && Pass;
+
+	// Lists which are not registered are evaluated term by term
+	std::vector<CurrentTerm*> Reordered = { new OMLi(), new OMLe() };
+	std::vector<HeatTerm*> Incomplete = { new EmissivityModel(),
+		new EvaporationModel(), new NeutralHeatFlux() };
+	std::vector<ForceTerm*> Registered = { new Gravity(), new LorentzForce(),
+		new DTOKSIonDrag(), new NeutralDrag() };
+	std::vector<ForceTerm*> Derived = { new TermKernelTestGravity(),
+		new LorentzForce(), new DTOKSIonDrag(), new NeutralDrag() };
+	bool NoKernel = find_currentkernel(Reordered) == NULL
+		&& find_heatkernel(Incomplete) == NULL
+		&& find_forcekernel(Derived) == NULL
+		&& find_forcekernel(Registered) != NULL;
+	std::cout << "\nReordered, incomplete and derived lists find no kernel: "
+		<< (NoKernel ? "PASS" : "FAIL");
+	Pass = Pass && NoKernel;
+
+	threevector Fast = TermKernelTestMotion(Registered,Pdata);
+	threevector Fallback = TermKernelTestMotion(Derived,Pdata);
+	bool SameMotion = TermKernelTestEqual(Fast,Fallback)
+		&& !TermKernelTestEqual(Fast,threevector(10.0,-5.0,3.0));
+	std::cout << "\nForce model without a kernel moves the dust the same: "
+		<< (SameMotion ? "PASS" : "FAIL");
+	Pass = Pass && SameMotion;
+
+	for( CurrentTerm *Term : Reordered ) delete Term;
+	for( HeatTerm *Term : Incomplete ) delete Term;
+	for( ForceTerm *Term : Registered ) delete Term;
+	for( ForceTerm *Term : Derived ) delete Term;
+	delete Sample;
+
+	clock_t end = clock();
+	double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;
+	std::cout << "\n\n*****\n\nTermKernel " << (Pass ? "PASSED" : "FAILED")
+		<< " in " << elapsd_secs << "s\n";
+	return Pass ? 0 : 1;
+}
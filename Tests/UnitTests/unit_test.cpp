@@ -4,16 +4,27 @@
 
 // FUNCTIONS TESTS
 #include "BackscatterTest.h"
+#include "BackscatterTableTest.h"
 #include "DeltaSecTest.h"
 #include "DeltaThermTest.h"
+#include "EmissivityTableTest.h"
 #include "MaxwellianTest.h"
+#include "PlasmaGridReadTest.h"
+#include "PlasmaGridCacheTest.h"
+#include "PlasmaGridFieldsTest.h"
+#include "GridInterpolationTest.h"
+#include "PropertyTableTest.h"
+#include "DataSinkTest.h"
+#include "MatterUpdateTest.h"
 
 // HEATING TESTS
 #include "EvaporativeCoolingTest.h"
 #include "EvaporativeMassLossTest.h"
 #include "NeutralHeatingTest.h"
+#include "HeatPowerTest.h"
 
 // CHARGING TESTS
+#include "BrentTest.h"
 #include "ChargingTimescales.h"
 #include "DTOKSchargingTest.h"
 #include "DTOKSwellchargingTest.h"
@@ -22,6 +33,8 @@
 #include "MOMLTest.h"
 #include "MOMLWEMTest.h"
 #include "MOMLEMTest.h"
+#include "PotentialTableTest.h"
+#include "TermBenchmarkTest.h"
 #include "SOMLTest.h"
 #include "SMOMLTest.h"
 #include "PHLTest.h"
@@ -32,6 +45,12 @@
 #include "HybridIonDrag.h"
 #include "FortovIonDrag.h"
 #include "NeutralDrag.h"
+#include "DormandPrinceTest.h"
+
+// SIMULATION TESTS
+#include "EnsembleTest.h"
+#include "CheckpointTest.h"
+#include "TermKernelTest.h"
 
 static void show_usage(std::string name){
     std::cerr << "Usage: int main(int argc, char* argv[]) <option(s)> SOURCES"
@@ -43,15 +62,36 @@ static void show_usage(std::string name){
     << "e Options:\n"
     << "\t\tBackscatter    : fraction of backscattered energy and back scattere"
     << "d particles\n"
+    << "\t\tBackscatterTable: interpolated backscattering against the int"
+    << "egrated values\n"
     << "\t\tDeltaSec       : empirical function calculating the yield due to se"
     << "condary electron emission\n"
     << "\t\tDeltaTherm     : value of the 'effective yield' from the Richardson"
     << "-Dushmann formula\n"
+    << "\t\tEmissivityTable: interpolation of tabulated emissivity files\n"
     << "\t\tMaxwellian     : value of the Maxwellian function for different val"
     << "ues of temperature and energy\n"
+    << "\t\tPlasmaGridRead : compare the threaded and reference readers of t"
+    << "he b2processed files\n"
+    << "\t\tPlasmaGridCache: map a cached plasma grid and compare it with t"
+    << "he grid written\n"
+    << "\t\tPlasmaGridFields: read back derived fields and rebuild an out o"
+    << "f date file\n"
+    << "\t\tGridInterpolation: bilinear and bicubic interpolation of linear"
+    << " plasma fields\n"
+    << "\t\tBrent          : root finding of the current balance against "
+    << "known roots\n"
+    << "\t\tPropertyTable  : tabulated element properties against their mo"
+    << "dels\n"
+    << "\t\tDataSink       : convert a binary data file to text and compare"
+    << " it with the text file\n"
+    << "\t\tMatterUpdate   : properties refreshed by update() with and witho"
+    << "ut a tolerance\n"
     << "\t\tEvapCooling    : heat loss due to evaporation\n"
     << "\t\tEvapMassLoss   : mass loss due to evaporation\n"
     << "\t\tNeutralHeating : heat gained from neutral collisions\n"
+    << "\t\tHeatPower      : printed heat term powers against fresh evaluat"
+    << "ions\n"
     << "\t\tDTOKScharging  : output the potential as calculated by the DTOK"
     << "S solution to the OML equation\n"
     << "\t\tDTOKSWell      : potential as calculated by the DTOKS solution "
@@ -64,6 +104,10 @@ static void show_usage(std::string name){
     << "ins in a stationary plasma \n"
     << "\t\tMOMLEM         : same as previous but as calculated by MOML-EM,"
     << "\n\t\t\tsee N. Rizopoulou and M. Bacharis, Phys. Plasmas 25, (2018)\n"
+    << "\t\tPotentialTable : tabulated MOMLEM and MOMLWEM potentials against t"
+    << "he solvers\n"
+    << "\t\tTermBenchmark  : time to evaluate current terms with the plasma"
+    << " by reference and by shared_ptr\n"
     << "\t\tSOML           : floating potential for small dust grains in a "
     << "flowing plasma following SOML theory.\n"
     << "\t\tSMOML          : floating potential for large dust grains in a "
@@ -80,7 +124,15 @@ static void show_usage(std::string name){
     << "s://doi.org/10.1063/1.1867995\n"
     << "\t\tFortovIonDrag  : magnitude of the ion drag force, see https://d"
     << "oi.org/10.1016/j.physrep.2005.08.007\n"
-    << "\t\tNeutralDrag    : magnitude of the neutral drag force\n\n";
+    << "\t\tNeutralDrag    : magnitude of the neutral drag force\n"
+    << "\t\tDormandPrince  : gyration in a uniform field against the exact "
+    << "orbit, compared with RK4\n"
+    << "\t\tEnsemble       : compare an ensemble run on several threads with"
+    << " a serial run\n"
+    << "\t\tCheckpoint     : restart a killed run from its checkpoint and com"
+    << "pare its files\n"
+    << "\t\tTermKernel     : registered term lists evaluated by kernel and vi"
+    << "rtual call\n\n";
 
 }
 
@@ -130,6 +182,13 @@ int main(int argc, char* argv[]){
     if( Test_Mode == "Backscatter" )
         BackscatterTest();
 
+    // Backscatter Table Unit Test:
+    // This test checks the fractions of backscattered energy and particles
+    // interpolated from the shared table against those integrated by the
+    // backscatter function, and that threads filling a table agree
+    else if( Test_Mode == "BackscatterTable" )
+        return BackscatterTableTest();
+
     // Delta Sec Unit Test:
     // This test prints the value of the empirical function calculating the 
     // yield due to secondary electron emission.
@@ -152,6 +211,12 @@ int main(int argc, char* argv[]){
     else if( Test_Mode == "DeltaTherm" )
     DeltaThermTest();
 
+    // Emissivity Table Unit Test:
+    // This test checks the emissivity interpolated from a set of tabulated
+    // emissivity files against the function used to write them
+    else if( Test_Mode == "EmissivityTable" )
+        return EmissivityTableTest();
+
     // Maxwellian Unit Test:
     // This test prints the value of the Maxwellian function for different 
     // values of temperature and energy.
@@ -160,6 +225,48 @@ int main(int argc, char* argv[]){
     else if( Test_Mode == "Maxwellian" )
         MaxwellianTest();
 
+    // Plasma Grid Read Unit Test:
+    // This test checks the threaded reader of the b2processed plasma files
+    // gives bitwise the same grid as the reference reader using file streams
+    else if( Test_Mode == "PlasmaGridRead" )
+        return PlasmaGridReadTest();
+
+    // Plasma Grid Cache Unit Test:
+    // This test checks a plasma grid mapped from its cache is bitwise the same as the grid
+    // written, read-only, and that a touched source or corrupted cache is refused
+    else if( Test_Mode == "PlasmaGridCache" )
+        return PlasmaGridCacheTest();
+
+    // Plasma Grid Fields Unit Test:
+    // This test checks derived fields read from their file are bitwise those written, and that a file
+    // for another plasma, another grid or cut short is refused and written again from fresh fields
+    else if( Test_Mode == "PlasmaGridFields" )
+        return PlasmaGridFieldsTest();
+
+    // Grid Interpolation Unit Test:
+    // This test checks bilinear and bicubic interpolation reproduce plasma fields linear in x and z
+    // exactly on a grid with dlx != dlz, and that points outside the grid are refused
+    else if( Test_Mode == "GridInterpolation" )
+        return GridInterpolationTest();
+
+    // Property Table Unit Test:
+    // This test checks tabulated heat capacity and vapour pressure models
+    // against the models, and that the models are used where not tabulated
+    else if( Test_Mode == "PropertyTable" )
+        return PropertyTableTest();
+
+    // Data Sink Unit Test:
+    // This test checks a binary data file converted to text is identical to the text file written
+    // with the same rows, and that files with a short or corrupt header or a partial row are refused
+    else if( Test_Mode == "DataSink" )
+        return DataSinkTest();
+
+    // Matter Update Unit Test:
+    // This test checks update() leaves every property as a full refresh would with no tolerance, and
+    // that with a tolerance small changes of temperature are skipped and larger ones are not
+    else if( Test_Mode == "MatterUpdate" )
+        return MatterUpdateTest();
+
     // *****    HEATING TESTS       ***** //
     else if( Test_Mode == "EvapCooling" )
         EvaporativeCoolingTest();
@@ -168,8 +275,21 @@ int main(int argc, char* argv[]){
     else if( Test_Mode == "NeutralHeating" )
         NeutralHeatingTest();
 
+    // Heat Power Unit Test:
+    // This test checks the heat term powers printed after the sample or plasma changes are those of
+    // the terms evaluated afresh, and not powers recorded before the change
+    else if( Test_Mode == "HeatPower" )
+        return HeatPowerTest();
+
 
     // *****    CHARGING TESTS      ***** //
+    // Brent Charging Test:
+    // This test checks the root of the current balance found by the charging
+    // model against current terms with known roots, including the case in
+    // which no root can be bracketed
+    else if( Test_Mode == "Brent" )
+        return BrentTest();
+
     // Charging Timescale Test:
     // This test is used to verify that the timestep as calculated by 
     // Krasheninnikovs is always smaller
@@ -236,8 +356,22 @@ int main(int argc, char* argv[]){
     // following MOML-EM theory, see: N. Rizopoulou and M. Bacharis, Phys. Plasmas 25, (2018). &
     // N. Rizopoulou and M. Bacharis, Phys. Plasmas 25, (2018).
     // This employs a Newton Rhapson method to solve the equations of the two papers finding a kinetic potential well
+    // The potentials found are checked against equation (24) and the residuals of the well equations
     else if( Test_Mode == "MOMLEM" )
-        MOMLEMTest();
+        return MOMLEMTest();
+
+    // Potential Table Test:
+    // This test tabulates the MOMLEM and MOMLWEM potentials on coarse grids and checks that
+    // the interpolated potentials agree with the solvers wherever the tables answer
+    else if( Test_Mode == "PotentialTable" )
+        return PotentialTableTest();
+
+    // Term Benchmark:
+    // This benchmark times the evaluation of current terms through CurrentTerm pointers with the plasma
+    // data passed by const reference and by std::shared_ptr copied by value, as before the terms took a
+    // reference, and checks both give the same evaluations
+    else if( Test_Mode == "TermBenchmark" )
+        return TermBenchmarkTest();
 
 
     // SOML Charging Test:
@@ -314,6 +448,30 @@ int main(int argc, char* argv[]){
     // This neutral drag force is formulated by the OML flux for uncharged species to a sphere
     else if( Test_Mode == "NeutralDrag" )
         IonNeutralDragTest();
+
+    // Dormand-Prince Test
+    // This test integrates the gyration of a grain in a uniform magnetic field with the RK4 and
+    // Dormand-Prince methods, compares the final state with the exact orbit and the evaluations of
+    // the force per metre, and checks the proposed step shortens when the force grows
+    else if( Test_Mode == "DormandPrince" )
+        return DormandPrinceTest();
+
+    // *****    SIMULATION TESTS    ***** //
+    // Ensemble Test:
+    // This test runs a set of grains one after the other and again on several
+    // threads sharing the term objects, checking that the results are the same
+    else if( Test_Mode == "Ensemble" )
+        return EnsembleTest();
+    // Checkpoint Test:
+    // This test kills a run taking checkpoints, restarts it from its last checkpoint and checks
+    // that its data files and deposition are the same as those of a run which was not stopped
+    else if( Test_Mode == "Checkpoint" )
+        return CheckpointTest();
+    // Term Kernel Test:
+    // This test checks every registered list of terms gives bitwise the same values through its kernel
+    // as through the virtual Evaluate(), and that other lists fall back to the virtual Evaluate()
+    else if( Test_Mode == "TermKernel" )
+        return TermKernelTest();
     else
         std::cout << "\n\nInput not recognised! Exiting program.\n";
 
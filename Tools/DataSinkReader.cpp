@@ -0,0 +1,44 @@
+/** @file DataSinkReader.cpp
+ *  @brief Convert binary model data files to tab separated text
+ *
+ *  Usage: dtoksread input.bin [output.txt]
+ *  The text is written to output.txt if given, otherwise to standard output,
+ *  and has the same layout as the files written with OutputFormat = "t".
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#include <iostream>
+#include <fstream>
+
+#include "DataSink.h"
+
+int main(int argc, char* argv[]){
+    if( argc < 2 || argc > 3 ){
+        std::cerr << "Usage: " << argv[0] << " input.bin [output.txt]\n";
+        return 1;
+    }
+
+    std::ofstream OutputFile;
+    if( argc == 3 ){
+        OutputFile.open(argv[2]);
+        if( !OutputFile.is_open() ){
+            std::cerr << "Failed to open " << argv[2] << "\n";
+            return 1;
+        }
+    }
+    std::ostream &Out = (argc == 3) ? OutputFile : std::cout;
+
+    int Status = convert_to_text(argv[1],Out);
+    if( Status == 1 ){
+        std::cerr << "Failed to open " << argv[1] << "\n";
+    }else if( Status == 2 ){
+        std::cerr << argv[1] << " is not a binary DTOKSU data file\n";
+    }else if( Status == 3 ){
+        std::cerr << argv[1] << " ends part way through a row\n";
+    }else if( Status == 4 ){
+        std::cerr << argv[1] << " has a truncated or corrupt header\n";
+    }
+    return Status;
+}
@@ -0,0 +1,190 @@
+/** @file PotentialTableGenerator.cpp
+ *  @brief Generate the potential tables of the MOMLEM and MOMLWEM models
+ *
+ *  Usage: dtokstable MOMLEM|MOMLWEM [massratio] [ionization] [output.tab]
+ *  The mass ratio mi/Me defaults to that of hydrogen, Mp/Me, and the
+ *  ionization to 1, which is the only value used by MOMLEM. The table is
+ *  written to output.tab if given, otherwise to the file the current terms
+ *  read it from, see PotentialTable::filename(). Once the nodes are solved,
+ *  the potential is interpolated at the centre of every cell and compared to
+ *  the solution there. Cells with corners in different regimes, or which fail
+ *  this comparison, are marked invalid and left to the solver.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <algorithm>
+#include <cmath>
+
+#include "PotentialTable.h"
+#include "solveMOMLEM.h"
+#include "Constants.h"
+#include "Functions.h"
+
+//!< \p n values evenly spaced from \p min to \p max
+static std::vector<double> linear_axis(double min, double max, size_t n){
+    std::vector<double> Axis(n);
+    for( size_t i = 0; i < n; i ++ ) Axis[i] = min+(max-min)*i/(n-1);
+    return Axis;
+}
+
+//!< \p n values evenly spaced in logarithm from \p min to \p max
+static std::vector<double> log_axis(double min, double max, size_t n){
+    std::vector<double> Axis(n);
+    for( size_t i = 0; i < n; i ++ )
+        Axis[i] = min*pow(max/min,(double)i/(n-1));
+    return Axis;
+}
+
+/** @brief Solve \p model at the parameters \p x
+ *  @param regime set to 0 without a potential well, 1 with a well and 2 if
+ *  a well forms but could not be solved for
+ *  @return the normalised potential, NaN if it is not finite
+ */
+static double solve(char model, const double *x, double massratio,
+    double ionization, unsigned char &regime){
+    double Potential(0.0);
+    regime = 0;
+    if( model == PotentialTables::MOMLEM ){
+        int Iterations(0);
+        Potential = solveMOMLEM(x[0],massratio,x[1],x[2],Iterations);
+        double Mu = 1.0/massratio;
+        double NoWell = log(sqrt(x[0]*Mu)+x[1]*sqrt(x[2]));
+        if( Iterations > 0 ) regime = Potential != NoWell ? 1 : 2;
+    }else{
+        try{
+            Potential = solveMOMLWEM(x[0],massratio,ionization,x[1]);
+        }catch( LambertWFailure &e ){
+            Potential = NAN;
+        }
+    }
+    return std::isfinite(Potential) ? Potential : NAN;
+}
+
+int main(int argc, char* argv[]){
+    if( argc < 2 || argc > 5 ){
+        std::cerr << "Usage: " << argv[0]
+            << " MOMLEM|MOMLWEM [massratio] [ionization] [output.tab]\n";
+        return 1;
+    }
+    std::string Name = argv[1];
+    char Model(0);
+    std::vector<std::vector<double>> Axes;
+    //!< Axes span the plasmas met in the edge, Tau = Ti/Te, Chi the emitted
+    //!< to sheath density ratio, Delta = Td/Te and DeltaTot the emission yield
+    if( Name == "MOMLEM" ){
+        Model = PotentialTables::MOMLEM;
+        Axes.push_back(log_axis(0.1,10.0,41));
+        Axes.push_back(linear_axis(0.0,5.0,101));
+        Axes.push_back(log_axis(0.01,1.0,41));
+    }else if( Name == "MOMLWEM" ){
+        Model = PotentialTables::MOMLWEM;
+        Axes.push_back(log_axis(0.1,10.0,101));
+        //!< Nodes gather towards DeltaTot = 1, where the potential diverges
+        std::vector<double> DeltaTot = log_axis(0.01,1.0,101);
+        for( double &Yield : DeltaTot ) Yield = 1.0-Yield;
+        std::reverse(DeltaTot.begin(),DeltaTot.end());
+        Axes.push_back(DeltaTot);
+    }else{
+        std::cerr << "Unrecognised model " << Name
+            << ", expected MOMLEM or MOMLWEM\n";
+        return 1;
+    }
+
+    double MassRatio = Mp/Me;
+    double Ionization(1.0);
+    std::stringstream ss;
+    if( argc > 2 ){
+        ss << argv[2];
+        if( !(ss >> MassRatio) || MassRatio <= 0.0 ){
+            std::cerr << "Invalid mass ratio " << argv[2] << "\n";
+            return 1;
+        }
+    }
+    if( argc > 3 ){
+        ss.clear();
+        ss << argv[3];
+        if( !(ss >> Ionization) || Ionization <= 0.0 ){
+            std::cerr << "Invalid ionization " << argv[3] << "\n";
+            return 1;
+        }
+    }
+    if( Model == PotentialTables::MOMLEM ) Ionization = 1.0;
+    std::string FileName = argc > 4 ? argv[4]
+        : PotentialTable::filename(Model,MassRatio,Ionization);
+
+    clock_t Begin = clock();
+    PotentialTable Table(Model,MassRatio,Ionization,Axes);
+    std::vector<unsigned char> Regimes(Table.size());
+    std::vector<double> Potentials(Table.size());
+    size_t Unsolved(0), Wells(0);
+    double x[3];
+    for( size_t n = 0; n < Table.size(); n ++ ){
+        Table.node(n,x);
+        Potentials[n] = solve(Model,x,MassRatio,Ionization,Regimes[n]);
+        Table.set(n,Potentials[n]);
+        if( std::isnan(Potentials[n]) || Regimes[n] == 2 ) Unsolved ++;
+        if( Regimes[n] == 1 ) Wells ++;
+    }
+    std::cout << "\nSolved " << Table.size() << " nodes, " << Unsolved
+        << " unsolved, " << Wells << " with a well";
+
+    //!< Invalidate cells spanning more than one regime or an unsolved node
+    size_t Spanning(0);
+    for( size_t c = 0; c < Table.cells(); c ++ ){
+        size_t Lower[3], Index(c);
+        for( size_t d = Axes.size(); d-- > 0; ){
+            Lower[d] = Index%(Axes[d].size()-1);
+            Index /= Axes[d].size()-1;
+        }
+        bool Valid(true);
+        unsigned char Regime(0);
+        for( size_t k = 0; k < (1u<<Axes.size()) && Valid; k ++ ){
+            size_t Node(0);
+            for( size_t d = 0; d < Axes.size(); d ++ )
+                Node = Node*Axes[d].size() + Lower[d] + ((k>>d)&1);
+            if( k == 0 ) Regime = Regimes[Node];
+            Valid = Regimes[Node] == Regime && Regime != 2 
+                && !std::isnan(Potentials[Node]);
+        }
+        Table.set_valid(c,Valid);
+        if( !Valid ) Spanning ++;
+    }
+
+    //!< Invalidate cells interpolating the solution at their centre poorly
+    size_t Inaccurate(0);
+    double MaxError(0.0);
+    for( size_t c = 0; c < Table.cells(); c ++ ){
+        double Interpolated(0.0);
+        Table.centre(c,x);
+        if( !Table.lookup(x,Interpolated) ) continue;
+        unsigned char Regime(0);
+        double Error = fabs(Interpolated
+            -solve(Model,x,MassRatio,Ionization,Regime));
+        if( !(Error <= PotentialTables::Tolerance) ){
+            Table.set_valid(c,false);
+            Inaccurate ++;
+        }else{
+            MaxError = std::max(MaxError,Error);
+        }
+    }
+    double SolveTime = double(clock()-Begin)/CLOCKS_PER_SEC;
+    std::cout << "\n" << Table.cells()-Spanning-Inaccurate << " of "
+        << Table.cells() << " cells valid, " << Spanning 
+        << " spanning regimes and " << Inaccurate << " inaccurate";
+    std::cout << "\nLargest error of valid cells at their centre " 
+        << MaxError << ", taking " << SolveTime << "s";
+
+    if( Table.write(FileName) != 0 ){
+        std::cerr << "\nFailed to write " << FileName << "\n";
+        return 1;
+    }
+    std::cout << "\nWritten " << FileName << "\n";
+    return 0;
+}
@@ -45,6 +45,7 @@ class Beryllium: public Matter{
         ~Beryllium(){};
 
         double probe_vapourpressure(double Temperature)const;
+        Matter* clone()const override{ return new Beryllium(*this); }
 };
 
 #endif /* __BERYLLIUM_H_INCLUDED__ */
@@ -12,6 +12,8 @@
 
 //#define CHARGING_DEBUG
 
+#include <array>
+
 #include "Model.h"
 #include "solveMOMLEM.h"
 #include "CurrentTerms.h"
@@ -28,10 +30,58 @@ class ChargingModel : public Model{
          */
         std::vector<CurrentTerm*> CurrentTerms; 
 
+        /** @name Term slots
+         *  @brief Current terms needing special treatment, set once by 
+         *  ClassifyTerms() so that the root finding compares no names
+         */
+        ///@{
+        int SEEIndex;               //!< Position of SEEcharge, -1 if unused
+        bool ThermionicEmission;    //!< True if TEEcharge or TEESchottky used
+        ///@}
+
+        /** @name Term kernel
+         *  @brief Statically dispatched kernel of \p CurrentTerms, NULL if 
+         *  none is registered, and the currents it last evaluated
+         */
+        ///@{
+        const Term::CurrentKernel *Kernel;
+        //!< Most current terms a model takes, std::length_error is thrown for
+        //!< more
+        static const unsigned int MaxCurrentTerms = 16;
+        mutable std::array<double,MaxCurrentTerms> TermCurrents;
+        ///@}
+
+        /** @brief Find the terms of \p CurrentTerms needing special treatment
+         *  and their kernel
+         */
+        void ClassifyTerms();
+
         /** @brief Print model data to ModelDataFile
          */
         void Print();
 
+        /** @brief Sum the current terms at normalised potential \p Potential
+         *
+         *  Each term is evaluated once. SEEcharge gives a yield, so is 
+         *  multiplied by the first current term.
+         *  @param Potential the normalised potential of the dust
+         *  @return the net current to the dust
+         */
+        double CurrentBalance(double Potential)const;
+
+        /** @brief Find an interval in which the current balance changes sign
+         *
+         *  Starts from an interval of width 2*Accuracy about the present 
+         *  potential of the dust, growing geometrically towards the root until
+         *  the range searched by Bisection() is covered.
+         *  @param a lower bound returned by the function
+         *  @param b upper bound returned by the function
+         *  @param fa current balance at \p a
+         *  @param fb current balance at \p b
+         *  @return true if a sign change was found
+         */
+        bool Bracket(double &a, double &b, double &fa, double &fb)const;
+
         /** @name Root Finding Algorithms
          *  @brief Functions which identify the root of a function
          *
@@ -53,6 +103,16 @@ class ChargingModel : public Model{
          *  @return the value of x which produces a root of the equation
          */
         double RegulaFalsi()const;
+        /** @brief Find Root of equation via Brent's method
+         *
+         *  Combines inverse quadratic interpolation and the secant method, 
+         *  falling back on bisection, within a bracket seeded from the present 
+         *  potential of the dust, see Bracket(). See wikipedia for description
+         *  https://en.wikipedia.org/wiki/Brent%27s_method
+         *  @return the value of x which produces a root of the equation
+         */
+        double Brent()const;
+        ///@}
 
 
     public:
@@ -63,10 +123,10 @@ class ChargingModel : public Model{
             std::vector<CurrentTerm*> CurrentTerms, Matter *& sample, PlasmaData * pdata);
         ChargingModel(std::string filename, float accuracy, 
             std::vector<CurrentTerm*> CurrentTerms, Matter *& sample, 
-            PlasmaGrid_Data & pgrid);
+            std::shared_ptr<const PlasmaGrid_Data> pgrid);
         ChargingModel(std::string filename, float accuracy, 
             std::vector<CurrentTerm*> CurrentTerms, Matter *& sample, 
-            PlasmaGrid_Data & pgrid, PlasmaData &pdata);
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata);
 
 
         ~ChargingModel(){
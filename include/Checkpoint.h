@@ -0,0 +1,131 @@
+/** @file Checkpoint.h
+ *  @brief Binary snapshots of a simulation, from which it can be restarted
+ *
+ *  Every class holding the state of a simulation writes it to a
+ *  CheckpointWriter and reads it back from a CheckpointReader, in the same
+ *  order and in native byte order. Checkpoint files are written by a single
+ *  background thread, see Checkpoints::write_async(), so that simulations do
+ *  not wait on the disk. Each file is written in full under a temporary name
+ *  and then renamed over the previous one, so that a run interrupted part way
+ *  through a write still leaves the previous checkpoint intact.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __CHECKPOINT_H_INCLUDED__
+#define __CHECKPOINT_H_INCLUDED__
+
+#include <string>
+#include <cstring>
+#include <type_traits>
+
+#include "threevector.h"
+
+/** @class CheckpointWriter
+ *  @brief Accumulates the binary state of a simulation in memory
+ */
+class CheckpointWriter{
+    private:
+        std::string Data;   //!< Bytes written so far
+
+    public:
+        /** @brief Append the bytes of the arithmetic \p value
+         */
+        template<typename T> CheckpointWriter &operator<<(const T &value){
+            static_assert(std::is_arithmetic<T>::value,
+                "Only arithmetic values are written to checkpoints");
+            Data.append(reinterpret_cast<const char*>(&value),sizeof(T));
+            return *this;
+        }
+        /** @brief Append the three components of \p vec
+         */
+        CheckpointWriter &operator<<(const threevector &vec){
+            return *this << vec.getx() << vec.gety() << vec.getz();
+        }
+        /** @brief Append the length and characters of \p str
+         */
+        CheckpointWriter &operator<<(const std::string &str){
+            *this << (unsigned long long)str.size();
+            Data += str;
+            return *this;
+        }
+
+        const std::string &data()const{ return Data; }
+};
+
+/** @class CheckpointReader
+ *  @brief Reads back the values written by a CheckpointWriter
+ *
+ *  Reading past the end of the data, or calling fail(), leaves the reader
+ *  failed, after which every read leaves its value unchanged.
+ */
+class CheckpointReader{
+    private:
+        std::string Data;   //!< Bytes of the checkpoint
+        size_t Position;    //!< Next byte to be read
+        bool Failed;        //!< True once any read has failed
+
+    public:
+        CheckpointReader():Position(0),Failed(false){}
+
+        /** @brief Read the data of the checkpoint file \p filename
+         *  @return 0 on success, 1 if the file could not be opened and 2 if
+         *  it is not a checkpoint of this version
+         */
+        int read(std::string filename);
+
+        /** @brief Read the arithmetic \p value
+         */
+        template<typename T> CheckpointReader &operator>>(T &value){
+            static_assert(std::is_arithmetic<T>::value,
+                "Only arithmetic values are read from checkpoints");
+            if( Failed || Data.size()-Position < sizeof(T) ){
+                Failed = true;
+                return *this;
+            }
+            std::memcpy(&value,Data.data()+Position,sizeof(T));
+            Position += sizeof(T);
+            return *this;
+        }
+        /** @brief Read the three components of \p vec
+         */
+        CheckpointReader &operator>>(threevector &vec);
+        /** @brief Read a string written with its length
+         */
+        CheckpointReader &operator>>(std::string &str);
+
+        /** @brief Mark the checkpoint as not matching the simulation
+         */
+        void fail(){ Failed = true; }
+        bool good()const{ return !Failed; }
+        bool at_end()const{ return Position == Data.size(); }
+};
+
+//!< Writing of checkpoint files in the background
+namespace Checkpoints{
+    /** @brief Queue \p data to be written to the checkpoint file \p filename
+     *
+     *  Writes and removals are carried out in the order they are queued. A
+     *  write queued while the last one queued is still waiting for the same
+     *  file replaces it. Safe to call from concurrent threads.
+     */
+    void write_async(std::string filename, const std::string &data);
+
+    /** @brief Queue the removal of the checkpoint file \p filename
+     */
+    void remove_async(std::string filename);
+
+    /** @brief Wait until every queued write and removal has been carried out
+     */
+    void wait();
+
+    /** @brief Cut the data file \p filename back to \p length bytes
+     *
+     *  Used to discard the rows written after a checkpoint was taken.
+     *  @return false if the file is shorter than \p length or cannot be cut
+     */
+    bool truncate_file(std::string filename, unsigned long long length);
+}
+
+#endif /* __CHECKPOINT_H_INCLUDED__ */
@@ -10,7 +10,9 @@
 
 #include "Term.h"
 #include "PlasmaFluxes.h"
+#include "TermKernel.h"
 #include "solveMOMLEM.h"
+#include "PotentialTable.h"
 
 namespace Term{
 
@@ -34,7 +36,7 @@ struct OMLe:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the electron flux following OML theory
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "OMLe"; };
 };
@@ -46,7 +48,7 @@ struct PHLe:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the electron Flux following PHL's theory
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "PHLe"; };
 };
@@ -58,7 +60,7 @@ struct OMLi:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the ion flux following OML theory
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "OMLi"; };
 };
@@ -70,7 +72,7 @@ struct MOMLi:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the ion flux following MOML theory
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "MOMLi"; };
 };
@@ -82,7 +84,7 @@ struct SOMLi:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the ion flux following SOML theory
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "SOMLi"; };
 };
@@ -94,7 +96,7 @@ struct SMOMLi:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the ion flux following SMOML theory
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "SMOMLi"; };
 };
@@ -106,7 +108,7 @@ struct TEEcharge:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the thermionic electron emission Flux
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "TEEcharge"; };
 };
@@ -118,7 +120,7 @@ struct TEESchottky:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the thermionic electron emission Flux with Schottky correction
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "TEESchottky"; };
 };
@@ -130,7 +132,7 @@ struct SEEcharge:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the secondary electron emission yield
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "SEEcharge"; };
 };
@@ -142,7 +144,7 @@ struct THSe:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the electron current in magnetic field with THS
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "THSe"; };
 };
@@ -154,7 +156,7 @@ struct THSi:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the ion current in magnetic field with THS
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "THSi"; };
 };
@@ -166,7 +168,7 @@ struct DTOKSi:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the ion current following original DTOKS method
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "DTOKSi"; };
 };
@@ -178,7 +180,7 @@ struct DTOKSe:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the electron current following original DTOKS method
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "DTOKSe"; };
 };
@@ -190,23 +192,51 @@ struct CW:CurrentTerm{
      *  @param Potential the normalised potential on the dust grain
      *  @return the equation for potential
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "CW"; };
 };
 
 struct MOMLWEM:CurrentTerm{
     /** @brief Calculate the potential following MOMLWEM Model
+     *
+     *  The potential is interpolated from the PotentialTables::MOMLWEM table
+     *  of the plasma where there is one, and otherwise from solveMOMLWEM().
      *  @param Sample Pointer to class containing all data about matter
      *  @param Pdata Pointer to data structure with information about plasma
      *  @param Potential the normalised potential on the dust grain
      *  @return the equation for potential
      */
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, 
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
         const double Potential);
     std::string PrintName(){ return "MOMLWEM"; };
 };
 
+struct MOMLEM:CurrentTerm{
+    /** @brief Calculate the current balance following the MOMLEM Model
+     *
+     *  The potential of the emitting dust is interpolated from the
+     *  PotentialTables::MOMLEM table of the plasma. Outside the table, it is
+     *  found with solveMOMLEM(), which solves for the space charge limited
+     *  potential well when one forms.
+     *  @param Sample Pointer to class containing all data about matter
+     *  @param Pdata Pointer to data structure with information about plasma
+     *  @param Potential the normalised potential on the dust grain
+     *  @return the current balance, vanishing at the MOMLEM potential
+     */
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, 
+        const double Potential);
+    std::string PrintName(){ return "MOMLEM"; };
+};
+
 ///@}
+
+typedef TermKernel<CurrentTerm,double,double> CurrentKernel;
+
+/** @brief The statically dispatched kernel of the current terms \p terms
+ *  @return the kernel, NULL if no kernel is registered for \p terms
+ */
+const CurrentKernel *find_currentkernel(
+    const std::vector<CurrentTerm*> &terms);
 }
 #endif /* __CHARGINGTERMS_H_INCLUDED__ */
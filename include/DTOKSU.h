@@ -14,6 +14,7 @@
 //#define DTOKSU_DEEP_DEBUG
 
 #include <algorithm>
+#include <chrono>           //!< for the wall-clock time between checkpoints
 
 #include "HeatingModel.h"
 #include "ForceModel.h"
@@ -48,7 +49,10 @@ class DTOKSU{
          *  this information. The \p WallBound and \p CoreBound are two vectors
          *  of pairs which are a series of points that define boundaries.
          *  \p TotalTime is used to record the total time taken to perform a 
-         *  simulation and \p MyFile is a output file
+         *  simulation and \p MyFile is a output file. The local plasma data
+         *  is recorded in the file \p PlasmaDataFileName. \p PlasmaState is
+         *  the single local plasma state observed by all three models.
+         *  \p OutputFormat is the format of the model data files.
          */
         ///@{
         double TotalTime;
@@ -56,10 +60,39 @@ class DTOKSU{
         HeatingModel HM;
         ForceModel FM;
         ChargingModel CM;
+        std::shared_ptr<LocalPlasmaState> PlasmaState;
         Boundary_Data WallBound, CoreBound;
         std::ofstream MyFile;
+        std::string PlasmaDataFileName;
+        char OutputFormat;
+        std::string DataFileName;   //!< Name of \p MyFile
         ///@}
 
+        /** @name Checkpoint data
+         *  @brief Where and how often Run() writes checkpoints
+         *
+         *  Every \p CheckpointInterval seconds of wall-clock time, Run() 
+         *  writes a checkpoint to \p CheckpointFileName at the end of a step,
+         *  including the mass deposited on the plasma grid if 
+         *  \p CheckpointDeposition. \p Resuming is set by read_checkpoint()
+         *  when the next Run() continues part way through, with the error
+         *  flag \p ResumeErrorFlag of the run interrupted.
+         */
+        ///@{
+        std::string CheckpointFileName;
+        double CheckpointInterval;  //!< s, zero for no checkpoints
+        bool CheckpointDeposition;
+        std::chrono::steady_clock::time_point NextCheckpoint;
+        bool Resuming;
+        bool ResumeErrorFlag;
+        ///@}
+
+        /** @brief Queue a checkpoint of the simulation to be written
+         *  @param inloop true if taken at the end of a step of Run()
+         *  @param errorflag the error flag of Run() when taken
+         */
+        void write_checkpoint(bool inloop, bool errorflag);
+
         /** @name Printing functions
          *  @brief Functions used to print data to a master simulation file
          *  @param filename is the name of the file to write to
@@ -69,6 +102,10 @@ class DTOKSU{
         void create_file(std::string filename);
         ///@}
 
+        /** @brief make \p HM and \p FM observe the local plasma state of \p CM
+         */
+        void share_plasmastate();
+
         /** @name Boundary functions
          *  @brief Functions used to check particle interaction with boundary
          */
@@ -94,6 +131,8 @@ class DTOKSU{
          *  In all cases, we specify \p MN number of accuracies to solve the 
          *  physics models to, as well as the \p sample, \p heatmodels, 
          *  \p forcemodels and \p chargemodels to specify the simulation.
+         *  The data files are opened as by OpenFiles(), so simulations built
+         *  together on several threads need different \p filename or \p i.
          */
         ///@{
         /** @brief pdata constructor.
@@ -104,59 +143,86 @@ class DTOKSU{
          *  @param HeatTerms pointers to Heating Terms used by HeatModel
          *  @param ForceTerms pointers to Force Terms used by ForceModel
          *  @param CurrentTerms pointers to Current Terms used by ChargingModel
+         *  @param filename prefix of the files first opened, see OpenFiles()
+         *  @param i number of the files first opened, see OpenFiles()
          */
         DTOKSU( std::array<float,MN> alvls, Matter *& sample, PlasmaData &pdata,
             std::vector<HeatTerm*> HeatTerms, 
             std::vector<ForceTerm*> ForceTerms, 
-            std::vector<CurrentTerm*> CurrentTerms);
+            std::vector<CurrentTerm*> CurrentTerms, 
+            std::string filename = "Data/default", unsigned int i = 0);
 
         /** @brief pgrid constructor.
          *
          *  @param alvls the accuracy levels for each of MN models
          *  @param sample pointer to reference of Matter object data
-         *  @param pgrid the plasma grid containing all plasma data
+         *  @param pgrid shared handle to the plasma grid of all plasma data
          *  @param HeatTerms pointers to Heating Terms used by HeatModel
          *  @param ForceTerms pointers to Force Terms used by ForceModel
          *  @param CurrentTerms pointers to Current Terms used by ChargingModel
+         *  @param filename prefix of the files first opened, see OpenFiles()
+         *  @param i number of the files first opened, see OpenFiles()
          */
         DTOKSU( std::array<float,MN> alvls, Matter *& sample, 
-            PlasmaGrid_Data &pgrid, std::vector<HeatTerm*> HeatTerms, 
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, 
+            std::vector<HeatTerm*> HeatTerms, 
             std::vector<ForceTerm*> ForceTerms, 
-            std::vector<CurrentTerm*> CurrentTerms);
+            std::vector<CurrentTerm*> CurrentTerms, 
+            std::string filename = "Data/default", unsigned int i = 0);
 
         /** @brief pdata and pgrid constructor.
          *
          *  @param alvls the accuracy levels for each of MN models
          *  @param sample pointer to reference of Matter object data
-         *  @param pgrid the plasma grid containing all plasma data
+         *  @param pgrid shared handle to the plasma grid of all plasma data
          *  @param pdata the plasma data used in the simulation
          *  @param HeatTerms pointers to Heating Terms used by HeatModel
          *  @param ForceTerms pointers to Force Terms used by ForceModel
          *  @param CurrentTerms pointers to Current Terms used by ChargingModel
+         *  @param filename prefix of the files first opened, see OpenFiles()
+         *  @param i number of the files first opened, see OpenFiles()
          */
         DTOKSU( std::array<float,MN> alvls, Matter *& sample, 
-            PlasmaGrid_Data &pgrid, PlasmaData &pdata, 
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata, 
             std::vector<HeatTerm*> HeatTerms, 
             std::vector<ForceTerm*> ForceTerms, 
-            std::vector<CurrentTerm*> CurrentTerms);
+            std::vector<CurrentTerm*> CurrentTerms, 
+            std::string filename = "Data/default", unsigned int i = 0);
 
         /** @brief boundary constructor.
          *
          *  @param alvls the accuracy levels for each of MN models
          *  @param sample pointer to reference of Matter object data
-         *  @param pgrid the plasma grid containing all plasma data
+         *  @param pgrid shared handle to the plasma grid of all plasma data
          *  @param pdata the plasma data used in the simulation
          *  @param cbound the list of points defining the core boundary
          *  @param wbound the list of points defining the wall boundary
          *  @param HeatTerms pointers to Heating Terms used by HeatModel
          *  @param ForceTerms pointers to Force Terms used by ForceModel
          *  @param CurrentTerms pointers to Current Terms used by ChargingModel
+         *  @param filename prefix of the files first opened, see OpenFiles()
+         *  @param i number of the files first opened, see OpenFiles()
          */
         DTOKSU( std::array<float,MN> alvls, Matter *& sample, 
-            PlasmaGrid_Data &pgrid, PlasmaData &pdata, Boundary_Data &wbound, 
-            Boundary_Data &cbound, std::vector<HeatTerm*> HeatTerms, 
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata, 
+            Boundary_Data &wbound, Boundary_Data &cbound, 
+            std::vector<HeatTerm*> HeatTerms, 
             std::vector<ForceTerm*> ForceTerms, 
-            std::vector<CurrentTerm*> CurrentTerms);
+            std::vector<CurrentTerm*> CurrentTerms, 
+            std::string filename = "Data/default", unsigned int i = 0);
+
+        /** @brief clone constructor.
+         *
+         *  Copies the whole state of \p other, its models, times and local
+         *  plasma, to continue from the same point acting on \p sample. The
+         *  stateless term objects and plasma grid are shared with \p other,
+         *  force terms holding state are copied with their state. No data
+         *  files are open until OpenFiles() is called.
+         *  @param other the simulation to be copied
+         *  @param sample the grain simulated, usually a clone of the grain of
+         *  \p other, see Matter::clone()
+         */
+        DTOKSU( const DTOKSU &other, Matter *sample );
         ///@}
 
         ~DTOKSU(){
@@ -184,14 +250,72 @@ class DTOKSU{
         /** @brief Used to close all the model data files
          */
         void CloseFiles();
+        /** @brief Set the format and flush interval of the model data files
+         *
+         *  Applies to files opened after, by OpenFiles()
+         *  @param format the output format, Output::Text or Output::Binary
+         *  @param flushinterval the number of rows buffered between writes
+         */
+        void set_output(char format, unsigned int flushinterval);
+        /** @brief Set the numerical method used to integrate the motion
+         *  @param method the method, one of the Integrator namespace
+         */
+        void set_integrator(char method){ FM.set_integrator(method); }
+        /** @brief Change the name of the file the plasma data is recorded in
+         *
+         *  @param filename name of the file inside the Data directory, the 
+         *  extension is given by the output format
+         */
+        void set_plasmadatafile(std::string filename)
+        { 
+            PlasmaDataFileName = filename; 
+        };
         /** @brief Reset the time as recorded by each model if necessary
          */
         void ResetModelTime(double HMTime, double FMTime, double CMTime);
+
+        /** @name Checkpoints
+         *  @brief Save the state of the simulation and restart from it
+         */
+        ///@{
+        /** @brief Write checkpoints to \p filename while running
+         *
+         *  @param filename the checkpoint file, replaced by each checkpoint
+         *  @param interval s, the wall-clock time between checkpoints, zero
+         *  for none
+         *  @param deposition if true, checkpoints include the mass deposited
+         *  on the plasma grid, only meaningful when no other simulation 
+         *  deposits on the same grid
+         */
+        void set_checkpoint(std::string filename, double interval, 
+            bool deposition);
+        /** @brief Queue a checkpoint of the simulation before Run() is called
+         */
+        void checkpoint(){ write_checkpoint(false,false); }
+        /** @brief Restore the simulation from the checkpoint \p filename
+         *
+         *  The data files are cut back to their length at the checkpoint and
+         *  reopened. If the checkpoint was taken part way through Run(), the
+         *  next Run() continues from the end of that step exactly as the
+         *  simulation checkpointed would have.
+         *  @return 0 on success, 1 if the file could not be opened and 2 if 
+         *  it is not a checkpoint of this simulation or its data files could
+         *  not be restored
+         */
+        int read_checkpoint(std::string filename);
+        ///@}
     
         /** @brief Prints to a file the data accumulated about impurity
          *  deposition in plasma grid
          */
         void ImpurityPrint();
+
+        /** @brief Record the mass lost by the grain in \p deposition
+         *  @see Model::set_deposition()
+         */
+        void set_deposition(std::shared_ptr<MassDeposition> deposition){
+            HM.set_deposition(deposition);
+        }
         
         /** @name Public getter methods
          *  @brief functions required to get member data
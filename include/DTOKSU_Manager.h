@@ -22,8 +22,21 @@
 #endif
 #include <exception>                  //!< for Exception handling
 #include <stdlib.h>
+#include <thread>                     //!< for std::thread in ensemble runs
+#include <atomic>                     //!< for std::atomic work counter
+#include <mutex>                      //!< for std::mutex of breakup tasks
+#include <condition_variable>         //!< for waiting on breakup tasks
+#include <deque>                      //!< for std::deque of breakup tasks
+#include <limits>                     //!< for numbering breakup branches
+#include <set>                        //!< for std::set of live branches
+#include <map>                        //!< for std::map of branch deposition
 
 #include "DTOKSU.h"
+#include "GridInterpolation.h"
+#include "PlasmaGridFields.h"
+#include "PlasmaGridCache.h"
+#include "PlasmaGridReader.h"
+#include "BackscatterTable.h"
 
 struct PlasmaFileReadFailure : public std::exception {
    const char * what () const throw () {
@@ -31,6 +44,41 @@ struct PlasmaFileReadFailure : public std::exception {
    }
 };
 
+/** @brief Initial conditions of a single grain in an ensemble run
+ */
+struct GrainInitialState{
+    char Element;         //!< Element of the grain, see Configure()
+    double Size;          //!< m, initial radius of the grain
+    double Temperature;   //!< K, initial temperature of the grain
+    threevector Position; //!< m, initial position in cylindrical coordinates
+    threevector Velocity; //!< m/s, initial velocity
+};
+
+/** @brief End state of a single grain in an ensemble run
+ */
+struct EnsembleResult{
+    unsigned int Index;   //!< Position of the grain in the ensemble file
+    int RunStatus;        //!< Return value of DTOKSU::Run()
+    double HMTime;        //!< s, total time of the heating model
+    double FMTime;        //!< s, total time of the force model
+    double CMTime;        //!< s, total time of the charging model
+    GrainData FinalState; //!< State of the grain when the simulation ended
+};
+
+/** @brief A fragment of a breakup tree waiting to be simulated
+ *
+ *  Branches are numbered as a binary heap. The grain simulated first is
+ *  branch 1 and when branch n breaks up, the fragment sent in the negative
+ *  direction becomes branch 2n and the one sent in the positive direction
+ *  branch 2n+1. The number of a branch depends only on its place in the tree.
+ */
+struct BreakupBranch{
+    unsigned int Index;   //!< Heap index of the branch
+    DTOKSU *Sim;          //!< Simulation continuing from the breakup
+    Matter *Sample;       //!< Fragment simulated by \p Sim
+    std::shared_ptr<MassDeposition> Deposition; //!< Mass lost by \p Sample
+};
+
 /** @class DTOKSU_Manager
  *  @brief Class wrapping DTOKSU class for configuring and running simulations
  *  
@@ -53,14 +101,24 @@ class DTOKSU_Manager{
         ///@{
         DTOKSU *Sim;
         Matter *Sample;
-        PlasmaGrid_Data Pgrid;
+        PlasmaGrid_Data Pgrid; //!< Grid under construction while configuring
+        std::shared_ptr<const PlasmaGrid_Data> SharedPgrid; //!< Read-only grid
         PlasmaData Pdata;
+        Boundary_Data WallBound, CoreBound;
+        bool ContinuousPlasma;
+        std::string DataFilePrefix;
+        char OutputFormat;          //!< Format of the model data files
+        unsigned int FlushInterval; //!< Rows buffered between file writes
+        char ForceIntegrator;       //!< Method used to integrate motion
+        std::string BackscatterCache; //!< Backscatter table file, "" for none
+        double CheckpointInterval;  //!< s, wall-clock time between checkpoints
+        bool Restart;               //!< Continue from the last checkpoint
         //!< FORCE MODEL NUMBER, the number of charge models
         const static unsigned int FMN = 10;
         // HEATING MODEL NUMBER, the number of charge models
         const static unsigned int HMN = 18;
         // CHARGE MODEL NUMBER, the number of charge models
-        const static unsigned int CMN = 15;
+        const static unsigned int CMN = 16;
 
         /** @brief Defines the status of configuration
          *
@@ -71,6 +129,66 @@ class DTOKSU_Manager{
         int Config_Status;
         ///@}
 
+        /** @name Configured models
+         *  @brief Models and accuracies retained from Configure()
+         *
+         *  These are kept so that further instances of DTOKSU can be created
+         *  with the same configuration, as required by ensemble runs. The
+         *  stateless term objects are shared between all instances, terms
+         *  holding state are copied by each ForceModel.
+         */
+        ///@{
+        std::array<float,DTOKSU::MN> AccuracyLevels;
+        std::vector<HeatTerm*> HeatTerms;
+        std::vector<ForceTerm*> ForceTerms;
+        std::vector<CurrentTerm*> CurrentTerms;
+        std::array<char,CM> ConstModels;
+        double UpdateTolerance;     //!< See Matter::set_updatetolerance()
+        ///@}
+
+        /** @name Ensemble data
+         *  @brief Initial states and results of an ensemble of grains
+         *
+         *  When an ensemble file is given, every grain in \p EnsembleStates is
+         *  simulated by its own DTOKSU instance on one of \p NumThreads 
+         *  worker threads. The result of grain n is stored in 
+         *  \p EnsembleResults[n].
+         */
+        ///@{
+        std::vector<GrainInitialState> EnsembleStates;
+        std::vector<EnsembleResult> EnsembleResults;
+        unsigned int NumThreads;
+        ///@}
+
+        /** @name Breakup data
+         *  @brief Branches of a breakup tree and their results
+         *
+         *  Every fragment of a breakup is simulated by a clone of the DTOKSU
+         *  instance it broke from, queued in \p BreakupQueue and taken by one
+         *  of \p NumThreads worker threads. \p BreakupsRunning counts the
+         *  branches being simulated, so that the workers stop once the queue
+         *  is empty and no branch can add to it. The end state of each branch
+         *  is stored in \p BreakupResults, in order of completion.
+         *  \p BreakupLive holds the indices of the branches queued or being
+         *  simulated, which have a checkpoint when checkpointing.
+         *  Each branch records the mass its fragment loses in its own grid,
+         *  stored in \p BreakupDeposition once the branch ends or breaks up.
+         *  These are merged onto the plasma grid in order of branch index, so
+         *  that the deposition does not depend on thread scheduling.
+         */
+        ///@{
+        std::deque<BreakupBranch> BreakupQueue;
+        std::vector<EnsembleResult> BreakupResults;
+        std::mutex BreakupMutex;
+        std::condition_variable BreakupReady;
+        unsigned int BreakupsRunning;
+        unsigned long BreakupSeed; //!< Seeds the random numbers of branches
+        std::set<unsigned int> BreakupLive;
+        std::map<unsigned int,std::shared_ptr<MassDeposition>> 
+            BreakupDeposition;
+        ///@}
+
+
         
         /** @brief Used to handle the input given by user
          */
@@ -96,6 +214,8 @@ class DTOKSU_Manager{
          *  files containing information about the background plasma and 
          *  simulation boundaries.
          *  @param plasma_dirname directory containing plasma data file
+         *  @param fields_filename file caching derived plasma fields, or ""
+         *  @param cache_filename file caching the whole plasma grid, or ""
          *  @param dirname directory containing generic boundary data file
          *  @param filename name of file containing generic boundary data
          *  @param BD the variable in which boundary data is stored
@@ -103,7 +223,8 @@ class DTOKSU_Manager{
          *  @return 1 if configured correctly, 0 if not
          */
         ///@{
-        int configure_plasmagrid(std::string plasma_dirname);
+        int configure_plasmagrid(std::string plasma_dirname, 
+            std::string fields_filename, std::string cache_filename);
         int configure_boundary(std::string dirname, std::string filename, 
             Boundary_Data& BD);
         int configure_coregrid(std::string wall_dirname);
@@ -111,21 +232,111 @@ class DTOKSU_Manager{
         /** @brief function to read plasma data in from a formatted text file
          * 
          *  @param plasma_dirname directory containing plasma data file
+         *  @param fields_filename file caching derived plasma fields, or ""
          *  @return a value corresponding to the status of file reading
          */
         int read_data(std::string plasma_dirname);
+        /** @brief true if a configured force uses the electric field
+         *
+         *  The plasma potential is only needed to derive the electric field,
+         *  see ForceTerm::needs_electricfield().
+         */
+        bool uses_electricfield();
         #ifdef NETCDF_SWITCH
         /** @brief function to read plasma data for MPSI in .netcdf file format
-         * 
+         *
+         *  The first theta plane of each variable is read in blocks of rows
+         *  straight into the grid fields.
          *  @param plasma_dirname directory containing plasma data file
+         *  @param potential read the potential, otherwise it is set to zero
          *  @return a value corresponding to the status of file reading
          */
-        int read_MPSIdata(std::string plasma_dirname);
+        int read_MPSIdata(std::string plasma_dirname, bool potential);
         #endif
 
+        /** @name Breakup functions
+         *  @brief functions for following every fragment of a breakup
+         */
+        ///@{
         /** @brief called by DTOKSU_Manager::Run(), operates DTOKSU with breakup
+         *
+         *  Branch n writes its model files to
+         *  \p DataFilePrefix_breakup_*_n and its plasma data to
+         *  Data/breakup_pd_n, see BreakupBranch for the numbering. The end
+         *  state of every branch is written to \p DataFilePrefix_breakup.txt
+         *  and the deposition of every branch to the shared plasma grid.
+         *  @return 11 if restarting and the checkpoints could not be read,
+         *  otherwise 0
+         */
+        int Breakup();
+        /** @brief take branches from \p BreakupQueue until none are left
+         */
+        void breakup_worker();
+        /** @brief simulate \p Branch, queueing a new branch at each breakup
+         *
+         *  The fragment sent in the negative direction is queued, while the
+         *  one sent in the positive direction is followed by this call.
+         *  @param Branch the branch to be simulated
+         */
+        void follow_branch(BreakupBranch Branch);
+        /** @brief an empty deposition record of the size of the plasma grid
+         *  @return null if the plasma grid has no deposition record
+         */
+        std::shared_ptr<MassDeposition> new_deposition()const{
+            if( !SharedPgrid || !SharedPgrid->dm ) return nullptr;
+            return std::make_shared<MassDeposition>(SharedPgrid->gridx,
+                SharedPgrid->gridz);
+        }
+        /** @brief name of the checkpoint file of the branch \p Index
+         */
+        std::string branch_checkpoint(unsigned int Index)const{
+            return DataFilePrefix+"_breakup_"+std::to_string(Index)+".chk";
+        }
+        /** @brief queue the breakup tree to be written to its checkpoint
+         *
+         *  Writes \p BreakupSeed, \p BreakupLive, \p BreakupResults and 
+         *  \p BreakupDeposition, \p BreakupMutex must be held. The
+         *  deposition of the live branches is in their own checkpoints
+         */
+        void write_breakup_checkpoint();
+        /** @brief read the breakup tree written by write_breakup_checkpoint()
+         *  @return 0 on success, else the return of CheckpointReader::read()
          */
-        void Breakup();
+        int read_breakup_checkpoint();
+        ///@}
+
+        /** @brief Create a new Matter object of the configured element
+         *
+         *  @param Element char identifying the element of the grain
+         *  @param size the initial radius of the grain
+         *  @param Temp the initial temperature of the grain
+         *  @param xinit the initial position of the grain
+         *  @param vinit the initial velocity of the grain
+         *  @return pointer to new Matter object or NULL for invalid element
+         */
+        Matter* create_sample(char Element, double size, double Temp, 
+            const threevector &xinit, const threevector &vinit);
+
+        /** @name Ensemble functions
+         *  @brief functions for simulating many independent grains in parallel
+         */
+        ///@{
+        /** @brief read initial grain states into \p EnsembleStates
+         *
+         *  @param filename name of file with one grain per line
+         *  @return 0 if read correctly, else a non-zero error code
+         */
+        int read_ensemble(std::string filename);
+        /** @brief take grains from the ensemble until none are left
+         *
+         *  @param NextGrain index of the next grain to be simulated
+         */
+        void ensemble_worker(std::atomic<unsigned int> &NextGrain);
+        /** @brief called by DTOKSU_Manager::Run(), runs the whole ensemble
+         *  @return 10 if any grain failed to be created, otherwise 0
+         */
+        int RunEnsemble();
+        ///@}
 
     public:
 
@@ -172,7 +383,8 @@ class DTOKSU_Manager{
         ///@}
 
         /** @brief If correctly configured, run DTOKSU 
-         *  @return the result of DTOKSU::Run() or 1 if not configured.
+         *  @return the result of DTOKSU::Run(), 1 if not configured or 11 if
+         *  restarting and the checkpoint could not be read.
          */
         int Run();
 };
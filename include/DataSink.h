@@ -0,0 +1,165 @@
+/** @file DataSink.h
+ *  @brief Buffered writer for the tabulated output of the physics models
+ *
+ *  A DataSink holds its file open for the whole simulation and buffers rows
+ *  in memory, writing them out every FlushInterval rows instead of opening
+ *  and closing the file for every row printed. Rows are written either as
+ *  tab separated text or in a binary columnar format, in which a header
+ *  describing the columns is followed by the raw values of each row. Binary
+ *  files are converted back to the text layout by convert_to_text().
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __DATASINK_H_INCLUDED__
+#define __DATASINK_H_INCLUDED__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <ostream>
+
+#include "threevector.h"
+#include "Checkpoint.h"
+
+//!< Output formats of a DataSink
+namespace Output{
+    const char Text   = 't';    //!< Tab separated values, one row per line
+    const char Binary = 'b';    //!< Header followed by rows of raw doubles
+
+    const unsigned int DefaultFlushInterval = 1000; //!< Rows per write
+}
+
+//!< Types of column of a DataSink, every value is stored as a double
+namespace Column{
+    const char Scalar  = 'd';   //!< One value, printed in scientific form
+    const char Integer = 'i';   //!< One value, printed as an integer
+    const char Sign    = 's';   //!< One value, printed as Pos or Neg
+    const char Vector  = 'v';   //!< Three values, printed space separated
+}
+
+/** @brief Name and type of one column of a DataSink
+ */
+struct DataColumn{
+    std::string Name;   //!< Name of column given in the header
+    char Type;          //!< Type of column, one of the Column namespace
+};
+
+/** @class DataSink
+ *  @brief Persistent, buffered writer of rows of model data
+ *
+ *  Values are added to the current row with operator<< and the row is
+ *  completed with end_row(). The number of values in each row must match the
+ *  columns passed to open().
+ */
+class DataSink{
+    private:
+        std::ofstream File;                 //!< File being written to
+        std::string FileName;               //!< Name of the file
+        char Format;                        //!< Output::Text or Output::Binary
+        unsigned int FlushInterval;         //!< Rows buffered between writes
+        std::vector<DataColumn> Columns;    //!< Layout of each row
+        unsigned int RowWidth;              //!< Number of values in a row
+        std::vector<double> Row;            //!< Values of the current row
+        std::string Buffer;                 //!< Encoded rows not yet written
+        unsigned int BufferedRows;          //!< Number of rows in Buffer
+        unsigned long long Written;         //!< Bytes written to File
+
+        /** @brief Open \p FileName, writing the header if it is empty
+         *  @param append if true, add to the end of an existing file
+         *  @return 0 on success and 1 if the file could not be opened
+         */
+        int open_file(bool append);
+
+    public:
+        DataSink();
+        ~DataSink();
+
+        /** @brief A sink with the format and flush interval of \p other
+         *
+         *  The file of \p other and any rows not yet written to it are not
+         *  copied, the new sink has no file until open() is called.
+         */
+        DataSink(const DataSink &other);
+        DataSink &operator=(const DataSink &) = delete;
+
+        /** @brief Set the format and flush interval of files opened after
+         *  @param format the output format, Output::Text or Output::Binary
+         *  @param flushinterval the number of rows buffered between writes
+         */
+        void configure(char format, unsigned int flushinterval);
+
+        /** @brief Open \p filename for rows with layout given by \p columns
+         *
+         *  Any file already open is flushed and closed first.
+         *  @param filename name of the file to be written
+         *  @param columns the name and type of each column
+         *  @param append if true, rows are added to the end of an existing
+         *  file of the same layout rather than replacing it
+         *  @return 0 on success and 1 if the file could not be opened
+         */
+        int open(std::string filename, const std::vector<DataColumn> &columns,
+            bool append = false);
+
+        /** @brief Add \p value to the current row
+         */
+        DataSink &operator<<(double value);
+        /** @brief Add the three components of \p vec to the current row
+         */
+        DataSink &operator<<(const threevector &vec);
+
+        /** @brief Complete the current row, writing buffered rows if due
+         *
+         *  If the file has been closed, it is reopened and appended to.
+         */
+        void end_row();
+
+        /** @brief Write all buffered rows to the file
+         */
+        void flush();
+
+        /** @brief Flush and close the file
+         */
+        void close();
+
+        /** @brief Write the state of the sink to \p out
+         *
+         *  Rows already written are recorded by the length of the file, rows
+         *  still buffered are copied.
+         */
+        void write_checkpoint(CheckpointWriter &out)const;
+
+        /** @brief Restore the state written by write_checkpoint()
+         *
+         *  The file is cut back to its length at the checkpoint and reopened,
+         *  discarding any rows written after the checkpoint was taken. Fails
+         *  \p in if the file is shorter than it was or cannot be reopened.
+         */
+        void read_checkpoint(CheckpointReader &in);
+
+        bool is_open                        ()const{ return File.is_open(); }
+        char get_format                     ()const{ return Format;         }
+        const std::string &get_filename     ()const{ return FileName;       }
+
+        /** @brief File extension conventionally used with \p format
+         *  @param format the output format
+         *  @return ".bin" for Output::Binary and ".txt" otherwise
+         */
+        static std::string extension(char format);
+};
+
+/** @brief Convert the binary DataSink file \p filename to text on \p out
+ *
+ *  The text produced is identical to that written by a DataSink with format
+ *  Output::Text given the same rows.
+ *  @param filename name of the binary file to be read
+ *  @param out stream to which the text is written
+ *  @return 0 on success, 1 if the file could not be opened, 2 if it is not a
+ *  binary DataSink file, 3 if the file ends part way through a row and 4 if
+ *  the file ends part way through the header or the header describes more
+ *  columns than the file holds
+ */
+int convert_to_text(std::string filename, std::ostream &out);
+
+#endif /* __DATASINK_H_INCLUDED__ */
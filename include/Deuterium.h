@@ -43,6 +43,7 @@ class Deuterium: public Matter{
         ~Deuterium(){};
 
         double probe_vapourpressure(double Temperature)const;
+        Matter* clone()const override{ return new Deuterium(*this); }
 };
 
 #endif /* __DEUTERIUM_H_INCLUDED__ */
\ No newline at end of file
@@ -0,0 +1,83 @@
+/** @file EmissivityTable.h
+ *  @brief Tabulated emissivity of an element as a function of temperature and
+ *  radius
+ *
+ *  The emissivity data of an element are stored as one file per temperature,
+ *  EmissivityData/EmissivityData<Element>/Temp_<Temperature(K)>.txt, holding
+ *  comma delimited pairs of grain radius (m) and emissivity. An
+ *  EmissivityTable reads every file of an element once and holds the data in
+ *  memory on a common (temperature x radius) grid. One immutable table per
+ *  element is shared by every grain in the process, see shared().
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __EMISSIVITYTABLE_H_INCLUDED__
+#define __EMISSIVITYTABLE_H_INCLUDED__
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "GridField.h"
+
+/** @class EmissivityTable
+ *  @brief Emissivity of an element tabulated in temperature and radius
+ *
+ *  Row n of \p Values holds the emissivity at temperature Temperatures[n] for
+ *  each radius of \p Radii. Files tabulating different radii are linearly
+ *  interpolated onto the union of all radii when read.
+ */
+class EmissivityTable{
+    private:
+        std::vector<double> Temperatures;   //!< K, ascending
+        std::vector<double> Radii;          //!< m, ascending
+        GridField<double> Values;           //!< Emissivity, arb
+
+    public:
+        EmissivityTable(){}
+
+        /** @brief Read the emissivity files of \p dirname
+         *
+         *  Tries the file of every whole temperature from \p tmin to \p tmax,
+         *  as there is no listing of the temperatures tabulated.
+         *  @param dirname directory containing files Temp_<Temperature>.txt
+         *  @param tmin lowest temperature tried (K)
+         *  @param tmax highest temperature tried (K)
+         *  @return 0 on success and 1 if no data could be read
+         */
+        int read(std::string dirname, int tmin, int tmax);
+
+        /** @brief Bilinear interpolation of the emissivity
+         *
+         *  Values outside the range of the table are taken from its edge.
+         *  Must not be called on an empty table.
+         *  @param temperature the temperature of the grain (K)
+         *  @param radius the radius of the grain (m)
+         *  @return the emissivity of the grain
+         */
+        double interpolate(double temperature, double radius)const;
+
+        bool empty()const{ return Temperatures.empty() || Radii.empty(); }
+
+        /** @brief Directory of the emissivity data for element \p elem
+         *  @param elem the element, as given by ElementConsts::Elem
+         *  @return the directory name, empty if there is no data for \p elem
+         */
+        static std::string directory(char elem);
+
+        /** @brief The table for element \p elem, shared by the whole process
+         *
+         *  The table is read on the first call for each element and returned
+         *  by every later call. Safe to call from concurrent threads.
+         *  @param elem the element, as given by ElementConsts::Elem
+         *  @param boilingtemp the boiling temperature of the element (K), the
+         *  highest temperature tabulated
+         *  @return the table, which is empty if no data could be read
+         */
+        static std::shared_ptr<const EmissivityTable> shared(char elem,
+            double boilingtemp);
+};
+
+#endif /* __EMISSIVITYTABLE_H_INCLUDED__ */
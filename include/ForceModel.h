@@ -10,9 +10,37 @@
 #ifndef __FORCEMODEL_H_INCLUDED__
 #define __FORCEMODEL_H_INCLUDED__
 
+#include <array>
+#include <memory>
+
 #include "Model.h"
 #include "ForceTerms.h"
 
+//!< Numerical methods for the equation of motion, see ForceModel::Force()
+namespace Integrator{
+    const char Euler         = 'e'; //!< Forward Euler, the original DTOKS
+    const char RungeKutta4   = 'r'; //!< Classical fourth order Runge-Kutta
+    const char DormandPrince = 'd'; //!< Adaptive embedded RK5(4) with FSAL
+}
+
+/** @brief The state of the dust and plasma read by the force terms
+ *
+ *  The acceleration is recalculated if any of these change, in addition to
+ *  the position and velocity it is evaluated at.
+ */
+struct ForceTermInputs{
+    double Temperature;     //!< K
+    double Mass;            //!< kg
+    double Radius;          //!< m
+    double Density;         //!< kg m^-3
+    double SurfaceArea;     //!< m^2
+    double RotationFreq;    //!< s^-1
+    double Potential;       //!< Normalised potential
+    bool Liquid;            //!< True if the sample is a liquid
+    bool Positive;          //!< True if the sample is positively charged
+    PlasmaData Pdata;       //!< Local plasma parameters
+};
+
 /** @class ForceModel
  *  @brief Defines the force models which affect the equation of motion of dust
  *  
@@ -25,6 +53,59 @@ class ForceModel : public Model {
          */
         std::vector<ForceTerm*> ForceTerms;
 
+        /** @brief This model's copies of the terms which hold state, which
+         *  replace the shared terms in \p ForceTerms, see own_terms()
+         */
+        std::vector<std::unique_ptr<ForceTerm>> OwnTerms;
+
+        /** @name Term kernel
+         *  @brief Statically dispatched kernel of \p ForceTerms, NULL if none
+         *  is registered, and the accelerations it last evaluated
+         */
+        ///@{
+        const Term::ForceKernel *Kernel;
+        //!< Most force terms a model takes, std::length_error is thrown for
+        //!< more
+        static const unsigned int MaxForceTerms = 16;
+        mutable std::array<threevector,MaxForceTerms> TermAccelerations;
+        ///@}
+
+        /** @brief Numerical method used by Force(), see Integrator namespace
+         */
+        char Method;
+
+        /** @name Dormand-Prince state
+         *  @brief Data carried between steps of the embedded RK5(4) method
+         *
+         *  \p NextStep is the step proposed by the error control of the last
+         *  step taken, zero before the first step. The acceleration at the end
+         *  of each step is the first stage of the next (FSAL), so is kept in
+         *  \p LastAcceleration with the state it was evaluated for and reused
+         *  while that state is unchanged.
+         */
+        ///@{
+        double NextStep;
+        bool AccelerationCached;
+        threevector LastPosition;
+        threevector LastVelocity;
+        threevector LastAcceleration;
+        ForceTermInputs LastInputs;
+        ///@}
+
+        /** @brief Set default settings for private member data
+         */
+        void Defaults();
+
+        /** @brief Replace each term of \p ForceTerms holding state by a copy
+         *  owned by this model, see ForceTerm::clone()
+         */
+        void own_terms();
+
+        /** @brief Record the current inputs to the force terms in \p inputs
+         *  @param inputs the structure to be filled
+         */
+        void get_inputs(ForceTermInputs &inputs)const;
+
         /** @brief Print model data to ModelDataFile
          */
         void Print();
@@ -41,6 +122,16 @@ class ForceModel : public Model {
          */
         void RungeKutta4(threevector &xf, threevector &vf, 
             double timestep)const;
+        /** @brief Calculate change in position and velocity using the 
+         *  Dormand-Prince RK5(4) method with error control
+         *
+         *  \p timestep is covered by as many steps as the error control 
+         *  requires, starting from \p NextStep.
+         *  @param xf Reference to the final position returned by the function
+         *  @param vf Reference to the final velocity returned by the function
+         *  @param timestep the time step over which functions are evaluated
+         */
+        void DormandPrince(threevector &xf, threevector &vf, double timestep);
 
     public:
         ForceModel();
@@ -52,25 +143,51 @@ class ForceModel : public Model {
             PlasmaData * pdata);
         ForceModel(std::string filename, float accuracy, 
             std::vector<ForceTerm*> forceterms, 
-                Matter *& sample, PlasmaGrid_Data & pgrid);
+                Matter *& sample,
+                std::shared_ptr<const PlasmaGrid_Data> pgrid);
         ForceModel(std::string filename, float accuracy, 
             std::vector<ForceTerm*> forceterms, Matter *& sample, 
-            PlasmaGrid_Data & pgrid, PlasmaData &pdata);
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata);
+
+        /** @brief Copy \p other, with copies of its terms holding state
+         */
+        ForceModel(const ForceModel &other);
 
         ~ForceModel(){};
         
         void CreateFile(std::string filename);
+        /** @brief Time step limited by the accuracy and the plasma
+         *
+         *  With the Dormand-Prince method, after the first step, this is the 
+         *  step proposed by its error control, shortened in proportion to any
+         *  growth of the acceleration since it was proposed. Otherwise the 
+         *  change in velocity in a step is limited. Both are further limited by the 
+         *  plasma grid spacing and gyromotion.
+         *  @return the time scale of the process
+         */
         double ProbeTimeStep()const;
         double UpdateTimeStep();
 
-        /** @brief Implement Euler method to calculate motion
+        /** @brief Also save the step proposed by the Dormand-Prince method
+         *  and the state of the force terms
+         */
+        void write_checkpoint(CheckpointWriter &out)const override;
+        void read_checkpoint(CheckpointReader &in) override;
+
+        /** @brief Set the numerical method used to calculate motion
+         *  @param method the method, one of the Integrator namespace
+         */
+        void set_integrator(char method);
+
+        /** @brief Calculate motion for a time period of \p TimeStep
          *   
          *  @see Force(double timestep)
          */
         void Force();
 
-        /** @brief Implement Euler method to calculate motion
+        /** @brief Calculate motion for a time period of \p timestep
          *   
+         *  Uses the method set by set_integrator()
          *  @see CalculateAcceleration()
          */
         void Force(double timestep);
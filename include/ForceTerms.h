@@ -10,6 +10,7 @@
 
 #include "Term.h"
 #include "PlasmaFluxes.h"
+#include "TermKernel.h"
 #include "MathHeader.h"
 
 namespace Term{
@@ -28,7 +29,7 @@ namespace Term{
  */
 struct Gravity:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "Gravity"; };
 };
 /** @brief Lorentz force due to electric and magnetic fields
@@ -36,15 +37,16 @@ struct Gravity:ForceTerm{
  */
 struct LorentzForce:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "LorentzForce"; };
+    bool needs_electricfield()const{ return true; }
 };
 /** @brief SOML ion drag model due to collisions of dust with ions
  *  @return The acceleration in m/s^2 due to SOML Ion Drag force
  */
 struct SOMLIonDrag:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "SOMLIonDrag"; };
 };
 /** @brief SMOML ion drag model due to collisions of dust with ions
@@ -52,7 +54,7 @@ struct SOMLIonDrag:ForceTerm{
  */
 struct SMOMLIonDrag:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "SMOMLIonDrag"; };
 };
 /** @brief DTOKS ion drag model due to collisions of dust with ions
@@ -60,7 +62,7 @@ struct SMOMLIonDrag:ForceTerm{
 */
 struct DTOKSIonDrag:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "DTOKSIonDrag"; };
 };
 /** @brief DUSTT ion drag model due to collisions of dust with ions
@@ -68,7 +70,7 @@ struct DTOKSIonDrag:ForceTerm{
  */
 struct DUSTTIonDrag:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "DUSTTIonDrag"; };
 };
 /** @brief Hybrid ion drag model due to collisions of dust with ions
@@ -76,7 +78,7 @@ struct DUSTTIonDrag:ForceTerm{
  */
 struct HybridIonDrag:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "HybridIonDrag"; };
 };
 /** @brief Lloyd ion drag model due to collisions of dust with ions
@@ -84,7 +86,7 @@ struct HybridIonDrag:ForceTerm{
  */
 struct LloydIonDrag:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "LloydIonDrag"; };
 };
 
@@ -93,19 +95,33 @@ struct LloydIonDrag:ForceTerm{
  */
 struct NeutralDrag:ForceTerm{
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "NeutralDrag"; };
 };
 /** @brief Neutral drag due to collisions of dust with neutrals
+ *
+ *  Holds the temperature of the dust when it was last evaluated, so each
+ *  ForceModel evaluates its own copy.
  *  @return The acceleration in m/s^2 due to the Rocket force
  */
 struct RocketForce:ForceTerm{
-    double OldTemp;
+    double OldTemp; //!< K, temperature at the last evaluation
+    RocketForce():OldTemp(0.0){}
     threevector Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, threevector velocity);
+        const PlasmaData &Pdata, threevector velocity);
     std::string PrintName(){ return "RocketForce"; };
+    ForceTerm *clone()const{ return new RocketForce(*this); }
+    void write_state(CheckpointWriter &out)const;
+    void read_state(CheckpointReader &in);
 };
 ///@}
+
+typedef TermKernel<ForceTerm,threevector,threevector> ForceKernel;
+
+/** @brief The statically dispatched kernel of the force terms \p terms
+ *  @return the kernel, NULL if no kernel is registered for \p terms
+ */
+const ForceKernel *find_forcekernel(const std::vector<ForceTerm*> &terms);
 }
 
 #endif /* __FORCETERMS_H_INCLUDED__ */
@@ -20,16 +20,18 @@
 #include <math.h>
 #include <stdio.h>
 #include <exception>
+#include <atomic>
 
 /** @brief Warning Message to be printed only once
  *  
  *  Function to print warning message to the screen only once. This is 
- *  achieved by passing a static bool variable which is set to true. By default
- *  the \p Message is preceeded by a warning string.
+ *  achieved by passing a static atomic bool variable which is set to true, so
+ *  that the message is printed once even when several threads reach it. By
+ *  default the \p Message is preceeded by a warning string.
  *  @param MessageNotDisplayed is true if the message has yet to be displayed
  *  @param Message is the message to be displayed,
  */
-void WarnOnce(bool &MessageNotDisplayed, std::string Message);
+void WarnOnce(std::atomic<bool> &MessageNotDisplayed, std::string Message);
 
 // Empirical fit to secondary electron emission equation as in Stangeby
 double sec(double Te, char material);
@@ -42,6 +42,7 @@ class Graphite: public Matter{
         ~Graphite(){};
         
         double probe_vapourpressure(double Temperature)const;
+        Matter* clone()const override{ return new Graphite(*this); }
 };
 
 #endif /* __GRAPHITE_H_INCLUDED__ */
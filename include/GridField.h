@@ -0,0 +1,120 @@
+/** @file GridField.h
+ *  @brief Contiguous storage for a field defined across the plasma grid
+ *
+ *  Template container storing one value per cell of a rectangular plasma grid
+ *  in a single, cache-line aligned, row-major block of memory. Rows are
+ *  exposed through operator[] so that existing field[i][k] indexing works.
+ *  A field can also view memory it does not own, such as a read-only mapped
+ *  file, which may then only be read through a const field.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __GRIDFIELD_H_INCLUDED__
+#define __GRIDFIELD_H_INCLUDED__
+
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <new>
+#include <algorithm>
+#include <memory>
+
+//!< Alignment in bytes of the start of every grid field, one cache line
+const std::size_t GridAlignment = 64;
+
+/** @class GridField
+ *  @brief Flat, aligned, row-major array of Nx by Nz values of type T
+ *
+ *  Element (i,k) is stored at offset i*Nz+k so that field[i] returns a
+ *  pointer to row i and field[i][k] the value in cell (i,k). T must be
+ *  trivially copyable, memory is allocated with GridAlignment. A view, see
+ *  the mapping constructor, holds \p Mapping instead of owning \p Data and
+ *  copies of it own their memory. A view is const only, the non-const
+ *  accessors assert that the field owns its memory.
+ */
+template<typename T> class GridField{
+    private:
+        int Nx;     //!< Number of rows, cells in the x direction
+        int Nz;     //!< Number of columns, cells in the z direction
+        T *Data;    //!< Aligned block of Nx*Nz values
+        std::shared_ptr<const void> Mapping; //!< Keeps the data of a view
+
+        void allocate(){
+            Data = nullptr;
+            if( Nx*Nz == 0 ) return;
+            void *Block = nullptr;
+            if( posix_memalign(&Block,GridAlignment,Nx*Nz*sizeof(T)) != 0 )
+                throw std::bad_alloc();
+            Data = static_cast<T*>(Block);
+        }
+
+    public:
+        GridField():Nx(0),Nz(0),Data(nullptr){}
+
+        /** @brief Allocate a grid of \p nx by \p nz cells set to \p value
+         *  @param nx the number of cells in the x direction
+         *  @param nz the number of cells in the z direction
+         *  @param value the initial value of every cell
+         */
+        GridField(int nx, int nz, const T &value = T()):Nx(nx),Nz(nz){
+            allocate();
+            std::fill(Data,Data+Nx*Nz,value);
+        }
+
+        /** @brief View \p nx by \p nz cells of memory owned by \p mapping
+         *
+         *  The memory must stay valid while \p mapping is held and may be
+         *  read-only, so the view may only be read through const accessors.
+         *  @param nx the number of cells in the x direction
+         *  @param nz the number of cells in the z direction
+         *  @param data the first cell, aligned to GridAlignment
+         *  @param mapping handle keeping \p data valid
+         */
+        GridField(int nx, int nz, const T *data, 
+        std::shared_ptr<const void> mapping):Nx(nx),Nz(nz),
+        Data(const_cast<T*>(data)),Mapping(std::move(mapping)){
+            assert( Mapping && "GridField: a view needs its mapping" );
+        }
+
+        GridField(const GridField &other):Nx(other.Nx),Nz(other.Nz){
+            allocate();
+            if( Data ) std::memcpy(Data,other.Data,Nx*Nz*sizeof(T));
+        }
+
+        GridField(GridField &&other):Nx(other.Nx),Nz(other.Nz),
+        Data(other.Data),Mapping(std::move(other.Mapping)){
+            other.Nx = 0; other.Nz = 0; other.Data = nullptr;
+        }
+
+        GridField &operator=(GridField other){
+            std::swap(Nx,other.Nx);
+            std::swap(Nz,other.Nz);
+            std::swap(Data,other.Data);
+            std::swap(Mapping,other.Mapping);
+            return *this;
+        }
+
+        ~GridField(){ if( !Mapping ) free(Data); }
+
+        T *operator[](int i){
+            assert( !Mapping && "GridField: writing to a read-only view" );
+            return Data+i*Nz;
+        }
+        const T *operator[](int i)const{ return Data+i*Nz; }
+
+        T *data(){
+            assert( !Mapping && "GridField: writing to a read-only view" );
+            return Data;
+        }
+        const T *data()const{ return Data; }
+        const int get_nx()const{ return Nx; }
+        const int get_nz()const{ return Nz; }
+        const int size()const{ return Nx*Nz; }
+        const bool empty()const{ return Data == nullptr; }
+        //!< Whether the field views memory it does not own
+        bool is_view()const{ return Mapping != nullptr; }
+};
+
+#endif /* __GRIDFIELD_H_INCLUDED__ */
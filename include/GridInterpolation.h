@@ -0,0 +1,67 @@
+/** @file GridInterpolation.h
+ *  @brief Functions interpolating the plasma grid to the dust position
+ *
+ *  Bilinear and bicubic (Catmull-Rom) interpolation of the packed plasma
+ *  parameters of a PlasmaGrid_Data structure, including the derived electric
+ *  field and plasma velocity. Grid spacings in the x and z directions are 
+ *  treated independently so dlx and dlz may differ. Stencils crossing the 
+ *  edge of the plasma (cells with differing gridflag) are identified once, 
+ *  when the grid is built, and fall back to the nearest cell.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __GRIDINTERPOLATION_H_INCLUDED__
+#define __GRIDINTERPOLATION_H_INCLUDED__
+
+#include "PlasmaData.h"
+
+//!< Interpolation schemes, set by PlasmaGrid_Data::interpolation
+namespace Interpolation{
+    const char Nearest  = 'n';  //!< Value of nearest grid cell
+    const char Bilinear = 'l';  //!< Bilinear over the 2x2 surrounding cells
+    const char Bicubic  = 'c';  //!< Catmull-Rom over the 4x4 surrounding cells
+
+    const char BilinearStencil = 0x1; //!< Bit set if 2x2 stencil is valid
+    const char BicubicStencil  = 0x2; //!< Bit set if 4x4 stencil is valid
+}
+
+/** @brief Determine the interpolation stencils valid at every cell of \p pgrid
+ *
+ *  A stencil with lower left corner (i,k) is valid if it lies within the grid
+ *  and all of its cells share the same gridflag. Must be called after
+ *  pack_plasmacells() and before the grid is shared with any models.
+ *  @param pgrid the plasma grid for which stencils are built
+ */
+void build_stencils(PlasmaGrid_Data &pgrid);
+
+/** @brief Interpolate the packed plasma parameters of \p pgrid at (\p x,\p z)
+ *
+ *  Uses the scheme given by pgrid.interpolation. Falls back from bicubic to
+ *  bilinear where only the smaller stencil is valid. Positive definite
+ *  quantities (temperatures and densities) are limited to the range of the
+ *  surrounding four cells so that the bicubic scheme cannot overshoot.
+ *  @param pgrid the plasma grid to be interpolated
+ *  @param x position of dust in x direction (m)
+ *  @param z position of dust in z direction (m)
+ *  @param cell the interpolated plasma parameters
+ *  @return false if no valid stencil exists and \p cell is unchanged
+ */
+bool interpolate_plasmacell(const PlasmaGrid_Data &pgrid, double x, double z,
+    PlasmaCell &cell);
+
+/** @brief Number of grid cells a grain may cross in one step for \p scheme
+ *
+ *  The plasma is interpolated once per time step, so every stage of a step
+ *  sees the plasma at its start. Without interpolation the plasma is
+ *  discontinuous between cells and steps must not exceed half a cell. With
+ *  interpolation a step may cross at most one cell, so that the stages stay
+ *  within the stencil the plasma was interpolated over and cannot jump past
+ *  a wall or core boundary.
+ *  @param scheme the interpolation scheme used
+ *  @return the fraction of a grid cell which may be crossed per time step
+ */
+double cells_per_step(char scheme);
+
+#endif /* __GRIDINTERPOLATION_H_INCLUDED__ */
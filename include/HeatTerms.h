@@ -10,6 +10,7 @@
 
 #include "Term.h"
 #include "PlasmaFluxes.h"
+#include "TermKernel.h"
 
 namespace Term{
 
@@ -26,112 +27,119 @@ namespace Term{
 /** @brief Power to surface due to black body radiation
  */
 struct EmissivityModel:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "EmissivityModel"; };
 };
 /** @brief Power to surface due evaporative loss of particles
  */
 struct EvaporationModel:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "EvaporationModel"; };
 };
 /** @brief Power to surface due to contact with air
  */
 struct NewtonCooling:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "NewtonCooling"; };
 };
 /** @brief Power to surface due to neutral bombardment
  */
 struct NeutralHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "NeutralHeatFlux"; };
 };
 /** @brief Power to surface due to SOML ion bombardment 
  */
 struct SOMLIonHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "SOMLIonHeatFlux"; };
 };
 /** @brief Power to surface due to SOML neutral recombination
  */
 struct SOMLNeutralRecombination:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "SOMLNeutralRecombination"; };
 };
 /** @brief Power to surface due to SMOML ion bombardment 
  */
 struct SMOMLIonHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "SMOMLIonHeatFlux"; };
 };
 /** @brief Power to surface due to SMOML neutral recombination
  */
 struct SMOMLNeutralRecombination:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "SMOMLNeutralRecombination"; };
 };
 /** @brief Power to surface due to secondary electron emission
  */
 struct SEE:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "SEE"; };
 };
 /** @brief Power to surface due to thermionic electron emission
  */
 struct TEE:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "TEE"; };
 };
 /** @brief Power to surface due to PHL electron bombardment 
  */
 struct PHLElectronHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "PHLElectronHeatFlux"; };
 };
 /** @brief Power to surface due to OML electron bombardment 
  */
 struct OMLElectronHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "OMLElectronHeatFlux"; };
 };
 /** @brief Power to surface due to DTOKS secondary electron emission
  */
 struct DTOKSSEE:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "DTOKSSEE"; };
 };
 /** @brief Power to surface due to DTOKS secondary electron emission
  */
 struct DTOKSTEE:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "DTOKSTEE"; };
 };
 /** @brief Power to surface due to DTOKS ion bombardment 
  */
 struct DTOKSIonHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "DTOKSIonHeatFlux"; };
 };
 /** @brief Power to surface due to DTOKS neutral recombination
  */
 struct DTOKSNeutralRecombination:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "DTOKSNeutralRecombination"; };
 };
 /** @brief Power to surface due to DTOKS electron bombardment 
  */
 struct DTOKSElectronHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "DTOKSElectronHeatFlux"; };
 };
 /** @brief Power to surface due to DUSTT ion bombardment 
  */
 struct DUSTTIonHeatFlux:HeatTerm{
-    double Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    double Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature);
     std::string PrintName(){ return "DUSTTIonHeatFlux"; };
 };
 ///@}
+
+typedef TermKernel<HeatTerm,double,double> HeatKernel;
+
+/** @brief The statically dispatched kernel of the heat terms \p terms
+ *  @return the kernel, NULL if no kernel is registered for \p terms
+ */
+const HeatKernel *find_heatkernel(const std::vector<HeatTerm*> &terms);
 }
 
 #endif /* __HEATTERMS_H_INCLUDED__ */
\ No newline at end of file
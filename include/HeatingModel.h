@@ -10,9 +10,34 @@
 #ifndef __HEATINGMODEL_H_INCLUDED__
 #define __HEATINGMODEL_H_INCLUDED__
 
+#include <array>
+
 #include "Model.h"
 #include "HeatTerms.h"
 
+/** @brief The state of the dust and plasma read by the heat terms
+ *
+ *  Two evaluations of the heat terms with equal inputs give equal powers, so
+ *  these are recorded with the powers to decide when they can be reused.
+ */
+struct HeatTermInputs{
+    double DustTemperature; //!< K, Temperature the terms are evaluated at
+    double Temperature;     //!< K, Temperature of the sample
+    double Mass;            //!< kg
+    double SurfaceArea;     //!< m^2
+    double Emissivity;      //!< Arb
+    double VapourPressure;  //!< Pa
+    double Potential;       //!< Normalised potential
+    double DeltaSec;        //!< Arb
+    double DeltaTherm;      //!< Arb
+    double RE;              //!< Arb
+    double RN;              //!< Arb
+    bool Liquid;            //!< True if the sample is a liquid
+    double PowerIncident;   //!< kW, Background power
+    threevector Velocity;   //!< m s^-1
+    PlasmaData Pdata;       //!< Local plasma parameters
+};
+
 /** @class Model
  *  @brief Defines the heating models which affect the temperature of dust
  *  
@@ -26,19 +51,68 @@ class HeatingModel : public Model{
          *
          *  \p OldTemp and \p ThermalEquilibrium are used to determine the 
          *  thermal equilibrium condition. \p PowerIncident defines the
-         *  background power present.
+         *  background power present. \p PhaseData is set if the fusion and 
+         *  vapour energies are printed.
          */
         ///@{
         double OldTemp;
         double PowerIncident;
         bool ThermalEquilibrium;
+        bool PhaseData;
         ///@}
 
         /** @brief vector of heating terms defining the heating terms used
          */
         std::vector<HeatTerm*> HeatTerms;
 
+        /** @name Term slots
+         *  @brief Position in \p HeatTerms of terms needing special treatment,
+         *  -1 if unused. Set once by ClassifyTerms() so that the time stepping
+         *  compares no names.
+         */
+        ///@{
+        int EmissivityIndex;
+        int EvaporationIndex;
+        ///@}
+
+        /** @brief Statically dispatched kernel of \p HeatTerms, NULL if none
+         *  is registered and the terms are evaluated one virtual call at a time
+         */
+        const Term::HeatKernel *Kernel;
+
+        /** @brief Find the terms of \p HeatTerms needing special treatment
+         *  and their kernel
+         */
+        void ClassifyTerms();
+
+        /** @name Power breakdown
+         *  @brief Power of each heat term from the last call to CalculatePower
+         *
+         *  CalculatePower() records the power of every term in \p TermPowers
+         *  with the inputs they were evaluated with. While the inputs are 
+         *  unchanged the recorded powers are reused by CalculatePower(), 
+         *  Print() and ProbeTimeStep() rather than evaluating the terms again.
+         */
+        ///@{
+        //!< Most heat terms a model takes, std::length_error is thrown for more
+        static const unsigned int MaxHeatTerms = 32;
+        mutable std::array<double,MaxHeatTerms> TermPowers; //!< W, per term
+        mutable double CachedPower;         //!< kW, sum of TermPowers
+        mutable HeatTermInputs CachedInputs;//!< Inputs of TermPowers
+        mutable bool PowerCached;           //!< True if TermPowers are set
+        ///@}
+
+        /** @brief Record the current inputs to the heat terms in \p inputs
+         *  @param DustTemperature the temperature the terms are evaluated at
+         *  @param inputs the structure to be filled
+         */
+        void get_inputs(double DustTemperature, HeatTermInputs &inputs)const;
+
         /** @brief Print model data to ModelDataFile
+         *
+         *  One value is printed under each column named by CreateFile(). Heat
+         *  terms are printed in W from \p TermPowers, evaporation being zero
+         *  unless the sample is liquid.
          */
         void Print();
 
@@ -53,6 +127,10 @@ class HeatingModel : public Model{
         double RungeKutta4(double timestep);
 
         /** @brief Calculate the sum of all the heating models
+         *
+         *  The power of each term is left in \p TermPowers
+         *  @param DustTemperature the temperature of the dust
+         *  @return the total power in kW
          */
         double CalculatePower(double DustTemperature)const;
 
@@ -67,10 +145,10 @@ class HeatingModel : public Model{
             PlasmaData * pdata);
         HeatingModel( std::string filename, float accuracy, 
             std::vector<HeatTerm*> heatterms, Matter *& sample, 
-            PlasmaGrid_Data & pgrid);
+            std::shared_ptr<const PlasmaGrid_Data> pgrid);
         HeatingModel( std::string filename, float accuracy, 
             std::vector<HeatTerm*> heatterms, Matter *& sample, 
-            PlasmaGrid_Data & pgrid, PlasmaData &pdata);
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata);
 
         ~HeatingModel(){
         };
@@ -102,6 +180,12 @@ class HeatingModel : public Model{
         double ProbeTimeStep()const;
         double UpdateTimeStep();
 
+        /** @brief Also save the temperature of the last step, incident power,
+         *  thermal equilibrium and whether phase data is printed
+         */
+        void write_checkpoint(CheckpointWriter &out)const override;
+        void read_checkpoint(CheckpointReader &in) override;
+
         /** @name Public getter methods
          *  @brief functions required to get member data
          *  
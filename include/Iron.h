@@ -42,6 +42,7 @@ class Iron : public Matter{
         ~Iron(){};
         
         double probe_vapourpressure(double Temperature)const;
+        Matter* clone()const override{ return new Iron(*this); }
 };
 
 #endif /* __IRON_H_INCLUDED__ */
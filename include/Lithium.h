@@ -41,6 +41,7 @@ class Lithium: public Matter{
         ~Lithium(){};
         
         double probe_vapourpressure(double Temperature)const;
+        Matter* clone()const override{ return new Lithium(*this); }
 };
 
 #endif /* __LITHIUM_H_INCLUDED__ */
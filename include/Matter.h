@@ -31,8 +31,7 @@
 #define MinMass 10e-25 
 
 #include <iostream>       //!< I/O operations and debugging
-#include <fstream>        //!< Open emissivity filestream
-#include <sstream>        //!< Convert temp to file number
+#include <sstream>        //!< std::stringstream
 #include <assert.h>       //!< Assertion errors
 #include <math.h>         //!< Round
 #include <array>          //!< std::array
@@ -42,6 +41,9 @@
 #include "GrainStructs.h" //!< Contains the structures for material properties
 #include "Constants.h"    //!< Contains general physical constants
 #include "Functions.h"    //!< sec(Te,'f') function used by HeatingModel.cpp
+#include "EmissivityTable.h" //!< Tabulated emissivity data
+#include "PropertyTable.h"   //!< Tabulated heat capacity and vapour pressure
+#include "Checkpoint.h"      //!< Saving and restoring the grain state
 
 //!< Constant model number, the number of constant models
 const unsigned int CM = 5;
@@ -88,6 +90,31 @@ class Matter{
         double PreBoilMass;              
         //<! Constant Models variation with Temperature turned on of possibly CM
         std::array<char,CM> ConstModels;
+        //<! Emissivity data of the element, shared by all grains
+        std::shared_ptr<const EmissivityTable> Emissivities;
+
+        /** @name Change tracking
+         *  @brief Inputs of the properties as they were last refreshed
+         *
+         *  update() only refreshes the properties whose inputs have changed by
+         *  more than \p UpdateTolerance since they were last refreshed, see
+         *  set_updatetolerance().
+         */
+        ///@{
+        //<! Inputs of update_dim(), mass and the inputs of thermal expansion
+        struct{ double Temperature, Mass, FusionEnergy; } DimInputs;
+        //<! Inputs of the heat capacity, emissivity, vapour pressure and
+        //<! boiling temperature
+        struct{ double Temperature, Radius; bool Liquid, Gas; } StateInputs;
+        //<! Every property must be refreshed by the next update()
+        bool Stale;
+        //<! Largest relative change of an input not refreshed by update()
+        double UpdateTolerance;
+        //<! Whether \p now has moved from \p then beyond \p UpdateTolerance
+        bool changed(double now, double then)const{
+            return !(fabs(now-then) <= UpdateTolerance*fabs(then));
+        }
+        ///@}
         
     protected: //<! Functions used by the elements inheriting Matter.
 
@@ -259,7 +286,9 @@ class Matter{
          *  Call the functions update_dim(), update_heatcapacity(), 
          *  update_emissivity(), update_vapourpressure() and 
          *  update_boilingtemp() in the order. Also check if rotational 
-         *  breakup has occured
+         *  breakup has occured. Dimensions are only refreshed when the mass,
+         *  or with variable expansion the temperature, has changed, and the
+         *  other properties only when the temperature, radius or phase has.
          *  @see update_dim()
          *  @see update_heatcapacity()
          *  @see update_emissivity()
@@ -317,7 +346,7 @@ class Matter{
          *  breakup
          *  @param NewData the new state of the matter being considered
          */
-        void set_graindata(GrainData &NewData){ St = NewData; };
+        void set_graindata(GrainData &NewData){ St = NewData; Stale = true; };
         /** @brief Set the potential
          *  
          *  Fix potential to the value \p potential
@@ -333,6 +362,7 @@ class Matter{
         { 
             assert(mass > MinMass*10); 
             St.Mass = mass;   
+            Stale = true;
         };
         /** @brief Set the restitution coefficients
          * 
@@ -341,6 +371,18 @@ class Matter{
          *  @param rn the fraction of backscattered particles
          */
         void set_rern(double re, double rn){ St.RE = re; St.RN = rn; };
+        /** @brief Set the tolerance of update()
+         *
+         *  update() leaves properties as they are while the relative changes
+         *  of their inputs since they were last refreshed are all within
+         *  \p tolerance. Zero, the default, refreshes on any change.
+         *  @param tolerance the largest relative change ignored
+         */
+        void set_updatetolerance(double tolerance)
+        {
+            assert(tolerance >= 0.0);
+            UpdateTolerance = tolerance;
+        };
         /** @brief Set Breakup to false
          *  
          *  Implemented by DTOKSU_Manager to set breakup flag to false
@@ -406,7 +448,40 @@ class Matter{
          */
         virtual double probe_vapourpressure (double Temperature)const=0;
         ///@}
+
+        /** @brief Create a copy of this grain, of the same element
+         *
+         *  The copy is independent of this grain, as needed to follow each
+         *  fragment of a breakup separately.
+         *  @return pointer to a new Matter object, owned by the caller
+         */
+        virtual Matter* clone               ()const=0;
+
+        /** @name Checkpoints
+         *  @brief Save and restore the state of the grain
+         *
+         *  The state includes the inputs each property was last refreshed
+         *  for, so that a restored grain refreshes them exactly as the
+         *  original would have. The models and tolerance of update() are
+         *  configuration and are not saved.
+         */
+        ///@{
+        void write_checkpoint(CheckpointWriter &out)const;
+        /** @brief Restore the state written by write_checkpoint()
+         *
+         *  Fails \p in if it was written by a grain of another element.
+         */
+        void read_checkpoint(CheckpointReader &in);
+        ///@}
 };
 
+/** @name GrainData checkpoints
+ *  @brief Write and read every field of a GrainData
+ */
+///@{
+CheckpointWriter &operator<<(CheckpointWriter &out, const GrainData &gd);
+CheckpointReader &operator>>(CheckpointReader &in, GrainData &gd);
+///@}
+
 #endif /* __MATTER_H_INCLUDED__ */
 
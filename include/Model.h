@@ -9,7 +9,6 @@
  *  @bug bugs, they definitely exist
  *  @bug Default structures should exist within a namespace
  *  @bug Consider encapsulating plasma data information in a separate class
- *  @bug InterpolatePlasmadata() is broken and only works for square grid
  */
 
 #ifndef __MODEL_H_INCLUDED__
@@ -19,6 +18,7 @@
 #include <iomanip> //!< std::ofstream::setprecision()
 
 #include "PlasmaData.h"
+#include "DataSink.h"
 #include "Iron.h"
 #include "Tungsten.h"
 #include "Graphite.h"
@@ -56,23 +56,29 @@ static struct PlasmaData PlasmaDataDefaults = {
  */
 static struct PlasmaGrid_Data PlasmaGrid_DataDefaults = {
     // Plasma Parameters
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<double> >(),
-    std::vector< std::vector<int> > (),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<double>(),
+    GridField<int>(),
+    GridField<PlasmaCell>(),
+    GridField<char>(),
 
     251,
     401,
@@ -97,18 +103,25 @@ class Model{
         /** @brief Shared_ptr to structure containing all plasma grid data
          *
          *  This structure contains the plasma parameters for a regular 
-         *  rectangular grid within which the dust grain exists
+         *  rectangular grid within which the dust grain exists. The grid is
+         *  read-only and shared between every model using it, only the mass
+         *  deposition record PG_data->dm is written to.
          */
-        std::shared_ptr<PlasmaGrid_Data> PG_data;
+        std::shared_ptr<const PlasmaGrid_Data> PG_data;
+
+        /** @brief Record of the mass lost by the grain, if not that of the
+         *  plasma grid, PG_data->dm. See set_deposition()
+         */
+        std::shared_ptr<MassDeposition> Deposition;
         
-        /** @name Grid coordinates of dust
-         *  @brief information regarding dust coordinates
+        /** @name Local plasma state of dust
+         *  @brief information regarding dust coordinates and plasma
          *
          *  Dust coordinates within two cylindrical dimensions of plasma grid
+         *  and the plasma parameters there, shared by all models of a DTOKSU
          */
         ///@{
-        int i; // r Position of dust
-        int k; // z Position of dust
+        std::shared_ptr<LocalPlasmaState> State;
         double OldMass; // Place Holder for old mass
         ///@}
 
@@ -144,8 +157,9 @@ class Model{
         /** @brief update fields in PlasmaData from PlasmaGrid at dust grain
          *  @param i grid coordinate of dust in x direction
          *  @param k grid coordinate of dust in z direction
+         *  @param local the plasma parameters at the dust grain
          */
-        void update_fields(int i, int k);
+        void update_fields(int i, int k, const PlasmaCell &local);
         ///@}
 
     protected:
@@ -162,6 +176,8 @@ class Model{
          */
         Matter *Sample;                    
         /** @brief Data structure containing local plasma parameters
+         *
+         *  Refers to State->Pdata, so is shared with any model sharing State
          */
         std::shared_ptr<PlasmaData> Pdata;
         /** @brief Determines the accuracy to which the model is calculated
@@ -181,10 +197,10 @@ class Model{
         std::string FileName;
         /** @brief Data file where data relevant to physics model is printed
          */
-        std::ofstream ModelDataFile;
+        DataSink ModelDataFile;
         /** @brief Data file where plasma data is printed
          */
-        std::ofstream PlasmaDataFile;
+        DataSink PlasmaDataFile;
         ///@}
 
         /** @name Pure virtual functions
@@ -293,8 +309,8 @@ class Model{
          *  @param pgrid the spatial grid over which plasma parameters are given
          *  @param accuracy the accuracy to which the model is calculated
          */
-        Model(std::string filename, Matter *& sample, PlasmaGrid_Data &pgrid, 
-            float accuracy);
+        Model(std::string filename, Matter *& sample, 
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, float accuracy);
 
         /** @brief PlasmaData and PlasmaGrid constructor.
          *
@@ -307,12 +323,27 @@ class Model{
          *  @param pdata the spatially continuous plasma paramater data
          *  @param accuracy the accuracy to which the model is calculated
          */
-        Model(std::string filename, Matter *& sample, PlasmaGrid_Data &pgrid, 
-            PlasmaData &pdata, float accuracy );
+        Model(std::string filename, Matter *& sample, 
+            std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata, 
+            float accuracy );
+
+        /** @brief Copy constructor.
+         *
+         *  The copy has its own local plasma state, starting from that of
+         *  \p other, and data files of the same format which are not open.
+         *  It acts on the same Matter as \p other until set_sample() is called.
+         *  @param other the model to be copied
+         */
+        Model(const Model &other);
         ///@}
 
         virtual ~Model(){};
 
+        /** @brief act on the Matter \p sample from now on
+         *  @param sample the matter class which this model is acting on
+         */
+        void set_sample(Matter *sample){ Sample = sample; }
+
         /** @name Public getter methods
          *  @brief functions required to get member data
          */
@@ -324,6 +355,7 @@ class Model{
         double get_totaltime          ()const{ return TotalTime;    }
         double get_timestep           ()const{ return TimeStep;     }   
         const double get_dlx          ()const{ return PG_data->dlx; }
+        const double get_gridstep     ()const;
         ///@}
 
         /** @brief Determine whether the particle has entered a new cell
@@ -332,7 +364,11 @@ class Model{
         bool new_cell                 ()const;
 
         /** @brief Write local plasma parameters to \p PlasmaDataFile
-         *  @param filename location to write to
+         *
+         *  The file is opened on the first call and kept open, rows are 
+         *  appended to it while \p filename is unchanged.
+         *  @param filename location to write to, within Data/ and without 
+         *  extension
          */
         void RecordPlasmadata(std::string filename); // Record the plasma Data   
 
@@ -341,10 +377,42 @@ class Model{
          */
         void set_plasmadata(PlasmaData &pdata);
 
-        /** @brief set the plasma grid to the data structure passed
+        /** @brief observe the local plasma state \p state of another model
+         *
+         *  Models sharing a state need only one of them to update it with
+         *  update_plasmadata() each step.
+         *  @param state the local plasma state to be shared
+         */
+        void share_localstate(std::shared_ptr<LocalPlasmaState> state);
+
+        /** @brief get the local plasma state of this model
+         *  @return shared pointer to the local plasma state
+         */
+        std::shared_ptr<LocalPlasmaState> get_localstate()const{ 
+            return State;
+        }
+
+        /** @brief share the plasma grid referred to by the handle passed
          *  @param pgrid set the \p PG_data to \p pgrid
          */
-        void set_plasmagrid(PlasmaGrid_Data &pgrid);
+        void set_plasmagrid(std::shared_ptr<const PlasmaGrid_Data> pgrid);
+
+        /** @brief record the mass lost by the grain in \p deposition
+         *
+         *  Lets a simulation keep its deposition apart from that of others
+         *  sharing the grid, to be merged in a fixed order later.
+         *  @param deposition a grid of the size of the plasma grid, or null
+         *  to record on PG_data->dm again
+         */
+        void set_deposition(std::shared_ptr<MassDeposition> deposition){
+            Deposition = deposition;
+        }
+        /** @brief the record the mass lost by the grain is added to
+         *  @return null if the plasma grid has no deposition record
+         */
+        MassDeposition *get_deposition()const{
+            return Deposition ? Deposition.get() : PG_data->dm.get();
+        }
         
         /** @brief if not a continuous plasma, update the plasma from PlasmaGrid
          *  @see locate()
@@ -360,12 +428,22 @@ class Model{
          */
         void close_file();
 
+        /** @brief Set the format and flush interval of files created after
+         *  @param format the output format, Output::Text or Output::Binary
+         *  @param flushinterval the number of rows buffered between writes
+         */
+        void set_output(char format, unsigned int flushinterval);
+
         /** @brief add to \p TotalTime, used to get correct timing across models
          *  @param T the time to be added to \p TotalTime
          */
         void AddTime(double T){ TotalTime = TotalTime + T;  }
 
-        /** @brief Record in the PlasmaGrid the amount of mass lost
+        /** @brief Add to the PlasmaGrid deposition the amount of mass lost
+         *
+         *  The deposition record is shared by every model using the grid,
+         *  unless set by set_deposition(), and is safe to call from
+         *  concurrently running simulations
          */
         void Record_MassLoss();
 
@@ -373,6 +451,29 @@ class Model{
          */
         void ImpurityPrint();
 
+        /** @name Checkpoints
+         *  @brief Save and restore the state of the model
+         *
+         *  The state of a model is its times, local plasma state and data
+         *  files, to which derived models add their own. Caches are not saved,
+         *  they are refilled with the same values after a restore.
+         */
+        ///@{
+        virtual void write_checkpoint(CheckpointWriter &out)const;
+        virtual void read_checkpoint(CheckpointReader &in);
+        /** @brief Write the mass deposited in every cell of the plasma grid
+         *
+         *  Writes the record of get_deposition(), so is only meaningful if
+         *  no other simulation deposits on the same record.
+         */
+        void write_deposition(CheckpointWriter &out)const;
+        /** @brief Replace the deposition by that of write_deposition()
+         *
+         *  Fails \p in if it was written for a grid of another size.
+         */
+        void read_deposition(CheckpointReader &in);
+        ///@}
+
         // Functions for printing, these haven't been validated yet
         // Print the inside and the outside of the tokamak 
         //void vtkcircle(double r, std::ofstream &fout); 
@@ -383,13 +484,3 @@ class Model{
 };
 
 #endif /* __MODEL_H_INCLUDED__ */
-
-/** @brief Calculate interpolated plasma parameters at dust position
- *
- *  Attempt to mutate the mean value plasma parameters at the dust 
- *  position
- *  @bug This doesn't work for a non-square grid, or generally
- *  @param i grid coordinate of dust in x direction
- *  @param k grid coordinate of dust in z direction
- */
-//const void interpolatepdata(const int i,const int k)const;
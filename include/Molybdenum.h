@@ -43,6 +43,7 @@ class Molybdenum: public Matter{
         ~Molybdenum(){};
         
         double probe_vapourpressure(double Temperature)const;
+        Matter* clone()const override{ return new Molybdenum(*this); }
 };
 
 #endif /* __MOLYBDENUM_H_INCLUDED__ */
@@ -14,8 +14,12 @@
 #define __PLASMADATA_H_INCLUDED__
 
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <cassert>
 
 #include "threevector.h"
+#include "GridField.h"
 
 //!< Maximum values for plasma parameters
 namespace Overflows{
@@ -34,6 +38,22 @@ namespace Underflows{
     const double Field = 0.0;
 }
 
+/** @brief Quantities depending only on the plasma parameters of a PlasmaData
+ *
+ *  The fluxes and terms are evaluated many times per step, by every RK stage
+ *  and root finding iteration, while the plasma is fixed. These are computed
+ *  once by derive_plasmadata() whenever the plasma parameters change.
+ */
+struct DerivedPlasmaQuantities{
+    double DebyeLength;         //!< m, Electron Debye length
+    double IonThermalSpeed;     //!< m s^-1, sqrt(2*Kb*Ti/mi)
+    double ElectronThermalFlux; //!< m^-2 s^-1, ne*sqrt(Kb*Te/(2*PI*Me))
+    double IonThermalFlux;      //!< m^-2 s^-1, ni*sqrt(Kb*Ti/(2*PI*mi))
+    double NeutralThermalFlux;  //!< m^-2 s^-1, nn*sqrt(Kb*Tn/(2*PI*mi))
+    double TiTe;                //!< Ion to electron temperature ratio
+    double MOMLPotential;       //!< 0.5*log(2*PI*(1+5*Ti/(3*Te))*Me/mi)
+};
+
 /** @brief Structure containing all the information defining the plasma 
  * conditions in the immediate surroundings of the dust grain 
  */
@@ -54,6 +74,118 @@ struct PlasmaData{
     threevector Gravity;       //!< m s^-2, Acceleration due to gravity
     threevector ElectricField; //!< V m^-1, Electric field at dust location
     threevector MagneticField; //!< T, Magnetic field at dust location
+
+    //!< Set by derive_plasmadata() from the parameters above
+    DerivedPlasmaQuantities Derived;
+};
+
+/** @brief Compute the derived quantities of \p pdata from its parameters
+ *
+ *  Must be called whenever the densities, temperatures or ion mass of 
+ *  \p pdata change, before it is passed to any flux or term.
+ *  @param pdata the plasma data to be updated
+ */
+inline void derive_plasmadata(PlasmaData &pdata){
+    DerivedPlasmaQuantities &Derived = pdata.Derived;
+    Derived.DebyeLength = sqrt((epsilon0*Kb*pdata.ElectronTemp)
+        /(pdata.ElectronDensity*echarge*echarge));
+    Derived.IonThermalSpeed = sqrt((2.0*Kb*pdata.IonTemp)/pdata.mi);
+    Derived.ElectronThermalFlux = pdata.ElectronDensity
+        *sqrt(Kb*pdata.ElectronTemp/(2*PI*Me));
+    Derived.IonThermalFlux = pdata.IonDensity
+        *sqrt(Kb*pdata.IonTemp/(2*PI*pdata.mi));
+    Derived.NeutralThermalFlux = pdata.NeutralDensity
+        *sqrt(Kb*pdata.NeutralTemp/(2*PI*pdata.mi));
+    Derived.TiTe = pdata.IonTemp/pdata.ElectronTemp;
+    Derived.MOMLPotential = 0.5*log((2.0*PI*Me/pdata.mi)
+        *(1.0+(5.0/3.0)*Derived.TiTe));
+}
+
+/** @brief The plasma conditions at the dust grain and its position in the 
+ * plasma grid. Updated once per step and observed by every model acting on
+ * the grain.
+ */
+struct LocalPlasmaState{
+    PlasmaData Pdata; //!< Plasma parameters at the dust grain
+    int i;            //!< r Position of dust in plasma grid
+    int k;            //!< z Position of dust in plasma grid
+    bool InGrid;      //!< True if the dust is within the plasma grid
+};
+
+/** @brief Thread-safe accumulator for the mass deposited in every cell of a
+ * plasma grid. Shared between all models and simulations which use the same
+ * grid so that concurrent dust trajectories can record their mass loss
+ * without copying or locking the grid itself.
+ */
+class MassDeposition{
+    private:
+        int Nx;                                 //!< Number of cells in x
+        int Nz;                                 //!< Number of cells in z
+        std::unique_ptr<std::atomic<double>[]> Mass; //!< kg, Mass in cells
+
+    public:
+        MassDeposition(int gridx, int gridz):
+        Nx(gridx),Nz(gridz),Mass(new std::atomic<double>[gridx*gridz]){
+            for( int n = 0; n < Nx*Nz; n ++ )
+                Mass[n].store(0.0,std::memory_order_relaxed);
+        }
+
+        /** @brief Atomically add mass dm to cell (i,k)
+         *  @param i the cell index in the x direction
+         *  @param k the cell index in the z direction
+         *  @param dm the mass to be added in kg
+         */
+        void add(int i, int k, double dm){
+            if( i < 0 || i >= Nx || k < 0 || k >= Nz ) return;
+            std::atomic<double> &Cell = Mass[i*Nz+k];
+            double Old = Cell.load(std::memory_order_relaxed);
+            while( !Cell.compare_exchange_weak(Old,Old+dm,
+                std::memory_order_relaxed) );
+        }
+
+        /** @brief Set the mass of cell (i,k), as when restoring a checkpoint
+         */
+        void set(int i, int k, double m){
+            Mass[i*Nz+k].store(m,std::memory_order_relaxed);
+        }
+
+        const double get(int i, int k)const{
+            return Mass[i*Nz+k].load(std::memory_order_relaxed);
+        }
+
+        /** @brief Add the mass of every cell of \p other, a grid of the same
+         *  size, as when gathering the depositions of separate trajectories
+         */
+        void merge(const MassDeposition &other){
+            assert(other.Nx == Nx && other.Nz == Nz);
+            for( int n = 0; n < Nx*Nz; n ++ )
+                add(n/Nz,n%Nz,other.Mass[n].load(std::memory_order_relaxed));
+        }
+        const int get_gridx()const{ return Nx; }
+        const int get_gridz()const{ return Nz; }
+};
+
+/** @brief Packed record of the plasma parameters in one cell of the grid
+ *
+ *  The fields read together on every plasma grid lookup, stored side by side
+ *  so that a lookup touches at most two cache lines. The electric field and
+ *  plasma velocity are the derived fields, computed once when the grid loads
+ */
+struct alignas(GridAlignment) PlasmaCell{
+    double Te;    //!< K, Electron temperature
+    double Ti;    //!< K, Ion temperature
+    double na0;   //!< m^-3, Ion density
+    double na1;   //!< m^-3, Electron density
+    double na2;   //!< m^-3, Neutral density
+    double bx;    //!< T, Mang field, x direction
+    double by;    //!< T, Mang field, y direction
+    double bz;    //!< T, Mang field, z direction
+    double Er;    //!< V m^-1, Electric field, x direction
+    double Ez;    //!< V m^-1, Electric field, z direction
+    double vpx;   //!< m s^-1, Plasma vel parallel to B, x direction
+    double vpy;   //!< m s^-1, Plasma vel parallel to B, y direction
+    double vpz;   //!< m s^-1, Plasma vel parallel to B, z direction
+    int gridflag; //!< Determine if cell is empty
 };
 
 /** @brief Defines the data to completely parameterise a rectangular grid of 
@@ -64,23 +196,29 @@ struct PlasmaData{
 struct PlasmaGrid_Data{
 
     /* Plasma Parameters */
-    std::vector<std::vector<double>> Te;    //!< K, Electron temperature
-    std::vector<std::vector<double>> Ti;    //!< K, Ion temperature
-    std::vector<std::vector<double>> Tn;    //!< K, Neutral temperature
-    std::vector<std::vector<double>> Ta;    //!< K, Ambient temperature
-    std::vector<std::vector<double>> na0;   //!< m^-3, Ion density
-    std::vector<std::vector<double>> na1;   //!< m^-3, Electron density
-    std::vector<std::vector<double>> na2;   //!< m^-3, Neutral density
-    std::vector<std::vector<double>> po;    //!< V, Potential
-    std::vector<std::vector<double>> ua0;   //!< m s^-1, Ion drift vel
-    std::vector<std::vector<double>> ua1;   //!< m s^-1, Electron drift vel
-    std::vector<std::vector<double>> bx;    //!< T, Mang field, x direction
-    std::vector<std::vector<double>> by;    //!< T, Mang field, y direction
-    std::vector<std::vector<double>> bz;    //!< T, Mang field, z direction
-    std::vector<std::vector<double>> x;     //!< m, Position of x cells
-    std::vector<std::vector<double>> z;     //!< m, Position of z cells
-    std::vector<std::vector<double>> dm;    //!< kg, Lost mass in every cell
-    std::vector<std::vector<int>> gridflag; //!< Determine if cell is empty
+    GridField<double> Te;    //!< K, Electron temperature
+    GridField<double> Ti;    //!< K, Ion temperature
+    GridField<double> Tn;    //!< K, Neutral temperature
+    GridField<double> Ta;    //!< K, Ambient temperature
+    GridField<double> na0;   //!< m^-3, Ion density
+    GridField<double> na1;   //!< m^-3, Electron density
+    GridField<double> na2;   //!< m^-3, Neutral density
+    GridField<double> po;    //!< V, Potential
+    GridField<double> ua0;   //!< m s^-1, Ion drift vel
+    GridField<double> ua1;   //!< m s^-1, Electron drift vel
+    GridField<double> bx;    //!< T, Mang field, x direction
+    GridField<double> by;    //!< T, Mang field, y direction
+    GridField<double> bz;    //!< T, Mang field, z direction
+    GridField<double> x;     //!< m, Position of x cells
+    GridField<double> z;     //!< m, Position of z cells
+    GridField<double> Er;    //!< V m^-1, Derived Electric field, x direction
+    GridField<double> Ez;    //!< V m^-1, Derived Electric field, z direction
+    GridField<double> vpx;   //!< m s^-1, Derived parallel plasma vel, x
+    GridField<double> vpy;   //!< m s^-1, Derived parallel plasma vel, y
+    GridField<double> vpz;   //!< m s^-1, Derived parallel plasma vel, z
+    GridField<int> gridflag; //!< Determine if cell is empty
+    GridField<PlasmaCell> Cells; //!< Packed copy of the fields read together
+    GridField<char> Stencils;    //!< Interpolation stencils valid at cell
 
     /* Plasma Simulation Domain */
     int gridx;       //!< the number of grid cells in x direction
@@ -96,8 +234,41 @@ struct PlasmaGrid_Data{
     /* Basic Parameters defining plasma type. */
     double mi;   //!< mi is the mass of the gas (kg)
     char device; //!< Specify the machine type ('m', 'j', 'i', 'p' or 'd')
+    char interpolation; //!< Interpolation scheme ('n', 'l' or 'c')
+
+    /* Mutable deposition record, shared by every copy of this grid */
+    std::shared_ptr<MassDeposition> dm; //!< kg, Lost mass in every cell
 };
 
+/** @brief Fill the packed \p Cells of \p pgrid from its individual fields.
+ *
+ *  Must be called once all of the fields of \p pgrid have been read in and 
+ *  derived and before the grid is shared with any models.
+ *  @param pgrid the plasma grid to be packed
+ */
+inline void pack_plasmacells(PlasmaGrid_Data &pgrid){
+    pgrid.Cells = GridField<PlasmaCell>(pgrid.gridx,pgrid.gridz);
+    for( int i = 0; i < pgrid.gridx; i ++ ){
+        for( int k = 0; k < pgrid.gridz; k ++ ){
+            PlasmaCell &Cell = pgrid.Cells[i][k];
+            Cell.Te       = pgrid.Te[i][k];
+            Cell.Ti       = pgrid.Ti[i][k];
+            Cell.na0      = pgrid.na0[i][k];
+            Cell.na1      = pgrid.na1[i][k];
+            Cell.na2      = pgrid.na2[i][k];
+            Cell.bx       = pgrid.bx[i][k];
+            Cell.by       = pgrid.by[i][k];
+            Cell.bz       = pgrid.bz[i][k];
+            Cell.Er       = pgrid.Er[i][k];
+            Cell.Ez       = pgrid.Ez[i][k];
+            Cell.vpx      = pgrid.vpx[i][k];
+            Cell.vpy      = pgrid.vpy[i][k];
+            Cell.vpz      = pgrid.vpz[i][k];
+            Cell.gridflag = pgrid.gridflag[i][k];
+        }
+    }
+}
+
 /** @brief Two dimensional positional information defining a boundary which
  * exists in cylindrical r, z space. Used by DTOKSU to terminate simulations. 
  */
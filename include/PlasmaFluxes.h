@@ -25,88 +25,85 @@ namespace Flux{
 ///@{
 /** @brief Calculate the Ion Flux as specified by OML
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the ion flux according to OML theory
  */
 double OMLIonFlux(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double Potential);
+    const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the Ion Flux as specified by MOML
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the ion flux following MOML theory for negative dust
  */
 double MOMLIonFlux(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double Potential);
+    const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the Ion Flux as specified by SOML
  *  For the case of no flow, to avoid dividing by zero we return OMLIonFlux.
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the ion flux as originally given by SOML
  */
 double SOMLIonFlux(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double Potential);
+    const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the Ion Flux as specified by SMOML
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the ion flux as originally given by SMOML
  */
 double SMOMLIonFlux(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double Potential);
+    const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the Ion Flux as specified by PHL
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the ion flux as originally given by PHL
  */
 double PHLElectronFlux(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double Potential);
+    const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the Ion Flux as specified originally in DTOKS
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the ion flux as originally given by DTOKS
  */
 double DTOKSIonFlux(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double Potential);
+    const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the electron flux as specified originally in DTOKS
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the electron flux as originally given by DTOKS
  */
-double DTOKSElectronFlux(const std::shared_ptr<PlasmaData> Pdata, 
-    const double Potential);
+double DTOKSElectronFlux(const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the electron flux as specified by OML
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the normalised potential on the dust grain
  *  @return the ion flux as originally given by OML
  */
-double OMLElectronFlux(const std::shared_ptr<PlasmaData> Pdata, 
-    const double Potential);
+double OMLElectronFlux(const PlasmaData &Pdata, const double Potential);
 /** @brief Calculate the thermal neutral flux 
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @return the  thermal neutral flux
  */
-double NeutralFlux(const std::shared_ptr<PlasmaData> Pdata);
+double NeutralFlux(const PlasmaData &Pdata);
 
 /** @brief flux of particles away from liquid surface due to evaporation
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param DustTemperature The temperature of the dust
  *  @return The flux of evaporating particles away from the liquid
  */
 double EvaporationFlux(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature);
+    const PlasmaData &Pdata, const double DustTemperature);
 /** @brief Thermionic electron emission yield
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @return the thermionic electron emission yield coefficient
  */
-double DeltaTherm(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata);
+double DeltaTherm(const Matter* Sample, const PlasmaData &Pdata);
 /** @brief Thermionic electron emission flux
  *  @param Sample Const pointer to class containing all data about matter
  *  @return the thermionic electron emission flux
@@ -114,18 +111,59 @@ double DeltaTherm(const Matter* Sample,
 double ThermFlux(const Matter* Sample);
 /** @brief Thermionic electron emission flux with schottky correction
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Potential the potential of the dust grain surface
  *  @return the thermionic electron emission flux
  */
 double ThermFluxSchottky(const Matter* Sample, 
-    const std::shared_ptr<PlasmaData> Pdata, const double Potential);
+    const PlasmaData &Pdata, const double Potential);
 /** @brief Secondary electron emission yield
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @return the secondary electron emission yield coefficient
  */
-double DeltaSec(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata);
+double DeltaSec(const Matter* Sample, const PlasmaData &Pdata);
+///@}
+
+/** @name Shared pointer adapters
+ *  @brief The fluxes above for callers still holding the plasma data by 
+ *  shared_ptr, kept while they move to passing PlasmaData by reference
+ */
+///@{
+typedef const std::shared_ptr<PlasmaData> &PlasmaDataPtr;
+inline double OMLIonFlux(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double Potential){ return OMLIonFlux(Sample,*Pdata,Potential); }
+inline double MOMLIonFlux(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double Potential){ return MOMLIonFlux(Sample,*Pdata,Potential); }
+inline double SOMLIonFlux(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double Potential){ return SOMLIonFlux(Sample,*Pdata,Potential); }
+inline double SMOMLIonFlux(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double Potential){ return SMOMLIonFlux(Sample,*Pdata,Potential); }
+inline double PHLElectronFlux(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double Potential){ return PHLElectronFlux(Sample,*Pdata,Potential); }
+inline double DTOKSIonFlux(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double Potential){ return DTOKSIonFlux(Sample,*Pdata,Potential); }
+inline double DTOKSElectronFlux(PlasmaDataPtr Pdata, const double Potential){
+    return DTOKSElectronFlux(*Pdata,Potential);
+}
+inline double OMLElectronFlux(PlasmaDataPtr Pdata, const double Potential){
+    return OMLElectronFlux(*Pdata,Potential);
+}
+inline double NeutralFlux(PlasmaDataPtr Pdata){ return NeutralFlux(*Pdata); }
+inline double EvaporationFlux(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double DustTemperature){
+    return EvaporationFlux(Sample,*Pdata,DustTemperature);
+}
+inline double DeltaTherm(const Matter* Sample, PlasmaDataPtr Pdata){
+    return DeltaTherm(Sample,*Pdata);
+}
+inline double ThermFluxSchottky(const Matter* Sample, PlasmaDataPtr Pdata, 
+    const double Potential){
+    return ThermFluxSchottky(Sample,*Pdata,Potential);
+}
+inline double DeltaSec(const Matter* Sample, PlasmaDataPtr Pdata){
+    return DeltaSec(Sample,*Pdata);
+}
 ///@}
 
 }
@@ -0,0 +1,63 @@
+/** @file PlasmaGridCache.h
+ *  @brief Binary cache of a plasma grid ready for simulation
+ *
+ *  Reading a plasma grid from the formatted b2processed files, converting it
+ *  to SI units, checking its range and deriving the fields takes seconds for
+ *  the larger machines. The finished grid is written once to a binary cache
+ *  which later runs map into memory read-only, so that they start at once
+ *  and concurrent runs on the same machine share the pages of the grid.
+ *
+ *  The cache is written in native byte order and begins with a fixed size
+ *  header identifying the format version, the grid and the inputs it was
+ *  made from, followed by every field of the grid, each aligned to
+ *  GridAlignment. Header and fields carry separate checksums. A source file
+ *  is identified by its size and its modification time to the nanosecond,
+ *  so that a file rewritten within the same second still makes the cache
+ *  out of date.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __PLASMAGRIDCACHE_H_INCLUDED__
+#define __PLASMAGRIDCACHE_H_INCLUDED__
+
+#include <string>
+#include <vector>
+
+#include "PlasmaData.h"
+
+/** @brief Write the finished grid \p pgrid to the cache \p filename
+ *
+ *  @param pgrid the plasma grid with its fields derived, packed and stencils
+ *  built
+ *  @param pdata the plasma data providing the ambient and neutral values
+ *  of the grid
+ *  @param readstatus the status returned when reading the grid
+ *  @param sources the files the grid was read from
+ *  @param filename the cache file, replaced through a temporary file
+ *  @return 0 on success and 1 if the file could not be written
+ */
+int write_gridcache(const PlasmaGrid_Data &pgrid, const PlasmaData &pdata,
+    int readstatus, const std::vector<std::string> &sources,
+    std::string filename);
+
+/** @brief Map the grid cached in \p filename into the fields of \p pgrid
+ *
+ *  The dimensions and spacing of \p pgrid must already be set. Its fields
+ *  become read-only views of the mapped file, which stays mapped until the
+ *  last field viewing it is destroyed.
+ *  @param pgrid the plasma grid, configured but not read
+ *  @param pdata the plasma data providing the ambient and neutral values
+ *  @param readstatus set to the status returned when the grid was read
+ *  @param sources the files the grid would be read from
+ *  @param filename the cache file written by write_gridcache()
+ *  @return 0 on success, 1 if the file could not be opened, 2 if it is not a
+ *  valid cache of this version and 3 if it was made from a different grid,
+ *  plasma data or source files
+ */
+int read_gridcache(PlasmaGrid_Data &pgrid, const PlasmaData &pdata,
+    int &readstatus, const std::vector<std::string> &sources,
+    std::string filename);
+
+#endif /* __PLASMAGRIDCACHE_H_INCLUDED__ */
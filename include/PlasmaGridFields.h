@@ -0,0 +1,66 @@
+/** @file PlasmaGridFields.h
+ *  @brief Functions computing the fields derived from the plasma grid
+ *
+ *  The electric field and the plasma velocity parallel to the magnetic field
+ *  depend only on the plasma grid, so are computed once when the grid is
+ *  loaded rather than every time the plasma is sampled. The derived fields
+ *  can be written to and read back from a file to skip this on later runs.
+ *  The file records a hash of the plasma fields they were derived from and
+ *  the version of the derivation, so that it is only used for the same
+ *  plasma derived in the same way.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __PLASMAGRIDFIELDS_H_INCLUDED__
+#define __PLASMAGRIDFIELDS_H_INCLUDED__
+
+#include <string>
+
+#include "PlasmaData.h"
+
+/** @brief Compute the electric field and parallel plasma velocity of \p pgrid
+ *
+ *  E is calculated from the potential of adjacent cells, using central
+ *  differences where both neighbours are in the plasma (gridflag == 1), one
+ *  sided differences where only one is and zero otherwise. The plasma
+ *  velocity is the density weighted mean of the ion and electron drift
+ *  velocities, directed along the magnetic field.
+ *  @param pgrid the plasma grid for which the fields are derived
+ */
+void derive_plasmafields(PlasmaGrid_Data &pgrid);
+
+/** @brief Write the derived fields of \p pgrid to \p filename
+ *  @param pgrid the plasma grid containing the derived fields
+ *  @param filename the file to which derived fields are written
+ *  @return 0 on success and 1 if the file could not be written
+ */
+int write_derivedfields(const PlasmaGrid_Data &pgrid, std::string filename);
+
+/** @brief Read the derived fields of \p pgrid from \p filename
+ *  @param pgrid the plasma grid, read, for which the derived fields are read
+ *  @param filename the file written by write_derivedfields()
+ *  @return 0 on success, 1 if the file could not be opened, 2 if the file
+ *  does not match the dimensions of \p pgrid or is incomplete and 3 if it
+ *  was derived from different plasma fields or by another version
+ */
+int read_derivedfields(PlasmaGrid_Data &pgrid, std::string filename);
+
+/** @brief Read the derived fields of \p pgrid from \p filename, deriving
+ *  them again if the file can't be used
+ *
+ *  A file which is missing, of other dimensions, incomplete or out of date is
+ *  never read into \p pgrid. The fields are derived instead and, if \p save,
+ *  written to \p filename in its place for later runs.
+ *  @param pgrid the plasma grid, read, for which the derived fields are found
+ *  @param filename the file of derived fields, none is used if empty
+ *  @param save true if derived fields are to be written to \p filename
+ *  @return 0 if the fields were read, otherwise the status of
+ *  read_derivedfields() once they have been derived, or 4 if they could not
+ *  be written
+ */
+int load_derivedfields(PlasmaGrid_Data &pgrid, std::string filename,
+    bool save);
+
+#endif /* __PLASMAGRIDFIELDS_H_INCLUDED__ */
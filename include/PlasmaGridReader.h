@@ -0,0 +1,60 @@
+/** @file PlasmaGridReader.h
+ *  @brief Functions reading a plasma grid from the b2processed text files
+ *
+ *  The grids derived from SOLPS are stored in three text files in the plasma
+ *  directory: b2processed.dat holding the position, temperatures, densities,
+ *  potential and drift velocities of each cell, b2processed2.dat holding the
+ *  magnetic field and locate.dat holding the grid flags. Both b2processed
+ *  files begin with a header of 20 characters. Cells are listed with z in
+ *  the outer loop. Temperatures are converted to K and every cell is checked
+ *  against Overflows and Underflows.
+ *
+ *  read_b2processed() parses the files on several threads and is used by
+ *  DTOKSU_Manager. read_b2processed_reference() is the original formatted
+ *  stream reader it is tested against.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __PLASMAGRIDREADER_H_INCLUDED__
+#define __PLASMAGRIDREADER_H_INCLUDED__
+
+#include <string>
+
+#include "PlasmaData.h"
+
+/** @brief Allocate every field of \p pgrid read from the plasma files
+ *  @param pgrid the plasma grid, with its dimensions set
+ */
+void allocate_plasmafields(PlasmaGrid_Data &pgrid);
+
+/** @brief Read the b2processed grid in \p plasma_dirname on several threads
+ *
+ *  The three files are read concurrently and split into line-aligned chunks
+ *  which are parsed in parallel. The unit conversion and range checks are
+ *  then taken over whole fields. The result is identical to that of
+ *  read_b2processed_reference(), which is used instead for files it cannot
+ *  parse, such as ones that are incomplete.
+ *  @param pgrid the plasma grid, with its dimensions and device set
+ *  @param pdata the plasma data providing the ambient and neutral values
+ *  @param plasma_dirname directory containing the plasma data files
+ *  @param threads the number of threads parsing the files
+ *  @return 0 on success, 1 if any value exceeds Overflows or Underflows and
+ *  2 if the files could not be opened
+ */
+int read_b2processed(PlasmaGrid_Data &pgrid, const PlasmaData &pdata,
+    std::string plasma_dirname, unsigned int threads);
+
+/** @brief Read the b2processed grid in \p plasma_dirname with file streams
+ *
+ *  Single threaded reference for read_b2processed().
+ *  @param pgrid the plasma grid, with its dimensions and device set
+ *  @param pdata the plasma data providing the ambient and neutral values
+ *  @param plasma_dirname directory containing the plasma data files
+ *  @return 0 on success and 1 if any value exceeds Overflows or Underflows
+ */
+int read_b2processed_reference(PlasmaGrid_Data &pgrid,
+    const PlasmaData &pdata, std::string plasma_dirname);
+
+#endif /* __PLASMAGRIDREADER_H_INCLUDED__ */
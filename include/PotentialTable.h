@@ -0,0 +1,153 @@
+/** @file PotentialTable.h
+ *  @brief Tabulated floating potentials of the charging models with emission
+ *
+ *  The MOMLEM and MOMLWEM current terms find the potential of the dust by
+ *  solving nonlinear equations in a few dimensionless plasma parameters, which
+ *  vary slowly along a trajectory. A PotentialTable holds the solutions on a
+ *  rectilinear grid of those parameters, for one ion to electron mass ratio,
+ *  and interpolates them multilinearly. Tables are generated offline by the
+ *  dtokstable tool and written to PotentialTables/, from where one immutable
+ *  copy of each is shared by the whole process, see shared(). Wherever a
+ *  table cannot answer, the terms fall back to solving the equations.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __POTENTIALTABLE_H_INCLUDED__
+#define __POTENTIALTABLE_H_INCLUDED__
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+//!< Models tabulated and settings of the potential tables
+namespace PotentialTables{
+    //!< Surface potential of solveMOMLEM(), against (Tau, Chi, Delta)
+    const char MOMLEM       = 'e';
+    //!< Potential of solveMOMLWEM(), against (Tau, DeltaTot)
+    const char MOMLWEM      = 'w';
+    //!< Directory the tables are read from
+    const std::string Directory = "PotentialTables";
+    //!< Largest relative difference in mass ratio for a table to be used
+    const double MassTolerance  = 1e-4;
+    //!< Largest error of the normalised potential at the centre of a cell
+    //!< for the cell to be interpolated
+    const double Tolerance      = 0.01;
+}
+
+/** @class PotentialTable
+ *  @brief A potential tabulated on a rectilinear grid of up to three axes
+ *
+ *  Nodes and cells are both stored in row-major order, the last axis varying
+ *  fastest. Only cells marked valid are interpolated. The potential need not
+ *  be continuous, for instance where a potential well forms or the solver
+ *  fails, so the generator only marks a cell valid if the interpolation at
+ *  its centre agrees with the solution there, see PotentialTables::Tolerance.
+ */
+class PotentialTable{
+    private:
+        char Model;                             //!< See PotentialTables
+        double MassRatio;                       //!< mi/Me
+        double Ionization;                      //!< Z, 1 for MOMLEM
+        std::vector<std::vector<double>> Axes;  //!< Each ascending
+        std::vector<double> Values;             //!< Normalised potentials
+        std::vector<unsigned char> Valid;       //!< 1 for valid cells
+
+    public:
+        PotentialTable():Model(0),MassRatio(0.0),Ionization(0.0){}
+
+        /** @brief An unsolved table of \p model on the grid of \p axes
+         *  @param model the model tabulated, see PotentialTables
+         *  @param massratio the ratio of ion to electron mass
+         *  @param ionization the mean ionization state of the plasma
+         *  @param axes the ascending values of each parameter
+         */
+        PotentialTable(char model, double massratio, double ionization,
+            const std::vector<std::vector<double>> &axes);
+
+        //!< Number of nodes of the table
+        size_t size()const{ return Values.size(); }
+        //!< Number of cells of the table
+        size_t cells()const{ return Valid.size(); }
+        size_t dimensions()const{ return Axes.size(); }
+        bool empty()const{ return Values.empty(); }
+
+        /** @brief Coordinates of node \p index
+         *  @param index the node, less than size()
+         *  @param x set to the value of each parameter at the node
+         */
+        void node(size_t index, double *x)const;
+
+        /** @brief Coordinates of the centre of cell \p index
+         *  @param index the cell, less than cells()
+         *  @param x set to the value of each parameter at the centre
+         */
+        void centre(size_t index, double *x)const;
+
+        //!< Set the potential of node \p index
+        void set(size_t index, double value){ Values[index] = value; }
+
+        //!< Mark cell \p index as valid or not, cells start valid
+        void set_valid(size_t index, bool valid){ Valid[index] = valid; }
+
+        /** @brief Multilinear interpolation of the potential
+         *
+         *  @param x the value of each parameter
+         *  @param value set to the potential if the table can answer
+         *  @return false if \p x lies outside the table or in a cell which is
+         *  not valid
+         */
+        bool lookup(const double *x, double &value)const;
+
+        /** @brief Whether the table is of \p model for the plasma given
+         *
+         *  The mass ratio need only agree to within
+         *  PotentialTables::MassTolerance.
+         */
+        bool matches(char model, double massratio, double ionization)const;
+
+        /** @brief Write the table to \p filename in binary
+         *  @return 0 on success and 1 if the file could not be opened
+         */
+        int write(std::string filename)const;
+
+        /** @brief Read a table written by write()
+         *  @return 0 on success, 1 if the file could not be opened and 2 if
+         *  it is not a potential table of this version
+         */
+        int read(std::string filename);
+
+        /** @brief Name of the file of \p model for the plasma given
+         *  @return the path within PotentialTables::Directory
+         */
+        static std::string filename(char model, double massratio,
+            double ionization);
+
+        /** @brief The table of \p model for the plasma given, shared by the
+         *  whole process
+         *
+         *  The table is read on the first call for each plasma and returned
+         *  by every later call. Safe to call from concurrent threads. If no
+         *  table matching the plasma could be read, the table returned is
+         *  empty and every lookup() fails.
+         */
+        static std::shared_ptr<const PotentialTable> shared(char model,
+            double massratio, double ionization);
+
+        /** @brief The shared() table of \p model for the plasma given, as
+         *  last found by the calling thread
+         *
+         *  Terms are shared by the threads of an ensemble or breakup, so
+         *  may not hold the table themselves. Each thread keeps the last
+         *  table of each model and only calls shared() when the plasma no
+         *  longer matches it, avoiding the lock of shared() on every call.
+         *  The table stays valid until the thread next calls local() for
+         *  the same model.
+         */
+        static const PotentialTable &local(char model, double massratio,
+            double ionization);
+};
+
+#endif /* __POTENTIALTABLE_H_INCLUDED__ */
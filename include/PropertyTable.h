@@ -0,0 +1,109 @@
+/** @file PropertyTable.h
+ *  @brief Tabulated temperature dependence of an element property
+ *
+ *  The heat capacity and vapour pressure models of the elements evaluate
+ *  pow() and log10() every time they are called, which is at least once per
+ *  time step and in every stage of the heating integrators. A PropertyTable
+ *  holds one such model on a piecewise-uniform grid, computed once when the
+ *  table is constructed, and interpolates linearly between the nodes. The grid
+ *  of each piece is refined until the interpolation agrees with the model to
+ *  within a given relative error, see PropertyTable().
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __PROPERTYTABLE_H_INCLUDED__
+#define __PROPERTYTABLE_H_INCLUDED__
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cmath>
+
+//!< Settings of the property tables
+namespace Tabulation{
+    //!< Model tabulated linearly against temperature
+    const char Linear       = 'l';
+    //!< Logarithm of the model tabulated against inverse temperature, for
+    //!< quantities such as vapour pressure following Clausius-Clapeyron
+    const char Arrhenius    = 'a';
+    //!< Largest relative error allowed between table and model
+    const double Tolerance  = 1e-7;
+    //!< Most intervals tried for one piece before it is left untabulated
+    const unsigned int MaxIntervals = 1u<<16;
+}
+
+/** @class PropertyTable
+ *  @brief A property of temperature, interpolated on a piecewise-uniform grid
+ *
+ *  The pieces lie between consecutive temperatures of the bounds given on
+ *  construction, which are placed wherever the model changes form. Each piece
+ *  has its own uniform spacing. The bounds themselves are never tabulated, so
+ *  temperatures exactly on a change of model still reach the model, along with
+ *  temperatures outside the bounds.
+ */
+class PropertyTable{
+    private:
+        struct Piece{
+            double TMin;                //!< K, lower bound, excluded
+            double TMax;                //!< K, upper bound, excluded
+            double XMin;                //!< Abscissa of the first node
+            double InvStep;             //!< Inverse spacing of the nodes
+            std::vector<double> Values; //!< Model at each node
+        };
+        char Scale;                     //!< See Tabulation namespace
+        std::vector<Piece> Pieces;
+        double MaxError;                //!< Largest relative error found
+
+        //!< Abscissa of temperature \p T on the scale of the table
+        inline double abscissa(double T)const{
+            return Scale == Tabulation::Arrhenius ? 1.0/T : T;
+        }
+
+    public:
+        /** @brief Tabulate \p model between each pair of \p bounds
+         *
+         *  The nodes of each piece are doubled, from 16, until linear
+         *  interpolation matches \p model to within \p tolerance at the
+         *  midpoint of every interval, where the error of interpolating a
+         *  smooth function is largest. Pieces needing more than
+         *  Tabulation::MaxIntervals, or on which \p model is not finite (and
+         *  positive, for Tabulation::Arrhenius), are left to the model.
+         *  @param model the property as a function of temperature (K)
+         *  @param bounds the temperatures (K) bounding the pieces, ascending
+         *  @param scale Tabulation::Linear or Tabulation::Arrhenius
+         *  @param tolerance the largest relative error allowed
+         */
+        PropertyTable(std::function<double(double)> model,
+            const std::vector<double> &bounds, char scale,
+            double tolerance=Tabulation::Tolerance);
+
+        /** @brief The tabulated property at temperature \p T
+         *
+         *  @param T the temperature (K)
+         *  @param value set to the property if \p T is tabulated
+         *  @return true if \p T lies strictly inside a tabulated piece
+         */
+        bool lookup(double T, double &value)const{
+            for( const Piece &P : Pieces ){
+                if( !(T > P.TMin && T < P.TMax) ) continue;
+                double s = (abscissa(T)-P.XMin)*P.InvStep;
+                size_t i = (size_t)s;
+                if( i > P.Values.size()-2 ) i = P.Values.size()-2;
+                double w = s-i;
+                double v = (1.0-w)*P.Values[i] + w*P.Values[i+1];
+                value = Scale == Tabulation::Arrhenius ? exp(v) : v;
+                return true;
+            }
+            return false;
+        }
+
+        //!< Largest relative error found between table and model
+        double max_error()const{ return MaxError; }
+
+        //!< Number of pieces tabulated
+        size_t pieces()const{ return Pieces.size(); }
+};
+
+#endif /* __PROPERTYTABLE_H_INCLUDED__ */
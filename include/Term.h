@@ -17,6 +17,9 @@
 #include <memory>
 #include <string>
 
+class CheckpointWriter;
+class CheckpointReader;
+
 /** @struct ForceTerm
  *  @brief struct defining the behaviour of Force terms within a dynamics model
  *  
@@ -24,15 +27,28 @@
  *  within the force model that describe the source terms of different 
  *  accelerations.
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Temp the temperature of the dust at which it is evaluated
  *  @return The acceleration in m/s^2 of \p Sample due to the ForceTerm
  */
 struct ForceTerm{
     virtual threevector Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
-        const threevector velocity)=0;
+        const PlasmaData &Pdata, const threevector velocity)=0;
     virtual std::string PrintName()=0;
+    //!< true if the term reads the electric field of the plasma
+    virtual bool needs_electricfield()const{ return false; }
+    virtual ~ForceTerm(){}
+
+    /** @name Term state
+     *  @brief Terms which keep state between evaluations are copied for
+     *  each ForceModel, see ForceModel::own_terms(), so that no two grains
+     *  share it. Stateless terms return NULL from clone() and are shared.
+     */
+    ///@{
+    virtual ForceTerm *clone()const{ return NULL; }
+    virtual void write_state(CheckpointWriter &/*out*/)const{}
+    virtual void read_state(CheckpointReader &/*in*/){}
+    ///@}
 };
 
 /** @struct HeatTerm
@@ -42,13 +58,13 @@ struct ForceTerm{
  *  within the heating model that describe the source terms of different 
  *  power fluxes.
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Temp the temperature of the dust at which it is evaluated
  *  @return The power in kW to the surface of \p Sample due to the HeatTerm
  */
 struct HeatTerm{
     virtual double Evaluate(const Matter* Sample, 
-        std::shared_ptr<PlasmaData> Pdata, const double Temp)=0;
+        const PlasmaData &Pdata, const double Temp)=0;
     virtual std::string PrintName()=0;
 };
 
@@ -58,14 +74,36 @@ struct HeatTerm{
  *  Abstract structure which defines the behaviour of the charging terms acting 
  *  within the charging model.
  *  @param Sample Const pointer to class containing all data about matter
- *  @param Pdata Const pointer to data structure with information about plasma
+ *  @param Pdata Data structure with information about plasma
  *  @param Temp the temperature of the dust at which it is evaluated
  *  @return The current flux to the surface of \p Sample due to the CurrentTerm
  */
 struct CurrentTerm{
     virtual double Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential)=0;
+        const PlasmaData &Pdata, const double Potential)=0;
     virtual std::string PrintName()=0;
 };
 
+/** @name Shared pointer adapters
+ *  @brief Evaluate \p term for callers still holding the plasma data by
+ *  shared_ptr
+ *
+ *  These are free functions so that they are not hidden by the Evaluate() of
+ *  the terms deriving from ForceTerm, HeatTerm and CurrentTerm.
+ */
+///@{
+inline threevector Evaluate(ForceTerm *term, const Matter* Sample,
+    const std::shared_ptr<PlasmaData> &Pdata, const threevector velocity){
+    return term->Evaluate(Sample,*Pdata,velocity);
+}
+inline double Evaluate(HeatTerm *term, const Matter* Sample,
+    const std::shared_ptr<PlasmaData> &Pdata, const double Temp){
+    return term->Evaluate(Sample,*Pdata,Temp);
+}
+inline double Evaluate(CurrentTerm *term, const Matter* Sample,
+    const std::shared_ptr<PlasmaData> &Pdata, const double Potential){
+    return term->Evaluate(Sample,*Pdata,Potential);
+}
+///@}
+
 #endif /* __TERM_H_INCLUDED__ */
\ No newline at end of file
@@ -0,0 +1,136 @@
+/** @file TermKernel.h
+ *  @brief Statically dispatched evaluation of a fixed list of terms
+ *
+ *  The models hold their terms as a vector of pointers to the abstract term
+ *  structs and pay a virtual call for every term at every evaluation. A
+ *  TermKernel evaluates every term of one particular list of term types,
+ *  casting each pointer to its known type and calling Evaluate() directly, so
+ *  that the compiler is free to inline the terms into a single loop free
+ *  function. Kernels are only instantiated for the lists registered in the
+ *  term source files, see Term::find_heatkernel(), Term::find_forcekernel()
+ *  and Term::find_currentkernel(). Any other list finds no kernel and is
+ *  evaluated term by term through the virtual functions as before.
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug No known bugs.
+ */
+
+#ifndef __TERMKERNEL_H_INCLUDED__
+#define __TERMKERNEL_H_INCLUDED__
+
+#include <vector>
+#include <typeinfo>
+#include <cstddef>
+#include <utility>
+
+#include "Matter.h"
+#include "PlasmaData.h"
+
+/** @class TermKernel
+ *  @brief Evaluates a list of terms derived from \p Base in one call
+ *
+ *  \p Arg is the argument the terms are evaluated at after the dust and plasma
+ *  and \p Result is the value they return.
+ */
+template<class Base, typename Arg, typename Result> class TermKernel{
+    public:
+        virtual ~TermKernel(){}
+
+        /** @brief Evaluate every term of \p terms
+         *
+         *  \p terms must be the list the kernel was found for.
+         *  @param terms the terms, in the order they were registered
+         *  @param Sample the dust the terms are evaluated for
+         *  @param Pdata the local plasma parameters
+         *  @param arg the argument of the terms, eg the dust temperature
+         *  @param skip index of a term not to evaluate, -1 to evaluate all
+         *  @param results the value of term n is written to results[n], the
+         *  skipped term gives Result()
+         */
+        virtual void Evaluate(const std::vector<Base*> &terms,
+            const Matter* Sample, const PlasmaData &Pdata, const Arg arg,
+            int skip, Result *results)const=0;
+};
+
+namespace Kernel{
+
+//!< A list of term types, in the order the terms are held by a model
+template<class... Terms> struct TermList{};
+
+/** @class FixedKernel
+ *  @brief The TermKernel of the terms \p Terms
+ */
+template<class Base, typename Arg, typename Result, class... Terms>
+class FixedKernel : public TermKernel<Base,Arg,Result>{
+    private:
+        //!< Evaluate term \p T directly, bypassing the virtual function
+        template<class T> static inline Result evaluate_term(Base *term,
+            const Matter* Sample, const PlasmaData &Pdata, const Arg arg){
+            return static_cast<T*>(term)->T::Evaluate(Sample,Pdata,arg);
+        }
+
+        template<size_t... I> static inline void evaluate_all(
+            std::index_sequence<I...>,
+            const std::vector<Base*> &terms, const Matter* Sample,
+            const PlasmaData &Pdata, const Arg arg, int skip,
+            Result *results){
+            //!< Expands to one direct call per term, in order
+            int Expand[] = { 0, ( results[I] = (int)I == skip ? Result()
+                : evaluate_term<Terms>(terms[I],Sample,Pdata,arg), 0 )... };
+            (void)Expand;
+        }
+
+    public:
+        void Evaluate(const std::vector<Base*> &terms, const Matter* Sample,
+            const PlasmaData &Pdata, const Arg arg, int skip,
+            Result *results)const{
+            evaluate_all(std::make_index_sequence<sizeof...(Terms)>(),
+                terms,Sample,Pdata,arg,skip,results);
+        }
+
+        /** @brief Whether the dynamic types of \p terms are exactly \p Terms
+         */
+        static bool matches(const std::vector<Base*> &terms){
+            if( terms.size() != sizeof...(Terms) ) return false;
+            const std::type_info *Types[] = { &typeid(Terms)... };
+            for( size_t n = 0; n < terms.size(); n ++ )
+                if( terms[n] == NULL || typeid(*terms[n]) != *Types[n] )
+                    return false;
+            return true;
+        }
+
+        //!< The one kernel of \p Terms, kernels hold no state
+        static const TermKernel<Base,Arg,Result> *instance(){
+            static FixedKernel Kernel;
+            return &Kernel;
+        }
+};
+
+/** @class Registry
+ *  @brief The kernels of the term lists \p Lists
+ */
+template<class Base, typename Arg, typename Result, class... Lists>
+struct Registry{
+    /** @brief Find the kernel for \p terms amongst \p Lists
+     *  @return the kernel, NULL if \p terms is none of \p Lists
+     */
+    static const TermKernel<Base,Arg,Result> *find(
+        const std::vector<Base*> &/*terms*/){
+        return NULL;
+    }
+};
+
+template<class Base, typename Arg, typename Result, class... Terms,
+    class... Lists>
+struct Registry<Base,Arg,Result,TermList<Terms...>,Lists...>{
+    static const TermKernel<Base,Arg,Result> *find(
+        const std::vector<Base*> &terms){
+        typedef FixedKernel<Base,Arg,Result,Terms...> Fixed;
+        if( Fixed::matches(terms) ) return Fixed::instance();
+        return Registry<Base,Arg,Result,Lists...>::find(terms);
+    }
+};
+
+}
+
+#endif /* __TERMKERNEL_H_INCLUDED__ */
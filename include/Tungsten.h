@@ -43,6 +43,7 @@ class Tungsten: public Matter{
         ~Tungsten(){};
         
         double probe_vapourpressure(double Temperature)const;
+        Matter* clone()const override{ return new Tungsten(*this); }
 };
 
 #endif /* __TUNGSTEN_H_INCLUDED__ */
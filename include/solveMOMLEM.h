@@ -52,11 +52,31 @@ double CWP_f(double x, double Tau, double Chi, double Delta, double Mu, char Cri
 
 double FindCriticalVal(const double FirstFixedValue, const double SecondFixedValue, double MassRatio, char CritValue );
 
-double solveWellCase( double &phis, double & phic, double &phiw, double tau, double chi, double delta, double mu);
+// Solve equations [53-55] for the well case, with the constraints phiw < phis < 0 and phiw < phic
+// phis, phic and phiw	: Initial guess, set to the solution
+// iterations		: Set to the number of Levenberg-Marquardt iterations taken
+// Returns the sum of the absolute residuals at the solution, HUGE_VAL if the guess breaks the constraints
+double solveWellCase( double &phis, double & phic, double &phiw, double tau, double chi, double delta, 
+	double mu, int &iterations);
+
+// Solve the Modified orbital motion limited potential for large emitting dust grains.
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou, A. P. L. Robinson, M. Coppins, and M. Bacharis, Phys. Plasmas 21, (2014).
+// Returns the normalised potential of the dust surface
+// Iterations	: Set to the number of iterations taken to solve the well case, 0 without a well
+double solveMOMLEM(double Tau, double MassRatio, double Chi, double Delta, int &Iterations);
 
 // Solve the Modified orbital motion limited potential for large emitting dust grains.
 // See the paper by Minas and Nikoleta, equation (1) and (2)
 // N. Rizopoulou and M. Bacharis, Phys. Plasmas 25, (2018).
 double solveDeltaMOMLEM(double Tau, double MassRatio, double Chi, double Delta);
 
+// Floating potential of large emitting dust grains with a potential well, equation (1) and (2)
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou and M. Bacharis, Phys. Plasmas 25, (2018).
+// Ionization	: Mean ionization state of the plasma, Z
+// DeltaTot	: Total electron emission yield, less than one
+// Returns the normalised potential of the dust, positive for negative dust
+double solveMOMLWEM(double Tau, double MassRatio, double Ionization, double DeltaTot);
+
 #endif
@@ -0,0 +1,167 @@
+/** @file BackscatterTable.cpp
+ *  @brief Implementation of the tabulated backscattering of ions
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <fstream>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <map>
+
+#include "BackscatterTable.h"
+#include "Functions.h"
+#include "Constants.h"
+
+//!< Identifies a backscatter cache file
+static const char CacheMagic[8] = {'D','T','O','K','S','B','S','C'};
+
+/** @brief Locate \p x on an axis of \p n nodes from \p min spaced by \p step
+ *
+ *  Sets \p i to the lower node and \p w to the weight of the upper node.
+ *  @return false if \p x is outside the axis
+ */
+static inline bool locate(double x, double min, double step, unsigned int n,
+    unsigned int &i, double &w){
+    double s = (x-min)/step;
+    if( !(s >= 0.0) || s > n-1 ) return false;
+    i = std::min((unsigned int)s,n-2);
+    w = s-i;
+    return true;
+}
+
+//!< Number of nodes of a table
+static const unsigned int NumNodes =
+    Backscatter::NT*Backscatter::NT*Backscatter::NPot;
+
+BackscatterTable::BackscatterTable(char material):Material(material),
+RE(NumNodes,0.0),RN(NumNodes,0.0),Known(new std::atomic<bool>[NumNodes]()),
+Computed(0){
+}
+
+void BackscatterTable::publish(unsigned int n, float re, float rn){
+    if( Known[n].load(std::memory_order_relaxed) ) return;
+    RE[n] = re;
+    RN[n] = rn;
+    Computed ++;
+    Known[n].store(true,std::memory_order_release);
+}
+
+unsigned int BackscatterTable::fill(unsigned int i, unsigned int j,
+    unsigned int k){
+    unsigned int n = index(i,j,k);
+    if( Known[n].load(std::memory_order_acquire) ) return n;
+    double Te = pow(10.0,Backscatter::LogTMin+i*Backscatter::LogTStep);
+    double Ti = pow(10.0,Backscatter::LogTMin+j*Backscatter::LogTStep);
+    double Potential = Backscatter::PotentialMin+k*Backscatter::PotentialStep;
+    //!< The ion mass cancels from RE and RN
+    double re(0.0), rn(0.0);
+    backscatter(Te,Ti,Mp,Potential,Material,re,rn);
+    std::lock_guard<std::mutex> Lock(Mutex);
+    publish(n,re,rn);
+    return n;
+}
+
+void BackscatterTable::lookup(double Te, double Ti, double potential,
+    double &re, double &rn){
+    unsigned int i(0), j(0), k(0);
+    double wi(0.0), wj(0.0), wk(0.0);
+    if( Te <= 0.0 || Ti <= 0.0
+        || !locate(log10(Te),Backscatter::LogTMin,Backscatter::LogTStep,
+            Backscatter::NT,i,wi)
+        || !locate(log10(Ti),Backscatter::LogTMin,Backscatter::LogTStep,
+            Backscatter::NT,j,wj)
+        || !locate(potential,Backscatter::PotentialMin,
+            Backscatter::PotentialStep,Backscatter::NPot,k,wk) ){
+        static std::atomic<bool> runOnce(true);
+        WarnOnce(runOnce,"Plasma outside backscatter table, integrating.");
+        backscatter(Te,Ti,Mp,potential,Material,re,rn);
+        return;
+    }
+
+    re = 0.0;
+    rn = 0.0;
+    for( unsigned int c = 0; c < 8; c ++ ){
+        unsigned int di = (c>>2)&1, dj = (c>>1)&1, dk = c&1;
+        unsigned int n = fill(i+di,j+dj,k+dk);
+        double w = (di ? wi : 1.0-wi)*(dj ? wj : 1.0-wj)*(dk ? wk : 1.0-wk);
+        re += w*RE[n];
+        rn += w*RN[n];
+    }
+}
+
+unsigned int BackscatterTable::computed()const{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return Computed;
+}
+
+void BackscatterTable::write_nodes(std::ostream &out)const{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    for( uint32_t n = 0; n < NumNodes; n ++ ){
+        if( !Known[n].load(std::memory_order_acquire) ) continue;
+        out.write(&Material,sizeof(Material));
+        out.write(reinterpret_cast<const char*>(&n),sizeof(n));
+        out.write(reinterpret_cast<const char*>(&RE[n]),sizeof(float));
+        out.write(reinterpret_cast<const char*>(&RN[n]),sizeof(float));
+    }
+}
+
+void BackscatterTable::set_node(uint32_t n, float re, float rn){
+    std::lock_guard<std::mutex> Lock(Mutex);
+    publish(n,re,rn);
+}
+
+//!< Every table in the process, one per material
+static std::mutex TablesMutex;
+static std::map<char,std::shared_ptr<BackscatterTable>> Tables;
+
+std::shared_ptr<BackscatterTable> BackscatterTable::shared(char material){
+    std::lock_guard<std::mutex> Lock(TablesMutex);
+    auto Found = Tables.find(material);
+    if( Found != Tables.end() ) return Found->second;
+    std::shared_ptr<BackscatterTable> Table(new BackscatterTable(material));
+    Tables[material] = Table;
+    return Table;
+}
+
+int BackscatterTable::write_cache(std::string filename){
+    std::ofstream CacheFile(filename,std::ofstream::binary);
+    if( !CacheFile.is_open() ) return 1;
+    uint32_t Layout[3] = {Backscatter::NT,Backscatter::NT,Backscatter::NPot};
+    CacheFile.write(CacheMagic,sizeof(CacheMagic));
+    CacheFile.write(reinterpret_cast<const char*>(Layout),sizeof(Layout));
+    //!< Only computed nodes are stored, as their material, index and values
+    std::lock_guard<std::mutex> Lock(TablesMutex);
+    for( auto &Table : Tables ) Table.second->write_nodes(CacheFile);
+    CacheFile.close();
+    return CacheFile.fail() ? 1 : 0;
+}
+
+int BackscatterTable::read_cache(std::string filename){
+    std::ifstream CacheFile(filename,std::ifstream::binary);
+    if( !CacheFile.is_open() ) return 1;
+    char Magic[sizeof(CacheMagic)];
+    uint32_t Layout[3] = {0,0,0};
+    if( !CacheFile.read(Magic,sizeof(Magic))
+        || std::memcmp(Magic,CacheMagic,sizeof(Magic)) != 0
+        || !CacheFile.read(reinterpret_cast<char*>(Layout),sizeof(Layout)) )
+        return 2;
+    if( Layout[0] != Backscatter::NT || Layout[1] != Backscatter::NT
+        || Layout[2] != Backscatter::NPot )
+        return 2;
+
+    char Material(0);
+    uint32_t n(0);
+    float re(0.0), rn(0.0);
+    while( CacheFile.read(&Material,sizeof(Material))
+        && CacheFile.read(reinterpret_cast<char*>(&n),sizeof(n))
+        && CacheFile.read(reinterpret_cast<char*>(&re),sizeof(re))
+        && CacheFile.read(reinterpret_cast<char*>(&rn),sizeof(rn)) ){
+        if( n >= NumNodes ) return 2;
+        shared(Material)->set_node(n,re,rn);
+    }
+    return 0;
+}
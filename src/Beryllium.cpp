@@ -34,6 +34,40 @@ const struct ElementConsts BerylliumConsts = {
     0.200,            //!< kW/mK, from Wikipedia,
 };
 
+/** @brief Heat capacity of beryllium in J/(mol K) at \p Temperature
+ */
+static double heatcapacity(double Temperature){
+    //!< Temperature dependent heat capacity model taken from:
+    //!< http://webbook.nist.gov/cgi/inchi?ID=C7440417&Mask=2
+    double t = Temperature/1000;
+    if( Temperature <= 1527 ){ 
+        return 21.20694+5.688190*t+0.968019*pow(t,2)-
+            0.001749*pow(t,3)-0.587526/(pow(t,2));
+    }else if( Temperature <= BerylliumConsts.MeltingTemp ){
+        return 30.00037-0.000396*t+0.000169*pow(t,2)-
+            0.000026*pow(t,3)-0.000105/(pow(t,2));
+    }
+    return 25.42516+2.157953*t-0.002573*pow(t,2)+
+        0.000287*pow(t,3)+0.003958/(pow(t,2));
+}
+
+//!< Also available from wikipedia in pascal: 
+//!< https://en.wikipedia.org
+//!< /wiki/Vapor_pressures_of_the_elements_(data_page)
+/** @brief Vapour pressure of solid beryllium in Pa at \p Temperature
+ */
+static double solid_vapourpressure(double Temperature){
+    // http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
+    return 101325*pow(10,8.042 -17020/Temperature-0.444*log10(Temperature));
+}
+
+/** @brief Vapour pressure of liquid beryllium in Pa at \p Temperature
+ */
+static double liquid_vapourpressure(double Temperature){
+    // http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
+    return 101325*pow(10,5.786 -15731/Temperature);
+}
+
 
 Beryllium::Beryllium():Matter(BerylliumConsts){
     E_Debug("\n\nIn Beryllium::Beryllium():Matter(BerylliumConsts)");
@@ -118,29 +152,21 @@ void Beryllium::set_defaults(){
 
 void Beryllium::update_heatcapacity(){ 
     E_Debug("\n\n\tIn Beryllium::update_heatcapacity()");
+    static const PropertyTable Table(heatcapacity,
+        {298,1527,BerylliumConsts.MeltingTemp,2*BerylliumConsts.BoilingTemp},
+        Tabulation::Linear);
 
-    double t = St.Temperature/1000;
-    //!< Temperature dependent heat capacity model taken from:
-    //!< http://webbook.nist.gov/cgi/inchi?ID=C7440417&Mask=2
     if( St.Temperature > 250 && St.Temperature <= 298 ){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Beryllium::update_heatcapacity():";
         WarningMessage += "\nExtending model outside range!";
         WarningMessage += " from T > 298 to T > 250";
         WarnOnce(runOnce,WarningMessage);
-        
-        St.HeatCapacity = 21.20694+5.688190*t+0.968019*pow(t,2)-
-            0.001749*pow(t,3)-0.587526/(pow(t,2));
-    }else if( St.Temperature > 298 && St.Temperature <= 1527 ){ 
-        St.HeatCapacity = 21.20694+5.688190*t+0.968019*pow(t,2)-
-            0.001749*pow(t,3)-0.587526/(pow(t,2));
-    }else if( St.Temperature > 1527 && St.Temperature <= Ec.MeltingTemp ){
-        St.HeatCapacity = 30.00037-0.000396*t+0.000169*pow(t,2)-
-            0.000026*pow(t,3)-0.000105/(pow(t,2));
-    }else if( St.Temperature > Ec.MeltingTemp 
-        && St.Temperature <= St.SuperBoilingTemp ){
-        St.HeatCapacity = 25.42516+2.157953*t-0.002573*pow(t,2)+
-            0.000287*pow(t,3)+0.003958/(pow(t,2));
+    }
+    if( St.Temperature > 250 && ( St.Temperature <= Ec.MeltingTemp 
+        || St.Temperature <= St.SuperBoilingTemp ) ){
+        if( !Table.lookup(St.Temperature,St.HeatCapacity) )
+            St.HeatCapacity = heatcapacity(St.Temperature);
     }
 
     E1_Debug("\n\tTemperature is : " << St.Temperature << "\n\tSt.Gas = " 
@@ -155,7 +181,7 @@ void Beryllium::update_radius(){
     //!< Temperature dependent expansion model taken from:
     //!< www-ferp.ucsd.edu/LIB/PROPS/PANOS/be.html
     if( St.Temperature > 250 && St.Temperature <= 298 ){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Beryllium::update_radius():\n";
         WarningMessage += "Extending model outside range!";
         WarningMessage += " (from T<298K to T<250K)";
@@ -168,7 +194,7 @@ void Beryllium::update_radius(){
             1.1464e-2*St.Temperature+2.9752e-6*pow(St.Temperature,2));
     }else if( St.Temperature >= Ec.MeltingTemp 
         && St.Temperature <= St.SuperBoilingTemp){ 
-        static bool runOncetwo = true;
+        static std::atomic<bool> runOncetwo(true);
         std::string WarningMessage = "In Beryllium::update_radius():\n";
         WarningMessage += "Extending model outside range!";
         WarningMessage += " (from T<Tmelt to T<Tboil)";
@@ -190,21 +216,21 @@ void Beryllium::update_vapourpressure(){
 
 double Beryllium::probe_vapourpressure(double Temperature)const{
     E_Debug("\n\n\tIn Beryllium::update_vapourpressure(double Temperature)");
-    //!< Also available from wikipedia in pascal: 
-    //!< https://en.wikipedia.org
-    //!< /wiki/Vapor_pressures_of_the_elements_(data_page)
+    static const PropertyTable SolidTable(solid_vapourpressure,
+        {298,BerylliumConsts.MeltingTemp},Tabulation::Arrhenius);
+    static const PropertyTable LiquidTable(liquid_vapourpressure,
+        {BerylliumConsts.MeltingTemp,2*BerylliumConsts.BoilingTemp},
+        Tabulation::Arrhenius);
     double VapourPressure(0.0);
     if( !St.Liquid && !St.Gas ){
-        // http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
-        VapourPressure = pow(10,8.042 -17020/Temperature-
-            0.444*log10(Temperature));
+        if( !SolidTable.lookup(Temperature,VapourPressure) )
+            VapourPressure = solid_vapourpressure(Temperature);
     }else if( St.Liquid ){
-        // http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
-        VapourPressure = pow(10,5.786 -15731/Temperature);
+        if( !LiquidTable.lookup(Temperature,VapourPressure) )
+            VapourPressure = liquid_vapourpressure(Temperature);
     }else{
         VapourPressure = 0;
         std::cout << "\nWarning, Sample is assumed gas! St.VapourPressure = 0";
     }
-    VapourPressure = 101325*VapourPressure; //!< Convert to Pascals
     return VapourPressure;
 }
@@ -7,14 +7,23 @@
  *  @bug bugs, they definitely exist
  */
 
+#include <limits>
+#include <stdexcept>
+
 #include "ChargingModel.h"
 
+//!< Range of normalised potential searched, based on mostly negative dust
+//!< typically with low magnitudes of potential. This may fail in unusual cases.
+static const double PotentialMin = -5.0;
+static const double PotentialMax = 10.0;
+
 ChargingModel::ChargingModel():Model(){
     C_Debug("\n\nIn ChargingModel::ChargingModel():Model()\n\n");
     // Charging Models turned on of possible 3
 
     CurrentTerms.push_back(new Term::OMLe());
     CurrentTerms.push_back(new Term::OMLi());
+    ClassifyTerms();
     CreateFile("Data/default_cm_0.txt");
 }
 
@@ -26,6 +35,7 @@ Model(filename,sample,pdata,accuracy){
         << "Matter *& sample, PlasmaData *&pdata) : "
         << "Model(sample,pdata,accuracy)\n\n");
     CurrentTerms = currentterms;
+    ClassifyTerms();
     CreateFile(filename);
 }
 
@@ -37,56 +47,71 @@ Model(filename,sample,*pdata,accuracy){
         << "Matter *& sample, PlasmaData *&pdata) : "
         << "Model(sample,pdata,accuracy)\n\n");
     CurrentTerms = currentterms;
+    ClassifyTerms();
     CreateFile(filename);
 }
 
 ChargingModel::ChargingModel(std::string filename, float accuracy, 
-std::vector<CurrentTerm*> currentterms, Matter *& sample, PlasmaGrid_Data &pgrid):
+std::vector<CurrentTerm*> currentterms, Matter *& sample, 
+std::shared_ptr<const PlasmaGrid_Data> pgrid):
 Model(filename,sample,pgrid,accuracy){
     C_Debug("\n\nIn ChargingModel::ChargingModel(std::string filename, "
         << "float accuracy, std::vector<CurrentTerm*> currentterms, "
-        << "Matter *& sample, PlasmaGrid_Data &pgrid) : "
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid) : "
         << "Model(sample,pgrid,accuracy)\n\n");
     CurrentTerms = currentterms;
+    ClassifyTerms();
     CreateFile(filename);
 }
 
 ChargingModel::ChargingModel(std::string filename, float accuracy, 
-std::vector<CurrentTerm*> currentterms, Matter *& sample, PlasmaGrid_Data &pgrid, 
+std::vector<CurrentTerm*> currentterms, Matter *& sample, 
+std::shared_ptr<const PlasmaGrid_Data> pgrid, 
 PlasmaData &pdata):
 Model(filename,sample,pgrid,pdata,accuracy){
     C_Debug("\n\nIn ChargingModel::ChargingModel(std::string filename, "
         << "float accuracy, std::vector<CurrentTerm*> currentterms, "
-        << "Matter *& sample, PlasmaGrid_Data &pgrid) : "
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid) : "
         << "Model(sample,pgrid,accuracy)\n\n");
     CurrentTerms = currentterms;
+    ClassifyTerms();
     CreateFile(filename);
 }
 
+void ChargingModel::ClassifyTerms(){
+    C_Debug("\tIn ChargingModel::ClassifyTerms()\n\n");
+    SEEIndex = -1;
+    ThermionicEmission = false;
+    for( unsigned int n = 0; n < CurrentTerms.size(); n ++ ){
+        std::string Name = CurrentTerms[n]->PrintName();
+        if( Name == "TEEcharge" || Name == "TEESchottky" )
+            ThermionicEmission = true;
+        else if( Name == "SEEcharge" )
+            SEEIndex = n;
+    }
+    if( CurrentTerms.size() > MaxCurrentTerms )
+        throw std::length_error("ChargingModel: more than "
+            + std::to_string(MaxCurrentTerms) + " current terms");
+    Kernel = Term::find_currentkernel(CurrentTerms);
+}
+
 void ChargingModel::CreateFile(std::string filename){
     C_Debug("\tIn ChargingModel::CreateFile(std::string filename)\n\n");
     FileName = filename;
-    ModelDataFile.open(FileName);
-    ModelDataFile << std::scientific << std::setprecision(16) << std::endl;
-    ModelDataFile << "Time\tCharge\tSign\tDeltatot\tPotential\n";
-    ModelDataFile.close();
-    ModelDataFile.clear();
+    ModelDataFile.open(FileName,{ {"Time",Column::Scalar}, 
+        {"Charge",Column::Scalar}, {"Sign",Column::Sign}, 
+        {"Deltatot",Column::Scalar}, {"Potential",Column::Scalar} });
     Print();
 }
 
 void ChargingModel::Print(){
     C_Debug("\tIn ChargingModel::Print()\n\n");
-    ModelDataFile.open(FileName,std::ofstream::app);
-    ModelDataFile << TotalTime << "\t" 
+    ModelDataFile << TotalTime 
         << -(4.0*PI*epsilon0*Sample->get_radius()*Sample->get_potential()*Kb*
-        Pdata->ElectronTemp)/(echarge*echarge);
-    if( Sample->is_positive() )  ModelDataFile << "\tPos";
-    if( !Sample->is_positive() ) ModelDataFile << "\tNeg";
-    ModelDataFile << "\t" << Sample->get_deltatot() << "\t" 
-        << Sample->get_potential() << "\n";
-
-    ModelDataFile.close();
-    ModelDataFile.clear();
+        Pdata->ElectronTemp)/(echarge*echarge)
+        << (Sample->is_positive() ? 1.0 : -1.0)
+        << Sample->get_deltatot() << Sample->get_potential();
+    ModelDataFile.end_row();
 }
 
 double ChargingModel::ProbeTimeStep()const{
@@ -121,19 +146,14 @@ void ChargingModel::Charge(double timestep){
     //!< Calculate Thermionic and secondary electron emission yields for use in
     //!< the heating models
     double DTherm(0.0), DSec(0.0);
-    for(auto iter = CurrentTerms.begin(); iter != CurrentTerms.end(); ++iter) {
-        if( (*iter)->PrintName() == "TEEcharge" ){
-            DTherm = Flux::DeltaTherm(Sample,Pdata);
-        }else if( (*iter)->PrintName() == "TEESchottky" ){
-            DTherm = Flux::DeltaTherm(Sample,Pdata);
-        }
-        if( (*iter)->PrintName() == "SEEcharge" ){
-            DSec = Flux::DeltaSec(Sample,Pdata);
-        }
-    }
+    if( ThermionicEmission ) DTherm = Flux::DeltaTherm(Sample,*Pdata);
+    if( SEEIndex >= 0 ) DSec = Flux::DeltaSec(Sample,*Pdata);
+
+    //!< Implement Brent's method to find root of current balance
+    double Potential = Brent();
 
     //!< Implement Bisection method to find root of current balance
-    double Potential = Bisection();
+    //double Potential = Bisection();
 
     //!< Implement regular falsi method to find root of current balance
     //double Potential = RegulaFalsi();
@@ -156,43 +176,41 @@ void ChargingModel::Charge(){
     Charge(TimeStep);
 }
 
+double ChargingModel::CurrentBalance(double Potential)const{
+    double Current(0.0), FirstCurrent(0.0);
+    if( Kernel != NULL )
+        Kernel->Evaluate(CurrentTerms,Sample,*Pdata,Potential,-1,
+            TermCurrents.data());
+    for( unsigned int n = 0; n < CurrentTerms.size(); n ++ ){
+        double Term = Kernel != NULL ? TermCurrents[n]
+            : CurrentTerms[n]->Evaluate(Sample,*Pdata,Potential);
+        if( n == 0 ) FirstCurrent = Term;
+        if( (int)n == SEEIndex ) Term *= FirstCurrent;
+        C_Debug( "\n\t\t" << CurrentTerms[n]->PrintName() << " = " << Term 
+            << "\n" );
+        Current += Term;
+    }
+    return Current;
+}
+
 double ChargingModel::Bisection()const{
     C_Debug("\tIn ChargingModel::Bisection()\n\n");
     //!< Implement Bisection method to find root of current balance
-    //!< Initial range of normalised potential based on mostly negative dust
-    //!< typically with low magntiudes of potential. This may fail in unusual
-    //!< cases.
-    double a(-5.0), b(10.0);
-    double Current1(0.0), Current2(0.0), Potential(0.0);
+    double a(PotentialMin), b(PotentialMax);
+    double Current1(0.0), Current2(CurrentBalance(a)), Potential(0.0);
     int i(0), imax(1000);
     do{ //!< Do while difference in bounds is greater than accuracy
         //!< Take new x position as halfway between upper and lower bound
         Potential = (a+b)/2.0;
+        Current1 = CurrentBalance(Potential);
 
-        //!< Sum all the terms in the current balance
-        for(auto iter = CurrentTerms.begin(); iter != CurrentTerms.end(); 
-            ++iter) {
-            if( (*iter)->PrintName() == "SEEcharge" ){
-                Current1 += (*iter)->Evaluate(Sample,Pdata,Potential)
-                    *CurrentTerms[0]->Evaluate(Sample,Pdata,Potential);
-                Current2 += (*iter)->Evaluate(Sample,Pdata,a)
-                    *CurrentTerms[0]->Evaluate(Sample,Pdata,a);
-                C_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
-                    << (*iter)->Evaluate(Sample,Pdata,Potential)
-                    *CurrentTerms[0]->Evaluate(Sample,Pdata,Potential)  
-                    << "\n" );
-            }else{
-                Current1 += (*iter)->Evaluate(Sample,Pdata,Potential);
-                Current2 += (*iter)->Evaluate(Sample,Pdata,a);
-                C_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
-                    << (*iter)->Evaluate(Sample,Pdata,Potential) << "\n");
-            }
-        }
         //!< If the root is on the RHS of our midpoint
-        if( Current1*Current2 > 0.0 )
+        if( Current1*Current2 > 0.0 ){
             a = Potential;
-        else //!< Else, it must be on LHS of our midpoint
+            Current2 = Current1;
+        }else{ //!< Else, it must be on LHS of our midpoint
             b = Potential;
+        }
 
         //!< Ensure we don't loop forever
         if( i > imax ){
@@ -209,32 +227,10 @@ double ChargingModel::Bisection()const{
 double ChargingModel::RegulaFalsi()const{
     C_Debug("\tIn ChargingModel::RegulaFalsi()\n\n");
     //!< Implement regula falsi method to find root of current balance
-    //!< Initial range of normalised potential based on mostly negative dust
-    //!< typically with low magntiudes of potential. This may fail in unusual
-    //!< cases.
-
-    double Current1(0.0), Current2(0.0);
-    double a(-5.0), b(10.0);
-    double amin(-5.0), bmax(10.0);
-    //!< Sum all the terms in the current balance
-    for(auto iter = CurrentTerms.begin(); iter != CurrentTerms.end(); 
-        ++iter) {
-        if( (*iter)->PrintName() == "SEEcharge" ){
-            Current1 += (*iter)->Evaluate(Sample,Pdata,a)
-                *CurrentTerms[0]->Evaluate(Sample,Pdata,a);
-            Current2 += (*iter)->Evaluate(Sample,Pdata,b)
-                *CurrentTerms[0]->Evaluate(Sample,Pdata,b);
-            C_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
-                << (*iter)->Evaluate(Sample,Pdata,a)
-                *CurrentTerms[0]->Evaluate(Sample,Pdata,a)  
-                << "\n" );
-        }else{
-            Current1 += (*iter)->Evaluate(Sample,Pdata,a);
-            Current2 += (*iter)->Evaluate(Sample,Pdata,b);
-            C_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
-                << (*iter)->Evaluate(Sample,Pdata,a) << "\n");
-        }
-    }
+    double a(PotentialMin), b(PotentialMax);
+    double amin(PotentialMin), bmax(PotentialMax);
+    double Current1 = CurrentBalance(a);
+    double Current2 = CurrentBalance(b);
 
     int side(0), imax(10000);
     double Potential(0.0);
@@ -245,24 +241,7 @@ double ChargingModel::RegulaFalsi()const{
         //!< If we're within accuracy, return result
         if (fabs(b-a) < Accuracy*fabs(b+a) && b < bmax && a > amin )
             return Potential;
-        double Current3(0.0);
-
-        //!< Sum all the terms in the current balance
-        for(auto iter = CurrentTerms.begin(); iter != CurrentTerms.end(); 
-            ++iter){
-            if( (*iter)->PrintName() == "SEEcharge" ){
-                Current1 += (*iter)->Evaluate(Sample,Pdata,Potential)
-                    *CurrentTerms[0]->Evaluate(Sample,Pdata,Potential);
-                C_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
-                    << (*iter)->Evaluate(Sample,Pdata,Potential)
-                    *CurrentTerms[0]->Evaluate(Sample,Pdata,Potential)  
-                    << "\n" );
-            }else{
-                Current3 += (*iter)->Evaluate(Sample,Pdata,Potential);
-                C_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
-                    << (*iter)->Evaluate(Sample,Pdata,Potential) << "\n");
-            }
-        }
+        double Current3 = CurrentBalance(Potential);
 
         if(Current3 * Current2 > 0){
             //!< Current3 and Current2 have same sign, copy Potential to b
@@ -290,3 +269,97 @@ double ChargingModel::RegulaFalsi()const{
     Potential = 0.0;
     return Potential;
 }
+
+bool ChargingModel::Bracket(double &a, double &b, double &fa, double &fb)const{
+    C_Debug("\tIn ChargingModel::Bracket(double &a, double &b, double &fa, "
+        << "double &fb)const\n\n");
+    //!< The root is usually close to the last potential, which is zero before
+    //!< the dust is first charged
+    double Start = std::min(std::max(Sample->get_potential(),PotentialMin),
+        PotentialMax);
+    double Width(Accuracy);
+    a = std::max(Start-Width,PotentialMin);
+    b = std::min(Start+Width,PotentialMax);
+    fa = CurrentBalance(a);
+    fb = CurrentBalance(b);
+    while( fa*fb > 0.0 ){
+        if( a == PotentialMin && b == PotentialMax ) return false;
+        Width *= 4.0;
+        //!< Extend towards the root, which lies beyond the bound at which the
+        //!< magnitude of the current is smaller
+        if( b == PotentialMax || (fabs(fa) < fabs(fb) && a > PotentialMin) ){
+            a = std::max(a-Width,PotentialMin);
+            fa = CurrentBalance(a);
+        }else{
+            b = std::min(b+Width,PotentialMax);
+            fb = CurrentBalance(b);
+        }
+    }
+    return true;
+}
+
+double ChargingModel::Brent()const{
+    C_Debug("\tIn ChargingModel::Brent()\n\n");
+    double a(0.0), b(0.0), fa(0.0), fb(0.0);
+    if( !Bracket(a,b,fa,fb) ){
+        std::cerr << "ChargingModel::Brent Root Finding failed to bracket "
+            << "root in [" << PotentialMin << "," << PotentialMax 
+            << "]! Setting Potential = 0.0\n";
+        return 0.0;
+    }
+    //!< c is the previous bound, with the root between b and c
+    double c(b), fc(fb), d(0.0), e(0.0);
+    const double Epsilon = std::numeric_limits<double>::epsilon();
+    int imax(100);
+    for( int i = 0; i < imax; i ++ ){
+        if( (fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0) ){
+            c = a; fc = fa;
+            d = b-a; e = d;
+        }
+        //!< Keep b as the best estimate of the root
+        if( fabs(fc) < fabs(fb) ){
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+        double Tolerance = 2.0*Epsilon*fabs(b)+0.5*Accuracy;
+        double Midpoint = 0.5*(c-b);
+        if( fabs(Midpoint) <= Tolerance || fb == 0.0 ) return b;
+
+        if( fabs(e) >= Tolerance && fabs(fa) > fabs(fb) ){
+            //!< Attempt inverse quadratic interpolation, or the secant method
+            //!< if only two points are distinct
+            double p(0.0), q(0.0), s = fb/fa;
+            if( a == c ){
+                p = 2.0*Midpoint*s;
+                q = 1.0-s;
+            }else{
+                double r = fb/fc;
+                q = fa/fc;
+                p = s*(2.0*Midpoint*q*(q-r)-(b-a)*(r-1.0));
+                q = (q-1.0)*(r-1.0)*(s-1.0);
+            }
+            if( p > 0.0 ) q = -q;
+            p = fabs(p);
+            //!< Accept interpolation only if it falls within the bounds and 
+            //!< converges faster than bisection
+            if( 2.0*p < std::min(3.0*Midpoint*q-fabs(Tolerance*q),fabs(e*q)) ){
+                e = d;
+                d = p/q;
+            }else{
+                d = Midpoint; e = d;
+            }
+        }else{
+            //!< Bounds decreasing too slowly, use bisection
+            d = Midpoint; e = d;
+        }
+        a = b; fa = fb;
+        if( fabs(d) > Tolerance )
+            b += d;
+        else
+            b += (Midpoint > 0.0 ? Tolerance : -Tolerance);
+        fb = CurrentBalance(b);
+    }
+    std::cerr << "ChargingModel::Brent Root Finding failed to "
+        << "converge in " << imax << " steps! Setting Potential = 0.0\n";
+    return 0.0;
+}
@@ -0,0 +1,196 @@
+/** @file Checkpoint.cpp
+ *  @brief Implementation of the checkpoints of simulations
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <fstream>
+#include <iostream>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+#include <unistd.h>     //!< truncate()
+
+#include "Checkpoint.h"
+
+//!< Identifies a checkpoint file, followed by the format version
+static const char CheckpointMagic[8] = {'D','T','O','K','S','C','H','K'};
+static const uint32_t CheckpointVersion = 1;
+//!< Written in native byte order so that the reader can detect a mismatch
+static const uint32_t ByteOrderMark = 0x01020304;
+
+int CheckpointReader::read(std::string filename){
+    std::ifstream File(filename,std::ifstream::binary);
+    if( !File.is_open() ) return 1;
+
+    char Magic[sizeof(CheckpointMagic)];
+    uint32_t Version(0), ByteOrder(0);
+    uint64_t Size(0);
+    if( !File.read(Magic,sizeof(Magic))
+        || std::memcmp(Magic,CheckpointMagic,sizeof(Magic)) != 0 ) return 2;
+    if( !File.read(reinterpret_cast<char*>(&Version),sizeof(Version))
+        || Version != CheckpointVersion ) return 2;
+    if( !File.read(reinterpret_cast<char*>(&ByteOrder),sizeof(ByteOrder))
+        || ByteOrder != ByteOrderMark ) return 2;
+    if( !File.read(reinterpret_cast<char*>(&Size),sizeof(Size)) ) return 2;
+
+    std::string NewData(Size,'\0');
+    if( Size > 0 && !File.read(&NewData[0],Size) ) return 2;
+    //!< Anything left over is not part of the checkpoint
+    if( File.peek() != std::ifstream::traits_type::eof() ) return 2;
+
+    Data = std::move(NewData);
+    Position = 0;
+    Failed = false;
+    return 0;
+}
+
+CheckpointReader &CheckpointReader::operator>>(threevector &vec){
+    double x(0.0), y(0.0), z(0.0);
+    *this >> x >> y >> z;
+    if( !Failed ) vec = threevector(x,y,z);
+    return *this;
+}
+
+CheckpointReader &CheckpointReader::operator>>(std::string &str){
+    unsigned long long Length(0);
+    *this >> Length;
+    if( Failed || Data.size()-Position < Length ){
+        Failed = true;
+        return *this;
+    }
+    str.assign(Data,Position,Length);
+    Position += Length;
+    return *this;
+}
+
+//!< Write \p data to \p filename, through a temporary file
+static bool write_file(const std::string &filename, const std::string &data){
+    std::string Temporary = filename + ".tmp";
+    {
+        std::ofstream File(Temporary,
+            std::ofstream::binary|std::ofstream::trunc);
+        if( !File.is_open() ) return false;
+        uint64_t Size = data.size();
+        File.write(CheckpointMagic,sizeof(CheckpointMagic));
+        File.write(reinterpret_cast<const char*>(&CheckpointVersion),
+            sizeof(CheckpointVersion));
+        File.write(reinterpret_cast<const char*>(&ByteOrderMark),
+            sizeof(ByteOrderMark));
+        File.write(reinterpret_cast<const char*>(&Size),sizeof(Size));
+        File.write(data.data(),data.size());
+        File.flush();
+        if( !File ) return false;
+    }
+    return std::rename(Temporary.c_str(),filename.c_str()) == 0;
+}
+
+namespace{
+//!< A write or removal of a checkpoint file waiting to be carried out
+struct CheckpointTask{
+    std::string FileName;
+    std::string Data;
+    bool Remove;
+};
+
+/** @brief The thread carrying out the queued writes and removals in order
+ *
+ *  Started by the first task queued and stopped, once the queue is empty,
+ *  when the program exits.
+ */
+class CheckpointThread{
+    private:
+        std::mutex Mutex;
+        std::condition_variable Ready;      //!< Signals a task was queued
+        std::condition_variable Finished;   //!< Signals the queue emptied
+        std::deque<CheckpointTask> Queue;
+        bool Busy;                          //!< A task is being carried out
+        bool Stopping;
+        std::thread Thread;
+
+        void run(){
+            std::unique_lock<std::mutex> Lock(Mutex);
+            while( true ){
+                Ready.wait(Lock,[this]{ return !Queue.empty() || Stopping; });
+                if( Queue.empty() ) break;
+                CheckpointTask Task = std::move(Queue.front());
+                Queue.pop_front();
+                Busy = true;
+                Lock.unlock();
+
+                if( Task.Remove ){
+                    std::remove(Task.FileName.c_str());
+                }else if( !write_file(Task.FileName,Task.Data) ){
+                    std::cerr << "\nFailed to write checkpoint "
+                        << Task.FileName;
+                }
+
+                Lock.lock();
+                Busy = false;
+                if( Queue.empty() ) Finished.notify_all();
+            }
+        }
+
+    public:
+        CheckpointThread():Busy(false),Stopping(false){}
+        ~CheckpointThread(){
+            {
+                std::lock_guard<std::mutex> Lock(Mutex);
+                Stopping = true;
+            }
+            Ready.notify_all();
+            if( Thread.joinable() ) Thread.join();
+        }
+
+        void submit(CheckpointTask Task){
+            {
+                std::lock_guard<std::mutex> Lock(Mutex);
+                if( !Thread.joinable() )
+                    Thread = std::thread(&CheckpointThread::run,this);
+                //!< A newer state of the same file supersedes one not begun
+                if( !Task.Remove && !Queue.empty() && !Queue.back().Remove
+                    && Queue.back().FileName == Task.FileName ){
+                    Queue.back() = std::move(Task);
+                }else{
+                    Queue.push_back(std::move(Task));
+                }
+            }
+            Ready.notify_one();
+        }
+
+        void wait(){
+            std::unique_lock<std::mutex> Lock(Mutex);
+            Finished.wait(Lock,[this]{ return Queue.empty() && !Busy; });
+        }
+};
+
+CheckpointThread &checkpoint_thread(){
+    static CheckpointThread Writer;
+    return Writer;
+}
+}
+
+void Checkpoints::write_async(std::string filename, const std::string &data){
+    checkpoint_thread().submit(CheckpointTask{filename,data,false});
+}
+
+void Checkpoints::remove_async(std::string filename){
+    checkpoint_thread().submit(CheckpointTask{filename,"",true});
+}
+
+void Checkpoints::wait(){
+    checkpoint_thread().wait();
+}
+
+bool Checkpoints::truncate_file(std::string filename, 
+    unsigned long long length){
+    std::ifstream File(filename,std::ifstream::binary|std::ifstream::ate);
+    if( !File.is_open() || (unsigned long long)File.tellg() < length ) 
+        return false;
+    File.close();
+    return truncate(filename.c_str(),length) == 0;
+}
@@ -11,11 +11,15 @@
 
 DTOKSU::DTOKSU( std::array<float,MN> acclvls, Matter *& sample, PlasmaData 
 &pdata, std::vector<HeatTerm*> HeatTerms, std::vector<ForceTerm*> ForceTerms, 
-std::vector<CurrentTerm*> CurrentTerms): 
+std::vector<CurrentTerm*> CurrentTerms, std::string filename, 
+unsigned int i): 
 Sample(sample), WallBound(BoundaryDefaults), CoreBound(BoundaryDefaults),
-HM("Data/default_hm_0.txt",acclvls[1],HeatTerms,sample,pdata),
-FM("Data/default_fm_0.txt",acclvls[2],ForceTerms,sample,pdata),
-CM("Data/default_cm_0.txt",acclvls[0],CurrentTerms,sample,pdata){
+HM(filename+"_hm_"+std::to_string(i)+".txt",
+    acclvls[1],HeatTerms,sample,pdata),
+FM(filename+"_fm_"+std::to_string(i)+".txt",
+    acclvls[2],ForceTerms,sample,pdata),
+CM(filename+"_cm_"+std::to_string(i)+".txt",
+    acclvls[0],CurrentTerms,sample,pdata){
     D_Debug("\n\nIn DTOKSU::DTOKSU( std::array<float,MN> acclvls, "
         << "Matter *& sample, PlasmaData &pdata, "
         << "std::vector<HeatTerm*> HeatTerms, "
@@ -23,92 +27,162 @@ CM("Data/default_cm_0.txt",acclvls[0],CurrentTerms,sample,pdata){
         << "std::vector<CurrentTerm*> CurrentTerms): "
         << "Sample(sample), WallBound(BoundaryDefaults), "
         << "CoreBound(BoundaryDefaults),"
-        << "HM(\"Data/default_hm_0.txt\",acclvls[1],heatmodels,sample,pdata),"
-        << "FM(\"Data/default_fm_0.txt\",acclvls[2],forcemodels,sample,pdata),"
-        << "CM(\"Data/default_cm_0.txt\",acclvls[0],chargemodels,sample,pdata)"
+        << "HM(filename+\"_hm_\"+i,acclvls[1],heatmodels,sample,pdata),"
+        << "FM(filename+\"_fm_\"+i,acclvls[2],forcemodels,sample,pdata),"
+        << "CM(filename+\"_cm_\"+i,acclvls[0],chargemodels,sample,pdata)"
         << "\n\n");
     D_Debug("\n\n******************* SETUP FINISHED ******************* \n\n");
 
     TotalTime = 0;
-    create_file("Data/df.txt");
+    PlasmaDataFileName = "pd";
+    OutputFormat = Output::Text;
+    CheckpointInterval = 0.0;
+    CheckpointDeposition = false;
+    Resuming = false;
+    ResumeErrorFlag = false;
+    share_plasmastate();
+    create_file(filename+"_df_"+std::to_string(i)+".txt");
 }
 
 DTOKSU::DTOKSU( std::array<float,MN> acclvls, Matter *& sample,
-PlasmaGrid_Data &pgrid,std::vector<HeatTerm*> HeatTerms, 
-std::vector<ForceTerm*> ForceTerms, std::vector<CurrentTerm*> CurrentTerms):
+std::shared_ptr<const PlasmaGrid_Data> pgrid,std::vector<HeatTerm*> HeatTerms, 
+std::vector<ForceTerm*> ForceTerms, std::vector<CurrentTerm*> CurrentTerms,
+std::string filename, unsigned int i):
 Sample(sample), WallBound(BoundaryDefaults), CoreBound(BoundaryDefaults),
-HM("Data/default_hm_0.txt",acclvls[1],HeatTerms,sample,pgrid),
-FM("Data/default_fm_0.txt",acclvls[2],ForceTerms,sample,pgrid),
-CM("Data/default_cm_0.txt",acclvls[0],CurrentTerms,sample,pgrid){
+HM(filename+"_hm_"+std::to_string(i)+".txt",
+    acclvls[1],HeatTerms,sample,pgrid),
+FM(filename+"_fm_"+std::to_string(i)+".txt",
+    acclvls[2],ForceTerms,sample,pgrid),
+CM(filename+"_cm_"+std::to_string(i)+".txt",
+    acclvls[0],CurrentTerms,sample,pgrid){
     D_Debug("\n\nIn DTOKSU::DTOKSU( std::array<float,MN> acclvls, "
-        << "Matter *& sample, PlasmaGrid_Data &pgrid, "
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid, "
         << "std::vector<HeatTerm*> HeatTerms, "
         << "std::vector<ForceTerm*> ForceTerms, "
         << "std::vector<CurrentTerm*> CurrentTerms): "
         << "Sample(sample), WallBound(BoundaryDefaults), "
         << "CoreBound(BoundaryDefaults),"
-        << "HM(\"Data/default_hm_0.txt\",acclvls[1],heatmodels,sample,pdata),"
-        << "FM(\"Data/default_fm_0.txt\",acclvls[2],forcemodels,sample,pdata),"
-        << "CM(\"Data/default_cm_0.txt\",acclvls[0],chargemodels,sample,pdata)"
+        << "HM(filename+\"_hm_\"+i,acclvls[1],heatmodels,sample,pdata),"
+        << "FM(filename+\"_fm_\"+i,acclvls[2],forcemodels,sample,pdata),"
+        << "CM(filename+\"_cm_\"+i,acclvls[0],chargemodels,sample,pdata)"
         << "\n\n");
     D_Debug("\n\n******************* SETUP FINISHED ******************* \n\n");
 
     TotalTime = 0;
-    create_file("Data/df.txt");
+    PlasmaDataFileName = "pd";
+    OutputFormat = Output::Text;
+    CheckpointInterval = 0.0;
+    CheckpointDeposition = false;
+    Resuming = false;
+    ResumeErrorFlag = false;
+    share_plasmastate();
+    create_file(filename+"_df_"+std::to_string(i)+".txt");
 }
 
 DTOKSU::DTOKSU( std::array<float,MN> acclvls, Matter *& sample, 
-PlasmaGrid_Data &pgrid, PlasmaData &pdata, std::vector<HeatTerm*> HeatTerms, 
-std::vector<ForceTerm*> ForceTerms, std::vector<CurrentTerm*> CurrentTerms): 
+std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata, 
+std::vector<HeatTerm*> HeatTerms, 
+std::vector<ForceTerm*> ForceTerms, std::vector<CurrentTerm*> CurrentTerms,
+std::string filename, unsigned int i): 
 Sample(sample), WallBound(BoundaryDefaults), CoreBound(BoundaryDefaults),
-HM("Data/default_hm_0.txt",acclvls[1],HeatTerms,sample,pgrid,pdata),
-FM("Data/default_fm_0.txt",acclvls[2],ForceTerms,sample,pgrid,pdata),
-CM("Data/default_cm_0.txt",acclvls[0],CurrentTerms,sample,pgrid,pdata){
+HM(filename+"_hm_"+std::to_string(i)+".txt",
+    acclvls[1],HeatTerms,sample,pgrid,pdata),
+FM(filename+"_fm_"+std::to_string(i)+".txt",
+    acclvls[2],ForceTerms,sample,pgrid,pdata),
+CM(filename+"_cm_"+std::to_string(i)+".txt",
+    acclvls[0],CurrentTerms,sample,pgrid,pdata){
     D_Debug("\n\nIn DTOKSU::DTOKSU( std::array<float,MN> acclvls, "
-        << "Matter *& sample, PlasmaGrid_Data &pgrid, PlasmaData &pdata,"
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid, "
+        << "PlasmaData &pdata,"
         << "std::vector<HeatTerm*> HeatTerms, "
         << "std::vector<ForceTerm*> ForceTerms, "
         << "std::vector<CurrentTerm*> CurrentTerms): "
         << "Sample(sample), WallBound(BoundaryDefaults), "
         << "CoreBound(BoundaryDefaults),"
-        << "HM(\"Data/default_hm_0.txt\",acclvls[1],heatmodels,sample,pdata),"
-        << "FM(\"Data/default_fm_0.txt\",acclvls[2],forcemodels,sample,pdata),"
-        << "CM(\"Data/default_cm_0.txt\",acclvls[0],chargemodels,sample,pdata)"
+        << "HM(filename+\"_hm_\"+i,acclvls[1],heatmodels,sample,pdata),"
+        << "FM(filename+\"_fm_\"+i,acclvls[2],forcemodels,sample,pdata),"
+        << "CM(filename+\"_cm_\"+i,acclvls[0],chargemodels,sample,pdata)"
         << "\n\n");
     D_Debug("\n\n******************* SETUP FINISHED ******************* \n\n");
 
     TotalTime = 0;
-    create_file("Data/df.txt");
+    PlasmaDataFileName = "pd";
+    OutputFormat = Output::Text;
+    CheckpointInterval = 0.0;
+    CheckpointDeposition = false;
+    Resuming = false;
+    ResumeErrorFlag = false;
+    share_plasmastate();
+    create_file(filename+"_df_"+std::to_string(i)+".txt");
 }
 
 DTOKSU::DTOKSU( std::array<float,MN> acclvls, Matter *& sample, 
-PlasmaGrid_Data &pgrid, PlasmaData &pdata, Boundary_Data &wbound, 
-Boundary_Data &cbound, std::vector<HeatTerm*> HeatTerms, 
-std::vector<ForceTerm*> ForceTerms, std::vector<CurrentTerm*> CurrentTerms): 
+std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata, 
+Boundary_Data &wbound, Boundary_Data &cbound, 
+std::vector<HeatTerm*> HeatTerms, 
+std::vector<ForceTerm*> ForceTerms, std::vector<CurrentTerm*> CurrentTerms,
+std::string filename, unsigned int i): 
 Sample(sample), WallBound(wbound), CoreBound(cbound),
-HM("Data/default_hm_0.txt",acclvls[1],HeatTerms,sample,pgrid,pdata),
-FM("Data/default_fm_0.txt",acclvls[2],ForceTerms,sample,pgrid,pdata),
-CM("Data/default_cm_0.txt",acclvls[0],CurrentTerms,sample,pgrid,pdata){
+HM(filename+"_hm_"+std::to_string(i)+".txt",
+    acclvls[1],HeatTerms,sample,pgrid,pdata),
+FM(filename+"_fm_"+std::to_string(i)+".txt",
+    acclvls[2],ForceTerms,sample,pgrid,pdata),
+CM(filename+"_cm_"+std::to_string(i)+".txt",
+    acclvls[0],CurrentTerms,sample,pgrid,pdata){
     D_Debug("\n\nIn DTOKSU::DTOKSU( std::array<float,MN> acclvls, "
-        << "Matter *& sample, PlasmaGrid_Data &pgrid, PlasmaData &pdata,"
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid, "
+        << "PlasmaData &pdata,"
         << "Boundary_Data &wbound, Boundary_Data &cbound,"
         << "std::vector<HeatTerm*> HeatTerms, "
         << "std::vector<ForceTerm*> ForceTerms, "
         << "std::vector<CurrentTerm*> CurrentTerms): "
         << "Sample(sample), WallBound(BoundaryDefaults), "
         << "CoreBound(BoundaryDefaults),"
-        << "HM(\"Data/default_hm_0.txt\",acclvls[1],heatmodels,sample,pdata),"
-        << "FM(\"Data/default_fm_0.txt\",acclvls[2],forcemodels,sample,pdata),"
-        << "CM(\"Data/default_cm_0.txt\",acclvls[0],chargemodels,sample,pdata)"
+        << "HM(filename+\"_hm_\"+i,acclvls[1],heatmodels,sample,pdata),"
+        << "FM(filename+\"_fm_\"+i,acclvls[2],forcemodels,sample,pdata),"
+        << "CM(filename+\"_cm_\"+i,acclvls[0],chargemodels,sample,pdata)"
         << "\n\n");
     D_Debug("\n\n******************* SETUP FINISHED ******************* \n\n");
 
     TotalTime = 0;
-    create_file("Data/df.txt");
+    PlasmaDataFileName = "pd";
+    OutputFormat = Output::Text;
+    CheckpointInterval = 0.0;
+    CheckpointDeposition = false;
+    Resuming = false;
+    ResumeErrorFlag = false;
+    share_plasmastate();
+    create_file(filename+"_df_"+std::to_string(i)+".txt");
+}
+
+DTOKSU::DTOKSU( const DTOKSU &other, Matter *sample ):
+TotalTime(other.TotalTime), Sample(sample), HM(other.HM), FM(other.FM), 
+CM(other.CM), WallBound(other.WallBound), CoreBound(other.CoreBound),
+PlasmaDataFileName(other.PlasmaDataFileName), 
+OutputFormat(other.OutputFormat), CheckpointFileName(other.CheckpointFileName),
+CheckpointInterval(other.CheckpointInterval), 
+CheckpointDeposition(other.CheckpointDeposition), 
+NextCheckpoint(other.NextCheckpoint), Resuming(false), 
+ResumeErrorFlag(false){
+    D_Debug("\n\nIn DTOKSU::DTOKSU( const DTOKSU &other, Matter *sample )"
+        << "\n\n");
+    HM.set_sample(sample);
+    FM.set_sample(sample);
+    CM.set_sample(sample);
+    share_plasmastate();
+}
+
+void DTOKSU::share_plasmastate(){
+    D_Debug("\n\nIn DTOKSU::share_plasmastate()\n\n");
+    PlasmaState = CM.get_localstate();
+    HM.share_localstate(PlasmaState);
+    FM.share_localstate(PlasmaState);
 }
 
 void DTOKSU::create_file( std::string filename ){
     D_Debug("\n\nIn DTOKSU::create_file(std::string filename)\n\n");
+    if( MyFile.is_open() ) MyFile.close();
+    DataFileName = filename;
     MyFile.open(filename);
     MyFile << "TotalTime\n";
 }
@@ -116,10 +190,20 @@ void DTOKSU::create_file( std::string filename ){
 void DTOKSU::OpenFiles( std::string filename, unsigned int i ){
     D_Debug("\n\nIn DTOKSU::OpenFiles(std::string filename,"
         << " unsigned int i)\n\n");
+    std::string Extension = DataSink::extension(OutputFormat);
     create_file(filename + "_df_" + std::to_string(i) + ".txt");
-    HM.CreateFile(filename + "_hm_" + std::to_string(i) + ".txt",false);
-    FM.CreateFile(filename + "_fm_" + std::to_string(i) + ".txt");
-    CM.CreateFile(filename + "_cm_" + std::to_string(i) + ".txt");
+    HM.CreateFile(filename + "_hm_" + std::to_string(i) + Extension,false);
+    FM.CreateFile(filename + "_fm_" + std::to_string(i) + Extension);
+    CM.CreateFile(filename + "_cm_" + std::to_string(i) + Extension);
+}
+
+void DTOKSU::set_output(char format, unsigned int flushinterval){
+    D_Debug("\n\nIn DTOKSU::set_output(char format, "
+        << "unsigned int flushinterval)\n\n");
+    OutputFormat = format;
+    HM.set_output(format,flushinterval);
+    FM.set_output(format,flushinterval);
+    CM.set_output(format,flushinterval);
 }
 
 void DTOKSU::CloseFiles(){
@@ -247,6 +331,71 @@ bool DTOKSU::Boundary_Check(bool InOrOut){
         return !oddNodes;
 }
 
+void DTOKSU::set_checkpoint(std::string filename, double interval, 
+    bool deposition){
+    D_Debug("\n\nIn DTOKSU::set_checkpoint(std::string filename, "
+        << "double interval, bool deposition)\n\n");
+    CheckpointFileName = filename;
+    CheckpointInterval = interval;
+    CheckpointDeposition = deposition;
+    NextCheckpoint = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(interval));
+}
+
+void DTOKSU::write_checkpoint(bool inloop, bool errorflag){
+    D_Debug("\n\nIn DTOKSU::write_checkpoint(bool inloop, bool errorflag)"
+        << "\n\n");
+    CheckpointWriter out;
+    MyFile.flush();
+    unsigned long long Length = MyFile.is_open() ? (long long)MyFile.tellp() 
+        : 0;
+    out << inloop << errorflag << TotalTime << PlasmaDataFileName 
+        << OutputFormat << DataFileName << MyFile.is_open() << Length;
+    Sample->write_checkpoint(out);
+    HM.write_checkpoint(out);
+    FM.write_checkpoint(out);
+    CM.write_checkpoint(out);
+    out << CheckpointDeposition;
+    if( CheckpointDeposition ) HM.write_deposition(out);
+    Checkpoints::write_async(CheckpointFileName,out.data());
+
+    NextCheckpoint = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(CheckpointInterval));
+}
+
+int DTOKSU::read_checkpoint(std::string filename){
+    D_Debug("\n\nIn DTOKSU::read_checkpoint(std::string filename)\n\n");
+    CheckpointReader in;
+    int Status = in.read(filename);
+    if( Status != 0 ) return Status;
+
+    bool InLoop(false), WasOpen(false), Deposition(false);
+    unsigned long long Length(0);
+    in >> InLoop >> ResumeErrorFlag >> TotalTime >> PlasmaDataFileName 
+        >> OutputFormat >> DataFileName >> WasOpen >> Length;
+    Sample->read_checkpoint(in);
+    HM.read_checkpoint(in);
+    FM.read_checkpoint(in);
+    CM.read_checkpoint(in);
+    in >> Deposition;
+    if( Deposition ) HM.read_deposition(in);
+    if( !in.good() || !in.at_end() ) return 2;
+
+    if( MyFile.is_open() ) MyFile.close();
+    if( WasOpen ){
+        if( !Checkpoints::truncate_file(DataFileName,Length) ) return 2;
+        MyFile.open(DataFileName,std::ofstream::app);
+        if( !MyFile.is_open() ) return 2;
+    }
+    Resuming = InLoop;
+    NextCheckpoint = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(CheckpointInterval));
+    return 0;
+}
+
 void DTOKSU::ImpurityPrint(){
     HM.ImpurityPrint();
 }
@@ -255,23 +404,25 @@ int DTOKSU::Run(){
     D_Debug("- In DTOKSU::Run()\n\n");
 
     double HeatTime(0),ForceTime(0),ChargeTime(0);
-
-    //!< Update the plasma data from the plasma grid for all models...
-    //!< This has to be done individually because PlasmaData is shared accross 
-    //!< models in current design
-    bool cm_InGrid = CM.update_plasmadata(); 
-    bool hm_InGrid = HM.update_plasmadata(); 
-    bool fm_InGrid = FM.update_plasmadata(); 
-    assert( cm_InGrid == fm_InGrid 
-        && fm_InGrid == hm_InGrid 
-        && hm_InGrid == cm_InGrid );
-    //!< Charge instantaneously as soon as we start, have to add time though...
-    CM.Charge(1e-100);
-    //!< Need to manually update the first time as first step is not necessarily
-    //!< heating      
-    Sample->update();
+    bool InGrid(true);
     bool ErrorFlag(false);
-    while( cm_InGrid && !Sample->is_split() ){
+
+    if( Resuming ){
+        //!< Continue from the end of the step checkpointed, in the grid
+        ErrorFlag = ResumeErrorFlag;
+        Resuming = false;
+    }else{
+        //!< Update the plasma data from the plasma grid for all models...
+        //!< PlasmaState is shared across models so only needs updating once
+        InGrid = CM.update_plasmadata(); 
+        //!< Charge instantaneously as soon as we start, have to add time 
+        //!< though...
+        CM.Charge(1e-100);
+        //!< Need to manually update the first time as first step is not 
+        //!< necessarily heating      
+        Sample->update();
+    }
+    while( InGrid && !Sample->is_split() ){
 
         // ***** START OF : DETERMINE TIMESCALES OF PROCESSES ***** //  
         //!< Charge instantaneously as soon as we start, have to add a time 
@@ -291,7 +442,7 @@ int DTOKSU::Run(){
 
         //!< Check Charging timescale isn't the fastest timescale.
         if( ChargeTime > MinTimeStep && ChargeTime != 1){
-            static bool runOnce = true;
+            static std::atomic<bool> runOnce(true);
             std::string Warning = "*** Charging Time scale is not the shortest";
             Warning += " timescale!! ***\n";
             WarnOnce(runOnce,Warning);
@@ -427,16 +578,10 @@ int DTOKSU::Run(){
             << ChargeTime << "\n\tForceTime = " << ForceTime
             << "\n\tHeatTime = " << HeatTime << "\n");
 
-        //!< Update the plasma data from the plasma grid for all models...
-        cm_InGrid = CM.update_plasmadata();
-        hm_InGrid = HM.update_plasmadata();
-        fm_InGrid = FM.update_plasmadata();
-        
-        assert( cm_InGrid == fm_InGrid 
-            && fm_InGrid == hm_InGrid 
-            && hm_InGrid == cm_InGrid );
+        //!< Update the shared plasma state from the plasma grid for all models
+        InGrid = CM.update_plasmadata();
 
-        CM.RecordPlasmadata("pd.txt");
+        CM.RecordPlasmadata(PlasmaDataFileName);
         HM.Record_MassLoss();
         //HM.RecordPlasmadata("hm_pd.txt");
         //FM.RecordPlasmadata("fm_pd.txt");
@@ -476,6 +621,10 @@ int DTOKSU::Run(){
             }
         }
         // ***** END OF : DETERMINE IF END CONDITION HAS BEEN REACHED ***** //
+
+        if( CheckpointInterval > 0.0 
+            && std::chrono::steady_clock::now() >= NextCheckpoint )
+            write_checkpoint(true,ErrorFlag);
     }
     if( fabs(1 - (HM.get_totaltime()/FM.get_totaltime())) > 0.001  
         || fabs(1 - (FM.get_totaltime()/CM.get_totaltime())) > 0.001 ){
@@ -485,7 +634,7 @@ int DTOKSU::Run(){
             << "\nCM.get_totaltime() = " << CM.get_totaltime() 
             << "\n\nTotalTime = " << TotalTime;
     }
-    if( !cm_InGrid ){
+    if( !InGrid ){
         std::cout << "\nSample has left simulation domain";
         return 1;
     }else if( HeatTime == 1 ){
@@ -12,6 +12,7 @@
 DTOKSU_Manager::DTOKSU_Manager(){
     DM_Debug("In DTOKSU_Manager::DTOKSU_Manager()\n\n");
     Config_Status = -1;
+    NumThreads = std::thread::hardware_concurrency();
 };
 
 DTOKSU_Manager::DTOKSU_Manager(int argc, char* argv[]){
@@ -19,6 +20,7 @@ DTOKSU_Manager::DTOKSU_Manager(int argc, char* argv[]){
         << "char* argv[])\n\n");
     std::cout << "\n * CONFIGURING DTOKS * \n";
     Config_Status = -1;
+    NumThreads = std::thread::hardware_concurrency();
 
     //!< Call the configure function with command line options to configure as 
     //!< well as construct.
@@ -30,6 +32,7 @@ DTOKSU_Manager::DTOKSU_Manager(int argc, char* argv[], std::string filename){
         << "std::string filename = Config/DTOKSU_Config.cfg)\n\n");
     std::cout << "\n * CONFIGURING DTOKS * \n";
     Config_Status = -1;
+    NumThreads = std::thread::hardware_concurrency();
 
     //!< Call the configure function with command line options to configure as 
     //!< well as construct.
@@ -179,7 +182,12 @@ void DTOKSU_Manager::show_usage(std::string name)const{
     << "\t-rt,--thetapos THETAPOS\t\tfloat angular position\n\n"
     << "\t-rz,--zpos ZPOS\t\t\tfloat longitudinal position\n\n"
     << "\t-op,--output OUTPUT\t\tstring the filename prefix to write to\n\n"
-    << "\t-om,--metadata METADATA\t\tstring the MetaData filename to write\n\n";
+    << "\t-om,--metadata METADATA\t\tstring the MetaData filename to write\n\n"
+    << "\t-e, --ensemble ENSEMBLE\t\tstring file of initial grain states to "
+    << "simulate in parallel\n\n"
+    << "\t-nt,--threads THREADS\t\tunsigned int number of ensemble and "
+    << "breakup worker threads\n\n"
+    << "\t-rs,--restart\t\t\tcontinue the run from its last checkpoint\n\n";
 }
 
 template<typename T> int DTOKSU_Manager::input_function(int &argc, char* argv[],
@@ -217,8 +225,17 @@ std::string Config_Filename){
 
     //!< Default data file prefix and plasma data directory
     std::string MetaDataFilename = "Data/DTOKSU.txt";
-    std::string DataFilePrefix = "Data/DTOKSU";
+    std::string EnsembleFilename = "";
+    DataFilePrefix = "Data/DTOKSU";
+    OutputFormat = Output::Text;
+    int Flush_interval = Output::DefaultFlushInterval;
+    ForceIntegrator = Integrator::DormandPrince;
+    UpdateTolerance = 0.0;
+    CheckpointInterval = 0.0;
+    Restart = false;
     std::string PlasmaData_dir = "PlasmaData/";
+    std::string Fields_file = "";
+    std::string Gridcache_file = "";
     std::string WallData_dir = "PlasmaData/";
     std::string CoreData_dir = "PlasmaData/";
 
@@ -253,17 +270,15 @@ std::string Config_Filename){
     float rvel(-1.4);
     float thetavel(0.0);
     float zvel(0.0);
-    bool ContinuousPlasma = false;
+    ContinuousPlasma = false;
 
     // ------------------- GROUP MODELS ------------------- //
     std::array<bool,HMN> HeatModels;
     std::array<bool,FMN> ForceModels;
     std::array<bool,CMN> ChargeModels;
-    std::vector<CurrentTerm*> CurrentTerms;
-    std::vector<ForceTerm*> ForceTerms;
-    std::vector<HeatTerm*> HeatTerms;
-    std::array<char,CM> ConstModels;
-    std::array<float,DTOKSU::MN> AccuracyLevels;
+    CurrentTerms.clear();
+    ForceTerms.clear();
+    HeatTerms.clear();
 
     config4cpp::StringVector CfgStringVec;
 
@@ -277,6 +292,10 @@ std::string Config_Filename){
         cfg->parse(Config_Filename.c_str());
         MetaDataFilename = cfg->lookupString("", "Filename");
         DataFilePrefix   = cfg->lookupString("", "DataFilePrefix");
+        OutputFormat     = cfg->lookupString("", "OutputFormat", "t")[0];
+        Flush_interval   = cfg->lookupInt("", "FlushInterval", 
+            Output::DefaultFlushInterval);
+        CheckpointInterval = cfg->lookupFloat("", "CheckpointInterval", 0.0);
         ContinuousPlasma = cfg->lookupBoolean("plasma", "ContinuousPlasma");
         IonSpecies       = cfg->lookupString("plasma", "Plasma")[0];
         Pdata.Z          = cfg->lookupFloat("plasma", "MeanIonization");
@@ -287,6 +306,12 @@ std::string Config_Filename){
             Pgrid.device  = cfg->lookupString("plasma","plasmagrid.Machine")[0];
             Pgrid.dlx     = cfg->lookupFloat ("plasma","plasmagrid.xSpacing");
             Pgrid.dlz     = cfg->lookupFloat ("plasma","plasmagrid.zSpacing");
+            Pgrid.interpolation 
+                = cfg->lookupString("plasma","plasmagrid.Interpolation","n")[0];
+            Fields_file   
+                = cfg->lookupString("plasma","plasmagrid.Fieldsfile","");
+            Gridcache_file
+                = cfg->lookupString("plasma","plasmagrid.Gridcache","");
         }
         Pdata.IonDensity      
             = cfg->lookupFloat("plasma","plasmadata.IonDensity");
@@ -354,6 +379,8 @@ std::string Config_Filename){
                 cfg->lookupString("variablemodels", "BoilingModel")[0],
                 cfg->lookupString("variablemodels", "BreakupModel")[0]
             };
+        UpdateTolerance
+            = cfg->lookupFloat("variablemodels","UpdateTolerance",0.0);
         HeatModels = 
             {
                 cfg->lookupBoolean("heatingmodels","RadiativeCooling"),
@@ -388,6 +415,9 @@ std::string Config_Filename){
                 cfg->lookupBoolean("forcemodels","NeutralDrag"), 
                 cfg->lookupBoolean("forcemodels","RocketForce")
             };
+        ForceIntegrator = cfg->lookupString("forcemodels","Integrator","d")[0];
+        BackscatterCache
+            = cfg->lookupString("heatingmodels","BackscatterCache","");
         ChargeModels =
             {
                 cfg->lookupBoolean("chargemodels","OMLe"), 
@@ -404,7 +434,8 @@ std::string Config_Filename){
                 cfg->lookupBoolean("chargemodels","TEESchottky"), 
                 cfg->lookupBoolean("chargemodels","SEE"), 
                 cfg->lookupBoolean("chargemodels","CW"),
-                cfg->lookupBoolean("chargemodels","MOMLWEM")
+                cfg->lookupBoolean("chargemodels","MOMLWEM"),
+                cfg->lookupBoolean("chargemodels","MOMLEM",false)
             };
         
         AccuracyLevels = 
@@ -461,16 +492,19 @@ std::string Config_Filename){
     if( ChargeModels[10] )      CurrentTerms.push_back(new Term::TEEcharge());
     else if( ChargeModels[11] ) CurrentTerms.push_back(new Term::TEESchottky());
     if( ChargeModels[12] )      CurrentTerms.push_back(new Term::SEEcharge());
-    if( ChargeModels[13] && !ChargeModels[14] ){
+    if( ChargeModels[13] + ChargeModels[14] + ChargeModels[15] > 1 ){
+        std::cout << "\n* CW, MOMLWEM and MOMLEM Not compatible models! *";
+        Config_Status = 7;
+        return Config_Status;
+    }else if( ChargeModels[13] ){
         CurrentTerms.clear();
         CurrentTerms.push_back(new Term::CW());
-    }else if( !ChargeModels[13] && ChargeModels[14] ){
+    }else if( ChargeModels[14] ){
         CurrentTerms.clear();
         CurrentTerms.push_back(new Term::MOMLWEM());
-    }else if( ChargeModels[13] && ChargeModels[14] ){
-        std::cout << "\n* CW and MOMLWEM Not compatible models! *";
-        Config_Status = 7;
-        return Config_Status;
+    }else if( ChargeModels[15] ){
+        CurrentTerms.clear();
+        CurrentTerms.push_back(new Term::MOMLEM());
     }
 
     if( ForceModels[0] ) ForceTerms.push_back(new Term::Gravity());
@@ -504,6 +538,28 @@ std::string Config_Filename){
     else if( HeatModels[17] ) HeatTerms.push_back(new Term::DTOKSTEE());
     
     cfg->destroy();
+    if( (OutputFormat != Output::Text && OutputFormat != Output::Binary)
+        || Flush_interval < 1 ){
+        std::cerr << "\nInvalid output, OutputFormat = " << OutputFormat 
+            << ", FlushInterval = " << Flush_interval << "!\n";
+        Config_Status = 2;
+        return Config_Status;
+    }
+    FlushInterval = Flush_interval;
+    if( UpdateTolerance < 0.0 ){
+        std::cerr << "\nInvalid update tolerance, UpdateTolerance = " 
+            << UpdateTolerance << "!\n";
+        Config_Status = 2;
+        return Config_Status;
+    }
+    if( ForceIntegrator != Integrator::Euler 
+        && ForceIntegrator != Integrator::RungeKutta4
+        && ForceIntegrator != Integrator::DormandPrince ){
+        std::cerr << "\nInvalid force integrator, Integrator = " 
+            << ForceIntegrator << "!\n";
+        Config_Status = 2;
+        return Config_Status;
+    }
     if( !check_pdata_range() ){
         Config_Status = 3;
         return Config_Status;
@@ -527,16 +583,26 @@ std::string Config_Filename){
     }
 
     // ------------------- CONFIGURE PLASMAGRID ------------------- //
-    Boundary_Data WallBound, CoreBound;
+    WallBound = BoundaryDefaults;
+    CoreBound = BoundaryDefaults;
     if( !ContinuousPlasma ){
         std::cout << "\n\n* Full Machine Simulation! *\n\n"
             << "* Creating PlasmaGrid_Data Structure *";
         std::cout << "\n\t* Plasma:\t" << IonSpecies << "\n\t* Machine:\t" 
             << Pgrid.device;
         std::cout << "\n\t* xSpacing:\t" << Pgrid.dlx << "\n\t* zSpacing:\t" 
-            << Pgrid.dlz;
+            << Pgrid.dlz << "\n\t* Interpolation:\t" << Pgrid.interpolation;
+        if( Pgrid.interpolation != Interpolation::Nearest 
+            && Pgrid.interpolation != Interpolation::Bilinear
+            && Pgrid.interpolation != Interpolation::Bicubic ){
+            std::cerr << "\nInvalid Interpolation, Interpolation = " 
+                << Pgrid.interpolation << "!\n";
+            Config_Status = 3;
+            return Config_Status;
+        }
         //!< Failed to configure plasma data
-        if( configure_plasmagrid(PlasmaData_dir) != 0 ){ 
+        if( configure_plasmagrid(PlasmaData_dir,Fields_file,
+            Gridcache_file) != 0 ){ 
             std::cerr << "\nFailed to configure plasma data!";
             Config_Status = 3;
             return Config_Status;
@@ -609,6 +675,12 @@ std::string Config_Filename){
             || arg == "-op"  ) input_function(argc,argv,i,ss0,DataFilePrefix);
         else if( arg == "--MetaData"    
             || arg == "-om"  ) input_function(argc,argv,i,ss0,MetaDataFilename);
+        else if( arg == "--ensemble"    
+            || arg == "-e"   ) input_function(argc,argv,i,ss0,EnsembleFilename);
+        else if( arg == "--threads"     
+            || arg == "-nt"  ) input_function(argc,argv,i,ss0,NumThreads);
+        else if( arg == "--restart"     
+            || arg == "-rs"  ) Restart = true;
         else{
             sources.push_back(argv[i]);
         }
@@ -632,21 +704,8 @@ std::string Config_Filename){
     threevector xinit(rpos,thetapos,zpos);
     threevector vinit(rvel,thetavel,zvel);
     std::cout << "* Creating Matter object *\n\t* Element:\t" << Element;
-    if  (Element == 'W')     
-        Sample = new Tungsten(size,Temp,ConstModels,xinit,vinit);
-    else if (Element == 'B') 
-        Sample = new Beryllium(size,Temp,ConstModels,xinit,vinit);
-    else if (Element == 'F') 
-        Sample = new Iron(size,Temp,ConstModels,xinit,vinit);
-    else if (Element == 'G') 
-        Sample = new Graphite(size,Temp,ConstModels,xinit,vinit);
-    else if (Element == 'D') 
-        Sample = new Deuterium(size,Temp,ConstModels,xinit,vinit);
-    else if (Element == 'M') 
-        Sample = new Molybdenum(size,Temp,ConstModels,xinit,vinit);
-    else if (Element == 'L') 
-        Sample = new Lithium(size,Temp,ConstModels,xinit,vinit);
-    else{ 
+    Sample = create_sample(Element,size,Temp,xinit,vinit);
+    if( Sample == NULL ){ 
         std::cerr << "\nInvalid Option entered for Element";
         Config_Status = 4;
         return Config_Status;
@@ -673,7 +732,10 @@ std::string Config_Filename){
             <<Pgrid.dlz<<"\n"<<"\nxmin (m)\txmax (m)\tzmin (m)\tzmax (m)\n"
             <<Pgrid.gridxmin<<"\t\t"<<Pgrid.gridxmax<<"\t\t"<<Pgrid.gridzmin
             <<"\t\t"<<Pgrid.gridzmax << "\n";
-        Sim = new DTOKSU(AccuracyLevels, Sample, Pgrid, Pdata, WallBound, 
+        //!< Freeze the grid, from here on it is only shared, never copied
+        Pgrid.dm = std::make_shared<MassDeposition>(Pgrid.gridx,Pgrid.gridz);
+        SharedPgrid = std::make_shared<const PlasmaGrid_Data>(std::move(Pgrid));
+        Sim = new DTOKSU(AccuracyLevels, Sample, SharedPgrid, Pdata, WallBound, 
             CoreBound, HeatTerms, ForceTerms, CurrentTerms);
     }else{
         MetaDataFile <<"\n\n#PLASMA DATA PARAMETERS"
@@ -734,10 +796,26 @@ std::string Config_Filename){
         << "\nTEESchottky:\t\t" << ChargeModels[11]
         << "\nSEE:\t\t" << ChargeModels[12]
         << "\nCW:\t\t" << ChargeModels[13]
-        << "\nMOMLWEM:\t\t" << ChargeModels[14] << "\n";
+        << "\nMOMLWEM:\t\t" << ChargeModels[14]
+        << "\nMOMLEM:\t\t" << ChargeModels[15] << "\n";
     MetaDataFile.close();
 
-    Sim->OpenFiles(DataFilePrefix,0);
+    // ------------------- READ ENSEMBLE OF GRAINS ------------------- //
+    EnsembleStates.clear();
+    if( EnsembleFilename != "" ){
+        std::cout << "\n* Reading ensemble file: " << EnsembleFilename << " *";
+        if( read_ensemble(EnsembleFilename) != 0 ){
+            Config_Status = 4;
+            return Config_Status;
+        }
+        std::cout << "\n* Ensemble of " << EnsembleStates.size() 
+            << " grains read successfully! *\n";
+    }
+
+    Sim->set_output(OutputFormat,FlushInterval);
+    Sim->set_integrator(ForceIntegrator);
+    //!< Restarted runs reopen the files of their checkpoints instead
+    if( !Restart ) Sim->OpenFiles(DataFilePrefix,0);
     if( ConstModels[4] == 'n' || ConstModels[4] == 'e' ){
         Config_Status = -3;
     }else if( ConstModels[4] == 'r' || ConstModels[4] == 'b' ){
@@ -753,9 +831,11 @@ std::string Config_Filename){
 //!< Function to configure plasma grid ready for simulation. 
 //!< Plasma data is read from plasma_dirname+filename where filename is a 
 //!< hard-coded string
-int DTOKSU_Manager::configure_plasmagrid(std::string plasma_dirname){
+int DTOKSU_Manager::configure_plasmagrid(std::string plasma_dirname,
+std::string fields_filename, std::string cache_filename){
     DM_Debug("  In DTOKSU_Manager::configure_plasmagrid(std::string "
-        << "plasma_dirname)\n\n");
+        << "plasma_dirname, std::string fields_filename, std::string "
+        << "cache_filename)\n\n");
     // Plasma parameters
     if(Pgrid.device=='m'){
         Pgrid.gridx = 121;
@@ -837,6 +917,32 @@ int DTOKSU_Manager::configure_plasmagrid(std::string plasma_dirname){
 
     //impurity.open("output///impurity///impurity.vtk");
     int readstatus(-1);
+    //!< Map the finished grid from the cache of an earlier run if it is 
+    //!< valid and made from the same files, else read it and write the cache
+    std::vector<std::string> Sources;
+    if( cache_filename != "" && Pgrid.device == 'p' ){
+        std::cout << "\n* Plasma grid cache is not used for Magnum-PSI *";
+        cache_filename = "";
+    }else if( cache_filename != "" ){
+        Sources = { plasma_dirname+"b2processed.dat", 
+            plasma_dirname+"b2processed2.dat", plasma_dirname+"locate.dat" };
+        int CacheStatus 
+            = read_gridcache(Pgrid,Pdata,readstatus,Sources,cache_filename);
+        if( CacheStatus == 0 ){
+            std::cout << "\n* Plasma grid mapped from " << cache_filename 
+                << " *";
+            if( readstatus == 1 )
+                std::cerr << "\n* Warning! Some PlasmaGrid values exceed "
+                    << "Overflows or Underflows! *\n\n";
+            return 0;
+        }else if( CacheStatus == 2 ){
+            std::cerr << "\nIgnoring invalid plasma grid cache " 
+                << cache_filename;
+        }else if( CacheStatus == 3 ){
+            std::cout << "\n* Plasma grid cache " << cache_filename 
+                << " is out of date *";
+        }
+    }
     try{ //!< Read data
         readstatus = read_data(plasma_dirname);
         if( readstatus == 1)
@@ -850,6 +956,35 @@ int DTOKSU_Manager::configure_plasmagrid(std::string plasma_dirname){
         std::cerr << "\nRead error status: " << readstatus;
         return readstatus;
     }
+    //!< Derive E and parallel plasma velocity, or reuse those from last run.
+    //!< Magnum-PSI grids read without the potential have no electric field,
+    //!< which must not be kept for runs that use it
+    bool SaveFields = !(Pgrid.device == 'p' && !uses_electricfield());
+    int FieldsStatus = load_derivedfields(Pgrid,fields_filename,SaveFields);
+    if( FieldsStatus == 0 ){
+        std::cout << "\n* Derived fields read from " << fields_filename << " *";
+    }else if( fields_filename != "" ){
+        if( FieldsStatus == 3 )
+            std::cout << "\n* Derived fields in " << fields_filename
+                << " are out of date *";
+        if( FieldsStatus == 4 )
+            std::cerr << "\nFailed to write derived fields to "
+                << fields_filename << "!";
+        else if( SaveFields )
+            std::cout << "\n* Derived fields written to " 
+                << fields_filename << " *";
+    }
+    pack_plasmacells(Pgrid); //!< Pack the fields read on every lookup
+    build_stencils(Pgrid);   //!< Find where the grid can be interpolated
+    if( cache_filename != "" ){
+        if( write_gridcache(Pgrid,Pdata,readstatus,Sources,cache_filename) 
+            == 0 )
+            std::cout << "\n* Plasma grid written to " << cache_filename 
+                << " *";
+        else
+            std::cerr << "\nFailed to write plasma grid cache "
+                << cache_filename << "!";
+    }
     return 0;
 }
 
@@ -884,125 +1019,36 @@ std::string filename, Boundary_Data& BD){
 
 int DTOKSU_Manager::read_data(std::string plasma_dirname){
     P_Debug("\tIn DTOKSU_Manager::read_data(std::string plasma_dirname)\n\n");
-    // Preallocate size of vectors
-    Pgrid.Te = std::vector<std::vector<double>>
-        (Pgrid.gridx,std::vector<double>(Pgrid.gridz));
-    Pgrid.Ti  = Pgrid.Te;
-    Pgrid.Tn  = Pgrid.Te;
-    Pgrid.Ta  = Pgrid.Te;
-    Pgrid.na0 = Pgrid.Te;
-    Pgrid.na1 = Pgrid.Te;
-    Pgrid.na2 = Pgrid.Te;
-    Pgrid.po  = Pgrid.Te;
-    Pgrid.ua0 = Pgrid.Te;
-    Pgrid.ua1 = Pgrid.Te;
-    Pgrid.bx  = Pgrid.Te;
-    Pgrid.by  = Pgrid.Te;
-    Pgrid.bz  = Pgrid.Te;
-    Pgrid.x   = Pgrid.Te;
-    Pgrid.z   = Pgrid.Te;
-    Pgrid.dm  = Pgrid.Te;
-    Pgrid.gridflag  = std::vector<std::vector<int>>
-        (Pgrid.gridx,std::vector<int>(Pgrid.gridz));
-    int ReStat = 0;
     if(Pgrid.device=='p'){ //!< Note, grid flags will be empty 
+        // Preallocate size of grid fields
+        allocate_plasmafields(Pgrid);
         #ifdef NETCDF_SWITCH
-        return read_MPSIdata(plasma_dirname);
+        return read_MPSIdata(plasma_dirname,uses_electricfield());
         #else
         std::cerr << "\nNETCDF SUPPORT REQUIRED FOR MPSI DATA!";
         std::cerr << "\nRECOMPILE WITH NETCDF AND DEFINE NETCDF_SWITCH!\n\n";
-        ReStat = 2;
         return 2;
         #endif
-    }else{
-        std::ifstream scalars,threevectors,gridflagfile;
-        scalars.open(plasma_dirname+"b2processed.dat");
-        threevectors.open(plasma_dirname+"b2processed2.dat");
-        gridflagfile.open(plasma_dirname+"locate.dat");
-
-        //!< Open files to read
-        assert( scalars.is_open() );
-        assert( threevectors.is_open() );
-        assert( gridflagfile.is_open() );
-
-        //!< Throw away variables which read in data which is unimportant.
-        char dummy_char;
-        double dummy_dub;
-        //!< Ignore first line of file
-        for(unsigned int i=0; i<=19; i++){
-            scalars >> dummy_char;
-            threevectors >> dummy_char;
-        }
-        //!< Now loop over the grid and feed in the data into the vectors
-        double convertJtoK = 7.242971666667e22;
-        double converteVtoK = 11604.5250061657;
-        for(unsigned int k=0; k<=Pgrid.gridz-1; k++){
-            for(unsigned int i=0; i<=Pgrid.gridx-1; i++){
-                //!< This is the read-in format without neutrals
-                scalars >> Pgrid.x[i][k] >> Pgrid.z[i][k] >> Pgrid.Te[i][k]
-                    >> Pgrid.Ti[i][k] >> Pgrid.na0[i][k] >> Pgrid.na1[i][k] 
-                    >> Pgrid.po[i][k] >> Pgrid.ua0[i][k] >> Pgrid.ua1[i][k];
-/*              //!< This is the read-in format with neutrals
-                scalars >> Pgrid.x[i][k] >> Pgrid.z[i][k] >> Pgrid.Te[i][k]
-                    >> Pgrid.Ti[i][k] >> Pgrid.Tn[i][k] >> Pgrid.na0[i][k] 
-                    >> Pgrid.na1[i][k] >> Pgrid.na2[i][k] >> Pgrid.po[i][k] 
-                    >> Pgrid.ua0[i][k] >> Pgrid.ua1[i][k] >> Pgrid.ua2[i][k];*/
-                threevectors >> dummy_dub >> dummy_dub >> Pgrid.bx[i][k] >>
-                    Pgrid.bz[i][k] >> Pgrid.by[i][k];
-                gridflagfile >> dummy_dub >> dummy_dub >> Pgrid.gridflag[i][k];
-
-                Pgrid.Te[i][k] = convertJtoK*Pgrid.Te[i][k];
-                Pgrid.Ti[i][k] = convertJtoK*Pgrid.Ti[i][k];
-                Pgrid.Tn[i][k] = convertJtoK*Pgrid.Tn[i][k];
-		
-                //!< For some reason, very small non-zero values are being 
-                //!< assigned to the 'zero' values being read in.
-                //!< This should correct for this...
-
-                if( Pgrid.device != 'j' && Pgrid.device != 'i' ){ 
-                        Pgrid.Te[i][k] = converteVtoK*Pgrid.Te[i][k];
-                        Pgrid.Ti[i][k] = converteVtoK*Pgrid.Ti[i][k];
-                        Pgrid.Tn[i][k] = converteVtoK*Pgrid.Tn[i][k];
-                }
-                if( fabs(Pgrid.bx[i][k]) > Overflows::Field 
-                    || fabs(Pgrid.bx[i][k]) < Underflows::Field ){ ReStat = 1; } 
-                if( fabs(Pgrid.by[i][k]) > Overflows::Field 
-                    || fabs(Pgrid.by[i][k]) < Underflows::Field ){ ReStat = 1; } 
-                if( fabs(Pgrid.bz[i][k]) > Overflows::Field 
-                    || fabs(Pgrid.bz[i][k]) < Underflows::Field ){ ReStat = 1; }
-                if( Pgrid.Te[i][k] > Overflows::Temperature 
-                    || Pgrid.Te[i][k] < Underflows::Temperature ){ ReStat = 1; } 
-                if( Pgrid.Ti[i][k] > Overflows::Temperature 
-                    || Pgrid.Ti[i][k] < Underflows::Temperature ){ ReStat = 1; } 
-                if( Pgrid.na0[i][k] > Overflows::Density 
-                    || Pgrid.na0[i][k] < Underflows::Density )   { ReStat = 1; }
-                if( Pgrid.na1[i][k] > Overflows::Density 
-                    || Pgrid.na1[i][k] < Underflows::Density )   { ReStat = 1; }
-                if( fabs(Pgrid.ua0[i][k]) > Overflows::PlasmaVel 
-                    || fabs(Pgrid.ua0[i][k]) < Underflows::PlasmaVel ) 
-                    { ReStat = 1; }
-                if( fabs(Pgrid.ua1[i][k]) > Overflows::PlasmaVel 
-                    || fabs(Pgrid.ua1[i][k]) < Underflows::PlasmaVel ) 
-                    { ReStat = 1; }
-                Pgrid.Ta[i][k] = Pdata.AmbientTemp;
-                Pgrid.Tn[i][k] = Pdata.NeutralTemp;
-                Pgrid.na2[i][k] = Pdata.NeutralDensity;
-                Pgrid.dm[i][k] = 0.0;
-            }
-        }
-        scalars.close();
-        threevectors.close();
-        gridflagfile.close();
     }
-    return ReStat; //!< return success!
+    //!< Parse the b2processed files on the worker threads
+    return read_b2processed(Pgrid,Pdata,plasma_dirname,NumThreads);
+}
+
+bool DTOKSU_Manager::uses_electricfield(){
+    DM_Debug("  In DTOKSU_Manager::uses_electricfield()\n\n");
+    for( ForceTerm *Term : ForceTerms )
+        if( Term->needs_electricfield() ) return true;
+    return false;
 }
 // *************************** READING FUNCTIONS *************************** //
 
 //!< for Magnum-PSI, we need to read a NET-cdf file which is special
 //!< This function does all the necessary effort of extracting this information.
 #ifdef NETCDF_SWITCH
-int DTOKSU_Manager::read_MPSIdata(std::string plasma_dirname){
-    P_Debug("\tDTOKSU_Manager::read_MPSIdata(std::string plasma_dirname)\n\n");
+int DTOKSU_Manager::read_MPSIdata(std::string plasma_dirname, 
+bool potential){
+    P_Debug("\tDTOKSU_Manager::read_MPSIdata(std::string plasma_dirname, "
+        << "bool potential)\n\n");
     
     const int NC_ERR = 2;
     std::string filename 
@@ -1011,14 +1057,6 @@ int DTOKSU_Manager::read_MPSIdata(std::string plasma_dirname){
     std::cout << " *\n\t\t* gridx: " << Pgrid.gridx << "\t * gridz: " 
         << Pgrid.gridz << "\t * gridtheta: " << Pgrid.gridtheta << " *\n";
 
-    float electron_dens_mat[Pgrid.gridx][Pgrid.gridz][Pgrid.gridtheta];
-    float electron_temp_mat[Pgrid.gridx][Pgrid.gridz][Pgrid.gridtheta];
-    float electron_Vele_mat[Pgrid.gridx][Pgrid.gridz][Pgrid.gridtheta];
-    float ion_dens_mat[Pgrid.gridx][Pgrid.gridz][Pgrid.gridtheta];
-    float ion_Veli_mat[Pgrid.gridx][Pgrid.gridz][Pgrid.gridtheta];
-    float Potential_mat[Pgrid.gridx][Pgrid.gridz][Pgrid.gridtheta];
-    float Bxy_mat[Pgrid.gridx][Pgrid.gridz];
-
     //< Change the error behavior of the netCDF C++ API by creating an
     //< NcError object. Until it is destroyed, this NcError object will
     //< ensure that the netCDF C++ API silently returns error codes on
@@ -1037,7 +1075,7 @@ int DTOKSU_Manager::read_MPSIdata(std::string plasma_dirname){
     // We get back a pointer to each NcVar we request. Get the
     // latitude and longitude coordinate variables.
 
-    NcVar *Ne, *e_Temp, *Vel_e, *Ni, *Vel_i, *Potential; //, *B_xy;
+    NcVar *Ne, *e_Temp, *Vel_e, *Ni, *Vel_i, *Potential(nullptr);
     if (!(Ne = dataFile.get_var("Ne")))
         return NC_ERR;
     if (!(e_Temp = dataFile.get_var("Te")))
@@ -1048,55 +1086,73 @@ int DTOKSU_Manager::read_MPSIdata(std::string plasma_dirname){
         return NC_ERR;
     if (!(Vel_i = dataFile.get_var("Vel_i")))
         return NC_ERR;
-    if (!(Potential = dataFile.get_var("Potential_Phi")))
-        return NC_ERR;
-//  if (!(B_xy = dataFile.get_var("B_xy")))
-//      return NC_ERR;
-
-    if (!Ne->get(&electron_dens_mat[0][0][0], 
-        Pgrid.gridx, Pgrid.gridz, Pgrid.gridtheta))
+    //!< The potential is only used to derive the electric field
+    if (potential && !(Potential = dataFile.get_var("Potential_Phi")))
         return NC_ERR;
-    if (!e_Temp->get(&electron_temp_mat[0][0][0], 
-        Pgrid.gridx, Pgrid.gridz, Pgrid.gridtheta))
+    //!< B_xy is not read, the magnetic field is homogeneous
+
+    //!< Only the first theta plane is used, so each variable is read a block
+    //!< of rows at a time into one aligned buffer and converted straight into
+    //!< its field. The memory needed is then independent of the grid size.
+    const int BlockSize = 65536; //!< Maximum values read at once
+    const int BlockRows = std::max(1,BlockSize/std::max(1,Pgrid.gridz));
+    GridField<float> Block(std::min(BlockRows,Pgrid.gridx),Pgrid.gridz);
+    auto read_plane = [&](NcVar *Var, GridField<double> &Field, 
+        bool Temperature)->bool{
+        if( Var->num_dims() != 3 || Var->get_dim(0)->size() < Pgrid.gridx
+            || Var->get_dim(1)->size() < Pgrid.gridz 
+            || Var->get_dim(2)->size() < std::max(1,Pgrid.gridtheta) )
+            return false;
+        for( int i0 = 0; i0 < Pgrid.gridx; i0 += BlockRows ){
+            int Rows = std::min(BlockRows,Pgrid.gridx-i0);
+            if( !Var->set_cur(i0,0,0) 
+                || !Var->get(Block.data(),Rows,Pgrid.gridz,1) )
+                return false;
+            for( int i = 0; i < Rows; i ++ ){
+                const float *Values = Block[i];
+                double *Row = Field[i0+i];
+                if( Temperature ){
+                    double ConvertJtoK(7.24297166e22); //!< J to K
+                    for( int k = 0; k < Pgrid.gridz; k ++ )
+                        Row[k] = fabs(Values[k])*ConvertJtoK;
+                }else{
+                    for( int k = 0; k < Pgrid.gridz; k ++ )
+                        Row[k] = Values[k];
+                }
+            }
+        }
+        return true;
+    };
+    if( !read_plane(e_Temp,Pgrid.Te,true) ) 
         return NC_ERR;
-    if (!Vel_e->get(&electron_Vele_mat[0][0][0], 
-        Pgrid.gridx, Pgrid.gridz, Pgrid.gridtheta))
+    // Can't set Ti=fixed as this messes up the Dust potential! 2.5*11598.5895;
+    Pgrid.Ti = Pgrid.Te;
+    if( !read_plane(Ni,Pgrid.na0,false) )
         return NC_ERR;
-    if (!Ni->get(&ion_dens_mat[0][0][0], 
-        Pgrid.gridx, Pgrid.gridz, Pgrid.gridtheta))
+    if( !read_plane(Ne,Pgrid.na1,false) )
         return NC_ERR;
-    if (!Vel_i->get(&ion_Veli_mat[0][0][0], 
-        Pgrid.gridx, Pgrid.gridz, Pgrid.gridtheta))
+    if( !read_plane(Vel_i,Pgrid.ua0,false) )
         return NC_ERR;
-    if (!Potential->get(&Potential_mat[0][0][0], 
-        Pgrid.gridx, Pgrid.gridz, Pgrid.gridtheta))
+    if( !read_plane(Vel_e,Pgrid.ua1,false) )
         return NC_ERR;
-//  if (!B_xy->get(&Bxy_mat[0][0], Pgrid.gridx, Pgrid.gridz))
-//      return NC_ERR;
-    double ConvertJtoK(7.24297166e22); //!< Conversion factor from J to K
-    for(unsigned int i=0; i< Pgrid.gridx; i++){
-        for(unsigned int k=0; k< Pgrid.gridz; k++){
-
-//            std::cout << "\n[" << i << "]" << "[" << k << "]";  std::cin.get();
-
-            Pgrid.Ti[i][k] = fabs(electron_temp_mat[i][k][0])*ConvertJtoK;// Can't set Ti=fixed as this messes up the Dust potential! 2.5*11598.5895;
-            Pgrid.Te[i][k] = fabs(electron_temp_mat[i][k][0])*ConvertJtoK;
+    if( potential ){
+        if( !read_plane(Potential,Pgrid.po,false) )
+            return NC_ERR;
+    }else{
+        std::cout << "\t\t* Potential not read, no force uses the electric "
+            << "field *\n";
+        std::fill(Pgrid.po.data(),Pgrid.po.data()+Pgrid.po.size(),0.0);
+    }
+    for(int i=0; i< Pgrid.gridx; i++){
+        for(int k=0; k< Pgrid.gridz; k++){
             Pgrid.Tn[i][k] = Pdata.NeutralTemp;
             Pgrid.Ta[i][k] = Pdata.AmbientTemp;
-            Pgrid.na0[i][k] = ion_dens_mat[i][k][0];
-            Pgrid.na1[i][k] = electron_dens_mat[i][k][0];
             Pgrid.na2[i][k] = Pdata.NeutralDensity;
-            Pgrid.po[i][k] = Potential_mat[i][k][0];
-            Pgrid.ua0[i][k] = ion_Veli_mat[i][k][0];
-            Pgrid.ua1[i][k] = electron_Vele_mat[i][k][0];
             Pgrid.bx[i][k] = 0.0;
             Pgrid.by[i][k] = 0.0;
             Pgrid.bz[i][k] = 0.4;
             Pgrid.x[i][k] = Pgrid.gridxmin+i*Pgrid.dlx;
             Pgrid.z[i][k] = Pgrid.gridzmin+k*Pgrid.dlz;
-            Pgrid.gridflag  = std::vector<std::vector<int>>
-                (Pgrid.gridx,std::vector<int>(Pgrid.gridz));
-            Pgrid.dm[i][k] = 0.0;
         }
     }
     return 0;
@@ -1171,19 +1227,56 @@ int DTOKSU_Manager::Run(){
 
     clock_t begin = clock();    // Measure start time
 
+    //!< Backscatter coefficients computed by earlier runs
+    if( BackscatterCache != ""
+        && BackscatterTable::read_cache(BackscatterCache) == 2 ){
+        static std::atomic<bool> runOnce(true);
+        WarnOnce(runOnce,"Ignoring invalid backscatter cache "
+            +BackscatterCache);
+    }
+
     // Actually running DTOKS
     int RunStatus(-1);
-    if( Config_Status == -3 ){
+    bool Checkpointing = CheckpointInterval > 0.0 || Restart;
+    if( EnsembleStates.size() > 0 ){
+        //!< Grains of an ensemble are not checkpointed, so a restart could
+        //!< only start the whole ensemble again
+        if( Checkpointing ){
+            std::cerr << "\nEnsemble runs cannot be checkpointed! Set "
+                << "CheckpointInterval to 0 and run without --restart.";
+            return 1;
+        }
+        RunStatus = RunEnsemble();
+    }else if( Config_Status == -3 ){
+        Sim->set_checkpoint(DataFilePrefix+".chk",CheckpointInterval,true);
+        if( Restart ){
+            if( Sim->read_checkpoint(DataFilePrefix+".chk") != 0 ){
+                std::cerr << "\nFailed to restart from checkpoint " 
+                    << DataFilePrefix << ".chk";
+                return 11;
+            }
+        }else if( Checkpointing ){
+            Sim->checkpoint();
+        }
         std::cout << "\n * RUNNING DTOKS * \n";
         RunStatus = Sim->Run();
-    }else if( Config_Status == -2 )
-        Breakup();
-    else{
+        if( Checkpointing ){
+            Checkpoints::remove_async(DataFilePrefix+".chk");
+            Checkpoints::wait();
+        }
+    }else if( Config_Status == -2 ){
+        if( Breakup() != 0 ) return 11;
+    }else{
         std::cerr << "\nBreakup Is not configured! Please configure correctly.";
         config_message();
         return 1;
     }
-    Sim->ImpurityPrint();
+    Sim->ImpurityPrint(); //!< Deposition of every trajectory on shared grid
+    if( BackscatterCache != ""
+        && BackscatterTable::write_cache(BackscatterCache) != 0 ){
+        std::cerr << "\nFailed to write backscatter cache "
+            << BackscatterCache;
+    }
 
     clock_t end = clock();      // Measure end time
     double elapsd_secs = double(end-begin)/CLOCKS_PER_SEC;  
@@ -1194,135 +1287,526 @@ int DTOKSU_Manager::Run(){
 }
 
 // Run DTOKS many times with breakup turned on
-void DTOKSU_Manager::Breakup(){
+int DTOKSU_Manager::Breakup(){
     DM_Debug("  In DTOKSU_Manager::Breakup()\n\n");
 
     if( Config_Status != -2 ){
         std::cerr << "\nDTOKSU Is not configured! Please configure first.";
         config_message();
-        return;
+        return 0;
     }
     
-    
-    std::cout << "\n * RUNNING DTOKS * \n";
+    unsigned int Workers = NumThreads;
+    if( Workers == 0 ) Workers = 1;
+    std::cout << "\n * RUNNING DTOKS WITH BREAKUP ON " << Workers 
+        << " THREADS * \n";
+
+    BreakupQueue.clear();
+    BreakupResults.clear();
+    BreakupLive.clear();
+    BreakupDeposition.clear();
+    BreakupsRunning = 0;
+    bool Checkpointing = CheckpointInterval > 0.0 || Restart;
+    if( Restart ){
+        //!< Every branch live at the checkpoint continues from its own
+        //!< checkpoint in a copy of the configured simulation
+        if( read_breakup_checkpoint() != 0 ){
+            std::cerr << "\nFailed to restart from checkpoint "
+                << DataFilePrefix << "_breakup.chk";
+            return 11;
+        }
+        for( unsigned int Index : BreakupLive ){
+            Matter *BranchSample = Sample->clone();
+            DTOKSU *BranchSim = new DTOKSU(*Sim,BranchSample);
+            std::shared_ptr<MassDeposition> Deposition = new_deposition();
+            BranchSim->set_deposition(Deposition);
+            BranchSim->set_checkpoint(branch_checkpoint(Index),
+                CheckpointInterval,true);
+            if( BranchSim->read_checkpoint(branch_checkpoint(Index)) != 0 ){
+                std::cerr << "\nFailed to restart from checkpoint "
+                    << branch_checkpoint(Index);
+                delete BranchSim;
+                delete BranchSample;
+                for( BreakupBranch &Branch : BreakupQueue ){
+                    delete Branch.Sim;
+                    delete Branch.Sample;
+                }
+                BreakupQueue.clear();
+                return 11;
+            }
+            BreakupQueue.push_back(
+                BreakupBranch{Index,BranchSim,BranchSample,Deposition});
+        }
+    }else{
+        //!< Random numbers of each branch are drawn from their own generator,
+        //!< seeded by this and the branch index
+        BreakupSeed = std::chrono::high_resolution_clock::now()
+            .time_since_epoch().count();
+
+        //!< The first branch is the configured grain, in the configured files
+        std::shared_ptr<MassDeposition> Deposition = new_deposition();
+        Sim->set_deposition(Deposition);
+        BreakupQueue.push_back(BreakupBranch{1,Sim,Sample,Deposition});
+        if( Checkpointing ){
+            Sim->set_checkpoint(branch_checkpoint(1),CheckpointInterval,true);
+            Sim->checkpoint();
+            BreakupLive.insert(1);
+            write_breakup_checkpoint();
+        }
+    }
 
-    threevector Zeroes(0.0,0.0,0.0);
+    std::vector<std::thread> Pool;
+    for( unsigned int t(0); t < Workers; t ++ )
+        Pool.push_back(std::thread(&DTOKSU_Manager::breakup_worker,this));
+    for( auto &Worker : Pool ) Worker.join();
+
+    //!< Gather the deposition of every branch in order of branch index
+    for( auto &Branch : BreakupDeposition )
+        if( Branch.second ) SharedPgrid->dm->merge(*Branch.second);
+    BreakupDeposition.clear();
+    Sim->set_deposition(nullptr);
+
+    //!< Record the end state of each branch in order of branch index
+    std::sort(BreakupResults.begin(),BreakupResults.end(),
+        [](const EnsembleResult &a, const EnsembleResult &b){ 
+            return a.Index < b.Index; });
+    std::ofstream BreakupFile(DataFilePrefix+"_breakup.txt");
+    BreakupFile << "# Seed " << BreakupSeed << "\n";
+    BreakupFile << std::scientific << std::setprecision(16);
+    BreakupFile << "Index\tRunStatus\tHMTime\tFMTime\tCMTime\tMass\tRadius"
+        << "\tTemp\tPosition\tVelocity\n";
+    for( const EnsembleResult &Result : BreakupResults ){
+        BreakupFile << Result.Index << "\t" << Result.RunStatus << "\t" 
+            << Result.HMTime << "\t" << Result.FMTime << "\t" 
+            << Result.CMTime << "\t" << Result.FinalState.Mass << "\t" 
+            << Result.FinalState.Radius << "\t" 
+            << Result.FinalState.Temperature << "\t" 
+            << Result.FinalState.DustPosition << "\t" 
+            << Result.FinalState.DustVelocity << "\n";
+    }
+    BreakupFile.close();
+    std::cout << "\n * " << BreakupResults.size() 
+        << " BREAKUP BRANCHES SIMULATED * \n";
 
-    clock_t begin = clock();
+    if( Checkpointing ){
+        Checkpoints::remove_async(DataFilePrefix+"_breakup.chk");
+        Checkpoints::wait();
+    }
 
-    unsigned int p(1);
-    unsigned int i(1);
-    
-    double seed
-        =std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    std::mt19937 randnumber(seed);
+    //  Pgrid.datadump(); // Print the plasma grid data
+    return 0;
+}
+
+//!< Write the cells of \p dm holding mass, few as a branch only crosses a 
+//!< small part of the grid
+static void write_branchdeposition(CheckpointWriter &out, 
+    const MassDeposition *dm){
+    int Nx = dm ? dm->get_gridx() : 0;
+    int Nz = dm ? dm->get_gridz() : 0;
+    std::vector<int> Cells;
+    for( int n = 0; n < Nx*Nz; n ++ )
+        if( dm->get(n/Nz,n%Nz) != 0.0 ) Cells.push_back(n);
+    out << Nx << Nz << (unsigned long long)Cells.size();
+    for( int n : Cells ) out << n << dm->get(n/Nz,n%Nz);
+}
+
+//!< Read the deposition written by write_branchdeposition(), failing \p in if 
+//!< it does not fit the grid of \p Pgrid
+static std::shared_ptr<MassDeposition> read_branchdeposition(
+    CheckpointReader &in, const std::shared_ptr<const PlasmaGrid_Data> &Pgrid){
+    int Nx(0), Nz(0);
+    unsigned long long NumCells(0);
+    in >> Nx >> Nz >> NumCells;
+    std::shared_ptr<MassDeposition> dm;
+    if( Pgrid && Pgrid->dm ) dm = std::make_shared<MassDeposition>(
+        Pgrid->dm->get_gridx(),Pgrid->dm->get_gridz());
+    if( (dm ? dm->get_gridx() : 0) != Nx || (dm ? dm->get_gridz() : 0) != Nz 
+        || NumCells > (unsigned long long)Nx*Nz ){
+        in.fail();
+        return nullptr;
+    }
+    for( unsigned long long c(0); c < NumCells && in.good(); c ++ ){
+        int n(0);
+        double m(0.0);
+        in >> n >> m;
+        if( n < 0 || n >= Nx*Nz ) in.fail();
+        else dm->set(n/Nz,n%Nz,m);
+    }
+    return dm;
+}
+
+void DTOKSU_Manager::write_breakup_checkpoint(){
+    DM_Debug("  In DTOKSU_Manager::write_breakup_checkpoint()\n\n");
+    CheckpointWriter out;
+    out << (unsigned long long)BreakupSeed 
+        << (unsigned long long)BreakupLive.size();
+    for( unsigned int Index : BreakupLive ) out << Index;
+    out << (unsigned long long)BreakupResults.size();
+    for( const EnsembleResult &Result : BreakupResults ){
+        out << Result.Index << Result.RunStatus << Result.HMTime 
+            << Result.FMTime << Result.CMTime << Result.FinalState;
+    }
+    out << (unsigned long long)BreakupDeposition.size();
+    for( auto &Branch : BreakupDeposition ){
+        out << Branch.first;
+        write_branchdeposition(out,Branch.second.get());
+    }
+    Checkpoints::write_async(DataFilePrefix+"_breakup.chk",out.data());
+}
+
+int DTOKSU_Manager::read_breakup_checkpoint(){
+    DM_Debug("  In DTOKSU_Manager::read_breakup_checkpoint()\n\n");
+    CheckpointReader in;
+    int Status = in.read(DataFilePrefix+"_breakup.chk");
+    if( Status != 0 ) return Status;
+
+    unsigned long long Seed(0), NumLive(0), NumResults(0);
+    in >> Seed >> NumLive;
+    for( unsigned long long n(0); n < NumLive && in.good(); n ++ ){
+        unsigned int Index(0);
+        in >> Index;
+        BreakupLive.insert(Index);
+    }
+    in >> NumResults;
+    for( unsigned long long n(0); n < NumResults && in.good(); n ++ ){
+        EnsembleResult Result;
+        in >> Result.Index >> Result.RunStatus >> Result.HMTime 
+            >> Result.FMTime >> Result.CMTime >> Result.FinalState;
+        BreakupResults.push_back(Result);
+    }
+    unsigned long long NumDeposition(0);
+    in >> NumDeposition;
+    for( unsigned long long n(0); n < NumDeposition && in.good(); n ++ ){
+        unsigned int Index(0);
+        in >> Index;
+        BreakupDeposition[Index] = read_branchdeposition(in,SharedPgrid);
+    }
+    if( !in.good() || !in.at_end() || BreakupLive.empty() ){
+        BreakupLive.clear();
+        BreakupResults.clear();
+        BreakupDeposition.clear();
+        return 2;
+    }
+    BreakupSeed = Seed;
+    return 0;
+}
+
+//!< Take the most recently queued branch, following the tree depth first so 
+//!< that few branches wait in the queue at once
+void DTOKSU_Manager::breakup_worker(){
+    DM_Debug("  In DTOKSU_Manager::breakup_worker()\n\n");
+    std::unique_lock<std::mutex> Lock(BreakupMutex);
+    while( true ){
+        BreakupReady.wait(Lock,[this]{ 
+            return !BreakupQueue.empty() || BreakupsRunning == 0; });
+        //!< Nothing is queued and no running branch can queue more
+        if( BreakupQueue.empty() ) break;
+        BreakupBranch Branch = BreakupQueue.back();
+        BreakupQueue.pop_back();
+        BreakupsRunning ++;
+        Lock.unlock();
+
+        follow_branch(Branch);
+
+        Lock.lock();
+        BreakupsRunning --;
+        if( BreakupsRunning == 0 && BreakupQueue.empty() )
+            BreakupReady.notify_all();
+    }
+}
+
+void DTOKSU_Manager::follow_branch(BreakupBranch Branch){
+    DM_Debug("  In DTOKSU_Manager::follow_branch(BreakupBranch Branch)\n\n");
+    threevector Zeroes(0.0,0.0,0.0);
+    DTOKSU *BranchSim = Branch.Sim;
+    Matter *BranchSample = Branch.Sample;
+    unsigned int Index = Branch.Index;
+    std::shared_ptr<MassDeposition> Deposition = Branch.Deposition;
     //!< Uniformly Randomly Distributed Variable between 0.0 and 1.0
     std::uniform_real_distribution<double> rad(0.0, 1.0); 
-
-    //!< Vector of Grain Data to record the final state of each branch
-    std::vector<GrainData> GDvector;
-
-    //!< Vectors to retain the time of each simulation branch so that the global
-    //!< time is preserved
-    std::vector<double> HMTime;
-    std::vector<double> FMTime;
-    std::vector<double> CMTime;
-    // Loop over the number of split paths.
-    for( unsigned int j(0); j < i; j ++){
-        DM_Debug("\tSimulating NEGATIVE Branch "); DM_Debug(i); DM_Debug(" : ");
-        DM_Debug(j);
-        DM_Debug("\n\tStart Pos = "); DM_Debug(Sample->get_position()); 
-        DM_Debug("\n\tVelocity = "); DM_Debug(Sample->get_velocity());
-        DM_Debug("\n\tMass = "); DM_Debug(Sample->get_mass()); 
-        DM_Debug("\n\tTemperature = "); DM_Debug(Sample->get_temperature());
-        DM_Debug("\n\t");
-
-        //!< When breakup occurs and a path forks, track it. If it breaks up, 
-        //!< track the subsequent particle Repeat until the end condition is no-
-        //!< longer breakup, i.e while return of DTOKSU object isn't 3.
-        while( Sim->Run() == 3 ){ // DTOKSU_Manager has occured...
-
-            //!< Close data files and open new ones, with names based off index
-            Sim->CloseFiles();
-            Sim->OpenFiles("Data/breakup",p);
-            
-            //!< Reset breakup so that it's recorded with breakup turned off
-            Sample->reset_breakup();
-
-            //!< Reset the end point data with the same position, no rotation 
-            //!< and heading off in negative direction
-            //!< Rotation occurs in random direction perpendicular to magnetic
-            //!< field and velocity as per theory
-            double VelocityMag = 2*PI*(Sample->get_radius())*
-                Sample->get_rotationalfreq();
-            threevector Unit(2.0*rad(randnumber)-1.0,2.0*rad(randnumber)-
-                1.0,2.0*rad(randnumber)-1.0);
-            threevector VelocityUnitVec 
-                = (Unit.getunit()^Sim->get_bfielddir()).getunit();
-            double RandomlyDistributeRotationAndLinMom = rad(randnumber);
-            threevector dvMinus = RandomlyDistributeRotationAndLinMom*
-                VelocityMag*VelocityUnitVec; // This is a fudge
-            Sample->update_motion(Zeroes,dvMinus,
-                -RandomlyDistributeRotationAndLinMom*
-                Sample->get_rotationalfreq()/2.0);
-
-            //!< Record dust end conditions for when other half is simulated
-            GDvector.push_back(Sample->get_graindata());
-            HMTime.push_back(Sim->get_HMTime());
-            FMTime.push_back(Sim->get_FMTime());
-            CMTime.push_back(Sim->get_CMTime());
+    bool Checkpointing = CheckpointInterval > 0.0 || Restart;
+
+    DM_Debug("\tSimulating Branch "); DM_Debug(Index);
+    DM_Debug("\n\tStart Pos = "); DM_Debug(BranchSample->get_position()); 
+    DM_Debug("\n\tVelocity = "); DM_Debug(BranchSample->get_velocity());
+    DM_Debug("\n\tMass = "); DM_Debug(BranchSample->get_mass()); 
+    DM_Debug("\n\tTemperature = "); DM_Debug(BranchSample->get_temperature());
+    DM_Debug("\n\t");
+
+    //!< When breakup occurs and a path forks, queue the negative fragment and
+    //!< track the positive one. Repeat until the end condition is no-longer 
+    //!< breakup, i.e while return of DTOKSU object isn't 3.
+    int RunStatus(0);
+    while( (RunStatus = BranchSim->Run()) == 3 ){
+        //!< Stop where the index of the next branches would overflow
+        if( Index > (std::numeric_limits<unsigned int>::max()-1)/2 ){
+            static std::atomic<bool> runOnce(true);
+            WarnOnce(runOnce,"\nBreakup tree too deep to number its branches!"
+                "\nFragments of the deepest branches are not followed.\n");
+            break;
+        }
+        std::seed_seq Seed{(unsigned int)(BreakupSeed&0xFFFFFFFF),
+            (unsigned int)(BreakupSeed>>32),Index};
+        std::mt19937 randnumber(Seed);
+
+        //!< Reset breakup so that it's recorded with breakup turned off
+        BranchSample->reset_breakup();
+
+        //!< Reset the end point data with the same position, no rotation 
+        //!< and heading off in negative direction
+        //!< Rotation occurs in random direction perpendicular to magnetic
+        //!< field and velocity as per theory
+        double VelocityMag = 2*PI*(BranchSample->get_radius())*
+            BranchSample->get_rotationalfreq();
+        threevector Unit(2.0*rad(randnumber)-1.0,2.0*rad(randnumber)-
+            1.0,2.0*rad(randnumber)-1.0);
+        threevector VelocityUnitVec 
+            = (Unit.getunit()^BranchSim->get_bfielddir()).getunit();
+        double RandomlyDistributeRotationAndLinMom = rad(randnumber);
+        threevector dvMinus = RandomlyDistributeRotationAndLinMom*
+            VelocityMag*VelocityUnitVec; // This is a fudge
+        BranchSample->update_motion(Zeroes,dvMinus,
+            -RandomlyDistributeRotationAndLinMom*
+            BranchSample->get_rotationalfreq()/2.0);
+
+        //!< The negative fragment continues from here in a copy of the 
+        //!< simulation, keeping the global time of the models
+        Matter *NegativeSample = BranchSample->clone();
+        DTOKSU *NegativeSim = new DTOKSU(*BranchSim,NegativeSample);
+        NegativeSim->OpenFiles(DataFilePrefix+"_breakup",2*Index);
+        NegativeSim->set_plasmadatafile("breakup_pd_"
+            +std::to_string(2*Index));
+        std::shared_ptr<MassDeposition> NegativeDeposition = new_deposition();
+        NegativeSim->set_deposition(NegativeDeposition);
     
-            //!< Change dust velocity, mass has already been halved in Matter. 
-            //!< Add the velocity twice over as we took it away in one direction
-            threevector dvPlus = -2.0*dvMinus;
-            Sample->update_motion(Zeroes,dvPlus,0.0);
-
-            DM_Debug("\nSimulating POSITIVE Branch "); 
-            DM_Debug(i); DM_Debug(" : "); DM_Debug(j);
-            DM_Debug("\nStart Pos = "); DM_Debug(Sample->get_position());
-            DM_Debug("\nVelocity = "); DM_Debug(Sample->get_velocity());
-            DM_Debug("\nMass = "); DM_Debug(Sample->get_mass()); 
-            DM_Debug("\nTemperature = "); 
-            DM_Debug(Sample->get_temperature()); DM_Debug("\n");
-            //!< increment counters of number of forks and positive forks.
-            //!< p is used for recording index of file
-            i = i + 1;
-            p = p + 1;
-        } //!< Run the simulation again if breakup occured!
-        
-        DM_Debug("\n***** START OF : DUST DIDN'T BREAKUP *****\n!");
-        DM_Debug(i); DM_Debug(" : "); DM_Debug(j);
-        //!< Close data files and open new ones
-        Sim->CloseFiles();
-        if( GDvector.size() > 0 ){ // If we have at least one breakup event, 
-            //!< Re-initialise simulation with new Velocity... 
-            //!< i.e stored end point data But we've already done this now when
-            //!< we saved the data previously...
-            //!< So we're good to go, just copy over the previous end conditions
-            Sample->set_graindata(GDvector[j]);
-
-
-            //!< Reset Model Times, this is to make the plotting work correctly.
-            //!< Ensure that time of the models is global and not local to track
-            Sim->ResetModelTime(
-                HMTime[j]-Sim->get_HMTime(),
-                FMTime[j]-Sim->get_FMTime(),
-                CMTime[j]-Sim->get_CMTime());
-
-            //!< Open files 
-            Sim->OpenFiles("Data/breakup",p);
-            p = p + 1;
-            DM_Debug("\nSimulating POSITIVE Branch "); 
-            DM_Debug(i); DM_Debug(" : "); DM_Debug(j);
-            DM_Debug("\nStart Pos = "); DM_Debug(Sample->get_position()); 
-            DM_Debug("\nVelocity = "); DM_Debug(Sample->get_velocity());
-            DM_Debug("\nMass = "); DM_Debug(Sample->get_mass());
-            DM_Debug("\nTemperature = "); 
-            DM_Debug(Sample->get_temperature()); DM_Debug("\n");
-            Pause();
+        //!< Change dust velocity, mass has already been halved in Matter. 
+        //!< Add the velocity twice over as we took it away in one direction
+        threevector dvPlus = -2.0*dvMinus;
+        BranchSample->update_motion(Zeroes,dvPlus,0.0);
+
+        //!< Close data files and open new ones, with names based off index
+        unsigned int Parent = Index;
+        Index = 2*Index+1;
+        BranchSim->CloseFiles();
+        BranchSim->OpenFiles(DataFilePrefix+"_breakup",Index);
+        BranchSim->set_plasmadatafile("breakup_pd_"+std::to_string(Index));
+        std::shared_ptr<MassDeposition> ParentDeposition = Deposition;
+        Deposition = new_deposition();
+        BranchSim->set_deposition(Deposition);
+
+        //!< Both fragments are checkpointed before the tree records them, and
+        //!< the checkpoint of the parent is removed only after
+        if( Checkpointing ){
+            NegativeSim->set_checkpoint(branch_checkpoint(2*Parent),
+                CheckpointInterval,true);
+            NegativeSim->checkpoint();
+            BranchSim->set_checkpoint(branch_checkpoint(Index),
+                CheckpointInterval,true);
+            BranchSim->checkpoint();
+        }
+        {
+            std::lock_guard<std::mutex> Lock(BreakupMutex);
+            BreakupQueue.push_back(BreakupBranch{2*Parent,NegativeSim,
+                NegativeSample,NegativeDeposition});
+            BreakupDeposition[Parent] = ParentDeposition;
+            if( Checkpointing ){
+                BreakupLive.erase(Parent);
+                BreakupLive.insert(2*Parent);
+                BreakupLive.insert(Index);
+                write_breakup_checkpoint();
+                Checkpoints::remove_async(branch_checkpoint(Parent));
+            }
         }
-        DM_Debug("\n***** END OF : DUST DIDN'T BREAKUP *****\n!");
+        BreakupReady.notify_one();
+
+        DM_Debug("\nSimulating POSITIVE Branch "); DM_Debug(Index);
+        DM_Debug("\nStart Pos = "); DM_Debug(BranchSample->get_position());
+        DM_Debug("\nVelocity = "); DM_Debug(BranchSample->get_velocity());
+        DM_Debug("\nMass = "); DM_Debug(BranchSample->get_mass()); 
+        DM_Debug("\nTemperature = "); 
+        DM_Debug(BranchSample->get_temperature()); DM_Debug("\n");
+    } //!< Run the simulation again if breakup occured!
+    DM_Debug("\n***** DUST DIDN'T BREAKUP *****\n!"); DM_Debug(Index);
+
+    EnsembleResult Result;
+    Result.Index = Index;
+    Result.RunStatus = RunStatus;
+    Result.FinalState = BranchSample->get_graindata();
+    Result.HMTime = BranchSim->get_HMTime();
+    Result.FMTime = BranchSim->get_FMTime();
+    Result.CMTime = BranchSim->get_CMTime();
+    BranchSim->CloseFiles();
+    //!< The configured simulation and grain are kept by the manager
+    if( BranchSim != Sim ){
+        delete BranchSim;
+        delete BranchSample;
+    }
+    std::lock_guard<std::mutex> Lock(BreakupMutex);
+    BreakupResults.push_back(Result);
+    BreakupDeposition[Index] = Deposition;
+    if( Checkpointing ){
+        BreakupLive.erase(Index);
+        write_breakup_checkpoint();
+        Checkpoints::remove_async(branch_checkpoint(Index));
     }
+}
 
-    //  Pgrid.datadump(); // Print the plasma grid data
+Matter* DTOKSU_Manager::create_sample(char Element, double size, double Temp,
+const threevector &xinit, const threevector &vinit){
+    DM_Debug("  In DTOKSU_Manager::create_sample(char Element, double size, "
+        << "double Temp, const threevector &xinit, const threevector &vinit)"
+        << "\n\n");
+    //!< Each sample takes its own copy of the variable models
+    std::array<char,CM> constmodels = ConstModels;
+    Matter *NewSample = NULL;
+    if  (Element == 'W')     
+        NewSample = new Tungsten(size,Temp,constmodels,xinit,vinit);
+    else if (Element == 'B') 
+        NewSample = new Beryllium(size,Temp,constmodels,xinit,vinit);
+    else if (Element == 'F') 
+        NewSample = new Iron(size,Temp,constmodels,xinit,vinit);
+    else if (Element == 'G') 
+        NewSample = new Graphite(size,Temp,constmodels,xinit,vinit);
+    else if (Element == 'D') 
+        NewSample = new Deuterium(size,Temp,constmodels,xinit,vinit);
+    else if (Element == 'M') 
+        NewSample = new Molybdenum(size,Temp,constmodels,xinit,vinit);
+    else if (Element == 'L') 
+        NewSample = new Lithium(size,Temp,constmodels,xinit,vinit);
+    if( NewSample != NULL ) NewSample->set_updatetolerance(UpdateTolerance);
+    return NewSample;
+}
+
+//!< Read the initial states of an ensemble of grains from a text file.
+//!< Each non-comment line gives: Element size Temp rpos thetapos zpos rvel 
+//!< thetavel zvel
+int DTOKSU_Manager::read_ensemble(std::string filename){
+    DM_Debug("  In DTOKSU_Manager::read_ensemble(std::string filename)\n\n");
+    std::ifstream EnsembleFile(filename);
+    if( !EnsembleFile.is_open() ){
+        std::cerr << "\nError! Could not open ensemble file: " << filename;
+        return 1;
+    }
+    std::string Line;
+    unsigned int LineNumber(0);
+    while( std::getline(EnsembleFile,Line) ){
+        LineNumber ++;
+        //!< Skip blank lines and comments
+        if( Line.find_first_not_of(" \t\r") == std::string::npos 
+            || Line[Line.find_first_not_of(" \t\r")] == '#' ) continue;
+        std::stringstream ss(Line);
+        GrainInitialState State;
+        double rpos, thetapos, zpos, rvel, thetavel, zvel;
+        if( !(ss >> State.Element >> State.Size >> State.Temperature >> rpos 
+            >> thetapos >> zpos >> rvel >> thetavel >> zvel) ){
+            std::cerr << "\nError! Badly formatted line " << LineNumber 
+                << " in ensemble file: " << filename;
+            return 2;
+        }
+        if( !strchr("WBFGDML",State.Element) ){
+            std::cerr << "\nError! Invalid element '" << State.Element 
+                << "' on line " << LineNumber << " of ensemble file: " 
+                << filename;
+            return 3;
+        }
+        State.Position = threevector(rpos,thetapos,zpos);
+        State.Velocity = threevector(rvel,thetavel,zvel);
+        EnsembleStates.push_back(State);
+    }
+    EnsembleFile.close();
+    if( EnsembleStates.size() == 0 ){
+        std::cerr << "\nError! No grains found in ensemble file: " << filename;
+        return 4;
+    }
+    return 0;
+}
+
+//!< Simulate a single member of the ensemble with its own Matter and models.
+//!< The plasma grid and the stateless term objects are shared read-only
+//!< between workers, each ForceModel copies the terms which hold state
+void DTOKSU_Manager::ensemble_worker(std::atomic<unsigned int> &NextGrain){
+    DM_Debug("  In DTOKSU_Manager::ensemble_worker(std::atomic<unsigned int>"
+        << " &NextGrain)\n\n");
+    for( unsigned int n = NextGrain++; n < EnsembleStates.size(); 
+        n = NextGrain++ ){
+        const GrainInitialState &State = EnsembleStates[n];
+        EnsembleResult &Result = EnsembleResults[n];
+        Result.Index = n;
+
+        Matter *WorkerSample = create_sample(State.Element,State.Size,
+            State.Temperature,State.Position,State.Velocity);
+        if( WorkerSample == NULL ){
+            Result.RunStatus = 10;
+            continue;
+        }
+        //!< Every worker writes files of its own from construction
+        DTOKSU *WorkerSim;
+        std::string WorkerPrefix = DataFilePrefix+"_ensemble";
+        if( !ContinuousPlasma ){
+            WorkerSim = new DTOKSU(AccuracyLevels, WorkerSample, SharedPgrid, 
+                Pdata, WallBound, CoreBound, HeatTerms, ForceTerms, 
+                CurrentTerms, WorkerPrefix, n);
+        }else{
+            WorkerSim = new DTOKSU(AccuracyLevels, WorkerSample, Pdata, 
+                HeatTerms, ForceTerms, CurrentTerms, WorkerPrefix, n);
+        }
+        WorkerSim->set_output(OutputFormat,FlushInterval);
+        WorkerSim->set_integrator(ForceIntegrator);
+        WorkerSim->OpenFiles(WorkerPrefix,n);
+        WorkerSim->set_plasmadatafile("ensemble_pd_"+std::to_string(n));
+
+        Result.RunStatus = WorkerSim->Run();
+        Result.FinalState = WorkerSample->get_graindata();
+        Result.HMTime = WorkerSim->get_HMTime();
+        Result.FMTime = WorkerSim->get_FMTime();
+        Result.CMTime = WorkerSim->get_CMTime();
+
+        WorkerSim->CloseFiles();
+        delete WorkerSim;
+        delete WorkerSample;
+    }
+}
+
+//!< Run every grain of the ensemble on a pool of worker threads
+int DTOKSU_Manager::RunEnsemble(){
+    DM_Debug("  In DTOKSU_Manager::RunEnsemble()\n\n");
+    if( Config_Status == -2 ){
+        std::cout << "\n* Breakup is not followed for ensemble runs! *";
+    }
+
+    unsigned int Workers = NumThreads;
+    if( Workers == 0 ) Workers = 1;
+    if( Workers > EnsembleStates.size() ) Workers = EnsembleStates.size();
+    std::cout << "\n * RUNNING DTOKS ENSEMBLE OF " << EnsembleStates.size() 
+        << " GRAINS ON " << Workers << " THREADS * \n";
+
+    EnsembleResults.assign(EnsembleStates.size(),EnsembleResult());
+    std::atomic<unsigned int> NextGrain(0);
+    std::vector<std::thread> Pool;
+    for( unsigned int t(0); t < Workers; t ++ ){
+        Pool.push_back(std::thread(&DTOKSU_Manager::ensemble_worker,this,
+            std::ref(NextGrain)));
+    }
+    for( auto &Worker : Pool ) Worker.join();
+
+    //!< Record the end state of each grain in order of the ensemble file
+    std::ofstream EnsembleFile(DataFilePrefix+"_ensemble.txt");
+    EnsembleFile << std::scientific << std::setprecision(16);
+    EnsembleFile << "Index\tElem\tInitialRadius\tRunStatus\tHMTime\tFMTime"
+        << "\tCMTime\tMass\tRadius\tTemp\tPosition\tVelocity\n";
+    int ReturnStatus(0);
+    for( unsigned int n(0); n < EnsembleResults.size(); n ++ ){
+        const EnsembleResult &Result = EnsembleResults[n];
+        EnsembleFile << Result.Index << "\t" << EnsembleStates[n].Element 
+            << "\t" << EnsembleStates[n].Size << "\t" << Result.RunStatus 
+            << "\t" << Result.HMTime << "\t" << Result.FMTime << "\t" 
+            << Result.CMTime << "\t" << Result.FinalState.Mass << "\t" 
+            << Result.FinalState.Radius << "\t" 
+            << Result.FinalState.Temperature << "\t" 
+            << Result.FinalState.DustPosition << "\t" 
+            << Result.FinalState.DustVelocity << "\n";
+        if( Result.RunStatus == 10 ) ReturnStatus = 10;
+    }
+    EnsembleFile.close();
+    return ReturnStatus;
 }
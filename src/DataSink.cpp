@@ -0,0 +1,282 @@
+/** @file DataSink.cpp
+ *  @brief Implementation of the buffered writer of model data
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#include "DataSink.h"
+
+//!< Identifies a binary DataSink file, followed by the format version
+static const char BinaryMagic[8] = {'D','T','O','K','S','D','A','T'};
+static const uint32_t BinaryVersion = 1;
+//!< Written in native byte order so that the reader can detect a mismatch
+static const uint32_t ByteOrderMark = 0x01020304;
+
+//!< Number of values stored for a column of type \p type
+static inline unsigned int column_width(char type){
+    return type == Column::Vector ? 3 : 1;
+}
+
+//!< Append the text header line for \p columns to \p out
+static void format_header(const std::vector<DataColumn> &columns,
+    std::string &out){
+    out += "\n";
+    for( size_t c = 0; c < columns.size(); c ++ ){
+        if( c > 0 ) out += "\t";
+        out += columns[c].Name;
+    }
+    out += "\n";
+}
+
+//!< Append one line of text for the values \p row laid out as \p columns
+static void format_row(const std::vector<DataColumn> &columns,
+    const double *row, std::string &out){
+    char Value[80];
+    for( size_t c = 0; c < columns.size(); c ++ ){
+        if( c > 0 ) out += "\t";
+        switch( columns[c].Type ){
+            case Column::Integer:
+                snprintf(Value,sizeof(Value),"%ld",(long)row[0]);
+                out += Value;
+                break;
+            case Column::Sign:
+                out += row[0] > 0.0 ? "Pos" : "Neg";
+                break;
+            case Column::Vector:
+                snprintf(Value,sizeof(Value),"%.16e %.16e %.16e",row[0],row[1],
+                    row[2]);
+                out += Value;
+                break;
+            default:
+                snprintf(Value,sizeof(Value),"%.16e",row[0]);
+                out += Value;
+                break;
+        }
+        row += column_width(columns[c].Type);
+    }
+    out += "\n";
+}
+
+//!< Append \p size bytes at \p data to \p out
+static inline void append_bytes(const void *data, size_t size,
+    std::string &out){
+    out.append(static_cast<const char*>(data),size);
+}
+
+DataSink::DataSink():Format(Output::Text),
+FlushInterval(Output::DefaultFlushInterval),RowWidth(0),BufferedRows(0),
+Written(0){
+}
+
+DataSink::DataSink(const DataSink &other):Format(other.Format),
+FlushInterval(other.FlushInterval),RowWidth(0),BufferedRows(0),Written(0){
+}
+
+DataSink::~DataSink(){
+    close();
+}
+
+void DataSink::configure(char format, unsigned int flushinterval){
+    Format = format;
+    FlushInterval = flushinterval;
+}
+
+int DataSink::open(std::string filename, 
+    const std::vector<DataColumn> &columns, bool append){
+    close();
+    FileName = filename;
+    Columns = columns;
+    RowWidth = 0;
+    for( size_t c = 0; c < Columns.size(); c ++ )
+        RowWidth += column_width(Columns[c].Type);
+    Row.clear();
+    Row.reserve(RowWidth);
+    return open_file(append);
+}
+
+int DataSink::open_file(bool append){
+    if( append ){
+        File.open(FileName,
+            std::ofstream::binary|std::ofstream::app|std::ofstream::ate);
+    }else{
+        File.open(FileName,std::ofstream::binary|std::ofstream::trunc);
+    }
+    if( !File.is_open() ) return 1;
+    Written = File.tellp();
+    //!< Only write a header when starting a new file
+    if( Written != 0 ) return 0;
+
+    if( Format == Output::Binary ){
+        uint32_t NumColumns = Columns.size();
+        append_bytes(BinaryMagic,sizeof(BinaryMagic),Buffer);
+        append_bytes(&BinaryVersion,sizeof(BinaryVersion),Buffer);
+        append_bytes(&ByteOrderMark,sizeof(ByteOrderMark),Buffer);
+        append_bytes(&NumColumns,sizeof(NumColumns),Buffer);
+        for( size_t c = 0; c < Columns.size(); c ++ ){
+            uint32_t NameLength = Columns[c].Name.size();
+            append_bytes(&Columns[c].Type,sizeof(char),Buffer);
+            append_bytes(&NameLength,sizeof(NameLength),Buffer);
+            Buffer += Columns[c].Name;
+        }
+    }else{
+        format_header(Columns,Buffer);
+    }
+    flush();
+    return 0;
+}
+
+DataSink &DataSink::operator<<(double value){
+    Row.push_back(value);
+    return *this;
+}
+
+DataSink &DataSink::operator<<(const threevector &vec){
+    Row.push_back(vec.getx());
+    Row.push_back(vec.gety());
+    Row.push_back(vec.getz());
+    return *this;
+}
+
+void DataSink::end_row(){
+    assert( Row.size() == RowWidth );
+    if( !File.is_open() && !FileName.empty() ) open_file(true);
+    if( Format == Output::Binary ){
+        append_bytes(Row.data(),Row.size()*sizeof(double),Buffer);
+    }else{
+        format_row(Columns,Row.data(),Buffer);
+    }
+    Row.clear();
+    BufferedRows ++;
+    if( BufferedRows >= FlushInterval ) flush();
+}
+
+void DataSink::flush(){
+    if( File.is_open() && !Buffer.empty() ){
+        File.write(Buffer.data(),Buffer.size());
+        File.flush();
+        Written += Buffer.size();
+    }
+    Buffer.clear();
+    BufferedRows = 0;
+}
+
+void DataSink::close(){
+    if( !File.is_open() ) return;
+    flush();
+    File.close();
+    File.clear();
+}
+
+void DataSink::write_checkpoint(CheckpointWriter &out)const{
+    out << FileName << Format << FlushInterval 
+        << (unsigned long long)Columns.size();
+    for( const DataColumn &Col : Columns ) out << Col.Name << Col.Type;
+    out << File.is_open() << Written << Buffer << BufferedRows;
+}
+
+void DataSink::read_checkpoint(CheckpointReader &in){
+    close();
+    unsigned long long NumColumns(0);
+    in >> FileName >> Format >> FlushInterval >> NumColumns;
+    if( !in.good() ) return;
+    Columns.clear();
+    RowWidth = 0;
+    for( unsigned long long c = 0; c < NumColumns && in.good(); c ++ ){
+        DataColumn Col;
+        in >> Col.Name >> Col.Type;
+        Columns.push_back(Col);
+        RowWidth += column_width(Col.Type);
+    }
+    bool WasOpen(false);
+    unsigned long long Length(0);
+    in >> WasOpen >> Length >> Buffer >> BufferedRows;
+    Row.clear();
+    Row.reserve(RowWidth);
+    if( !in.good() || !WasOpen ) return;
+
+    //!< Rows written after the checkpoint are written again by the restart
+    if( !Checkpoints::truncate_file(FileName,Length) ){
+        std::cerr << "\nCould not restore data file " << FileName 
+            << " to its length at the checkpoint";
+        in.fail();
+        return;
+    }
+    File.open(FileName,std::ofstream::binary|std::ofstream::app);
+    if( !File.is_open() ){
+        in.fail();
+        return;
+    }
+    Written = Length;
+}
+
+std::string DataSink::extension(char format){
+    return format == Output::Binary ? ".bin" : ".txt";
+}
+
+//!< Read a value of type T from \p in, returning false on failure
+template<typename T> static inline bool read_value(std::istream &in, 
+    T &value){
+    return bool(in.read(reinterpret_cast<char*>(&value),sizeof(T)));
+}
+
+int convert_to_text(std::string filename, std::ostream &out){
+    std::ifstream BinaryFile(filename,std::ifstream::binary);
+    if( !BinaryFile.is_open() ) return 1;
+
+    char Magic[sizeof(BinaryMagic)];
+    uint32_t Version(0), ByteOrder(0), NumColumns(0);
+    if( !BinaryFile.read(Magic,sizeof(Magic))
+        || std::memcmp(Magic,BinaryMagic,sizeof(Magic)) != 0 ) return 2;
+    if( !read_value(BinaryFile,Version) || Version != BinaryVersion ) return 2;
+    if( !read_value(BinaryFile,ByteOrder) || ByteOrder != ByteOrderMark )
+        return 2;
+    if( !read_value(BinaryFile,NumColumns) ) return 4;
+
+    //!< Check the header against the bytes left in the file before anything
+    //!< is allocated from it, each column takes at least its type and the 
+    //!< length of its name
+    std::streamoff HeaderStart = BinaryFile.tellg();
+    BinaryFile.seekg(0,std::ifstream::end);
+    std::streamoff Remaining = BinaryFile.tellg()-HeaderStart;
+    BinaryFile.seekg(HeaderStart);
+    const std::streamoff ColumnSize = sizeof(char)+sizeof(uint32_t);
+    if( NumColumns > Remaining/ColumnSize ) return 4;
+
+    std::vector<DataColumn> Columns(NumColumns);
+    unsigned int RowWidth(0);
+    for( uint32_t c = 0; c < NumColumns; c ++ ){
+        uint32_t NameLength(0);
+        if( !read_value(BinaryFile,Columns[c].Type)
+            || !read_value(BinaryFile,NameLength) ) return 4;
+        Remaining -= ColumnSize;
+        if( NameLength > Remaining-(NumColumns-c-1)*ColumnSize ) return 4;
+        Columns[c].Name.resize(NameLength);
+        if( NameLength > 0 
+            && !BinaryFile.read(&Columns[c].Name[0],NameLength) ) return 4;
+        Remaining -= NameLength;
+        RowWidth += column_width(Columns[c].Type);
+    }
+
+    std::string Text;
+    format_header(Columns,Text);
+    out << Text;
+    if( RowWidth == 0 ) return 0;
+
+    std::vector<double> Row(RowWidth);
+    while( BinaryFile.read(reinterpret_cast<char*>(Row.data()),
+        RowWidth*sizeof(double)) ){
+        Text.clear();
+        format_row(Columns,Row.data(),Text);
+        out << Text;
+    }
+    //!< Anything left over is an incomplete row
+    if( BinaryFile.gcount() != 0 ) return 3;
+    return 0;
+}
@@ -34,6 +34,22 @@ const struct ElementConsts DeuteriumConsts = {
     0.0001382,  //!< kW/mK, invalid for liquid hydrogen
 };
 
+//!< H.W. Woolley, R.B. Scott, and F.G. Brickwedde, 
+//!< J. Res. Natl. Bur. Stand. (1934). 41, 379 (1948).
+/** @brief Vapour pressure of solid deuterium in Pa at \p Temperature
+ */
+static double solid_vapourpressure(double Temperature){
+    //!< Page 466, equation 7.15
+    return 133.322*pow(10,5.1625-67.9119/Temperature+0.03102*Temperature);
+}
+
+/** @brief Vapour pressure of liquid deuterium in Pa at \p Temperature
+ */
+static double liquid_vapourpressure(double Temperature){
+    //!< Page 466, equation 7.14
+    return 133.322*pow(10,4.7367-58.54440/Temperature+0.02670*Temperature);
+}
+
 
 Deuterium::Deuterium():Matter(DeuteriumConsts){
     E_Debug("\n\nIn Deuterium::Deuterium(DeuteriumConsts)");
@@ -120,7 +136,7 @@ void Deuterium::set_defaults(){
 
 void Deuterium::update_heatcapacity(){
     E_Debug("\n\n\tIn Deuterium::update_heatcapacity()");
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string WarningMessage = "Deuterium HeatCapacity assumed constant!\n";
     WarningMessage += "Variable heat capacity not possible";
     WarnOnce(runOnce,WarningMessage);
@@ -130,7 +146,7 @@ void Deuterium::update_heatcapacity(){
 void Deuterium::update_radius(){
     E_Debug("\n\n\tIn Deuterium::update_radius():");
     St.LinearExpansion=1.0;
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string WarningMessage = "Deuterium LinearExpansion == 1.0 assumed!\n";
     WarningMessage += "Temperature dependant radius not possible";
     WarnOnce(runOnce,WarningMessage);
@@ -145,21 +161,21 @@ void Deuterium::update_vapourpressure(){
 
 double Deuterium::probe_vapourpressure(double Temperature)const{
     E_Debug("\n\n\tIn Deuterium::update_vapourpressure(double Temperature):");    
+    static const PropertyTable SolidTable(solid_vapourpressure,
+        {10,DeuteriumConsts.MeltingTemp},Tabulation::Arrhenius);
+    static const PropertyTable LiquidTable(liquid_vapourpressure,
+        {DeuteriumConsts.MeltingTemp,2*DeuteriumConsts.BoilingTemp},
+        Tabulation::Arrhenius);
     double VapourPressure(0.0);
-    //!< Page 466, equation 7.15
-    //!< Page 466, equation 7.14
-    //!< H.W. Woolley, R.B. Scott, and F.G. Brickwedde, 
-    //!< J. Res. Natl. Bur. Stand. (1934). 41, 379 (1948).
     if( !St.Liquid && !St.Gas ){
-        VapourPressure = pow(10,5.1625-
-            67.9119/Temperature+0.03102*Temperature);
+        if( !SolidTable.lookup(Temperature,VapourPressure) )
+            VapourPressure = solid_vapourpressure(Temperature);
     }else if( St.Liquid ){
-        VapourPressure = pow(10,4.7367-
-            58.54440/Temperature+0.02670*Temperature);
+        if( !LiquidTable.lookup(Temperature,VapourPressure) )
+            VapourPressure = liquid_vapourpressure(Temperature);
     }else{
         VapourPressure = 0;
         std::cout << "\nWarning, Sample is assumed gas! St.VapourPressure = 0";
     }
-    VapourPressure = 133.322*VapourPressure; // Convert to Pascals
     return VapourPressure;
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+/** @file EmissivityTable.cpp
+ *  @brief Implementation of the tabulated emissivity of an element
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <fstream>
+#include <algorithm>
+#include <utility>
+#include <map>
+#include <mutex>
+#include <cctype>
+#include <cmath>
+
+#include "EmissivityTable.h"
+
+//!< Lowest temperature of the emissivity data (K)
+static const int MinTableTemperature = 275;
+
+/** @brief Find the interval of \p axis containing \p x
+ *
+ *  Sets \p i to the lower index and \p w to the weight of the upper point,
+ *  clamping \p x to the range of \p axis.
+ */
+static inline void locate(const std::vector<double> &axis, double x,
+    size_t &i, double &w){
+    i = 0;
+    w = 0.0;
+    if( axis.size() < 2 || x <= axis.front() ) return;
+    if( x >= axis.back() ){
+        i = axis.size()-2;
+        w = 1.0;
+        return;
+    }
+    i = std::upper_bound(axis.begin(),axis.end(),x)-axis.begin()-1;
+    w = (x-axis[i])/(axis[i+1]-axis[i]);
+}
+
+//!< Linear interpolation of the points \p row at \p x, clamped at the ends
+static double interpolate_row(const std::vector<std::pair<double,double>> &row,
+    double x){
+    if( x <= row.front().first ) return row.front().second;
+    if( x >= row.back().first ) return row.back().second;
+    auto Upper = std::upper_bound(row.begin(),row.end(),
+        std::make_pair(x,-HUGE_VAL));
+    auto Lower = Upper-1;
+    double w = (x-Lower->first)/(Upper->first-Lower->first);
+    return (1.0-w)*Lower->second + w*Upper->second;
+}
+
+int EmissivityTable::read(std::string dirname, int tmin, int tmax){
+    std::vector<std::vector<std::pair<double,double>>> Rows;
+    std::vector<double> Temps, AllRadii;
+    for( int T = tmin; T <= tmax; T ++ ){
+        std::ifstream TempFile(dirname+"/Temp_"+std::to_string(T)+".txt");
+        if( !TempFile.is_open() ) continue;
+
+        std::vector<std::pair<double,double>> Row;
+        double Radius(0.0), Emissivity(0.0);
+        char buffer;
+        while( TempFile >> Radius >> buffer >> Emissivity ){
+            Row.push_back(std::make_pair(Radius,Emissivity));
+            AllRadii.push_back(Radius);
+        }
+        if( Row.empty() ) continue;
+        std::sort(Row.begin(),Row.end());
+        Rows.push_back(Row);
+        Temps.push_back(T);
+    }
+    if( Rows.empty() ) return 1;
+
+    std::sort(AllRadii.begin(),AllRadii.end());
+    AllRadii.erase(std::unique(AllRadii.begin(),AllRadii.end()),
+        AllRadii.end());
+
+    //!< Place every row on the common radius axis
+    GridField<double> Table(Rows.size(),AllRadii.size());
+    for( size_t n = 0; n < Rows.size(); n ++ )
+        for( size_t r = 0; r < AllRadii.size(); r ++ )
+            Table[n][r] = interpolate_row(Rows[n],AllRadii[r]);
+
+    Temperatures = std::move(Temps);
+    Radii = std::move(AllRadii);
+    Values = std::move(Table);
+    return 0;
+}
+
+double EmissivityTable::interpolate(double temperature, double radius)const{
+    size_t i(0), k(0);
+    double wt(0.0), wr(0.0);
+    locate(Temperatures,temperature,i,wt);
+    locate(Radii,radius,k,wr);
+    size_t i1 = std::min(i+1,Temperatures.size()-1);
+    size_t k1 = std::min(k+1,Radii.size()-1);
+    return (1.0-wt)*((1.0-wr)*Values[i][k] + wr*Values[i][k1])
+        + wt*((1.0-wr)*Values[i1][k] + wr*Values[i1][k1]);
+}
+
+std::string EmissivityTable::directory(char elem){
+    switch( toupper(elem) ){
+        case 'W': return "EmissivityData/EmissivityDataTungsten";
+        case 'F': return "EmissivityData/EmissivityDataIron";
+        case 'G': return "EmissivityData/EmissivityDataGraphite";
+        case 'B': return "EmissivityData/EmissivityDataBeryllium";
+        default:  return "";
+    }
+}
+
+std::shared_ptr<const EmissivityTable> EmissivityTable::shared(char elem,
+    double boilingtemp){
+    static std::mutex TablesMutex;
+    static std::map<char,std::shared_ptr<const EmissivityTable>> Tables;
+
+    std::lock_guard<std::mutex> Lock(TablesMutex);
+    char Key = toupper(elem);
+    auto Found = Tables.find(Key);
+    if( Found != Tables.end() ) return Found->second;
+
+    std::shared_ptr<EmissivityTable> Table(new EmissivityTable());
+    std::string DirName = directory(Key);
+    if( !DirName.empty() )
+        Table->read(DirName,MinTableTemperature,(int)ceil(boilingtemp));
+    Tables[Key] = Table;
+    return Table;
+}
@@ -7,10 +7,63 @@
  *  @bug bugs, they definitely exist
  */
 
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
 #include "ForceModel.h"
+
+//!< Dormand-Prince RK5(4) coefficients, Hairer, Norsett & Wanner (1993)
+namespace DP{
+    const double c2 = 1.0/5.0, c3 = 3.0/10.0, c4 = 4.0/5.0, c5 = 8.0/9.0;
+    const double a21 = 1.0/5.0;
+    const double a31 = 3.0/40.0, a32 = 9.0/40.0;
+    const double a41 = 44.0/45.0, a42 = -56.0/15.0, a43 = 32.0/9.0;
+    const double a51 = 19372.0/6561.0, a52 = -25360.0/2187.0, 
+        a53 = 64448.0/6561.0, a54 = -212.0/729.0;
+    const double a61 = 9017.0/3168.0, a62 = -355.0/33.0, 
+        a63 = 46732.0/5247.0, a64 = 49.0/176.0, a65 = -5103.0/18656.0;
+    //!< Fifth order weights, also the last row of the tableau (FSAL)
+    const double b1 = 35.0/384.0, b3 = 500.0/1113.0, b4 = 125.0/192.0, 
+        b5 = -2187.0/6784.0, b6 = 11.0/84.0;
+    //!< Difference between the fifth and embedded fourth order weights
+    const double e1 = 71.0/57600.0, e3 = -71.0/16695.0, e4 = 71.0/1920.0,
+        e5 = -17253.0/339200.0, e6 = 22.0/525.0, e7 = -1.0/40.0;
+
+    const double Safety     = 0.9;  //!< Fraction of optimal step taken
+    const double MinScale   = 0.2;  //!< Smallest factor a step may shrink by
+    const double MaxScale   = 5.0;  //!< Largest factor a step may grow by
+    const double MaxStep    = 1.0;  //!< Largest step proposed (s)
+    //!< Relative and absolute tolerance per unit accuracy
+    const double Tolerance  = 1e-4;
+}
+
+//!< Rate of change of the cylindrical position (r,theta,z) at velocity v
+static inline threevector position_rate(const threevector &x,
+    const threevector &v){
+    return threevector(v.getx(),v.gety()/x.getx(),v.getz());
+}
+
+//!< Return true if the force terms see the same state in \p a and \p b
+static bool same_inputs(const ForceTermInputs &a, const ForceTermInputs &b){
+    return a.Temperature == b.Temperature && a.Mass == b.Mass 
+        && a.Radius == b.Radius && a.Density == b.Density 
+        && a.SurfaceArea == b.SurfaceArea 
+        && a.RotationFreq == b.RotationFreq && a.Potential == b.Potential 
+        && a.Liquid == b.Liquid && a.Positive == b.Positive
+        && std::memcmp(&a.Pdata,&b.Pdata,sizeof(PlasmaData)) == 0;
+}
+
+//!< Return true if each component of \p a and \p b is equal
+static inline bool same_vector(const threevector &a, const threevector &b){
+    return a.getx() == b.getx() && a.gety() == b.gety() 
+        && a.getz() == b.getz();
+}
+
 ForceModel::ForceModel():
 Model(){
     F_Debug("\n\nIn ForceModel::ForceModel():Model()\n\n");
+    Defaults();
     CreateFile("Default_Force_filename.txt");
 }
 
@@ -22,6 +75,7 @@ Model(filename,sample,pdata,accuracy){
         << "Matter *& sample, PlasmaData const *& pdata) : "
         << "Model(sample,pdata,accuracy)\n\n");
     ForceTerms = forceterms;
+    Defaults();
     CreateFile(filename);
 }
 
@@ -33,91 +87,187 @@ Model(filename,sample,*pdata,accuracy){
         << "Matter *& sample, PlasmaData const *& pdata) : "
         << "Model(sample,pdata,accuracy)\n\n");
     ForceTerms = forceterms;
+    Defaults();
     CreateFile(filename);
 }
 
 ForceModel::ForceModel(std::string filename, float accuracy,
-std::vector<ForceTerm*> forceterms, Matter *& sample, PlasmaGrid_Data & pgrid):
+std::vector<ForceTerm*> forceterms, Matter *& sample, 
+std::shared_ptr<const PlasmaGrid_Data> pgrid):
 Model(filename,sample,pgrid,accuracy){
     F_Debug("\n\nIn ForceModel::ForceModel(std::string filename, "
         << "float accuracy, std::vector<ForceTerm*> forceterms, "
-        << "Matter *& sample, PlasmaGrid const& pgrid) : "
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid) : "
         << "Model(sample,pgrid,accuracy)\n\n");
     ForceTerms = forceterms;
+    Defaults();
     CreateFile(filename);
 }
 
 ForceModel::ForceModel(std::string filename, float accuracy, 
-std::vector<ForceTerm*> forceterms, Matter *& sample, PlasmaGrid_Data & pgrid, 
+std::vector<ForceTerm*> forceterms, Matter *& sample, 
+std::shared_ptr<const PlasmaGrid_Data> pgrid, 
 PlasmaData & pdata):
 Model(filename,sample,pgrid,pdata,accuracy){
     F_Debug("\n\nIn ForceModel::ForceModel(std::string filename, "
         << "float accuracy, std::vector<ForceTerm*> forceterms, "
-        << "Matter *& sample, PlasmaGrid const& pgrid) : "
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid) : "
         << "Model(sample,pgrid,accuracy)\n\n");
     ForceTerms = forceterms;
+    Defaults();
     CreateFile(filename);
 }
 
+ForceModel::ForceModel(const ForceModel &other):
+Model(other),ForceTerms(other.ForceTerms),Kernel(other.Kernel),
+TermAccelerations(other.TermAccelerations),Method(other.Method),
+NextStep(other.NextStep),AccelerationCached(other.AccelerationCached),
+LastPosition(other.LastPosition),LastVelocity(other.LastVelocity),
+LastAcceleration(other.LastAcceleration),LastInputs(other.LastInputs){
+    F_Debug("\n\nIn ForceModel::ForceModel(const ForceModel &other)\n\n");
+    own_terms();
+}
+
+void ForceModel::Defaults(){
+    F_Debug("\tIn ForceModel::Defaults()\n\n");
+    Method = Integrator::DormandPrince;
+    NextStep = 0.0;
+    AccelerationCached = false;
+    if( ForceTerms.size() > MaxForceTerms )
+        throw std::length_error("ForceModel: more than "
+            + std::to_string(MaxForceTerms) + " force terms");
+    own_terms();
+    Kernel = Term::find_forcekernel(ForceTerms);
+}
+
+void ForceModel::own_terms(){
+    F_Debug("\tIn ForceModel::own_terms()\n\n");
+    std::vector<std::unique_ptr<ForceTerm>> Owned;
+    for( ForceTerm *&Term : ForceTerms ){
+        ForceTerm *Copy = Term->clone();
+        if( Copy == NULL ) continue;
+        Owned.emplace_back(Copy);
+        Term = Copy;
+    }
+    OwnTerms.swap(Owned);
+}
+
+void ForceModel::set_integrator(char method){
+    F_Debug("\tIn ForceModel::set_integrator(char method)\n\n");
+    assert( method == Integrator::Euler || method == Integrator::RungeKutta4
+        || method == Integrator::DormandPrince );
+    Method = method;
+    NextStep = 0.0;
+    AccelerationCached = false;
+}
+
+void ForceModel::get_inputs(ForceTermInputs &inputs)const{
+    inputs.Temperature  = Sample->get_temperature();
+    inputs.Mass         = Sample->get_mass();
+    inputs.Radius       = Sample->get_radius();
+    inputs.Density      = Sample->get_density();
+    inputs.SurfaceArea  = Sample->get_surfacearea();
+    inputs.RotationFreq = Sample->get_rotationalfreq();
+    inputs.Potential    = Sample->get_potential();
+    inputs.Liquid       = Sample->is_liquid();
+    inputs.Positive     = Sample->is_positive();
+    inputs.Pdata        = *Pdata;
+}
+
 void ForceModel::CreateFile(std::string filename){
     F_Debug("\tIn ForceModel::CreateFile(std::string filename)\n\n");
     FileName=filename;
-    ModelDataFile.open(FileName);
-    ModelDataFile << std::scientific << std::setprecision(16) << std::endl;
-    ModelDataFile << "Time\tPosition\tVelocity\tRotationFreq";
+    std::vector<DataColumn> Columns = { {"Time",Column::Scalar}, 
+        {"Position",Column::Vector}, {"Velocity",Column::Vector}, 
+        {"RotationFreq",Column::Scalar} };
 
-    //!< Loop over force terms and print their names
+    //!< Loop over force terms and add their names
     for(auto iter = ForceTerms.begin(); iter != ForceTerms.end(); ++iter) {
-        ModelDataFile << "\t" << (*iter)->PrintName();
+        Columns.push_back({(*iter)->PrintName(),Column::Vector});
     }
     
-    ModelDataFile << "\n";
-    ModelDataFile.close();
-    ModelDataFile.clear();
+    ModelDataFile.open(FileName,Columns);
     Print();
 }
 
+void ForceModel::write_checkpoint(CheckpointWriter &out)const{
+    F_Debug("\tIn ForceModel::write_checkpoint(CheckpointWriter &out)"
+        << "const\n\n");
+    Model::write_checkpoint(out);
+    out << NextStep;
+    for( const ForceTerm *Term : ForceTerms ) Term->write_state(out);
+}
+
+void ForceModel::read_checkpoint(CheckpointReader &in){
+    F_Debug("\tIn ForceModel::read_checkpoint(CheckpointReader &in)\n\n");
+    Model::read_checkpoint(in);
+    in >> NextStep;
+    for( ForceTerm *Term : ForceTerms ) Term->read_state(in);
+    AccelerationCached = false;
+}
+
 void ForceModel::Print(){
     F_Debug("\tIn ForceModel::Print()\n\n");
-    ModelDataFile.open(FileName,std::ofstream::app);
-    ModelDataFile << TotalTime << "\t" << Sample->get_position() << "\t" 
-        << Sample->get_velocity() << "\t" << Sample->get_rotationalfreq();
+    ModelDataFile << TotalTime << Sample->get_position() 
+        << Sample->get_velocity() << Sample->get_rotationalfreq();
 
     //!< Loop over force terms and print their evaluations
     for(auto iter = ForceTerms.begin(); iter != ForceTerms.end(); ++iter) {
-        ModelDataFile << "\t" 
-            << (*iter)->Evaluate(Sample,Pdata,Sample->get_velocity());
+        ModelDataFile << (*iter)->Evaluate(Sample,*Pdata,Sample->get_velocity());
     }
 
-    ModelDataFile << "\n";
-    ModelDataFile.close();
-    ModelDataFile.clear();
+    ModelDataFile.end_row();
 }
 
 double ForceModel::ProbeTimeStep()const{
     F_Debug( "\tIn ForceModel::ProbeTimeStep()const\n\n" );
 
     double timestep(0);
-    threevector Acceleration 
-        = CalculateAcceleration(Sample->get_position(),Sample->get_velocity());
-
-    //!< For Accuracy = 1.0, requires change in velocity less than 10cm/s
-    if( Acceleration.mag3() == 0 ){
-        static bool runOnce = true;
-        WarnOnce(runOnce,"Zero Acceleration!\ntimestep being set to unity");
-        //!< Set arbitarily large time step
-        timestep = 1;
+    threevector Acceleration;
+
+    if( Method == Integrator::DormandPrince && NextStep > 0.0 ){
+        //!< Use the step proposed by the error control of the last step.
+        //!< Heating and charging change the forces without a step being
+        //!< taken, so shorten it in proportion to any growth of the
+        //!< acceleration since it was proposed. The acceleration is only
+        //!< recalculated if the dust or plasma have changed.
+        timestep = NextStep;
+        ForceTermInputs Inputs;
+        get_inputs(Inputs);
+        if( AccelerationCached && !(same_inputs(Inputs,LastInputs)
+            && same_vector(Sample->get_position(),LastPosition)
+            && same_vector(Sample->get_velocity(),LastVelocity)) ){
+            Acceleration = CalculateAcceleration(Sample->get_position(),
+                Sample->get_velocity());
+            double Now = Acceleration.mag3(), Last = LastAcceleration.mag3();
+            if( Now > Last && Last > 0.0 )
+                timestep *= Last/Now;
+            else if( Now > Last )
+                timestep = std::min(timestep,(0.01*Accuracy)/Now);
+        }
     }else{
-        timestep = (0.01*Accuracy)*(1.0/Acceleration.mag3());
+        Acceleration = CalculateAcceleration(Sample->get_position(),
+            Sample->get_velocity());
+        //!< For Accuracy = 1.0, requires change in velocity less than 10cm/s
+        if( Acceleration.mag3() == 0 ){
+            static std::atomic<bool> runOnce(true);
+            WarnOnce(runOnce,
+                "Zero Acceleration!\ntimestep being set to unity");
+            //!< Set arbitarily large time step
+            timestep = 1;
+        }else{
+            timestep = (0.01*Accuracy)*(1.0/Acceleration.mag3());
+        }
     }
 
     //!< Check if the timestep should be shortened such that particles don't 
     //!< cross many grid cells in a single step
     //!< (This is often the case without this condition.)
+    //!< Interpolated plasma grids are smooth, so allow up to a whole cell
     if( !ContinuousPlasma &&  Sample->get_velocity().mag3() != 0.0 
-        && (get_dlx()*Accuracy/(2*Sample->get_velocity().mag3())) < timestep ){
+        && (get_gridstep()*Accuracy/Sample->get_velocity().mag3()) < timestep ){
         F_Debug("\ntimestep limited by grid size!");
-        timestep = get_dlx()*Accuracy/(2*Sample->get_velocity().mag3());
+        timestep = get_gridstep()*Accuracy/Sample->get_velocity().mag3();
     }
     
     //!< Check if the timestep is limited by the gyration of the particle in a
@@ -154,26 +304,31 @@ void ForceModel::Force(double timestep){
     //!< of the process.
     assert(timestep > 0 && timestep <= TimeStep );
 
-    //!< Code for Euler time step, this was the original DTOKSU method
-    threevector Acceleration 
-        = CalculateAcceleration(Sample->get_position(),Sample->get_velocity());
-    threevector ChangeInPosition(
-        Sample->get_velocity().getx()*timestep,
-        (Sample->get_velocity().gety()*timestep)/Sample->get_position().getx(),
-        Sample->get_velocity().getz()*timestep);
-    threevector ChangeInVelocity = Acceleration*timestep;
-
-    //!< Code for 4th order Runge Kutta time step, higher accuracy and stability
-    threevector xi = Sample->get_position();
-    threevector vi = Sample->get_velocity();
-    RungeKutta4(xi,vi,timestep);
-    //std::cout << "\n\nEuler dx = " << ChangeInPosition;
-    //std::cout << "\nEuler dv = " << ChangeInVelocity;
-    //std::cout << "\nRK4 dx = " << xi-Sample->get_position();
-    //std::cout << "\nRK4 dv = " << vi-Sample->get_velocity(); std::cin.get();
+    threevector ChangeInPosition, ChangeInVelocity;
+    if( Method == Integrator::Euler ){
+        //!< Code for Euler time step, this was the original DTOKSU method
+        threevector Acceleration = CalculateAcceleration(
+            Sample->get_position(),Sample->get_velocity());
+        ChangeInPosition = threevector(
+            Sample->get_velocity().getx()*timestep,
+            (Sample->get_velocity().gety()*timestep)
+            /Sample->get_position().getx(),
+            Sample->get_velocity().getz()*timestep);
+        ChangeInVelocity = Acceleration*timestep;
     
-    //!< Assert change in absolute vel less than ten times accuracy
-    assert( ChangeInVelocity.mag3() < 0.1*Accuracy );
+        //!< Assert change in absolute vel less than ten times accuracy
+        assert( ChangeInVelocity.mag3() < 0.1*Accuracy );
+    }else{
+        //!< Higher order methods, giving the final position and velocity
+        threevector xf, vf;
+        if( Method == Integrator::RungeKutta4 ){
+            RungeKutta4(xf,vf,timestep);
+        }else{
+            DormandPrince(xf,vf,timestep);
+        }
+        ChangeInPosition = xf-Sample->get_position();
+        ChangeInVelocity = vf-Sample->get_velocity();
+    }
 
     // Krasheninnikov, S. I. (2006). On dust spin up in uniform magnetized plasma. Physics of Plasmas, 13(11), 2004–2007.
 //  double TimeOfSpinUp = Sample->get_radius()*sqrt(Pdata->mi/(Kb*Pdata->IonTemp))*Sample->get_density()/(Pdata->mi*Pdata->IonDensity);
@@ -204,9 +359,13 @@ void ForceModel::Force(double timestep){
 
     Sample->update_motion(ChangeInPosition,ChangeInVelocity,RotationalSpeedUp);
 
+    //!< Record the state the FSAL acceleration is valid for
+    LastPosition = Sample->get_position();
+    LastVelocity = Sample->get_velocity();
+
     F1_Debug( "\nChangeInPosition : " << ChangeInPosition 
-        << "\nChangeInVelocity : " << ChangeInVelocity << "\nAcceleration : " 
-        << Acceleration << "\nTimeStep : " << TimeStep << "\n");
+        << "\nChangeInVelocity : " << ChangeInVelocity 
+        << "\nTimeStep : " << TimeStep << "\n");
     F_Debug("\t"); Print();
     TotalTime += timestep;
 }
@@ -229,10 +388,20 @@ threevector ForceModel::CalculateAcceleration(threevector position,
         0.0);
 
     //!< Sum all other force terms for the velocity given.
-    for(auto iter = ForceTerms.begin(); iter != ForceTerms.end(); ++iter) {
-        Accel += (*iter)->Evaluate(Sample,Pdata,velocity);
-        F1_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
-            << (*iter)->Evaluate(Sample,Pdata,velocity) );
+    if( Kernel != NULL ){
+        Kernel->Evaluate(ForceTerms,Sample,*Pdata,velocity,-1,
+            TermAccelerations.data());
+        for( unsigned int n = 0; n < ForceTerms.size(); n ++ ){
+            Accel += TermAccelerations[n];
+            F1_Debug( "\n\t\t" << ForceTerms[n]->PrintName() << " = " 
+                << TermAccelerations[n] );
+        }
+    }else{
+        for(auto iter = ForceTerms.begin(); iter != ForceTerms.end(); ++iter){
+            Accel += (*iter)->Evaluate(Sample,*Pdata,velocity);
+            F1_Debug( "\n\t\t" << (*iter)->PrintName() << " = " 
+                << (*iter)->Evaluate(Sample,*Pdata,velocity) );
+        }
     }
 
     F1_Debug( "\n\t\tAccel = " << Accel << "\n\n" );
@@ -242,36 +411,146 @@ threevector ForceModel::CalculateAcceleration(threevector position,
 
 void ForceModel::RungeKutta4(threevector &xf, threevector &vf, 
         double timestep)const{
+    F_Debug("\tIn ForceModel::RungeKutta4(threevector &xf, threevector &vf, "
+        << "double timestep)const\n\n");
 
     threevector xi = Sample->get_position();
     threevector vi = Sample->get_velocity();
 
-    threevector k1x(
-        vi.getx()*timestep,
-        (vi.gety()*timestep)/xi.getx(), 
-        vi.getz()*timestep);
+    threevector k1x = timestep*position_rate(xi,vi);
     threevector k1v = timestep*CalculateAcceleration(xi,vi);
 
-    threevector k2x(
-        (vi.getx()+k1v.getx()/2.0)*timestep,
-        ((vi.gety()+k1v.gety())*timestep)/(xi.getx()+k1x.getx()/2.0), 
-        (vi.getz()+k1v.getz()/2.0)*timestep);
-    threevector k2v 
-        = timestep*CalculateAcceleration(xi+k1x*(1.0/2.0),vi+k1v*(1.0/2.0));
-
-    threevector k3x(
-        (vi.getx()+k2v.getx()/2.0)*timestep,
-        ((vi.gety()+k2v.gety())*timestep)/(xi.getx()+k2x.getx()/2.0), 
-        (vi.getz()+k2v.getz()/2.0)*timestep);
-    threevector k3v 
-        = timestep*CalculateAcceleration(xi+k2x*(1.0/2.0),vi+k2v*(1.0/2.0));
-
-    threevector k4x(
-        (vi.getx()+k3v.getx()/2.0)*timestep,
-        ((vi.gety()+k3v.gety())*timestep)/(xi.getx()+k3x.getx()/2.0), 
-        (vi.getz()+k3v.getz()/2.0)*timestep);
-    threevector k4v = timestep*CalculateAcceleration(xi+k3x,vi+k3v);
+    threevector x2 = xi+k1x*(1.0/2.0), v2 = vi+k1v*(1.0/2.0);
+    threevector k2x = timestep*position_rate(x2,v2);
+    threevector k2v = timestep*CalculateAcceleration(x2,v2);
+
+    threevector x3 = xi+k2x*(1.0/2.0), v3 = vi+k2v*(1.0/2.0);
+    threevector k3x = timestep*position_rate(x3,v3);
+    threevector k3v = timestep*CalculateAcceleration(x3,v3);
+
+    threevector x4 = xi+k3x, v4 = vi+k3v;
+    threevector k4x = timestep*position_rate(x4,v4);
+    threevector k4v = timestep*CalculateAcceleration(x4,v4);
 
     xf = xi + (k1x + 2.0*(k2x+k3x) + k4x)*(1.0/6.0);
     vf = vi + (k1v + 2.0*(k2v+k3v) + k4v)*(1.0/6.0);
-}
\ No newline at end of file
+}
+
+void ForceModel::DormandPrince(threevector &xf, threevector &vf, 
+        double timestep){
+    F_Debug("\tIn ForceModel::DormandPrince(threevector &xf, "
+        << "threevector &vf, double timestep)\n\n");
+
+    threevector x = Sample->get_position();
+    threevector v = Sample->get_velocity();
+    double Tolerance = DP::Tolerance*Accuracy;
+
+    //!< The first stage is the last stage of the previous step, unless the
+    //!< dust or plasma have changed since it was evaluated
+    ForceTermInputs Inputs;
+    get_inputs(Inputs);
+    threevector a1;
+    if( AccelerationCached && same_inputs(Inputs,LastInputs) 
+        && same_vector(x,LastPosition) && same_vector(v,LastVelocity) ){
+        a1 = LastAcceleration;
+    }else{
+        a1 = CalculateAcceleration(x,v);
+    }
+
+    double h = NextStep > 0.0 ? NextStep : timestep;
+    double Remaining = timestep;
+    while( Remaining > 0.0 ){
+        //!< Shorten the step to end at exactly timestep, keeping the 
+        //!< proposal for the step after
+        bool Truncated = h > Remaining;
+        double dt = Truncated ? Remaining : h;
+
+        threevector x1 = position_rate(x,v);
+
+        threevector x2 = x + dt*(DP::a21*x1);
+        threevector v2 = v + dt*(DP::a21*a1);
+        threevector k2 = position_rate(x2,v2);
+        threevector a2 = CalculateAcceleration(x2,v2);
+
+        threevector x3 = x + dt*(DP::a31*x1 + DP::a32*k2);
+        threevector v3 = v + dt*(DP::a31*a1 + DP::a32*a2);
+        threevector k3 = position_rate(x3,v3);
+        threevector a3 = CalculateAcceleration(x3,v3);
+
+        threevector x4 = x + dt*(DP::a41*x1 + DP::a42*k2 + DP::a43*k3);
+        threevector v4 = v + dt*(DP::a41*a1 + DP::a42*a2 + DP::a43*a3);
+        threevector k4 = position_rate(x4,v4);
+        threevector a4 = CalculateAcceleration(x4,v4);
+
+        threevector x5 = x + dt*(DP::a51*x1 + DP::a52*k2 + DP::a53*k3 
+            + DP::a54*k4);
+        threevector v5 = v + dt*(DP::a51*a1 + DP::a52*a2 + DP::a53*a3 
+            + DP::a54*a4);
+        threevector k5 = position_rate(x5,v5);
+        threevector a5 = CalculateAcceleration(x5,v5);
+
+        threevector x6 = x + dt*(DP::a61*x1 + DP::a62*k2 + DP::a63*k3 
+            + DP::a64*k4 + DP::a65*k5);
+        threevector v6 = v + dt*(DP::a61*a1 + DP::a62*a2 + DP::a63*a3 
+            + DP::a64*a4 + DP::a65*a5);
+        threevector k6 = position_rate(x6,v6);
+        threevector a6 = CalculateAcceleration(x6,v6);
+
+        //!< Fifth order solution, the seventh stage is evaluated here
+        threevector xn = x + dt*(DP::b1*x1 + DP::b3*k3 + DP::b4*k4 
+            + DP::b5*k5 + DP::b6*k6);
+        threevector vn = v + dt*(DP::b1*a1 + DP::b3*a3 + DP::b4*a4 
+            + DP::b5*a5 + DP::b6*a6);
+        threevector k7 = position_rate(xn,vn);
+        threevector a7 = CalculateAcceleration(xn,vn);
+
+        //!< Estimate of the local error from the embedded fourth order 
+        //!< solution, with the angle converted to a distance
+        threevector dx = dt*(DP::e1*x1 + DP::e3*k3 + DP::e4*k4 + DP::e5*k5
+            + DP::e6*k6 + DP::e7*k7);
+        threevector dv = dt*(DP::e1*a1 + DP::e3*a3 + DP::e4*a4 + DP::e5*a5
+            + DP::e6*a6 + DP::e7*a7);
+        double r = std::max(fabs(x.getx()),fabs(xn.getx()));
+        double Scale[6] = { r, r, std::max(fabs(x.getz()),fabs(xn.getz())),
+            std::max(fabs(v.getx()),fabs(vn.getx())),
+            std::max(fabs(v.gety()),fabs(vn.gety())),
+            std::max(fabs(v.getz()),fabs(vn.getz())) };
+        double Delta[6] = { dx.getx(), r*dx.gety(), dx.getz(), 
+            dv.getx(), dv.gety(), dv.getz() };
+        double Error(0.0);
+        for( unsigned int n = 0; n < 6; n ++ ){
+            double e = Delta[n]/(Tolerance+Tolerance*Scale[n]);
+            Error += e*e;
+        }
+        Error = sqrt(Error/6.0);
+        assert(Error == Error);
+
+        double Factor = DP::MaxScale;
+        if( Error > 0.0 )
+            Factor = std::min(DP::MaxScale,std::max(DP::MinScale,
+                DP::Safety*pow(Error,-0.2)));
+
+        if( Error <= 1.0 ){
+            //!< Accept the step
+            x = xn;
+            v = vn;
+            a1 = a7;
+            Remaining = Truncated ? 0.0 : Remaining-dt;
+            if( !Truncated || Factor < 1.0 ) 
+                h = std::min(dt*Factor,DP::MaxStep);
+        }else{
+            //!< Reject the step and retry with a shorter one
+            F1_Debug("\n\t\tStep rejected, Error = " << Error << "\n");
+            h = dt*Factor;
+        }
+    }
+    NextStep = h;
+    xf = x;
+    vf = v;
+
+    //!< Store the last stage for the next step, valid while the inputs to 
+    //!< the force terms are unchanged
+    LastAcceleration = a1;
+    LastInputs = Inputs;
+    AccelerationCached = true;
+}
@@ -5,27 +5,28 @@
  */
 
 #include "ForceTerms.h"
+#include "Checkpoint.h"
 
 namespace Term{
 //!< This term is due to gravity, I'm not refencing it!
 threevector Gravity::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct Gravity::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
-    return Pdata->Gravity;
+    return Pdata.Gravity;
 }
 //!< This term is due to Lorentz force, I'm not refencing it either!
 threevector LorentzForce::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct LorentzForce::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
     //!< Dust grain charge to mass ratio
     double Charge = -4.0*PI*epsilon0*Sample->get_radius()*Kb*
-        Pdata->ElectronTemp*Sample->get_potential()/echarge;
+        Pdata.ElectronTemp*Sample->get_potential()/echarge;
 
     double qtom = Charge/Sample->get_mass();
 
@@ -35,7 +36,7 @@ threevector LorentzForce::Evaluate(const Matter* Sample,
     //      (qtom = 3.0*epsilon0*Kb*Sample->get_temperature())
     //          /(echarge*pow(Sample->get_radius(),2)*Sample->get_density());
     // else 
-    //      qtom = -3.0*epsilon0*Pdata->ElectronTemp*ConvertKelvsToeV*
+    //      qtom = -3.0*epsilon0*Pdata.ElectronTemp*ConvertKelvsToeV*
     //          Sample->get_potential()/
     //          (pow(Sample->get_radius(),2)*Sample->get_density());   
     //else qtom = -1000.0*3.0*epsilon0*V/(a*a*rho);//why it had Te???????
@@ -44,8 +45,8 @@ threevector LorentzForce::Evaluate(const Matter* Sample,
     // Google Translate: Here I had changed it to all the brides in 
     // After 28_Feb so they have to be done again
     
-    threevector returnvec = (Pdata->ElectricField+(velocity^
-        Pdata->MagneticField))*qtom;
+    threevector returnvec = (Pdata.ElectricField+(velocity^
+        Pdata.MagneticField))*qtom;
     return returnvec;
 }
 //!< This term is arises by simply multiplying ion momentum by SOMLIonFLux
@@ -55,13 +56,13 @@ threevector LorentzForce::Evaluate(const Matter* Sample,
 //!< Plasma Phys. Control. Fusion 46, (2004).
 //!< With a shifted maxwellian velocity distribution for small dust
 threevector SOMLIonDrag::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct SOMLIonDrag::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
-    return (Pdata->PlasmaVel-velocity)*
-        Pdata->mi*(1.0/sqrt(Kb*Pdata->IonTemp/Pdata->mi))*
+    return (Pdata.PlasmaVel-velocity)*
+        Pdata.mi*(sqrt(2.0)/Pdata.Derived.IonThermalSpeed)*
         Flux::SOMLIonFlux(Sample,Pdata,Sample->get_potential())*
         (1.0/Sample->get_mass());
 }
@@ -72,13 +73,13 @@ threevector SOMLIonDrag::Evaluate(const Matter* Sample,
 //!< Plasma Phys. Control. Fusion 46, (2004).
 //!< With a shifted maxwellian velocity distribution for large dust
 threevector SMOMLIonDrag::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn SMOMLIonDrag::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
-    return (Pdata->PlasmaVel-velocity)*
-        Pdata->mi*(1.0/sqrt(Kb*Pdata->IonTemp/Pdata->mi))*
+    return (Pdata.PlasmaVel-velocity)*
+        Pdata.mi*(sqrt(2.0)/Pdata.Derived.IonThermalSpeed)*
         Flux::SMOMLIonFlux(Sample,Pdata,Sample->get_potential())*
         (1.0/Sample->get_mass());
 }
@@ -87,10 +88,10 @@ threevector SMOMLIonDrag::Evaluate(const Matter* Sample,
 //!< A. V. Ivlev, S. K. Zhdanov, S. A. Khrapak, and G. E. Morfill,
 //!< Plasma Phys. Control. Fusion 46, (2004).
 threevector DTOKSIonDrag::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct DTOKSIonDrag::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
     threevector Fid(0.0,0.0,0.0);
     //!< Calculations for ion drag: Mach number, shielding length with fitting 
@@ -98,15 +99,15 @@ threevector DTOKSIonDrag::Evaluate(const Matter* Sample,
     //!< ION TEMPERATURE IN THIS FUNCTION IS IN ev.
     double ConvertKelvsToeV(8.621738e-5);
     threevector Mt(0.0,0.0,0.0);
-    if( Pdata->IonTemp != 0 ) 
-        Mt = (Pdata->PlasmaVel-velocity)*
-            sqrt(Pdata->mi/(Kb*Pdata->IonTemp)); 
-        F1_Debug("\nMt = " << Mt << "\tmi = " << Pdata->mi
-            << "\nVp = " << Pdata->PlasmaVel
+    if( Pdata.IonTemp != 0 ) 
+        Mt = (Pdata.PlasmaVel-velocity)*
+            sqrt(Pdata.mi/(Kb*Pdata.IonTemp)); 
+        F1_Debug("\nMt = " << Mt << "\tmi = " << Pdata.mi
+            << "\nVp = " << Pdata.PlasmaVel
             << "\nVd = " << velocity);
 
-        if( Pdata->IonDensity == 0 || Pdata->IonTemp == 0 
-            || Pdata->ElectronTemp == 0  || Mt.mag3() == 0 ){ 
+        if( Pdata.IonDensity == 0 || Pdata.IonTemp == 0 
+            || Pdata.ElectronTemp == 0  || Mt.mag3() == 0 ){ 
 
             Fid = threevector(0.0,0.0,0.0);
         }else{
@@ -114,13 +115,13 @@ threevector DTOKSIonDrag::Evaluate(const Matter* Sample,
             //!< theory with screening length 'Lambda'.
             if(Mt.mag3()<2.0){ 
 
-                double lambda = sqrt(epsilon0/(Pdata->IonDensity*echarge*
+                double lambda = sqrt(epsilon0/(Pdata.IonDensity*echarge*
                     exp(-Mt.mag3()*Mt.mag3()/2)*
-                    (1.0/(Pdata->IonTemp*ConvertKelvsToeV))+
-                    1.0/(Pdata->ElectronTemp*ConvertKelvsToeV)));
-                double beta = Pdata->ElectronTemp*ConvertKelvsToeV*
+                    (1.0/(Pdata.IonTemp*ConvertKelvsToeV))+
+                    1.0/(Pdata.ElectronTemp*ConvertKelvsToeV)));
+                double beta = Pdata.ElectronTemp*ConvertKelvsToeV*
                     Sample->get_radius()*fabs(Sample->get_potential())/
-                    (lambda*Pdata->IonTemp*ConvertKelvsToeV);
+                    (lambda*Pdata.IonTemp*ConvertKelvsToeV);
                 F1_Debug("\nlambda = " << lambda << "\nbeta = " << beta 
                     << "\nPot = " << Sample->get_potential());
 
@@ -134,13 +135,13 @@ threevector DTOKSIonDrag::Evaluate(const Matter* Sample,
                     double Lambda = -exp(beta/2.0)*
                         Exponential_Integral_Ei(-beta/2.0); 
                     FidS = Mt*(sqrt(32*PI)/3.0*epsilon0*
-                        pow(Pdata->IonTemp*ConvertKelvsToeV,2)*Lambda*
+                        pow(Pdata.IonTemp*ConvertKelvsToeV,2)*Lambda*
                         pow(beta,2));
                 }
 
-                threevector FidC =(Pdata->PlasmaVel-velocity)*4.0*
-                    PI*pow(Sample->get_radius(),2)*Pdata->IonDensity*Pdata->mi*
-                    sqrt(Kb*Pdata->ElectronTemp/(2.0*PI*Me))*
+                threevector FidC =(Pdata.PlasmaVel-velocity)*4.0*
+                    PI*pow(Sample->get_radius(),2)*Pdata.IonDensity*Pdata.mi*
+                    sqrt(Kb*Pdata.ElectronTemp/(2.0*PI*Me))*
                     exp(-Sample->get_potential()); 
                 //for John's ion drag... I assume here and in other places in 
                 //the calculation that the given potential is normalised to 
@@ -153,11 +154,11 @@ threevector DTOKSIonDrag::Evaluate(const Matter* Sample,
         }else{ 
             //!< Relative speed greater than twice the mach number, 
             //!< use just plain collection area
-            //double lambdadi = sqrt(epsilon0*Pdata->IonTemp*ConvertKelvsToeV)/
-            //  sqrt(Pdata->IonDensity*echarge);
+            //double lambdadi = sqrt(epsilon0*Pdata.IonTemp*ConvertKelvsToeV)/
+            //  sqrt(Pdata.IonDensity*echarge);
             //F_Debug("\nlambdadi = " << lambdadi);
-            Fid = Mt*Mt.mag3()*PI*Pdata->IonTemp*ConvertKelvsToeV*
-                pow(Sample->get_radius(),2)*Pdata->IonDensity*echarge;
+            Fid = Mt*Mt.mag3()*PI*Pdata.IonTemp*ConvertKelvsToeV*
+                pow(Sample->get_radius(),2)*Pdata.IonDensity*echarge;
         }
     }
     return Fid*(3/(4*PI*pow(Sample->get_radius(),3)*Sample->get_density()));
@@ -168,38 +169,38 @@ threevector DTOKSIonDrag::Evaluate(const Matter* Sample,
 //!< S. I. Krasheninnikov, R. D. Smirnov, and D. L. Rudakov, 
 //!< Plasma Phys. Control. Fusion 53, 083001 (2011).
 threevector DUSTTIonDrag::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct DUSTTIonDrag::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
     //!< Pre-define commonly used quantities
     double Chi = Sample->get_potential(); 
-    double Tau = Pdata->IonTemp/Pdata->ElectronTemp;
-    double uz = (Pdata->PlasmaVel-velocity).mag3()/
-        sqrt(2.0*Kb*Pdata->IonTemp/Pdata->mi);
-    double uzp = uz+sqrt(-Pdata->Z*Chi/Tau);
-    double uzm = uz-sqrt(-Pdata->Z*Chi/Tau);
-    double wzp = uz*uz+Pdata->Z*Chi/Tau;
-    double wzm = uz*uz-Pdata->Z*Chi/Tau;
+    double Tau = Pdata.Derived.TiTe;
+    double uz = (Pdata.PlasmaVel-velocity).mag3()/
+        Pdata.Derived.IonThermalSpeed;
+    double uzp = uz+sqrt(-Pdata.Z*Chi/Tau);
+    double uzm = uz-sqrt(-Pdata.Z*Chi/Tau);
+    double wzp = uz*uz+Pdata.Z*Chi/Tau;
+    double wzm = uz*uz-Pdata.Z*Chi/Tau;
 
     double CircularArea = PI*Sample->get_radius()*Sample->get_radius();
     double G = (erf(uz)-2.0*uz*exp(-uz*uz))/(2.0*uz*uz*sqrt(PI));
     //!< Predefine scattering 
     double CoulombLogarithm = 17.0;     //!< Approximation of coulomb logarithm   
     //!< Equation (26)
-    double IonScatter = 2.0*CircularArea*Pdata->mi*Pdata->IonDensity*
-        sqrt(2.0*Kb*Pdata->IonTemp/Pdata->mi)*
-        (Pdata->PlasmaVel-velocity).mag3()*(Pdata->Z*Chi/Tau)*
-        (Pdata->Z*Chi/Tau)*G*log(CoulombLogarithm);
+    double IonScatter = 2.0*CircularArea*Pdata.mi*Pdata.IonDensity*
+        Pdata.Derived.IonThermalSpeed*
+        (Pdata.PlasmaVel-velocity).mag3()*(Pdata.Z*Chi/Tau)*
+        (Pdata.Z*Chi/Tau)*G*log(CoulombLogarithm);
     double IonCollect(0.0);
     if( Chi <= 0 )
         //!< Equation (25), missing common coefficients
         IonCollect = (1.0/(4.0*uz*uz))*
             ((1.0/sqrt(PI))*((1.0+2.0*uz*uz+(1.0-2.0*uz*uz)*
-            sqrt(-Pdata->Z*Sample->get_potential()/Tau)/uz)*exp(-uzp*uzp)+
+            sqrt(-Pdata.Z*Sample->get_potential()/Tau)/uz)*exp(-uzp*uzp)+
             (1.0+2.0*uz*uz-(1.0-2.0*uz*uz)*
-            sqrt(-Pdata->Z*Sample->get_potential()/Tau)/uz)*exp(-uzm*uzm))+
+            sqrt(-Pdata.Z*Sample->get_potential()/Tau)/uz)*exp(-uzm*uzm))+
             uz*(1.0+2.0*wzp-(1.0-2.0*wzm)/(2.0*uz*uz))*(erf(uzp)+erf(uzm)));
     else    
         //!< Equation (24), missing common coefficients
@@ -207,8 +208,8 @@ threevector DUSTTIonDrag::Evaluate(const Matter* Sample,
             ((1.0/sqrt(PI))*(1.0+2.0*wzp)*exp(-uz*uz)+
             uz*(1.0+2*wzp-(1.0-2.0*wzm)/(2.0*uz*uz))*erf(uz));
     //!< The sum of Equation (24) and (25)
-    return CircularArea*Pdata->mi*Pdata->IonDensity*
-        sqrt(2.0*Kb*Pdata->IonTemp/Pdata->mi)*(Pdata->PlasmaVel-velocity)*
+    return CircularArea*Pdata.mi*Pdata.IonDensity*
+        Pdata.Derived.IonThermalSpeed*(Pdata.PlasmaVel-velocity)*
         (IonScatter+IonCollect)*(1.0/Sample->get_mass());
 }
 
@@ -217,17 +218,17 @@ threevector DUSTTIonDrag::Evaluate(const Matter* Sample,
 //!< S. A. Khrapak, A. V. Ivlev, S. K. Zhdanov, and G. E. Morfill, 
 //!< Phys. Plasmas 12, 1 (2005).
 threevector HybridIonDrag::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct HybridIonDrag::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
 
     //!< Taken from :
-    double IonThermalVelocity = sqrt(Kb*Pdata->IonTemp/Pdata->mi);
+    double IonThermalVelocity = Pdata.Derived.IonThermalSpeed/sqrt(2.0);
     //!< Normalised ion flow velocity
-    double u = (Pdata->PlasmaVel-velocity).mag3()*(1.0/IonThermalVelocity);
-    double Tau = Pdata->ElectronTemp/Pdata->IonTemp;
+    double u = (Pdata.PlasmaVel-velocity).mag3()*(1.0/IonThermalVelocity);
+    double Tau = Pdata.ElectronTemp/Pdata.IonTemp;
 
     if( u == 0.0 ){
         threevector Zero(0.0,0.0,0.0);
@@ -236,9 +237,9 @@ threevector HybridIonDrag::Evaluate(const Matter* Sample,
 
     //!< This expression for z looks weird but is correct!
     double z = Sample->get_potential();
-    double DebyeLength = sqrt(epsilon0*Kb*Pdata->ElectronTemp/(Pdata->ElectronDensity*echarge*echarge));
-    double Gamma = Sample->get_radius()*Kb*Pdata->ElectronTemp*Sample->get_potential()
-        /(DebyeLength*Pdata->mi*IonThermalVelocity*IonThermalVelocity*(1+u*u));
+    double DebyeLength = Pdata.Derived.DebyeLength;
+    double Gamma = Sample->get_radius()*Kb*Pdata.ElectronTemp*Sample->get_potential()
+        /(DebyeLength*Pdata.mi*IonThermalVelocity*IonThermalVelocity*(1+u*u));
     double CoulombLogarithm(0.0);
     if( Gamma != 0.0 ){
         CoulombLogarithm = log(1.0+1.0/Gamma);     //!< Approximation of coulomb logarithm   
@@ -247,7 +248,7 @@ threevector HybridIonDrag::Evaluate(const Matter* Sample,
 
 
     double Coefficient = sqrt(2*PI)*Sample->get_radius()*
-        Sample->get_radius()*Pdata->IonDensity*Pdata->mi*
+        Sample->get_radius()*Pdata.IonDensity*Pdata.mi*
         IonThermalVelocity*IonThermalVelocity;
     double Collection = (1.0/u)*exp(-u*u/2.0)*(1.0+2.0*Tau*z+u*u-4*z*z*Tau*Tau*
         CoulombLogarithm); 
@@ -257,16 +258,16 @@ threevector HybridIonDrag::Evaluate(const Matter* Sample,
 
     //!< Equation (18)
     threevector HybridDrag = Coefficient*(Collection+Scattering)*(
-        Pdata->PlasmaVel-velocity).getunit();
+        Pdata.PlasmaVel-velocity).getunit();
 
 
-    //std::cout << "\n\nni = " << Pdata->IonDensity;
-    //std::cout << "\nTi = " << Pdata->IonTemp;
-    //std::cout << "\nmi = " << Pdata->mi;
+    //std::cout << "\n\nni = " << Pdata.IonDensity;
+    //std::cout << "\nTi = " << Pdata.IonTemp;
+    //std::cout << "\nmi = " << Pdata.mi;
     //std::cout << "\nVti = " << IonThermalVelocity;
-    //std::cout << "\nPlasmaVel = " << Pdata->PlasmaVel;
+    //std::cout << "\nPlasmaVel = " << Pdata.PlasmaVel;
     //std::cout << "\nvelocity = " << velocity;
-    //std::cout << "\nrelative velocity = " << Pdata->PlasmaVel-velocity;
+    //std::cout << "\nrelative velocity = " << Pdata.PlasmaVel-velocity;
     //std::cout << "\nu = " << u;
     //std::cout << "\nArea = " << Sample->get_radius()*Sample->get_radius()*PI;
     //std::cout << "\nMass = " << Sample->get_mass();
@@ -288,17 +289,17 @@ threevector HybridIonDrag::Evaluate(const Matter* Sample,
 //!< S. A. Khrapak, A. V. Ivlev, S. K. Zhdanov, and G. E. Morfill, 
 //!< Phys. Plasmas 12, 1 (2005).
 threevector LloydIonDrag::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct HybridIonDrag::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
 
     //!< Taken from :
-    double IonThermalVelocity = sqrt(Kb*Pdata->IonTemp/Pdata->mi);
+    double IonThermalVelocity = Pdata.Derived.IonThermalSpeed/sqrt(2.0);
     //!< Normalised ion flow velocity
-    double u = (Pdata->PlasmaVel-velocity).mag3()*(1.0/IonThermalVelocity);
-    double Tau = Pdata->ElectronTemp/Pdata->IonTemp;
+    double u = (Pdata.PlasmaVel-velocity).mag3()*(1.0/IonThermalVelocity);
+    double Tau = Pdata.ElectronTemp/Pdata.IonTemp;
 
     if( u == 0.0 ){
         threevector Zero(0.0,0.0,0.0);
@@ -309,18 +310,18 @@ threevector LloydIonDrag::Evaluate(const Matter* Sample,
 
     //!< This expression for z looks weird but is correct!
     double z = Potential*4.0*PI*epsilon0;
-    double DebyeLength = sqrt(epsilon0*Kb*Pdata->ElectronTemp/(Pdata->ElectronDensity*echarge*echarge));
-    double Gamma = Radius*Kb*Pdata->ElectronTemp*Potential
-        /(DebyeLength*Pdata->mi*IonThermalVelocity*IonThermalVelocity*(1+u*u));
+    double DebyeLength = Pdata.Derived.DebyeLength;
+    double Gamma = Radius*Kb*Pdata.ElectronTemp*Potential
+        /(DebyeLength*Pdata.mi*IonThermalVelocity*IonThermalVelocity*(1+u*u));
     double CoulombLogarithm(0.0);
     if( Gamma != 0.0 ){
         CoulombLogarithm = log(1.0+1.0/Gamma);     //!< Approximation of coulomb logarithm   
     }
-    double Beta =  Radius/(IonThermalVelocity*Pdata->mi/(echarge*Pdata->MagneticField.mag3()));
+    double Beta =  Radius/(IonThermalVelocity*Pdata.mi/(echarge*Pdata.MagneticField.mag3()));
 
     double G = 1.0/(1.0+Beta*Beta/(2.81e5*Radius-0.187));
 
-    double Coefficient = PI*Radius*Radius*Pdata->IonDensity*Pdata->mi*
+    double Coefficient = PI*Radius*Radius*Pdata.IonDensity*Pdata.mi*
         IonThermalVelocity*IonThermalVelocity;
     double NoFieldDependence = (u*u+1.0)*erf(u/sqrt(2.0))+u*exp(-u*u/2.0); 
     double FieldDependence = erf(u/sqrt(2.0))*((1.0-1.0/(u*u))*(1+2.0*Tau*Potential)
@@ -329,16 +330,16 @@ threevector LloydIonDrag::Evaluate(const Matter* Sample,
         4*Potential*Potential*Tau*Tau*CoulombLogarithm)*exp(-u*u/2.0);
 
     threevector LloydDrag = Coefficient*(NoFieldDependence+G*FieldDependence)*(
-        Pdata->PlasmaVel-velocity).getunit();
+        Pdata.PlasmaVel-velocity).getunit();
 
-    //std::cout << "\n\nni = " << Pdata->IonDensity;
-    //std::cout << "\nTi = " << Pdata->IonTemp;
-    //std::cout << "\nTe = " << Pdata->ElectronTemp;
-    //std::cout << "\nmi = " << Pdata->mi;
+    //std::cout << "\n\nni = " << Pdata.IonDensity;
+    //std::cout << "\nTi = " << Pdata.IonTemp;
+    //std::cout << "\nTe = " << Pdata.ElectronTemp;
+    //std::cout << "\nmi = " << Pdata.mi;
     //std::cout << "\nVti = " << IonThermalVelocity;
-    //std::cout << "\nPlasmaVel = " << Pdata->PlasmaVel;
-    //std::cout << "\nrelative velocity = " << Pdata->PlasmaVel-velocity;
-    //std::cout << "\nRhoT = " << (IonThermalVelocity*Pdata->mi/(echarge*Pdata->MagneticField.mag3()));
+    //std::cout << "\nPlasmaVel = " << Pdata.PlasmaVel;
+    //std::cout << "\nrelative velocity = " << Pdata.PlasmaVel-velocity;
+    //std::cout << "\nRhoT = " << (IonThermalVelocity*Pdata.mi/(echarge*Pdata.MagneticField.mag3()));
     //std::cout << "\nBeta = " << Beta;
     //std::cout << "\nGamma = " << Gamma;
     //std::cout << "\nG = " << G;
@@ -363,19 +364,19 @@ threevector LloydIonDrag::Evaluate(const Matter* Sample,
 //!< S. I. Krasheninnikov, R. D. Smirnov, and D. L. Rudakov, 
 //!< Plasma Phys. Control. Fusion 53, 083001 (2011).
 threevector NeutralDrag::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct NeutralDrag::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
     // Assuming OML flux of neutrals, with neutrals flowing with the
     // background plasma
-    // return (Pdata->PlasmaVel-velocity)*Pdata->mi*sqrt(4*PI)*
+    // return (Pdata.PlasmaVel-velocity)*Pdata.mi*sqrt(4*PI)*
     // NeutralFlux()*PI*pow(Sample->get_radius(),2)*(1.0/Sample->get_mass());
 
     // Assuming OML flux of neutrals, neutrals stationary with respect to dust 
     // grain and not flowing with plasma
-    // return -1.0*velocity*Pdata->mi*sqrt(4*PI)*NeutralFlux()*PI*
+    // return -1.0*velocity*Pdata.mi*sqrt(4*PI)*NeutralFlux()*PI*
     // pow(Sample->get_radius(),2)*(1.0/Sample->get_mass());
 
     // (1) Pigarov A Yu, Krasheninnikov S I, Soboleva T K and Rognlien T D 2005 
@@ -383,19 +384,19 @@ threevector NeutralDrag::Evaluate(const Matter* Sample,
     // (2) Baines M J, Williams I P and Asebiomo A S 1965 Mon. Not. R. Astron. 
     // Soc. 130 63
     // Assuming DUSTT flux of neutrals flowing 
-    //double ua = (Pdata->PlasmaVel-velocity).mag3()/
-    // sqrt(2.0*Kb*Pdata->NeutralTemp/Pdata->mi);
+    //double ua = (Pdata.PlasmaVel-velocity).mag3()/
+    // sqrt(2.0*Kb*Pdata.NeutralTemp/Pdata.mi);
 
     //!< Assuming DUSTT flux of neutrals, neutrals stationary
-    double ua = -velocity.mag3()/sqrt(2.0*Kb*Pdata->NeutralTemp
-        /Pdata->mi);
+    double ua = -velocity.mag3()/sqrt(2.0*Kb*Pdata.NeutralTemp
+        /Pdata.mi);
 
     if( ua == 0.0 ){
         threevector Zeros(0.0,0.0,0.0);
         return Zeros;
     }else{
-        return -PI*Sample->get_radius()*Sample->get_radius()*Pdata->mi*
-            Pdata->NeutralDensity*sqrt(2.0*Kb*Pdata->NeutralTemp/Pdata->mi)*
+        return -PI*Sample->get_radius()*Sample->get_radius()*Pdata.mi*
+            Pdata.NeutralDensity*sqrt(2.0*Kb*Pdata.NeutralTemp/Pdata.mi)*
             velocity*(1.0/ua)*((1.0/sqrt(PI))*(ua+1/(2.0*ua))*exp(-ua*ua)+
             (1.0+ua*ua-1.0/(4.0*ua*ua))*erf(ua))*(1.0/Sample->get_mass());
     }
@@ -405,10 +406,10 @@ threevector NeutralDrag::Evaluate(const Matter* Sample,
 //!< that matter is emitted following Hertz-Knudsen evaporation.
 //!< The heat transfer time is dictated by code timescale, so is incorrect.
 threevector RocketForce::Evaluate(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, 
+        const PlasmaData &Pdata, 
         const threevector velocity){
     F_Debug("\tIn struct RocketForce::Evaluate(const Matter* Sample, "
-        << "const std::shared_ptr<PlasmaData> Pdata, "
+        << "const PlasmaData &Pdata, "
         << "const threevector velocity)\n\n");
         threevector returnvec(0.0,0.0,0.0);
 
@@ -418,9 +419,29 @@ threevector RocketForce::Evaluate(const Matter* Sample,
         double Pv_minus = Sample->probe_vapourpressure(OldTemp);
         OldTemp = Sample->get_temperature();
         returnvec = Sample->get_surfacearea()*((Pv_plus-Pv_minus)/
-            Sample->get_radius())*Pdata->MagneticField.getunit();
+            Sample->get_radius())*Pdata.MagneticField.getunit();
     }
     return returnvec*(1.0/Sample->get_mass());
 }
 
+void RocketForce::write_state(CheckpointWriter &out)const{
+    out << OldTemp;
+}
+
+void RocketForce::read_state(CheckpointReader &in){
+    in >> OldTemp;
+}
+
+//!< Kernels are instantiated here, where the terms above can be inlined
+const ForceKernel *find_forcekernel(const std::vector<ForceTerm*> &terms){
+    return Kernel::Registry<ForceTerm,threevector,threevector,
+        //!< Default configuration
+        Kernel::TermList<Gravity,LorentzForce,HybridIonDrag,LloydIonDrag,
+            NeutralDrag>,
+        //!< The original DTOKS forces
+        Kernel::TermList<Gravity,LorentzForce,DTOKSIonDrag,NeutralDrag>,
+        Kernel::TermList<Gravity,LorentzForce,SMOMLIonDrag,NeutralDrag>
+        >::find(terms);
+}
+
 }
@@ -61,10 +61,9 @@ double sec(double Te, char material)
     }else return 0.0;
 }
 
-void WarnOnce(bool &MessageNotDisplayed, std::string Message){
-    if(MessageNotDisplayed){
+void WarnOnce(std::atomic<bool> &MessageNotDisplayed, std::string Message){
+    if(MessageNotDisplayed.exchange(false)){
         std::cout << "\n\n*[W]* Warning! " << Message;
-        MessageNotDisplayed = false;
     }
 }
 
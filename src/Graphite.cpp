@@ -40,6 +40,24 @@ const struct ElementConsts GraphiteConsts = {
                        //!< /download?doi=10.1.1.736.9349&rep=rep1&type=pdf
 };
 
+/** @brief Heat capacity of graphite in kJ/(kg K) at \p Temperature
+ */
+static double heatcapacity(double Temperature){
+    //!< Heat capacity model
+    //!< http://webbook.nist.gov/cgi/cbook.cgi?ID=C7440440&Type=JANAFG&Plot=on
+    //!< Redirected from NIST: 
+    //!< http://webbook.nist.gov/cgi/formula?ID=C7782425&Mask=2
+    //!< http://ac.els-cdn.com/0022311573900603/
+    //!< 1-s2.0-0022311573900603-main.pdf?_tid=3478dcf2-0338-11e7-a73c-
+    //!< 00000aacb361&acdnat=1488892739_9595b510ccead6c7baa0f96a11b9d39d
+    double HeatCapacity = 0.54212-2.42667e-6*Temperature-
+        90.2725/Temperature-43449.3/(pow(Temperature,2))+
+        1.59309e7/(pow(Temperature,3))-1.43688e9/(pow(Temperature,4));
+
+    //!< Convert from calorie/gram to KiloJoule / Kilogramme
+    return HeatCapacity*4.184; 
+}
+
 
 Graphite::Graphite():Matter(GraphiteConsts){
     E_Debug("\n\nIn Graphite::Graphite(GraphiteConsts)");
@@ -123,34 +141,19 @@ void Graphite::set_defaults(){
 
 void Graphite::update_heatcapacity(){
     E_Debug("\n\n\tIn Graphite::update_heatcapacity()");
-    //!< Heat capacity model
-    //!< http://webbook.nist.gov/cgi/cbook.cgi?ID=C7440440&Type=JANAFG&Plot=on
+    static const PropertyTable Table(heatcapacity,{200,500,3500},
+        Tabulation::Linear);
     if( St.Temperature > 200 && St.Temperature <= 3500){
-        //!< Redirected from NIST: 
-        //!< http://webbook.nist.gov/cgi/formula?ID=C7782425&Mask=2
-        //!< http://ac.els-cdn.com/0022311573900603/
-        //!< 1-s2.0-0022311573900603-main.pdf?_tid=3478dcf2-0338-11e7-a73c-
-        //!< 00000aacb361&acdnat=1488892739_9595b510ccead6c7baa0f96a11b9d39d
-        St.HeatCapacity = 0.54212-2.42667e-6*St.Temperature-
-            90.2725/St.Temperature-43449.3/(pow(St.Temperature,2))+
-            1.59309e7/(pow(St.Temperature,3))-
-            1.43688e9/(pow(St.Temperature,4));
-
-        //!< Convert from calorie/gram to KiloJoule / Kilogramme
-        St.HeatCapacity = St.HeatCapacity*4.184; 
+        if( !Table.lookup(St.Temperature,St.HeatCapacity) )
+            St.HeatCapacity = heatcapacity(St.Temperature);
     }else if( St.Temperature > 3500 && St.Temperature <= 4000){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Graphite::update_heatcapacity():\n";
         WarningMessage += "Extending model outside range!";
         WarningMessage += " (from T < 3500K to T < 4000K)";
         WarnOnce(runOnce,WarningMessage);
 
-        St.HeatCapacity = 0.54212-2.42667e-6*St.Temperature-
-            90.2725/St.Temperature-43449.3/(pow(St.Temperature,2))+
-            1.59309e7/(pow(St.Temperature,3))-1.43688e9/(pow(St.Temperature,4));
-
-        //!< Convert from calorie/gram to KiloJoule / Kilogramme 
-        St.HeatCapacity = St.HeatCapacity*4.184; 
+        St.HeatCapacity = heatcapacity(St.Temperature);
     }
     E_Debug("\n\tTemperature is : " << St.Temperature << "\n\tSt.Gas = " 
         << St.Gas << "\n\tSt.Liquid = " << St.Liquid << "\n\tCv of Solid: " 
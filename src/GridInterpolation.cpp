@@ -0,0 +1,136 @@
+/** @file GridInterpolation.cpp
+ *  @brief Implementation of plasma grid interpolation functions
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "GridInterpolation.h"
+#include "Constants.h"
+
+//!< Return true if every cell of the nx by nz block at (i,k) is in the grid
+//!< and has the same gridflag
+static bool uniform_block(const PlasmaGrid_Data &pgrid, int i, int k,
+    int nx, int nz){
+    if( i < 0 || k < 0 || i+nx > pgrid.gridx || k+nz > pgrid.gridz )
+        return false;
+    int Flag = pgrid.gridflag[i][k];
+    for( int p = i; p < i+nx; p ++ )
+        for( int s = k; s < k+nz; s ++ )
+            if( pgrid.gridflag[p][s] != Flag ) return false;
+    return true;
+}
+
+void build_stencils(PlasmaGrid_Data &pgrid){
+    P_Debug("\tIn build_stencils(PlasmaGrid_Data &pgrid)\n\n");
+    pgrid.Stencils = GridField<char>(pgrid.gridx,pgrid.gridz,0);
+    for( int i = 0; i < pgrid.gridx; i ++ ){
+        for( int k = 0; k < pgrid.gridz; k ++ ){
+            char Stencil = 0;
+            if( uniform_block(pgrid,i,k,2,2) )
+                Stencil |= Interpolation::BilinearStencil;
+            if( uniform_block(pgrid,i-1,k-1,4,4) )
+                Stencil |= Interpolation::BicubicStencil;
+            pgrid.Stencils[i][k] = Stencil;
+        }
+    }
+}
+
+//!< Add \p w times the parameters of \p src to \p dst
+static inline void accumulate(const PlasmaCell &src, double w,
+    PlasmaCell &dst){
+    dst.Te  += w*src.Te;
+    dst.Ti  += w*src.Ti;
+    dst.na0 += w*src.na0;
+    dst.na1 += w*src.na1;
+    dst.na2 += w*src.na2;
+    dst.bx  += w*src.bx;
+    dst.by  += w*src.by;
+    dst.bz  += w*src.bz;
+    dst.Er  += w*src.Er;
+    dst.Ez  += w*src.Ez;
+    dst.vpx += w*src.vpx;
+    dst.vpy += w*src.vpy;
+    dst.vpz += w*src.vpz;
+}
+
+//!< Catmull-Rom weights of the four points about a fraction \p t of a cell
+static inline void catmullrom_weights(double t, double w[4]){
+    double t2 = t*t;
+    double t3 = t2*t;
+    w[0] = 0.5*(-t3+2.0*t2-t);
+    w[1] = 0.5*(3.0*t3-5.0*t2+2.0);
+    w[2] = 0.5*(-3.0*t3+4.0*t2+t);
+    w[3] = 0.5*(t3-t2);
+}
+
+//!< Limit \p value to the range of \p a, \p b, \p c and \p d
+static inline double clamp4(double value, double a, double b, double c,
+    double d){
+    double Min = std::min(std::min(a,b),std::min(c,d));
+    double Max = std::max(std::max(a,b),std::max(c,d));
+    return std::min(std::max(value,Min),Max);
+}
+
+bool interpolate_plasmacell(const PlasmaGrid_Data &pgrid, double x, double z,
+    PlasmaCell &cell){
+    P_Debug("\tIn interpolate_plasmacell(const PlasmaGrid_Data &pgrid, double "
+        << x << ", double " << z << ", PlasmaCell &cell)\n\n");
+    if( pgrid.interpolation != Interpolation::Bilinear
+        && pgrid.interpolation != Interpolation::Bicubic ) return false;
+
+    //!< Position in units of grid cells, each direction scaled separately
+    double fx = (x-pgrid.gridxmin)/pgrid.dlx;
+    double fz = (z-pgrid.gridzmin)/pgrid.dlz;
+    int i = int(floor(fx));
+    int k = int(floor(fz));
+    if( i < 0 || k < 0 || i+1 >= pgrid.gridx || k+1 >= pgrid.gridz )
+        return false;
+    double tx = fx-i;
+    double tz = fz-k;
+    char Stencil = pgrid.Stencils[i][k];
+
+    PlasmaCell Result = {};
+    if( pgrid.interpolation == Interpolation::Bicubic
+        && (Stencil & Interpolation::BicubicStencil) ){
+        double wx[4], wz[4];
+        catmullrom_weights(tx,wx);
+        catmullrom_weights(tz,wz);
+        for( int p = 0; p < 4; p ++ ){
+            const PlasmaCell *Row = pgrid.Cells[i-1+p]+(k-1);
+            for( int s = 0; s < 4; s ++ )
+                accumulate(Row[s],wx[p]*wz[s],Result);
+        }
+    }else if( Stencil & Interpolation::BilinearStencil ){
+        accumulate(pgrid.Cells[i][k],    (1.0-tx)*(1.0-tz),Result);
+        accumulate(pgrid.Cells[i+1][k],  tx*(1.0-tz),      Result);
+        accumulate(pgrid.Cells[i][k+1],  (1.0-tx)*tz,      Result);
+        accumulate(pgrid.Cells[i+1][k+1],tx*tz,            Result);
+    }else{
+        return false;
+    }
+
+    //!< Keep temperatures and densities within the values of the 2x2 cells
+    const PlasmaCell &A = pgrid.Cells[i][k];
+    const PlasmaCell &B = pgrid.Cells[i+1][k];
+    const PlasmaCell &C = pgrid.Cells[i][k+1];
+    const PlasmaCell &D = pgrid.Cells[i+1][k+1];
+    Result.Te  = clamp4(Result.Te, A.Te, B.Te, C.Te, D.Te);
+    Result.Ti  = clamp4(Result.Ti, A.Ti, B.Ti, C.Ti, D.Ti);
+    Result.na0 = clamp4(Result.na0,A.na0,B.na0,C.na0,D.na0);
+    Result.na1 = clamp4(Result.na1,A.na1,B.na1,C.na1,D.na1);
+    Result.na2 = clamp4(Result.na2,A.na2,B.na2,C.na2,D.na2);
+    Result.gridflag = A.gridflag;
+
+    cell = Result;
+    return true;
+}
+
+double cells_per_step(char scheme){
+    if( scheme == Interpolation::Bicubic
+        || scheme == Interpolation::Bilinear ) return 1.0;
+    return 0.5;
+}
@@ -10,12 +10,12 @@
 namespace Term{
     
 //!< Using Stefan-Boltzmann Law, returns Energy lost per second in Kila Joules
-double EmissivityModel::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double EmissivityModel::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::EmissivityModel(const double DustTemperature):"
         << "\n\n");
     //!< Energy emitted from a sample converted to kJ
     return -Sample->get_emissivity()*Sample->get_surfacearea()*Sigma
-            *(pow(DustTemperature,4)-pow(Pdata->AmbientTemp,4));
+            *(pow(DustTemperature,4)-pow(Pdata.AmbientTemp,4));
 }
 
 //!< http://users.wfu.edu/ucerkb/Nan242/L06-Vacuum_Evaporation.pdf, 
@@ -24,7 +24,7 @@ double EmissivityModel::Evaluate(const Matter* Sample, const std::shared_ptr<Pla
 //!< MASS LOSS EQUATION 
 //!< http://www.leb.eei.uni-erlangen.de/
 //!< winterakademie/2006/result/content/course01/pdf/0102.pdf
-double EvaporationModel::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double EvaporationModel::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::EvaporationModel():\n\n");
 
     //!< Approximate emitted energy as mean maxwell
@@ -45,36 +45,36 @@ double EvaporationModel::Evaluate(const Matter* Sample, const std::shared_ptr<Pl
 //!< VERY APPROXIMATE MODEL: Atmosphere assumed to be 300 degrees always,
 //!< rough heat transfer coefficient is use
 //!< https://en.wikipedia.org/wiki/Newton%27s_law_of_cooling
- double NewtonCooling::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+ double NewtonCooling::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::NewtonCooling():\n\n");
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "In HeatingModel::NewtonCooling():\nHeatTransair ";
     Warning += "Coefficient wrong for Tungsten, Beryllium, Graphite, Helium,";
     Warning += " Lithium & Molybdenum.";
     WarnOnce(runOnce,Warning);
 
     return (Sample->get_heattransair()*Sample->get_surfacearea()*
-        (DustTemperature-Pdata->AmbientTemp)); 
+        (DustTemperature-Pdata.AmbientTemp)); 
 }   
 
-double NeutralHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double NeutralHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::NeutralHeatFlux(const double DustTemperature)"
         << ":\n\n");
     return Sample->get_surfacearea()*Flux::NeutralFlux(Pdata)*
-        (Pdata->NeutralTemp-DustTemperature)*Kb;
+        (Pdata.NeutralTemp-DustTemperature)*Kb;
 }
 
 // ************************** SOML/OML/PHL MODELS ************************** //
 
-double SEE::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double SEE::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::SEE():\n\n");
     double ConvertKtoev(8.6173303e-5);
     return -Sample->get_surfacearea()*Flux::PHLElectronFlux(Sample,Pdata,Sample->get_potential())*
-        sec(Pdata->ElectronTemp*ConvertKtoev,Sample->get_elem())*echarge*
+        sec(Pdata.ElectronTemp*ConvertKtoev,Sample->get_elem())*echarge*
         (3.0+Sample->get_workfunction()); 
 }
 
-double TEE::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double TEE::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::TEE():\n\n");
     if( Sample->get_potential() >= 0.0){
         return -Sample->get_surfacearea()*Richardson*pow(DustTemperature,2)*
@@ -86,30 +86,30 @@ double TEE::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pda
         //<! Page 23, section 3.3
         return -Sample->get_surfacearea()*Richardson*pow(DustTemperature,2)*
             (1.0-Sample->get_potential()*
-            (Pdata->ElectronTemp/Sample->get_temperature()))*
-            exp((Sample->get_potential()*Kb*Pdata->ElectronTemp-
+            (Pdata.ElectronTemp/Sample->get_temperature()))*
+            exp((Sample->get_potential()*Kb*Pdata.ElectronTemp-
             Sample->get_workfunction()*echarge)/(Kb*DustTemperature))*
             (2.0*Kb*DustTemperature+echarge*Sample->get_workfunction())/echarge;
     }
 }
 
-double PHLElectronHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){ 
+double PHLElectronHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){ 
 
     H_Debug("\n\tIn HeatingModel::PHLElectronHeatFlux():\n\n");
     //!< Only for a negative grain
     return Sample->get_surfacearea()*Flux::PHLElectronFlux(Sample,Pdata,Sample->get_potential())*
-        Kb*(Pdata->ElectronTemp-DustTemperature);
+        Kb*(Pdata.ElectronTemp-DustTemperature);
 }
 
-double SOMLIonHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){ 
+double SOMLIonHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){ 
     H_Debug("\n\tIn HeatingModel::SOMLIonHeatFlux(const double DustTemperature):"
         <<"\n\n");
     // Assuming Re = 0
     return Sample->get_surfacearea()*(1.0-Sample->get_re())*
-        Flux::SOMLIonFlux(Sample,Pdata,Sample->get_potential())*Pdata->IonTemp*Kb; 
+        Flux::SOMLIonFlux(Sample,Pdata,Sample->get_potential())*Pdata.IonTemp*Kb; 
 }
 
-double SOMLNeutralRecombination::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature)
+double SOMLNeutralRecombination::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature)
 {
     H_Debug("\n\tIn HeatingModel::SOMLNeutralRecombination():\n\n");
     //!< Neutral Recombination assuming Rn=0; fraction of backscattered 
@@ -119,15 +119,15 @@ double SOMLNeutralRecombination::Evaluate(const Matter* Sample, const std::share
         Flux::SOMLIonFlux(Sample,Pdata,Sample->get_potential()); 
 }
 
-double SMOMLIonHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){ 
+double SMOMLIonHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){ 
     H_Debug("\n\tIn HeatingModel::SMOMLIonHeatFlux(const double DustTemperature):"
         << "\n\n");
     // Assuming Re = 0
     return Sample->get_surfacearea()*(1.0-Sample->get_re())*
-        Flux::SMOMLIonFlux(Sample,Pdata,Sample->get_potential())*Pdata->IonTemp*Kb;
+        Flux::SMOMLIonFlux(Sample,Pdata,Sample->get_potential())*Pdata.IonTemp*Kb;
 }
 
-double SMOMLNeutralRecombination::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature)
+double SMOMLNeutralRecombination::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature)
 {
     H_Debug("\n\tIn HeatingModel::SMOMLNeutralRecombination():\n\n");
     // Neutral Recombination assuming Rn=0; fraction of backscattered 
@@ -138,16 +138,16 @@ double SMOMLNeutralRecombination::Evaluate(const Matter* Sample, const std::shar
 }
 
 
-double OMLElectronHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){ 
+double OMLElectronHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){ 
     H_Debug("\n\tIn HeatingModel::OMLElectronHeatFlux():\n\n");
     // Only for a negative grain
     return Sample->get_surfacearea()*Flux::OMLElectronFlux(Pdata,Sample->get_potential())*
-        Kb*(Pdata->ElectronTemp-DustTemperature);
+        Kb*(Pdata.ElectronTemp-DustTemperature);
 }
 
 // ****************************** DTOKS MODELS ****************************** //
 
- double DTOKSSEE::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+ double DTOKSSEE::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::DTOKSSEE():\n\n");
     //!< Electrons released all re-captured by positive dust grain
     double SEE=0; 
@@ -159,7 +159,7 @@ double OMLElectronHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr
     return -SEE; 
 }
 
-double DTOKSTEE::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double DTOKSTEE::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::DTOKSTEE():\n\n");
     //!< Electrons released all re-captured by positive dust grain
     double TEE=0;
@@ -172,20 +172,20 @@ double DTOKSTEE::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData
     return -TEE;
 }
 
-double DTOKSIonHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){ 
+double DTOKSIonHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){ 
     H_Debug("\n\tIn HeatingModel::DTOKSIonHeatFlux(const double DustTemperature):"
         << "\n\n");
     // Assuming Re = 0
     return (Sample->get_surfacearea()*(1.0-Sample->get_re())*
-        Flux::DTOKSIonFlux(Sample,Pdata,Sample->get_potential())*Pdata->IonTemp*Kb)*
-        (2.0+2.0*Sample->get_potential()*(Pdata->ElectronTemp/Pdata->IonTemp)+
-        pow(Sample->get_potential()*(Pdata->ElectronTemp/Pdata->IonTemp),2.0))/
-        (1.0+Sample->get_potential()*(Pdata->ElectronTemp/Pdata->IonTemp)); 
+        Flux::DTOKSIonFlux(Sample,Pdata,Sample->get_potential())*Pdata.IonTemp*Kb)*
+        (2.0+2.0*Sample->get_potential()*(Pdata.ElectronTemp/Pdata.IonTemp)+
+        pow(Sample->get_potential()*(Pdata.ElectronTemp/Pdata.IonTemp),2.0))/
+        (1.0+Sample->get_potential()*(Pdata.ElectronTemp/Pdata.IonTemp)); 
     // Convert from Joules to KJ
 }
 
 
-double DTOKSNeutralRecombination::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double DTOKSNeutralRecombination::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::NeutralRecombination():\n\n");
     // Neutral Recombination assuming Rn=0; fraction of backscattered 
     // ions/neutrals is zero.
@@ -194,12 +194,12 @@ double DTOKSNeutralRecombination::Evaluate(const Matter* Sample, const std::shar
         Flux::DTOKSIonFlux(Sample,Pdata,Sample->get_potential()); 
 }
 
-double DTOKSElectronHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){ 
+double DTOKSElectronHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){ 
     H_Debug("\n\tIn HeatingModel::ElectronHeatFlux():\n\n");
     // Only for a negative grain
     return 2.0*sqrt(2.0*PI)*Sample->get_radius()*Sample->get_radius()
         *Flux::DTOKSElectronFlux(Pdata,Sample->get_potential())*Kb*
-        (Pdata->ElectronTemp-DustTemperature);
+        (Pdata.ElectronTemp-DustTemperature);
 }
 
 // ****************************** DUSTT MODELS ****************************** //
@@ -209,23 +209,23 @@ double DTOKSElectronHeatFlux::Evaluate(const Matter* Sample, const std::shared_p
 //!< Calculated from equation (31) & (32), page 29, from the following reference
 //!< S.I. Krasheninnikov, R.D. Smirnov, and D.L. Rudakov,
 //!< Plasma Phys. Control. Fusion 53, 083001 (2011).
-double DUSTTIonHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+double DUSTTIonHeatFlux::Evaluate(const Matter* Sample, const PlasmaData &Pdata, const double DustTemperature){
     H_Debug("\n\tIn HeatingModel::DUSTTIonHeatFlux(const double DustTemperature):"
         << "\n\n");
     // Assuming Re = 0
 //  H1_Debug( "\nSample->get_re() = " << Sample->get_re() );
     if( Sample->get_re() > 0.1 ){ // Uncomment when Sample->get_re() is calculated
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string Warning = "In HeatingModel::DUSTTIonHeatFlux(double ";
         Warning += "DustTemperature)\nSample->get_re() > 0.1. Ion Heat Flux affected by ";
         Warning += "backscattering by more than 10%!";
         WarnOnce(runOnce,Warning);
     }
-    double TemperatureRatio = Pdata->IonTemp/Pdata->ElectronTemp;
-    double IonThermalVelocity = sqrt((Kb*Pdata->IonTemp)/Pdata->mi);
-    double RelativeVelocity = (Pdata->PlasmaVel-Sample->get_velocity()).mag3()/
+    double TemperatureRatio = Pdata.IonTemp/Pdata.ElectronTemp;
+    double IonThermalVelocity = Pdata.Derived.IonThermalSpeed/sqrt(2.0);
+    double RelativeVelocity = (Pdata.PlasmaVel-Sample->get_velocity()).mag3()/
         IonThermalVelocity;
-    double RenormalisedPotential = (Pdata->Z*Sample->get_potential())/
+    double RenormalisedPotential = (Pdata.Z*Sample->get_potential())/
         TemperatureRatio;
     double Term1(0.0);
     double Term2(0.0), Term2Coeff(0.0);
@@ -235,8 +235,8 @@ double DUSTTIonHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<Pl
             2.0*RenormalisedPotential*
             (1+2.0*RelativeVelocity*RelativeVelocity));
     }else if(RelativeVelocity == 0.0){
-        return  Sample->get_surfacearea()*(1.0-Sample->get_re())*Pdata->IonDensity*
-            Pdata->IonTemp*Kb*IonThermalVelocity;
+        return  Sample->get_surfacearea()*(1.0-Sample->get_re())*Pdata.IonDensity*
+            Pdata.IonTemp*Kb*IonThermalVelocity;
     }
     if( RenormalisedPotential >= 0.0 ){ // Negative dust grain
         Term1 =(1.0/(2.0*sqrt(PI)))*(5.0+2.0*RelativeVelocity*RelativeVelocity
@@ -265,9 +265,27 @@ double DUSTTIonHeatFlux::Evaluate(const Matter* Sample, const std::shared_ptr<Pl
     assert((Term1 + Term2) > 0 && (Term1 + Term2) != INFINITY 
         && (Term1 + Term2) == (Term1 + Term2));
 
-    return Sample->get_surfacearea()*(1.0-Sample->get_re())*Pdata->IonDensity
-        *Pdata->IonTemp*Kb*IonThermalVelocity*(Term1 + Term2);
+    return Sample->get_surfacearea()*(1.0-Sample->get_re())*Pdata.IonDensity
+        *Pdata.IonTemp*Kb*IonThermalVelocity*(Term1 + Term2);
     // Convert from Joules to KJ
 }
 
-}
\ No newline at end of file
+//!< Kernels are instantiated here, where the terms above can be inlined
+const HeatKernel *find_heatkernel(const std::vector<HeatTerm*> &terms){
+    return Kernel::Registry<HeatTerm,double,double,
+        //!< Default configuration
+        Kernel::TermList<EmissivityModel,EvaporationModel,NeutralHeatFlux,
+            OMLElectronHeatFlux,DTOKSIonHeatFlux,DTOKSNeutralRecombination,
+            DTOKSSEE,DTOKSTEE>,
+        //!< The original DTOKS heating
+        Kernel::TermList<EmissivityModel,EvaporationModel,NeutralHeatFlux,
+            DTOKSElectronHeatFlux,DTOKSIonHeatFlux,DTOKSNeutralRecombination,
+            DTOKSSEE,DTOKSTEE>,
+        //!< Shifted modified OML heating
+        Kernel::TermList<EmissivityModel,EvaporationModel,NeutralHeatFlux,
+            OMLElectronHeatFlux,SMOMLIonHeatFlux,SMOMLNeutralRecombination,
+            SEE,TEE>
+        >::find(terms);
+}
+
+}
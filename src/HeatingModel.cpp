@@ -7,14 +7,34 @@
  *  @bug bugs, they definitely exist
  */
 
+#include <cstring>
+#include <stdexcept>
+
 #include "HeatingModel.h"
 #include "Constants.h"
 #include "Functions.h"
+#include "BackscatterTable.h"
+
+//!< Return true if the heat terms give the same powers for \p a and \p b
+static bool same_inputs(const HeatTermInputs &a, const HeatTermInputs &b){
+    return a.DustTemperature == b.DustTemperature 
+        && a.Temperature == b.Temperature && a.Mass == b.Mass 
+        && a.SurfaceArea == b.SurfaceArea && a.Emissivity == b.Emissivity 
+        && a.VapourPressure == b.VapourPressure 
+        && a.Potential == b.Potential && a.DeltaSec == b.DeltaSec 
+        && a.DeltaTherm == b.DeltaTherm && a.RE == b.RE && a.RN == b.RN 
+        && a.Liquid == b.Liquid && a.PowerIncident == b.PowerIncident
+        && a.Velocity.getx() == b.Velocity.getx() 
+        && a.Velocity.gety() == b.Velocity.gety() 
+        && a.Velocity.getz() == b.Velocity.getz() 
+        && std::memcmp(&a.Pdata,&b.Pdata,sizeof(PlasmaData)) == 0;
+}
 
 HeatingModel::HeatingModel():
 Model(){
     H_Debug("\n\nIn HeatingModel::HeatingModel():Model()\n\n");
     Defaults();
+    ClassifyTerms();
     CreateFile("Default_Heating_filename.txt",false);
 }
 
@@ -27,6 +47,7 @@ Model(filename,sample,pdata,accuracy){
         << "Model(sample,pdata,accuracy)\n\n");
     Defaults();
     HeatTerms = heatterms;
+    ClassifyTerms();
     CreateFile(filename,false);
 }
 
@@ -39,31 +60,36 @@ Model(filename,sample,*pdata,accuracy){
         << "Model(sample,pdata,accuracy)\n\n");
     Defaults();
     HeatTerms = heatterms;
+    ClassifyTerms();
     CreateFile(filename,false);
 }
 
 HeatingModel::HeatingModel(std::string filename, float accuracy, 
-std::vector<HeatTerm*> heatterms,Matter *& sample, PlasmaGrid_Data &pgrid):
+std::vector<HeatTerm*> heatterms,Matter *& sample, 
+std::shared_ptr<const PlasmaGrid_Data> pgrid):
 Model(filename,sample,pgrid,accuracy){
     H_Debug("\n\nIn HeatingModel::HeatingModel(std::string filename, "
         << "float accuracy, std::vector<HeatTerm*> heatterms, "
-        << "Matter *& sample, PlasmaGrid const &pgrid) : "
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid) : "
         << "Model(sample,pgrid,accuracy)\n\n");
     Defaults();
     HeatTerms = heatterms;
+    ClassifyTerms();
     CreateFile(filename,false);
 }
 
 HeatingModel::HeatingModel(std::string filename, float accuracy, 
-std::vector<HeatTerm*> heatterms, Matter *& sample, PlasmaGrid_Data &pgrid,
+std::vector<HeatTerm*> heatterms, Matter *& sample, 
+std::shared_ptr<const PlasmaGrid_Data> pgrid,
 PlasmaData &pdata):
 Model(filename,sample,pgrid,pdata,accuracy){
     H_Debug("\n\nIn HeatingModel::HeatingModel(std::string filename, "
         << "float accuracy, std::vector<HeatTerm*> heatterms, "
-        << "Matter *& sample, PlasmaGrid const &pgrid) : "
+        << "Matter *& sample, std::shared_ptr<const PlasmaGrid_Data> pgrid) : "
         << "Model(sample,pgrid,accuracy)\n\n");
     Defaults();
     HeatTerms = heatterms;
+    ClassifyTerms();
     CreateFile(filename,false);
 }
 
@@ -72,6 +98,44 @@ void HeatingModel::Defaults(){
     PowerIncident = 0;                      //!< kW, Power Incident
     OldTemp = Sample->get_temperature();    //!< Set default OldTemp
     ThermalEquilibrium = false;
+    PhaseData = false;
+    PowerCached = false;
+}
+
+void HeatingModel::ClassifyTerms(){
+    H_Debug("\tIn HeatingModel::ClassifyTerms()\n\n");
+    EmissivityIndex = -1;
+    EvaporationIndex = -1;
+    for( unsigned int n = 0; n < HeatTerms.size(); n ++ ){
+        std::string Name = HeatTerms[n]->PrintName();
+        if( Name == "EmissivityModel" )
+            EmissivityIndex = n;
+        else if( Name == "EvaporationModel" )
+            EvaporationIndex = n;
+    }
+    if( HeatTerms.size() > MaxHeatTerms )
+        throw std::length_error("HeatingModel: more than "
+            + std::to_string(MaxHeatTerms) + " heat terms");
+    Kernel = Term::find_heatkernel(HeatTerms);
+}
+
+void HeatingModel::get_inputs(double DustTemperature, 
+    HeatTermInputs &inputs)const{
+    inputs.DustTemperature = DustTemperature;
+    inputs.Temperature     = Sample->get_temperature();
+    inputs.Mass            = Sample->get_mass();
+    inputs.SurfaceArea     = Sample->get_surfacearea();
+    inputs.Emissivity      = Sample->get_emissivity();
+    inputs.VapourPressure  = Sample->get_vapourpressure();
+    inputs.Potential       = Sample->get_potential();
+    inputs.DeltaSec        = Sample->get_deltasec();
+    inputs.DeltaTherm      = Sample->get_deltatherm();
+    inputs.RE              = Sample->get_re();
+    inputs.RN              = Sample->get_rn();
+    inputs.Liquid          = Sample->is_liquid();
+    inputs.PowerIncident   = PowerIncident;
+    inputs.Velocity        = Sample->get_velocity();
+    inputs.Pdata           = *Pdata;
 }
 
 void HeatingModel::CreateFile(std::string filename){
@@ -83,31 +147,46 @@ void HeatingModel::CreateFile(std::string filename, bool PrintPhaseData){
     H_Debug("\tIn HeatingModel::CreateFile(std::string filename, "
         << "bool PrintPhaseData)\n\n");
     FileName=filename;
-    ModelDataFile.open(FileName);
-    ModelDataFile << std::scientific << std::setprecision(16) << std::endl;
-    ModelDataFile << "Time\tTemp\tMass\tDensity";
-
-    if( PrintPhaseData )                
-        ModelDataFile << "\tFusionE\tVapourE";
+    PhaseData = PrintPhaseData;
+    std::vector<DataColumn> Columns = { {"Time",Column::Scalar}, 
+        {"Temp",Column::Scalar}, {"Mass",Column::Scalar}, 
+        {"Density",Column::Scalar} };
+
+    if( PhaseData ){
+        Columns.push_back({"FusionE",Column::Scalar});
+        Columns.push_back({"VapourE",Column::Scalar});
+    }
     if( Sample->get_c(1) == 'v' || Sample->get_c(1) == 'V' )    
-        ModelDataFile << "\tLinearExpansion";
+        Columns.push_back({"LinearExpansion",Column::Scalar});
     if( Sample->get_c(2) == 'v' || Sample->get_c(2) == 'V' )    
-        ModelDataFile << "\tCv";
+        Columns.push_back({"Cv",Column::Scalar});
     if( Sample->get_c(3) == 'v' || Sample->get_c(3) == 'V' )    
-        ModelDataFile << "\tVapourP";
+        Columns.push_back({"VapourP",Column::Scalar});
     
-    //!< Loop over heat terms and print their names
-    for(auto iter = HeatTerms.begin(); iter != HeatTerms.end(); ++iter) {
-        ModelDataFile << "\t" << (*iter)->PrintName();
-        if( (*iter)->PrintName() == "EmissivityModel" &&
+    //!< Loop over heat terms and add their names
+    for( unsigned int n = 0; n < HeatTerms.size(); n ++ ){
+        Columns.push_back({HeatTerms[n]->PrintName(),Column::Scalar});
+        if( (int)n == EmissivityIndex &&
             (Sample->get_c(0) == 'f' || Sample->get_c(0) == 'F') )   
-            ModelDataFile << "\tEmissiv";
+            Columns.push_back({"Emissiv",Column::Scalar});
     }
 
-    ModelDataFile << "\n";
+    ModelDataFile.open(FileName,Columns);
     Print();
-    ModelDataFile.close();
-    ModelDataFile.clear();
+}
+
+void HeatingModel::write_checkpoint(CheckpointWriter &out)const{
+    H_Debug("\tIn HeatingModel::write_checkpoint(CheckpointWriter &out)"
+        << "const\n\n");
+    Model::write_checkpoint(out);
+    out << OldTemp << PowerIncident << ThermalEquilibrium << PhaseData;
+}
+
+void HeatingModel::read_checkpoint(CheckpointReader &in){
+    H_Debug("\tIn HeatingModel::read_checkpoint(CheckpointReader &in)\n\n");
+    Model::read_checkpoint(in);
+    in >> OldTemp >> PowerIncident >> ThermalEquilibrium >> PhaseData;
+    PowerCached = false;
 }
 
 double HeatingModel::ProbeTimeStep()const{
@@ -123,24 +202,20 @@ double HeatingModel::ProbeTimeStep()const{
     //!< of current mass.
     //!< If this timestep is quicker than current step, change timestep
     if( TotalPower != 0 ){
-        for(auto iter = HeatTerms.begin(); iter != HeatTerms.end(); ++iter) {
-            if( (*iter)->PrintName() == "EvaporationModel" ){
-                if( Sample->is_liquid() ){
-                    double MassTimeStep = fabs((0.01*Sample->get_mass()*AvNo)
-                        /fabs(Flux::EvaporationFlux(Sample,Pdata,
-                        Sample->get_temperature())*Sample->get_atomicmass()));
-                    if( MassTimeStep < timestep ){
-                        H_Debug("\nMass is limiting time step\nMassTimeStep = " 
-                            << MassTimeStep << "\ntimestep = " << timestep);
-                        timestep = MassTimeStep;
-                    }
-                }
+        if( EvaporationIndex >= 0 && Sample->is_liquid() ){
+            double MassTimeStep = fabs((0.01*Sample->get_mass()*AvNo)
+                /fabs(Flux::EvaporationFlux(Sample,*Pdata,
+                Sample->get_temperature())*Sample->get_atomicmass()));
+            if( MassTimeStep < timestep ){
+                H_Debug("\nMass is limiting time step\nMassTimeStep = " 
+                    << MassTimeStep << "\ntimestep = " << timestep);
+                timestep = MassTimeStep;
             }
         }
     }else{
         //!< Check thermal equilibrium hasn't been explicitly reached somehow.
         if( ContinuousPlasma ){ 
-            static bool runOnce = true;
+            static std::atomic<bool> runOnce(true);
             WarnOnce(runOnce,"\nWarning! TotalPower = 0");
             std::cout << "\nThermalEquilibrium reached on condition (1): "
                 << "TotalPower = 0.";
@@ -194,44 +269,32 @@ double HeatingModel::UpdateTimeStep(){
 
 void HeatingModel::Print(){
     H_Debug("\tIn HeatingModel::Print()\n\n");
-    ModelDataFile.open(FileName,std::ofstream::app);
-    ModelDataFile   << TotalTime << "\t" << Sample->get_temperature() << "\t" 
-        << Sample->get_mass() << "\t" << Sample->get_density();
-
+    //!< Fills TermPowers for the current state, reusing them if possible
+    CalculatePower(Sample->get_temperature());
+    ModelDataFile << TotalTime << Sample->get_temperature() 
+        << Sample->get_mass() << Sample->get_density();
+
+    if( PhaseData )
+        ModelDataFile << Sample->get_fusionenergy() 
+            << Sample->get_vapourenergy();
     //!< Print variable constants if they are varying
     if( Sample->get_c(1) == 'v' || Sample->get_c(1) == 'V' )    
-        ModelDataFile << "\t" << Sample->get_linearexpansion();
+        ModelDataFile << Sample->get_linearexpansion();
     if( Sample->get_c(2) == 'v' || Sample->get_c(2) == 'V' )    
-        ModelDataFile << "\t" << Sample->get_heatcapacity();
+        ModelDataFile << Sample->get_heatcapacity();
     if( Sample->get_c(3) == 'v' || Sample->get_c(3) == 'V' )    
-        ModelDataFile << "\t" << Sample->get_vapourpressure();
-
-    //!< Loop over heat terms and print their values
-    for(auto iter = HeatTerms.begin(); iter != HeatTerms.end(); ++iter) {
-        ModelDataFile << "\t" << (*iter)->
-            Evaluate(Sample, Pdata, Sample->get_temperature());
-        if( (*iter)->PrintName() == "EmissivityModel" ){
-            ModelDataFile << "\t" << (*iter)->
-                Evaluate(Sample, Pdata, Sample->get_temperature());
-            if (Sample->get_c(0) == 'f' || Sample->get_c(0) == 'F'){
-                ModelDataFile   << "\t" << Sample->get_emissivity();
-            }
-        }else if( (*iter)->PrintName() == "EvaporationModel" ){
-            if( Sample->is_liquid() ){
-                ModelDataFile << "\t" << (*iter)->
-                    Evaluate(Sample, Pdata, Sample->get_temperature())*1000;
-            }else{ //!< If evaporation is turned off
-                ModelDataFile   << "\t" << 0 << "\t" << 0 << "\t" << 0;
-            }
-        }else{
-            ModelDataFile << "\t" << (*iter)->
-                Evaluate(Sample, Pdata, Sample->get_temperature());;
+        ModelDataFile << Sample->get_vapourpressure();
+
+    //!< Loop over heat terms and print their values, one for each column
+    for( unsigned int n = 0; n < HeatTerms.size(); n ++ ){
+        ModelDataFile << TermPowers[n];
+        if( (int)n == EmissivityIndex 
+            && (Sample->get_c(0) == 'f' || Sample->get_c(0) == 'F') ){
+            ModelDataFile << Sample->get_emissivity();
         }
     }
 
-    ModelDataFile << "\n";
-    ModelDataFile.close();
-    ModelDataFile.clear();
+    ModelDataFile.end_row();
 }
 
 
@@ -273,19 +336,19 @@ void HeatingModel::UpdateRERN(){
     //!< If it's positive, Ions aren't backscattered
     double RE(0.0), RN(0.0);
     if( !Sample->is_positive() ){
-        backscatter(Pdata->ElectronTemp,Pdata->IonTemp,Pdata->mi,
-            Sample->get_potential(),Sample->get_elem(),RE,RN);
+        BackscatterTable::shared(Sample->get_elem())->lookup(
+            Pdata->ElectronTemp,Pdata->IonTemp,Sample->get_potential(),RE,RN);
     }
 
     if( RN > 0.1 ){ //!< Uncomment when RN is calculated
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string Warning = "In HeatingModel::UpdateRERN()\nRN > 0.1. ";
         Warning += "Neutral Recombination affected by backscattering by more ";
         Warning += "than 10%!";
         WarnOnce(runOnce,Warning);
     }   
     if( RE > 0.1 ){ //!< Uncomment when RE is calculated
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string Warning = "In HeatingModel::UpdateRERN()\nRE > 0.1. ";
         Warning += "Ion Heat Flux affected by backscattering by more than 10%!";
         WarnOnce(runOnce,Warning);
@@ -308,17 +371,13 @@ void HeatingModel::Heat(double timestep){
 
     //!< Account for evaporative mass loss, if model is turned on, if it's a 
     //!< liquid and not boiling!
-    for(auto iter = HeatTerms.begin(); iter != HeatTerms.end(); ++iter) {
-        if( (*iter)->PrintName() == "EvaporationModel" )
-            if( Sample->is_liquid()
-                && (Sample->get_temperature() != Sample->get_boilingtemp()) )
-                Sample->update_mass( 
-                    (timestep*Flux::EvaporationFlux(Sample,Pdata,Sample->get_temperature())*
-                    Sample->get_atomicmass())/AvNo );
-    }
+    if( EvaporationIndex >= 0 && Sample->is_liquid()
+        && (Sample->get_temperature() != Sample->get_boilingtemp()) )
+        Sample->update_mass( (timestep*Flux::EvaporationFlux(Sample,*Pdata,
+            Sample->get_temperature())*Sample->get_atomicmass())/AvNo );
 
     H1_Debug("\n\t\tMass Loss = " 
-        << (timestep*Flux::EvaporationFlux(Sample,Pdata,
+        << (timestep*Flux::EvaporationFlux(Sample,*Pdata,
         Sample->get_temperature())*Sample->get_atomicmass())/AvNo << "\n");
 
     if( !Sample->is_gas() )
@@ -338,27 +397,37 @@ void HeatingModel::Heat(){
 double HeatingModel::CalculatePower(double DustTemperature)const{
     H_Debug( "\tIn HeatingModel::CalculatePower(double DustTemperature = " 
         << DustTemperature << ")\n\n");
+    HeatTermInputs Inputs;
+    get_inputs(DustTemperature,Inputs);
+    if( PowerCached && same_inputs(Inputs,CachedInputs) ) return CachedPower;
+
     //!< Rreduces the number of divisions
     double TotalPower = PowerIncident*1000;
     H1_Debug("\n\n\t\tPowerIncident = \t"    << PowerIncident*1000 << "W");
     
-    //!< Loop over heat terms and print their names
-    for(auto iter = HeatTerms.begin(); iter != HeatTerms.end(); ++iter) {
-        if( (*iter)->PrintName() == "EvaporationModel" ){
-            if( Sample->is_liquid() ){
-                TotalPower += (*iter)
-                    ->Evaluate(Sample, Pdata, DustTemperature)*1000;
-            }
-        }else{
-            TotalPower 
-                += (*iter)->Evaluate(Sample, Pdata, DustTemperature);
+    //!< Record the power of each heat term, evaporation only from liquids
+    int Skip = Sample->is_liquid() ? -1 : EvaporationIndex;
+    if( Kernel != NULL ){
+        Kernel->Evaluate(HeatTerms,Sample,*Pdata,DustTemperature,Skip,
+            TermPowers.data());
+    }else{
+        for( unsigned int n = 0; n < HeatTerms.size(); n ++ ){
+            TermPowers[n] = (int)n == Skip ? 0.0 
+                : HeatTerms[n]->Evaluate(Sample, *Pdata, DustTemperature);
         }
-        H1_Debug("\n\t\t" << (*iter)->PrintName() << " = "  
-            << (*iter)->Evaluate(Sample, Pdata, DustTemperature)  << "W");
+    }
+    if( EvaporationIndex >= 0 ) TermPowers[EvaporationIndex] *= 1000;
+    for( unsigned int n = 0; n < HeatTerms.size(); n ++ ){
+        TotalPower += TermPowers[n];
+        H1_Debug("\n\t\t" << HeatTerms[n]->PrintName() << " = "  
+            << TermPowers[n]  << "W");
     }
     TotalPower = TotalPower/1000;
 
     H1_Debug("\n\t\tTotalPower = \t" << TotalPower*1000 << "W\n\n");
+    CachedInputs = Inputs;
+    CachedPower = TotalPower;
+    PowerCached = true;
     return TotalPower;
 }
 
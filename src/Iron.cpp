@@ -35,6 +35,63 @@ const struct ElementConsts IronConsts = {
                      //!< /hbase/Tables/thrcn.html
 };
 
+/** @brief Heat capacity of solid iron in J/(mol K) at \p Temperature
+ */
+static double solid_heatcapacity(double Temperature){
+    double t = Temperature / 1000;
+    //!< All values (Except Temp < 298) from from:
+    //!< http://webbook.nist.gov/cgi/
+    //!< cbook.cgi?ID=C7439896&Units=SI&Mask=2&Type=JANAFS&Plot=on#JANAFS
+    if(Temperature <= 298){
+        //!< HeatCapacity = ( 4.942*Temperature +
+        //!< (1943.75/pow(465,3))*pow(Temperature,4) ) / 1000;
+        //!< This is an 8th order polynomial fit to the low temperature heat
+        //!< capacity data found at
+        //!< http://nist.gov/data/PDFfiles/jpcrd298.pdf
+        double z=(Temperature-120)/99;
+        return -0.71*pow(z,8) + 2.2*pow(z,7) + 0.38*pow(z,6) -
+            6.8*pow(z,5) + 5.3*pow(z,4) + 3.5*pow(z,3) - 8.7*pow(z,2) + 12*z 
+            + 15;
+    }else if(Temperature > 298 && Temperature <= 700){ //!< 298 - 700    
+        return 18.42868 + 24.64301*t - 8.91372*pow(t,2) +
+            9.664706*pow(t,3) - (0.012643/pow(t,2));
+    }else if(Temperature > 700 && Temperature <= 1042){ //!< 700 - 1042
+        return -57767.65 + 137919.7*t - 122773.2*pow(t,2) +
+            38682.42*pow(t,3) + (3993.080/pow(t,2));
+    }else if(Temperature > 1042 && Temperature <= 1100){ //!< 1042 - 1100
+        return -325.8859 + 28.92876*t + (411.9629/pow(t,2));
+    }else if(Temperature > 1100 
+        && Temperature <= IronConsts.MeltingTemp ){ //!< 1100 - 1809
+        return -776.7387 + 919.4005*t - 383.7184*pow(t,2) +
+            57.08148*pow(t,3) + (242.1369/pow(t,2)); 
+    }
+    return 46.632;
+}
+
+/** @brief Heat capacity of liquid iron in J/(mol K) at \p Temperature
+ */
+static double liquid_heatcapacity(double Temperature){
+    if(Temperature < 2200){
+        //!< Recommended values +/- 3 from: 
+        //!< http://nist.gov/data/PDFfiles/jpcrd298.pdf
+        return 46.632;
+    }
+    //!< From NIST: http://webbook.nist.gov/cgi/inchi?ID=C7439896&Mask=2
+    double t = Temperature / 1000;
+    return 46.02400 - 1.884667e-8*t + 6.094750e-9 *pow(t,2) -
+        6.640301e-10*pow(t,3) - (8.246121e-9/pow(t,2));
+}
+
+/** @brief Vapour pressure of liquid iron at \p Temperature
+ */
+static double liquid_vapourpressure(double Temperature){
+    //!<  St.VapourPressure = pow(10,6.347 - 19574/St.Temperature); 
+    //!< http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
+    //!< https://en.wikipedia.org/
+    //!< wiki/Vapor_pressures_of_the_elements_(data_page)
+    return pow(10,11.353 - 19574/Temperature);
+}
+
 Iron::Iron():
 Matter(IronConsts){
     E_Debug("\n\nIn Iron::Iron():Matter(IronConsts)");
@@ -131,51 +188,19 @@ void Iron::set_defaults(){
 
 void Iron::update_heatcapacity(){
     E_Debug("\n\n\tIn Iron::update_heatcapacity()");
-    double t = St.Temperature / 1000;
+    static const PropertyTable SolidTable(solid_heatcapacity,
+        {298,700,1042,1100,IronConsts.MeltingTemp},Tabulation::Linear);
+    static const PropertyTable LiquidTable(liquid_heatcapacity,
+        {2200,2*IronConsts.BoilingTemp},Tabulation::Linear);
 
     if( St.Liquid == true ){
-        if(St.Temperature < 2200){
-            //!< Recommended values +/- 3 from: 
-            //!< http://nist.gov/data/PDFfiles/jpcrd298.pdf
-            St.HeatCapacity = 46.632;
-        }else{
-            //!< From NIST: http://webbook.nist.gov/cgi/inchi?ID=C7439896&Mask=2          
-            St.HeatCapacity = 46.02400 - 1.884667e-8*t + 6.094750e-9 *pow(t,2) -
-                6.640301e-10*pow(t,3) - (8.246121e-9/pow(t,2));
-        }
+        if( !LiquidTable.lookup(St.Temperature,St.HeatCapacity) )
+            St.HeatCapacity = liquid_heatcapacity(St.Temperature);
     }else if( St.Gas == true ){
         
     }else{ //!< Must be a solid
-        //!< All values (Except Temp < 298) from from:
-        //!< http://webbook.nist.gov/cgi/
-        //!< cbook.cgi?ID=C7439896&Units=SI&Mask=2&Type=JANAFS&Plot=on#JANAFS
-        if(St.Temperature <= 298){
-            //!< HeatCapacity = ( 4.942*Temperature +
-            //!< (1943.75/pow(465,3))*pow(Temperature,4) ) / 1000;
-            //!< This is an 8th order polynomial fit to the low temperature heat
-            //!< capacity data found at
-            //!< http://nist.gov/data/PDFfiles/jpcrd298.pdf
-            double z=(St.Temperature-120)/99;
-            St.HeatCapacity = -0.71*pow(z,8) + 2.2*pow(z,7) + 0.38*pow(z,6) -
-                6.8*pow(z,5) + 5.3*pow(z,4) + 3.5*pow(z,3) - 8.7*pow(z,2) + 12*z 
-                + 15;
-        }else if(St.Temperature > 298 && St.Temperature <= 700){ //!< 298 - 700    
-            St.HeatCapacity = 18.42868 + 24.64301*t - 8.91372*pow(t,2) +
-                9.664706*pow(t,3) - (0.012643/pow(t,2));
-        }else if(St.Temperature > 700 
-            && St.Temperature <= 1042){ //!< 700 - 1042
-            St.HeatCapacity = -57767.65 + 137919.7*t - 122773.2*pow(t,2) +
-                38682.42*pow(t,3) + (3993.080/pow(t,2));
-        }else if(St.Temperature > 1042 
-            && St.Temperature <= 1100){ //!< 1042 - 1100
-            St.HeatCapacity = -325.8859 + 28.92876*t + (411.9629/pow(t,2));
-        }else if(St.Temperature > 1100 
-            && St.Temperature <= Ec.MeltingTemp ){ //!< 1100 - 1809
-            St.HeatCapacity = -776.7387 + 919.4005*t - 383.7184*pow(t,2) +
-                57.08148*pow(t,3) + (242.1369/pow(t,2)); 
-        }else{
-            St.HeatCapacity = 46.632;
-        }
+        if( !SolidTable.lookup(St.Temperature,St.HeatCapacity) )
+            St.HeatCapacity = solid_heatcapacity(St.Temperature);
     }
     // E_Debug("\nCv of Solid: " << St.HeatCapacity << "[J/(mol K)]");
     // Pause();
@@ -189,7 +214,7 @@ void Iron::update_radius(){
     St.LinearExpansion = 1+(10.8*St.Temperature)*1e-6;
     St.Radius=St.UnheatedRadius*St.LinearExpansion;
     if(St.Temperature == Ec.MeltingTemp){
-        static bool runOnce;
+        static std::atomic<bool> runOnce;
         WarnOnce(runOnce,"Linear exansion Discontinuous in time");
     }
     E1_Debug("\n\tTemperature = " << St.Temperature 
@@ -207,24 +232,26 @@ void Iron::update_vapourpressure(){
 
 double Iron::probe_vapourpressure(double Temperature)const{
     E_Debug("\n\n\tIn Iron::probe_vapourpressure(double Temperature)const");
-    //!<  St.VapourPressure = pow(10,6.347 - 19574/St.Temperature); 
-    //!< http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
+    static const PropertyTable LiquidTable(liquid_vapourpressure,
+        {IronConsts.MeltingTemp,2*IronConsts.BoilingTemp},
+        Tabulation::Arrhenius);
     double VapourPressure(0.0);
-    //!< https://en.wikipedia.org/
-    //!< wiki/Vapor_pressures_of_the_elements_(data_page)
 
     // old model for evaporation in the solide phase
     // pow(10,12.106 - 21723/St.Temperature + 0.4536*log(St.Temperature) -
     //  0.5846/pow(St.Temperature,3));
     if( !St.Liquid && !St.Gas ) VapourPressure = 0;
     if( St.Liquid ){
-        static bool runOnce = true;
-        std::string WarningMessage = "In Iron::probe_vapourpressure():\n";
-        WarningMessage += "Temperature range of model extended from";
-        WarningMessage += " 2100K to 3134K";
-        WarnOnce(runOnce,WarningMessage);
+        static std::atomic<bool> runOnce(true);
+        if( runOnce ){
+            std::string WarningMessage = "In Iron::probe_vapourpressure():\n";
+            WarningMessage += "Temperature range of model extended from";
+            WarningMessage += " 2100K to 3134K";
+            WarnOnce(runOnce,WarningMessage);
+        }
 
-        VapourPressure = pow(10,11.353 - 19574/Temperature);
+        if( !LiquidTable.lookup(Temperature,VapourPressure) )
+            VapourPressure = liquid_vapourpressure(Temperature);
     }
 
     E1_Debug("VapourPressure = " << St.VapourPressure);
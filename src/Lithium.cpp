@@ -33,6 +33,20 @@ const struct ElementConsts LithiumConsts = {
     0.0848    //!< kW/m K at 20 degrees celsius
 };
 
+/** @brief Vapour pressure of lithium in Pa at \p Temperature
+ */
+static double vapourpressure(double Temperature){
+    //!< Model being used:
+    //!< http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
+    //!< High temperature model:
+    //!< https://ntrs.nasa.gov/archive/nasa/casi.ntrs.nasa.gov/19680018893.pdf
+    if( Temperature < LithiumConsts.MeltingTemp )
+        return 101325*pow(10,5.667 - 8310/Temperature); 
+    else if( Temperature < 800 )
+        return 101325*pow(10,5.055 - 8023/Temperature); 
+    return 101325*pow(10,10.015-8064.5/Temperature);
+}
+
 Lithium::Lithium():
 Matter(LithiumConsts){
     E_Debug("\n\nIn Lithium::Lithium():Matter(LithiumConsts)");
@@ -121,7 +135,7 @@ void Lithium::update_heatcapacity(){
     //!< Temperature dependant heat capacity for Lithium taken from:
     //!< D. Harry W., Lewis Reserch Cent. 24 (1968), pg 8, figure 4
     if( St.Temperature < Ec.MeltingTemp ){ 
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Lithium::update_heatcapacity():\n";
         WarningMessage += "Extending heat capacity model outside temperature";
         WarningMessage += " range! T < 300K";
@@ -134,7 +148,7 @@ void Lithium::update_heatcapacity(){
         St.HeatCapacity = 4169-0.2427*St.Temperature+
             1.045e-3*pow(St.Temperature,2.0);
     }else{
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Lithium::update_heatcapacity():\n";
         WarningMessage += "Extending heat capacity model outside temperature";
         WarningMessage += " T > Ec.BoilingTemp";
@@ -170,24 +184,22 @@ void Lithium::update_vapourpressure(){
 
 double Lithium::probe_vapourpressure(double Temperature)const{
     E_Debug("\n\n\tIn Lithium::update_vapourpressure(double Temperature)const");
+    static const PropertyTable Table(vapourpressure,
+        {LithiumConsts.MeltingTemp,800,2*LithiumConsts.BoilingTemp},
+        Tabulation::Arrhenius);
     double VapourPressure(0.0);
-    //!< Model being used:
-    //!< http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
-    //!< High temperature model:
-    //!< https://ntrs.nasa.gov/archive/nasa/casi.ntrs.nasa.gov/19680018893.pdf
+    if( Table.lookup(Temperature,VapourPressure) ) return VapourPressure;
+
     if( Temperature < Ec.MeltingTemp ){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Lithium::update_vapourpressure():\n";
         WarningMessage += "Extending model outside temperature range!";
         WarningMessage += " (from 298K< to 0K<)";
         WarnOnce(runOnce,WarningMessage);
 
-        VapourPressure = 101325*pow(10,5.667 - 8310/Temperature); 
-    }else if( Temperature >= Ec.MeltingTemp && Temperature < 800 ){
-        VapourPressure = 101325*pow(10,5.055 - 8023/Temperature); 
-    }else if( Temperature >= 800 ){
-        
-        VapourPressure = 101325*pow(10,10.015-8064.5/Temperature);
+        VapourPressure = vapourpressure(Temperature);
+    }else if( Temperature >= Ec.MeltingTemp ){
+        VapourPressure = vapourpressure(Temperature);
     }else{
         std::cerr << "\nError! Negative Temperature in Lithium::" 
             << "probe_vapourpressure(double "<< Temperature <<")";
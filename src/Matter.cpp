@@ -41,7 +41,7 @@ struct GrainData MatterDefaults = {
 
 //!< Make sure dimensions of material are self-consistent after constructor
 Matter::Matter(const ElementConsts &elementconsts):
-Ec(elementconsts),St(MatterDefaults){
+Stale(true),UpdateTolerance(0.0),Ec(elementconsts),St(MatterDefaults){
     M_Debug("\n\nIn Matter::Matter(const ElementConsts &elementconsts):"
         << "Ec(elementconsts),St(MatterDefaults)\n\n");
     ConstModels = {'c','c','c','y'};
@@ -50,7 +50,7 @@ Ec(elementconsts),St(MatterDefaults){
 };
 
 Matter::Matter(double rad, const ElementConsts &elementconsts):
-Ec(elementconsts),St(MatterDefaults){
+Stale(true),UpdateTolerance(0.0),Ec(elementconsts),St(MatterDefaults){
     M_Debug("\n\nIn Matter::Matter(double rad, const ElementConsts "
         << "&elementconsts):Ec(elementconsts),St(MatterDefaults)\n\n");
     ConstModels = {'c','c','c','y'};
@@ -62,7 +62,7 @@ Ec(elementconsts),St(MatterDefaults){
 };
 
 Matter::Matter(double rad, double temp, const ElementConsts &elementconsts):
-Ec(elementconsts),St(MatterDefaults){
+Stale(true),UpdateTolerance(0.0),Ec(elementconsts),St(MatterDefaults){
     M_Debug("\n\nIn Matter::Matter(double rad, double temp, const ElementConsts"
         << " &elementconsts):Ec(elementconsts),St(MatterDefaults)\n\n");
     ConstModels = {'c','c','c','y'};
@@ -103,7 +103,7 @@ Ec(elementconsts),St(MatterDefaults){
 
 Matter::Matter(double rad, double temp, const ElementConsts &elementconsts, 
 std::array<char,CM> &constmodels)
-:Ec(elementconsts),St(MatterDefaults){
+:Stale(true),UpdateTolerance(0.0),Ec(elementconsts),St(MatterDefaults){
     M_Debug("\n\n(double rad, double temp, const ElementConsts &elementconsts," 
         << " std::array<char,CM> &constmodels):Ec(elementconsts),"
         << " St(MatterDefaults)\n\n");
@@ -197,49 +197,23 @@ void Matter::update_emissivity(){
 //          std::cout << "\nError! In Matter::update_emissivity().\n"
 //              << "Radius = " << St.Radius 
 //              << " outside limit of Emissivty model.\n";
-            static bool runOnce1 = true;
+            static std::atomic<bool> runOnce1(true);
             WarnOnce(runOnce1,"Radius outside limit of Emissivty model.");
 //          assert(St.Radius > 2e-8);
 //          assert(St.Radius < 1e-4);
         }else{
             assert(St.Temperature > 275); //!< Check temperature is in table
             assert(St.Temperature <= Ec.BoilingTemp);
-            std::string DirName, FileName("/Temp_");
-            std::string TempString, txtstring(".txt");
-            //!< Set DirName for correct elements Emissivity Data folder
-            if(Ec.Elem == 'w' || Ec.Elem == 'W' ) 
-                DirName = "EmissivityData/EmissivityDataTungsten";
-            else if(Ec.Elem == 'f' || Ec.Elem == 'F' ) 
-                DirName = "EmissivityData/EmissivityDataIron";
-            else if(Ec.Elem == 'g' || Ec.Elem == 'G' ) 
-                DirName = "EmissivityData/EmissivityDataGraphite";
-            else if(Ec.Elem == 'b' || Ec.Elem == 'B' ) 
-                DirName = "EmissivityData/EmissivityDataBeryllium";
-            std::ifstream TempFile;
-            std::stringstream ss;
-
-            ss << round(St.Temperature);
-            ss >> TempString;
-
-            //!< Open the file with emissivity data
-            TempFile.open((DirName+FileName+TempString+txtstring).c_str());
-            bool Found = false;
-
-            char buffer;
-            double TestRad;
-            //!< Extract data from file
-            while( TempFile >> TestRad >> buffer >> St.Emissivity 
-                && Found != true ){
-                if(TestRad == round_to_digits(St.Radius,2)){ 
-                    Found = true;
-                    M2_Debug("\nround(St.Radius,9) = " 
-                        << round_to_digits(St.Radius,2) << "\nTestRad = " 
-                        << TestRad );
-                    //Pause();
-                }
+            //!< Data are read once per element, on first use
+            if( !Emissivities ) 
+                Emissivities = EmissivityTable::shared(Ec.Elem,Ec.BoilingTemp);
+            if( Emissivities->empty() ){
+                static std::atomic<bool> runOnce3(true);
+                WarnOnce(runOnce3,"No emissivity data found for element.");
+            }else{
+                St.Emissivity = Emissivities->interpolate(St.Temperature,
+                    St.Radius);
             }
-            ss.clear(); ss.str("");
-            TempFile.close(); //!< close the file with emissivity data
         }
     }else{ //!< Invalid input for Emissivity model
         std::cout << "\nError! In Matter::update_emissivity()\n"
@@ -248,7 +222,7 @@ void Matter::update_emissivity(){
     }
     //!< Ensure emissivity is correctly set
     if(St.Emissivity > 1.0 || St.Emissivity < 0.0 ){
-        static bool runOnce2 = true;
+        static std::atomic<bool> runOnce2(true);
         WarnOnce(runOnce2,"Emissivity > 1! Emissivity being forced equal to 1");
         St.Emissivity = 1.0;
     }
@@ -399,19 +373,38 @@ void Matter::update_state(double EnergyIn){
 
 void Matter::update(){
     M_Debug("\tIn Matter::update()\n\n");
+    //!< Thermal expansion makes the dimensions depend on the temperature, and
+    //!< on the fusion energy while melting
+    bool Expanding = ( ConstModels[1] == 'v' || ConstModels[1] == 'V' );
+    bool DimChanged = Stale || changed(St.Mass,DimInputs.Mass)
+        || ( Expanding && ( changed(St.Temperature,DimInputs.Temperature)
+        || changed(St.FusionEnergy,DimInputs.FusionEnergy) ) );
+
     //!< ORDER DEPENDENT UPDATES:
-    M_Debug("\t"); update_dim();
+    if( DimChanged ){
+        M_Debug("\t"); update_dim();
+        DimInputs.Temperature = St.Temperature;
+        DimInputs.Mass = St.Mass;
+        DimInputs.FusionEnergy = St.FusionEnergy;
+    }
+    bool StateChanged = Stale || St.Liquid != StateInputs.Liquid 
+        || St.Gas != StateInputs.Gas
+        || changed(St.Temperature,StateInputs.Temperature)
+        || changed(St.Radius,StateInputs.Radius);
     
     //!< ORDER INDEPENDENT UPDATES:
-    if( ConstModels[2] == 'v'|| ConstModels[2] == 'V') update_heatcapacity();
-    else if( ConstModels[2] == 'c'||ConstModels[2] == 'C')  
-        St.HeatCapacity = St.HeatCapacity;
-    else if( ConstModels[2] == 's'|| ConstModels[2] == 'S') 
-        St.HeatCapacity = 0.56; //!< This is an arbitrary fixed number
-    else{
-        std::cout << "\nError! In Matter::update(...)\n"
-            << "Invalid input for HeatCapacity Model.";
-        assert( strchr("vVcCsS",ConstModels[2]) );  
+    if( StateChanged ){
+        if( ConstModels[2] == 'v'|| ConstModels[2] == 'V') 
+            update_heatcapacity();
+        else if( ConstModels[2] == 'c'||ConstModels[2] == 'C')  
+            St.HeatCapacity = St.HeatCapacity;
+        else if( ConstModels[2] == 's'|| ConstModels[2] == 'S') 
+            St.HeatCapacity = 0.56; //!< This is an arbitrary fixed number
+        else{
+            std::cout << "\nError! In Matter::update(...)\n"
+                << "Invalid input for HeatCapacity Model.";
+            assert( strchr("vVcCsS",ConstModels[2]) );  
+        }
     }
 
     //!< Calculate the critical dimensionless angular velocity for rotational
@@ -438,9 +431,16 @@ void Matter::update(){
         }
     } 
     //!< Call update functions for models with variable constants
-    M_Debug("\n\n"); update_emissivity();
-    M_Debug("\t"); update_vapourpressure();
-    M_Debug("\n\n\t"); update_boilingtemp();
+    if( StateChanged ){
+        M_Debug("\n\n"); update_emissivity();
+        M_Debug("\t"); update_vapourpressure();
+        M_Debug("\n\n\t"); update_boilingtemp();
+        StateInputs.Temperature = St.Temperature;
+        StateInputs.Radius = St.Radius;
+        StateInputs.Liquid = St.Liquid;
+        StateInputs.Gas = St.Gas;
+    }
+    Stale = false;
 };
 
 void Matter::update_models(char emissivmodel, char linexpanmodel, 
@@ -452,11 +452,13 @@ void Matter::update_models(char emissivmodel, char linexpanmodel,
     ConstModels[2] = heatcapacitymodel;
     ConstModels[3] = boilingmodel;
     ConstModels[4] = breakupmodel;
+    Stale = true;
 };
 
 void Matter::update_models(std::array<char,CM> &constmodels){
     M_Debug("\tIn Matter::update_models(std::array<char,CM> &constmodels)\n\n");
     ConstModels = constmodels;
+    Stale = true;
 }
 
 void Matter::update_mass(double LostMass){ 
@@ -522,7 +524,7 @@ void Matter::update_motion(const threevector &ChangeInPosition,
     
     //!< Check that position is sensible
     if( St.DustPosition.getx() == 0.0 ){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string Warning = "Dust Radial Position <= 0.0! Angular";
         Warning += " position poory defined!";
         WarnOnce(runOnce,Warning);
@@ -557,3 +559,45 @@ void Matter::update_charge(double charge, double potential, double deltat,
         St.Gas = true;
     }
 }
+
+void Matter::write_checkpoint(CheckpointWriter &out)const{
+    M_Debug("\tIn Matter::write_checkpoint(CheckpointWriter &out)const\n\n");
+    out << Ec.Elem << St << PreBoilMass 
+        << DimInputs.Temperature << DimInputs.Mass << DimInputs.FusionEnergy
+        << StateInputs.Temperature << StateInputs.Radius 
+        << StateInputs.Liquid << StateInputs.Gas << Stale;
+}
+
+void Matter::read_checkpoint(CheckpointReader &in){
+    M_Debug("\tIn Matter::read_checkpoint(CheckpointReader &in)\n\n");
+    char Elem(0);
+    in >> Elem;
+    if( Elem != Ec.Elem ){
+        in.fail();
+        return;
+    }
+    in >> St >> PreBoilMass 
+        >> DimInputs.Temperature >> DimInputs.Mass >> DimInputs.FusionEnergy
+        >> StateInputs.Temperature >> StateInputs.Radius 
+        >> StateInputs.Liquid >> StateInputs.Gas >> Stale;
+}
+
+CheckpointWriter &operator<<(CheckpointWriter &out, const GrainData &gd){
+    return out << gd.Liquid << gd.Gas << gd.Breakup << gd.UnheatedRadius 
+        << gd.Mass << gd.Radius << gd.SurfaceArea << gd.Volume << gd.Density
+        << gd.SuperBoilingTemp << gd.Temperature << gd.VapourPressure 
+        << gd.Emissivity << gd.LinearExpansion << gd.HeatCapacity 
+        << gd.DeltaSec << gd.DeltaTherm << gd.RE << gd.RN << gd.Potential 
+        << gd.Positive << gd.DustPosition << gd.DustVelocity 
+        << gd.RotationalFrequency << gd.FusionEnergy << gd.VapourEnergy;
+}
+
+CheckpointReader &operator>>(CheckpointReader &in, GrainData &gd){
+    return in >> gd.Liquid >> gd.Gas >> gd.Breakup >> gd.UnheatedRadius 
+        >> gd.Mass >> gd.Radius >> gd.SurfaceArea >> gd.Volume >> gd.Density
+        >> gd.SuperBoilingTemp >> gd.Temperature >> gd.VapourPressure 
+        >> gd.Emissivity >> gd.LinearExpansion >> gd.HeatCapacity 
+        >> gd.DeltaSec >> gd.DeltaTherm >> gd.RE >> gd.RN >> gd.Potential 
+        >> gd.Positive >> gd.DustPosition >> gd.DustVelocity 
+        >> gd.RotationalFrequency >> gd.FusionEnergy >> gd.VapourEnergy;
+}
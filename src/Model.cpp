@@ -8,95 +8,107 @@
  */
 
 #include "Model.h"
+#include "GridInterpolation.h"
+
+//!< Layout of the rows written by Model::RecordPlasmadata()
+static const std::vector<DataColumn> PlasmaDataColumns = {
+    {"#t",Column::Scalar},      {"i",Column::Integer},  {"k",Column::Integer},
+    {"Nn",Column::Scalar},      {"Ne",Column::Scalar},  {"Ni",Column::Scalar},
+    {"Ti",Column::Scalar},      {"Te",Column::Scalar},  {"Tn",Column::Scalar},
+    {"T0",Column::Scalar},      {"Pvel",Column::Vector},
+    {"gravity",Column::Vector}, {"E",Column::Vector},   {"B",Column::Vector}
+};
 
 Model::Model():
-FileName("Data/default_0.txt"),Sample(new Tungsten),
 PG_data(std::make_shared<PlasmaGrid_Data>(PlasmaGrid_DataDefaults)),
-Pdata(&PlasmaDataDefaults),Accuracy(1.0),ContinuousPlasma(true),
-TimeStep(0.0),TotalTime(0.0){
+State(std::make_shared<LocalPlasmaState>(
+    LocalPlasmaState{PlasmaDataDefaults,0,0,true})),
+Sample(new Tungsten),Pdata(State,&State->Pdata),Accuracy(1.0),
+ContinuousPlasma(true),TimeStep(0.0),TotalTime(0.0),
+FileName("Data/default_0.txt"){
     Mo_Debug("\n\nIn Model::Model():FileName(filename),Sample(new Tungsten),"
         << "PG_data(std::make_shared<PlasmaGrid_Data>"
         << "PlasmaGrid_DataDefaults)),"
-        << "Pdata(&PlasmaDataDefaults),Accuracy(1.0),ContinuousPlasma(true),"
+        << "State(PlasmaDataDefaults),Pdata(State,&State->Pdata),"
+        << "Accuracy(1.0),ContinuousPlasma(true),"
         << "TimeStep(0.0),TotalTime(0.0))\n\n");
-    i = 0; k = 0; OldMass = 0;
-    PlasmaDataFile.open("Data/pd.txt");
-    PlasmaDataFile << "#t\ti\tk\tNn\tNe\tNi\tTi\tTe\t"
-        << "Tn\tT0\tPvel\tgravity\tE\tB";
-    PlasmaDataFile.close();
-    PlasmaDataFile.clear();
+    OldMass = 0;
+    derive_plasmadata(*Pdata);
     update_plasmadata();
 }
 
 Model::Model(std::string filename, Matter *&sample, PlasmaData &pdata, 
     float accuracy ):
-FileName(filename),Sample(sample),
 PG_data(std::make_shared<PlasmaGrid_Data>(PlasmaGrid_DataDefaults)),
-Pdata(std::make_shared<PlasmaData>(pdata)),Accuracy(accuracy),
-ContinuousPlasma(true),TimeStep(0.0),TotalTime(0.0){
+State(std::make_shared<LocalPlasmaState>(
+    LocalPlasmaState{pdata,0,0,true})),
+Sample(sample),Pdata(State,&State->Pdata),Accuracy(accuracy),
+ContinuousPlasma(true),TimeStep(0.0),TotalTime(0.0),FileName(filename){
     Mo_Debug("\n\nIn Model::Model( Matter *&sample, PlasmaData &pdata, "
         << "float accuracy ):FileName(filename),Sample(sample),"
         << "PG_data(std::make_shared<PlasmaGrid_Data>"
         << "(PlasmaGrid_DataDefaults)),"
-        << "Pdata(std::make_shared<PlasmaData>(pdata)),Accuracy(accuracy),"
+        << "State(pdata),Pdata(State,&State->Pdata),Accuracy(accuracy),"
         << "ContinuousPlasma(true),TimeStep(0.0),TotalTime(0.0))\n\n");
     assert(Accuracy > 0);
-    i = 0; k = 0; OldMass = 0;
-    PlasmaDataFile.open("Data/pd.txt");
-    PlasmaDataFile << "#t\ti\tk\tNn\tNe\tNi\tTi\tTe\t"
-        << "Tn\tT0\tPvel\tgravity\tE\tB";
-    PlasmaDataFile.close();
-    PlasmaDataFile.clear();
+    OldMass = 0;
     set_plasmadata(pdata);
 }
 
-Model::Model(std::string filename, Matter *&sample, PlasmaGrid_Data &pgrid, 
-    float accuracy ):
-FileName(filename),Sample(sample),
-PG_data(std::make_shared<PlasmaGrid_Data>(pgrid)),
-Pdata(&PlasmaDataDefaults),Accuracy(accuracy),
-ContinuousPlasma(false),TimeStep(0.0),TotalTime(0.0){
-    Mo_Debug("\n\nIn Model::Model( Matter *&sample, PlasmaGrid_Data &pgrid, "
-        << "float accuracy ):FileName(filename),Sample(sample),"
-        << "PG_data(std::make_shared<PlasmaGrid_Data>(pgrid)),"
-        << "Pdata(&PlasmaDataDefaults),Accuracy(accuracy),"
+Model::Model(std::string filename, Matter *&sample, 
+    std::shared_ptr<const PlasmaGrid_Data> pgrid, float accuracy ):
+PG_data(pgrid),
+State(std::make_shared<LocalPlasmaState>(
+    LocalPlasmaState{PlasmaDataDefaults,0,0,true})),
+Sample(sample),Pdata(State,&State->Pdata),Accuracy(accuracy),
+ContinuousPlasma(false),TimeStep(0.0),TotalTime(0.0),FileName(filename){
+    Mo_Debug("\n\nIn Model::Model( Matter *&sample, "
+        << "std::shared_ptr<const PlasmaGrid_Data> pgrid, float accuracy ):"
+        << "FileName(filename),Sample(sample),PG_data(pgrid),"
+        << "State(PlasmaDataDefaults),Pdata(State,&State->Pdata),"
+        << "Accuracy(accuracy),"
         << "ContinuousPlasma(false), TimeStep(0.0),TotalTime(0.0))\n\n");
     assert(Accuracy > 0);
-    i = 0; k = 0; OldMass = 0;
-    PlasmaDataFile.open("Data/pd.txt");
-    PlasmaDataFile << "#t\ti\tk\tNn\tNe\tNi\tTi\tTe\t"
-        << "Tn\tT0\tPvel\tgravity\tE\tB";
-    static bool runOnce = true;
+    assert(PG_data);
+    OldMass = Sample->get_mass();
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "Default values being taken: Tn = 0.025*116045.25K,";
     Warning += " Nn = 1e19m^-3, Ta = 300K & Mi = 1.66054e-27Kg!";
     WarnOnce(runOnce,Warning);
-    PlasmaDataFile.close();
-    PlasmaDataFile.clear();
+    derive_plasmadata(*Pdata);
     update_plasmadata();
 }
 
-Model::Model( std::string filename, Matter *&sample, PlasmaGrid_Data &pgrid, 
-    PlasmaData &pdata, float accuracy ):
-FileName(filename),Sample(sample),
-PG_data(std::make_shared<PlasmaGrid_Data>(pgrid)),
-Pdata(std::make_shared<PlasmaData>(pdata)),Accuracy(accuracy),
-ContinuousPlasma(false),TimeStep(0.0),TotalTime(0.0){
-    Mo_Debug("\n\nIn Model::Model( Matter *&sample, PlasmaGrid_Data &pgrid, "
-        << "PlasmaData &pdata, float accuracy ):"
-        << "FileName(filename),Sample(sample), "
-        << "PG_data(std::make_shared<PlasmaGrid_Data>(pgrid)),"
-        << "Pdata(std::make_shared<PlasmaData>(pdata)),Accuracy(accuracy),"
+Model::Model( std::string filename, Matter *&sample, 
+    std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata, 
+    float accuracy ):
+PG_data(pgrid),
+State(std::make_shared<LocalPlasmaState>(
+    LocalPlasmaState{pdata,0,0,true})),
+Sample(sample),Pdata(State,&State->Pdata),Accuracy(accuracy),
+ContinuousPlasma(false),TimeStep(0.0),TotalTime(0.0),FileName(filename){
+    Mo_Debug("\n\nIn Model::Model( Matter *&sample, "
+        << "std::shared_ptr<const PlasmaGrid_Data> pgrid, PlasmaData &pdata, "
+        << "float accuracy ):FileName(filename),Sample(sample),PG_data(pgrid),"
+        << "State(pdata),Pdata(State,&State->Pdata),Accuracy(accuracy),"
         << "ContinuousPlasma(false),TimeStep(0.0),TotalTime(0.0))\n\n");
     assert(Accuracy > 0);
-    i = 0; k = 0; OldMass = 0;
-    PlasmaDataFile.open("Data/pd.txt");
-    PlasmaDataFile << "#t\ti\tk\tNn\tNe\tNi\tTi\tTe\t"
-        << "Tn\tT0\tPvel\tgravity\tE\tB";
-    PlasmaDataFile.close();
-    PlasmaDataFile.clear();
+    assert(PG_data);
+    OldMass = Sample->get_mass();
+    derive_plasmadata(*Pdata);
     update_plasmadata();
 }
 
+Model::Model(const Model &other):
+PG_data(other.PG_data),Deposition(other.Deposition),
+State(std::make_shared<LocalPlasmaState>(*other.State)),
+OldMass(other.OldMass),Sample(other.Sample),Pdata(State,&State->Pdata),
+Accuracy(other.Accuracy),ContinuousPlasma(other.ContinuousPlasma),
+TimeStep(other.TimeStep),TotalTime(other.TotalTime),FileName(other.FileName),
+ModelDataFile(other.ModelDataFile),PlasmaDataFile(other.PlasmaDataFile){
+    Mo_Debug("\n\nIn Model::Model(const Model &other)\n\n");
+}
+
 const bool Model::locate(int &i, int &k, const threevector xd)const{
     P_Debug("\tIn Model::locate(int &" << i << ", int &" << k << ", " << xd 
         << ")\n\n");
@@ -132,90 +144,84 @@ bool Model::new_cell()const{
     locate(j,p,Sample->get_position());
 
     //!< If it's same as stored (previous) position, new_cell is false
-    if( (j == i) && (p == k) )  return false;
+    if( (j == State->i) && (p == State->k) )  return false;
     return true; //!< else, it's true
 }
 
+const double Model::get_gridstep()const{
+    //!< Distance which may be travelled in one step while the plasma data,
+    //!< updated once per step, remains valid
+    return std::min(PG_data->dlx,PG_data->dlz)
+        *cells_per_step(PG_data->interpolation);
+}
+
 void Model::close_file(){
     ModelDataFile.close();
 }
 
+void Model::set_output(char format, unsigned int flushinterval){
+    Mo_Debug( "\tIn Model::set_output(char format, "
+        << "unsigned int flushinterval)\n\n");
+    ModelDataFile.configure(format,flushinterval);
+    PlasmaDataFile.configure(format,flushinterval);
+}
+
 void Model::set_plasmadata(PlasmaData &pdata){
-    Mo_Debug( "\tIn Model::update_plasmadata(PlasmaData &pdata)\n\n");
-    Pdata = std::make_shared<PlasmaData>(pdata);
+    Mo_Debug( "\tIn Model::set_plasmadata(PlasmaData &pdata)\n\n");
+    *Pdata = pdata;
+    derive_plasmadata(*Pdata);
+}
+
+void Model::share_localstate(std::shared_ptr<LocalPlasmaState> state){
+    Mo_Debug( "\tIn Model::share_localstate("
+        << "std::shared_ptr<LocalPlasmaState> state)\n\n");
+    assert(state);
+    State = state;
+    Pdata = std::shared_ptr<PlasmaData>(State,&State->Pdata);
 }
 
-void Model::set_plasmagrid(PlasmaGrid_Data &pgrid){
-    Mo_Debug( "\tIn Model::set_plasmagrid(PlasmaGrid_Data &pgrid)\n\n");
-    PG_data = std::make_shared<PlasmaGrid_Data>(pgrid);
+void Model::set_plasmagrid(std::shared_ptr<const PlasmaGrid_Data> pgrid){
+    Mo_Debug( "\tIn Model::set_plasmagrid("
+        << "std::shared_ptr<const PlasmaGrid_Data> pgrid)\n\n");
+    assert(pgrid);
+    PG_data = pgrid;
 }
 
 const bool Model::update_plasmadata(){
     Mo_Debug( "\tIn Model::update_plasmadata()\n\n");
     
+    int &i = State->i;
+    int &k = State->k;
     //!< Check if particle is within grid
     bool InGrid = locate(i,k,Sample->get_position());
+    State->InGrid = InGrid;
     //!< If not, particle has escaped simulation domain
     if( !InGrid ) return InGrid;
     if( ContinuousPlasma ) return InGrid;
-    update_fields(i,k); //!< Update the fields
-    Pdata->NeutralDensity   = PG_data->na2[i][k];  
-    Pdata->ElectronDensity  = PG_data->na1[i][k];  
-    Pdata->IonDensity       = PG_data->na0[i][k];
-    Pdata->IonTemp          = PG_data->Ti[i][k];
-    Pdata->ElectronTemp     = PG_data->Te[i][k];
+    //!< Plasma parameters of nearest cell, unless they can be interpolated
+    PlasmaCell Local = PG_data->Cells[i][k];
+    interpolate_plasmacell(*PG_data,Sample->get_position().getx(),
+        Sample->get_position().getz(),Local);
+    update_fields(i,k,Local); //!< Update the fields
+    Pdata->NeutralDensity   = Local.na2;  
+    Pdata->ElectronDensity  = Local.na1;  
+    Pdata->IonDensity       = Local.na0;
+    Pdata->IonTemp          = Local.Ti;
+    Pdata->ElectronTemp     = Local.Te;
     Pdata->NeutralTemp      = PG_data->Tn[i][k];
     Pdata->AmbientTemp      = PG_data->Ta[i][k];
-    //interpolatepdata(i,k); //RecordPlasmadata("pd.txt");
+    derive_plasmadata(*Pdata);
     return true;
 }
 
-void Model::update_fields(int i, int k){
+void Model::update_fields(int i, int k, const PlasmaCell &local){
     Mo_Debug( "\tIn Model::update_fields(int " << i << ", int " 
-        << k << ")\n\n");
-    threevector vp, E, B, gravity(0.0,0.0,-9.81);
-
-    //!< Get Average plasma velocity
-    double aveu(0.0);
-    if( (PG_data->na0[i][k]>0.0) || (PG_data->na1[i][k]>0.0) ){
-        aveu = (PG_data->na0[i][k]*PG_data->ua0[i][k]+PG_data->na1[i][k]
-            *PG_data->ua1[i][k])
-            /(PG_data->na0[i][k]+PG_data->na1[i][k]);
-    }
-    else aveu = 0.0;
-
-    //!< Read magnetic field in at dust position
-    B.setx(PG_data->bx[i][k]);
-    B.sety(PG_data->by[i][k]);
-    B.setz(PG_data->bz[i][k]);
-
-    //!< Plasma velocity is parallel to the B field
-    vp.setx(aveu*(B.getunit().getx()));
-    vp.sety(aveu*(B.getunit().gety()));
-    vp.setz(aveu*(B.getunit().getz()));
-
-    //!< Calculate EField from potential at adjactentcells
-    if(PG_data->gridflag[i][k]==1){
-        if( (PG_data->gridflag[i+1][k]==1) && (PG_data->gridflag[i-1][k]==1) ){
-            E.setx(-(PG_data->po[i+1][k]-PG_data->po[i-1][k])
-                /(2.0*PG_data->dlx));
-        }else if(PG_data->gridflag[i+1][k]==1){
-            E.setx(-(PG_data->po[i+1][k]-PG_data->po[i][k])/PG_data->dlx);
-        }else if(PG_data->gridflag[i-1][k]==1){
-            E.setx(-(PG_data->po[i][k]-PG_data->po[i-1][k])/PG_data->dlx);
-        }else E.setx(0.0);
-        if((PG_data->gridflag[i][k+1]==1)&&(PG_data->gridflag[i][k-1]==1)){
-            E.setz(-(PG_data->po[i][k+1]-PG_data->po[i][k-1])
-                /(2.0*PG_data->dlz));
-        }else if(PG_data->gridflag[i][k+1]==1){
-            E.setz(-(PG_data->po[i][k+1]-PG_data->po[i][k])/PG_data->dlz);
-        }else if(PG_data->gridflag[i][k-1]==1){
-            E.setz(-(PG_data->po[i][k]-PG_data->po[i][k-1])/PG_data->dlz);
-        }else E.sety(0.0);
-    }else{
-        E.setx(0.0);
-        E.setz(0.0);
-    }
+        << k << ", const PlasmaCell &local)\n\n");
+    //!< Fields are derived once when the grid loads, so only gather them here
+    threevector vp(local.vpx,local.vpy,local.vpz);
+    threevector E(local.Er,0.0,local.Ez);
+    threevector B(local.bx,local.by,local.bz);
+    threevector gravity(0.0,0.0,-9.81);
 
     //!< Setup for Magnum-PSI gravity
     //!< For Magnum PSI, Gravity is not in -z direction it is radial & Azimuthal
@@ -236,16 +242,16 @@ void Model::update_fields(int i, int k){
 
 void Model::RecordPlasmadata(std::string filename){
     Mo_Debug( "\tModel::RecordPlasmadata(std::string filename)\n\n");
-    PlasmaDataFile.open("Data/" + filename,std::ofstream::app);
-    PlasmaDataFile << "\n" << TotalTime 
-            << "\t" << i << "\t" << k << "\t" << Pdata->NeutralDensity << "\t" 
-            << Pdata->ElectronDensity << "\t" << Pdata->IonDensity << "\t" 
-            << Pdata->IonTemp << "\t" << Pdata->ElectronTemp  << "\t" 
-            << Pdata->NeutralTemp << "\t" << Pdata->AmbientTemp << "\t" 
-            << Pdata->PlasmaVel << "\t" << Pdata->Gravity << "\t" 
-            << Pdata->ElectricField << "\t" << Pdata->MagneticField;
-    PlasmaDataFile.close();
-    PlasmaDataFile.clear();
+    std::string PathName = "Data/" + filename 
+        + DataSink::extension(PlasmaDataFile.get_format());
+    if( PlasmaDataFile.get_filename() != PathName )
+        PlasmaDataFile.open(PathName,PlasmaDataColumns);
+    PlasmaDataFile << TotalTime << State->i << State->k 
+        << Pdata->NeutralDensity << Pdata->ElectronDensity 
+        << Pdata->IonDensity << Pdata->IonTemp << Pdata->ElectronTemp 
+        << Pdata->NeutralTemp << Pdata->AmbientTemp << Pdata->PlasmaVel 
+        << Pdata->Gravity << Pdata->ElectricField << Pdata->MagneticField;
+    PlasmaDataFile.end_row();
 }
 
 const double Model::SOMLIonFlux(double Potential)const{
@@ -308,7 +314,7 @@ const double Model::PHLElectronFlux(double Potential)const{
     double MassRatio = Pdata->mi/Me;
 
     if( Beta/MassRatio > 0.01 ){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string Warning = "Beta/MassRatio > 0.01 in solvePHL! Model may ";
         Warning += "not be valid in this range! see Fig 11. of  L. Patacchini,";
         Warning += " I. H. Hutchinson, and G. Lapenta, ";
@@ -400,18 +406,21 @@ const double Model::NeutralFlux()const{
 
 void Model::Record_MassLoss(){
     H_Debug("\tIn Model::Record_MassLoss()\n\n");
-    PG_data->dm[i][k]=Sample->get_mass()-OldMass;
+    //!< Accumulate, several grains may deposit mass in the same cell
+    MassDeposition *dm = get_deposition();
+    if( dm ) dm->add(State->i,State->k,Sample->get_mass()-OldMass);
     OldMass=Sample->get_mass();
 }
 
 void Model::ImpurityPrint(){
     H_Debug("\tIn Model::ImpurityPrint()\n\n");
+    if( !PG_data->dm ) return;
     std::ofstream impurity;
     impurity.open(FileName+"_ImpurityProfile.txt");
     impurity << std::scientific << std::setprecision(16) << std::endl;
     for(int s=0;s<=PG_data->gridz-1;s++){
         for(int p=0;p<=PG_data->gridx-1;p++){
-            impurity << PG_data->dm[p][s] << "\t";
+            impurity << PG_data->dm->get(p,s) << "\t";
         }
         impurity << std::endl;
     }
@@ -419,185 +428,85 @@ void Model::ImpurityPrint(){
     impurity.close();
 }
 
-// *************************************** Unused Code *************************************** //
+//!< Write every field of the plasma data \p pd to \p out
+static void write_plasmadata(CheckpointWriter &out, const PlasmaData &pd){
+    const DerivedPlasmaQuantities &Derived = pd.Derived;
+    out << pd.NeutralDensity << pd.ElectronDensity << pd.IonDensity 
+        << pd.IonTemp << pd.ElectronTemp << pd.NeutralTemp << pd.AmbientTemp 
+        << pd.mi << pd.Z << pd.A << pd.PlasmaVel << pd.Gravity 
+        << pd.ElectricField << pd.MagneticField << Derived.DebyeLength 
+        << Derived.IonThermalSpeed << Derived.ElectronThermalFlux 
+        << Derived.IonThermalFlux << Derived.NeutralThermalFlux 
+        << Derived.TiTe << Derived.MOMLPotential;
+}
 
-// Print the inside and the outside of the tokamak
-/*
+//!< Read every field of the plasma data \p pd from \p in
+static void read_plasmadata(CheckpointReader &in, PlasmaData &pd){
+    DerivedPlasmaQuantities &Derived = pd.Derived;
+    in >> pd.NeutralDensity >> pd.ElectronDensity >> pd.IonDensity 
+        >> pd.IonTemp >> pd.ElectronTemp >> pd.NeutralTemp >> pd.AmbientTemp 
+        >> pd.mi >> pd.Z >> pd.A >> pd.PlasmaVel >> pd.Gravity 
+        >> pd.ElectricField >> pd.MagneticField >> Derived.DebyeLength 
+        >> Derived.IonThermalSpeed >> Derived.ElectronThermalFlux 
+        >> Derived.IonThermalFlux >> Derived.NeutralThermalFlux 
+        >> Derived.TiTe >> Derived.MOMLPotential;
+}
 
-//!< Function to return the sgn of val, true for positive, false for negative
-template <typename T> int sgn(T val) {
-    return (T(0) < val) - (val < T(0));
+void Model::write_checkpoint(CheckpointWriter &out)const{
+    Mo_Debug("\tIn Model::write_checkpoint(CheckpointWriter &out)const\n\n");
+    out << TimeStep << TotalTime << OldMass << FileName;
+    write_plasmadata(out,State->Pdata);
+    out << State->i << State->k << State->InGrid;
+    ModelDataFile.write_checkpoint(out);
+    PlasmaDataFile.write_checkpoint(out);
 }
 
-// Interpolate between grid points to determine plasma data
-const void Model::interpolatepdata(const int i,const int k)const{
-    Mo_Debug( "\tIn Model::interpolatepdata(const int i,const int k)const\n\n");
-    threevector vp1, vp2, E, B, gravity(0.0,0.0,-9.81);
+void Model::read_checkpoint(CheckpointReader &in){
+    Mo_Debug("\tIn Model::read_checkpoint(CheckpointReader &in)\n\n");
+    in >> TimeStep >> TotalTime >> OldMass >> FileName;
+    read_plasmadata(in,State->Pdata);
+    in >> State->i >> State->k >> State->InGrid;
+    ModelDataFile.read_checkpoint(in);
+    PlasmaDataFile.read_checkpoint(in);
+}
 
-    if( PG_data->dlx != PG_data->dlz ){
-        static bool runOnce = true;
-        WarnOnce(runOnce,"PlasmaGrid Interpolation only valid for square Grid! PG_data->dlx != PG_data->dlz!");
+void Model::write_deposition(CheckpointWriter &out)const{
+    Mo_Debug("\tIn Model::write_deposition(CheckpointWriter &out)const\n\n");
+    if( !get_deposition() ){
+        out << 0 << 0;
+        return;
     }
+    const MassDeposition &dm = *get_deposition();
+    out << dm.get_gridx() << dm.get_gridz();
+    for( int i = 0; i < dm.get_gridx(); i ++ )
+        for( int k = 0; k < dm.get_gridz(); k ++ )
+            out << dm.get(i,k);
+}
 
-    // Get the position of the dust as a decimal number of grid cells
-    double i_pos = 0.5+(Sample->get_position().getx()-PG_data->gridxmin)/PG_data->dlx;
-    double k_pos = 0.5+(Sample->get_position().getz()-PG_data->gridzmin)/PG_data->dlz;
-
-    // Calculate the distance to the relative (0,0) of the current square
-    double i_diff = i_pos - i;
-    double k_diff = k_pos - k;
-
-    // Calculate the SI distance to each edge (m)
-    double dx_1 = PG_data->dlx*(1-i_diff);
-    double dz_1 = PG_data->dlz*(1-k_diff);
-    double dx_2 = PG_data->dlx*i_diff;
-    double dz_2 = PG_data->dlz*k_diff;
-
-    // Calculate the normalisation
-    double Coeff = 1.0/sqrt(4.0*PG_data->dlx*PG_data->dlx+4.0*PG_data->dlz*PG_data->dlz);
-    
-    // If it is not edge, in which case we aren't in a square
-    if( PG_data->gridx >= i_pos && PG_data->gridz >= k_pos 
-        && 0 <= i_pos && 0 <= k_pos ){
-        std::cout << "\n\nCoeff = " << Coeff;
-        std::cout << "\ni = " << i;
-        std::cout << "\nk = " << k;
-        std::cout << "\ni_pos = " << i_pos;
-        std::cout << "\nk_pos = " << k_pos; 
-        std::cout << "\ni_diff = " << i_diff;
-        std::cout << "\nk_diff = " << k_diff;
-        std::cout << "\ni+sgn(i_diff) = " << i+1*sgn(i_diff);
-        std::cout << "\nk+sgn(k_diff) = " << k+1*sgn(k_diff);
-        std::cout << "\nPG_data->na0[" << i << "][" << k << "] = " << PG_data->na0[i][k]; 
-        std::cout << "\nPG_data->na0[" << i+sgn(i_diff) << "][" << k << "] = " << PG_data->na0[i+1*sgn(i_diff)][k]; 
-        std::cout << "\nPG_data->na0[" << i << "][" << k+sgn(k_diff) << "] = " << PG_data->na0[i][k+1*sgn(k_diff)]; 
-        std::cout << "\nPG_data->na0[" << i+sgn(i_diff) << "][" << k+sgn(k_diff) << "] = " << PG_data->na0[i+1*sgn(i_diff)][k+1*sgn(k_diff)];
-        std::cout << "\nsqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->na0[" << i << "][" << k << "] = " << sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->na0[i][k]; 
-        std::cout << "\nsqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->na0[" << i+sgn(i_diff) << "][" << k << "] = " << sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->na0[i+1*sgn(i_diff)][k]; 
-        std::cout << "\nsqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->na0[" << i << "][" << k+sgn(k_diff) << "] = " << sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->na0[i][k+1*sgn(k_diff)]; 
-        std::cout << "\nsqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->na0[" << i+sgn(i_diff) << "][" << k+sgn(k_diff) << "] = " << sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->na0[i+1*sgn(i_diff)][k+1*sgn(k_diff)]; std::cin.get();
-        std::cout << "\nPdata->IonDensity = " << Pdata->IonDensity;
-        Pdata->NeutralDensity   = Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->na2[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->na2[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->na2[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->na2[i+1*sgn(i_diff)][k+1*sgn(k_diff)]);
-        
-        Pdata->ElectronDensity  = Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->na1[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->na1[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->na1[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->na1[i+1*sgn(i_diff)][k+1*sgn(k_diff)]);
-
-        Pdata->IonDensity       = Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->na0[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->na0[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->na0[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->na0[i+1*sgn(i_diff)][k+1*sgn(k_diff)]);
-        
-
-        Pdata->IonTemp          = Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->Ti[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->Ti[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->Ti[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->Ti[i+1*sgn(i_diff)][k+1*sgn(k_diff)]);
-
-        Pdata->ElectronTemp     = Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->Te[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->Te[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->Te[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->Te[i+1*sgn(i_diff)][k+1*sgn(k_diff)]);
-
-        Pdata->NeutralTemp      = Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->Tn[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->Tn[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->Tn[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->Tn[i+1*sgn(i_diff)][k+1*sgn(k_diff)]);
-
-        Pdata->AmbientTemp      = Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->Ta[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->Ta[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->Ta[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->Ta[i+1*sgn(i_diff)][k+1*sgn(k_diff)]);
-        B.setx( Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->bx[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->bx[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->bx[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->bx[i+1*sgn(i_diff)][k+1*sgn(k_diff)]));
-
-        B.sety( Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->by[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->by[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->by[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->by[i+1*sgn(i_diff)][k+1*sgn(k_diff)]));
-
-        B.setz( Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->bz[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->bz[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->bz[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->bz[i+1*sgn(i_diff)][k+1*sgn(k_diff)]));
-
-        // Ion Plasma velocity parallel to the B field
-        vp1.setx(Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->ua0[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->ua0[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->ua0[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->ua0[i+1*sgn(i_diff)][k+1*sgn(k_diff)])*(B.getunit().getx()));
-        vp1.sety(Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->ua0[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->ua0[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->ua0[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->ua0[i+1*sgn(i_diff)][k+1*sgn(k_diff)])*(B.getunit().gety()));
-        vp1.setz(Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->ua0[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->ua0[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->ua0[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->ua0[i+1*sgn(i_diff)][k+1*sgn(k_diff)])*(B.getunit().getz()));
-
-        // Electron Plasma velocity parallel to the B field
-        vp2.setx(Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->ua1[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->ua1[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->ua1[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->ua1[i+1*sgn(i_diff)][k+1*sgn(k_diff)])*(B.getunit().getx()));
-        vp2.sety(Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->ua1[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->ua1[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->ua1[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->ua1[i+1*sgn(i_diff)][k+1*sgn(k_diff)])*(B.getunit().gety()));
-        vp2.setz(Coeff*(sqrt(dx_1*dx_1+dz_1*dz_1)*PG_data->ua1[i][k]
-                                +sqrt(dx_2*dx_2+dz_1*dz_1)*PG_data->ua1[i+1*sgn(i_diff)][k]
-                                +sqrt(dx_1*dx_1+dz_2*dz_2)*PG_data->ua1[i][k+1*sgn(k_diff)]
-                                +sqrt(dx_2*dx_2+dz_2*dz_2)*PG_data->ua1[i+1*sgn(i_diff)][k+1*sgn(k_diff)])*(B.getunit().getz()));
-
-    }else{
-        Pdata->NeutralDensity   = PG_data->na2[i][k];  
-        Pdata->ElectronDensity  = PG_data->na1[i][k];  
-        Pdata->IonDensity       = PG_data->na0[i][k];
-        Pdata->IonTemp          = PG_data->Ti[i][k];
-        Pdata->ElectronTemp     = PG_data->Te[i][k];
-        Pdata->NeutralTemp      = PG_data->Tn[i][k];
-        Pdata->AmbientTemp      = PG_data->Ta[i][k];
-
-        B.setx(PG_data->bx[i][k]);
-        B.sety(PG_data->by[i][k]);
-        B.setz(PG_data->bz[i][k]);
-
-        vp1.setx(PG_data->ua0[i][k]*(B.getunit().getx()));
-        vp1.sety(PG_data->ua0[i][k]*(B.getunit().gety()));
-        vp1.setz(PG_data->ua0[i][k]*(B.getunit().getz()));
-
-        vp2.setx(PG_data->ua1[i][k]*(B.getunit().getx()));
-        vp2.sety(PG_data->ua1[i][k]*(B.getunit().gety()));
-        vp2.setz(PG_data->ua1[i][k]*(B.getunit().getz()));
+void Model::read_deposition(CheckpointReader &in){
+    Mo_Debug("\tIn Model::read_deposition(CheckpointReader &in)\n\n");
+    int gridx(0), gridz(0);
+    in >> gridx >> gridz;
+    MassDeposition *dm = get_deposition();
+    int Nx = dm ? dm->get_gridx() : 0;
+    int Nz = dm ? dm->get_gridz() : 0;
+    if( gridx != Nx || gridz != Nz ){
+        in.fail();
+        return;
     }
-
-    E.setx(-(PG_data->po[i+1][k]-PG_data->po[i-1][k])/(2.0*PG_data->dlx));
-    E.sety(0.0);
-    E.setz(-(PG_data->po[i][k+1]-PG_data->po[i][k-1])/(2.0*PG_data->dlz));
-
-    
-    // Setup for Magnum-PSI
-    // For Magnum PSI, Gravity is not in -z direction but has a radial & Azimuthal
-    if( PG_data->device == 'p' ){ 
-        double Theta = Sample->get_position().gety();
-        gravity.setx(-1.0*gravity.mag3()*cos(Theta));
-        gravity.sety(gravity.mag3()*sin(Theta));
-        gravity.setz(0.0);
-    }else{
-        gravity = Pdata->Gravity;
+    for( int i = 0; i < Nx; i ++ ){
+        for( int k = 0; k < Nz; k ++ ){
+            double m(0.0);
+            in >> m;
+            dm->set(i,k,m);
+        }
     }
-    Pdata->PlasmaVel        = vp1;
-    Pdata->ElectricField    = E;
-    Pdata->MagneticField    = B;
-    Pdata->Gravity          = gravity;
 }
 
+// *************************************** Unused Code *************************************** //
+
+// Print the inside and the outside of the tokamak
+/*
 void Model::vtkcircle(double r, std::ofstream &fout){
     P_Debug("\tModel::vtkcircle(double r, std::ofstream &fout)\n\n");
     int i,imax;
@@ -32,6 +32,13 @@ const struct ElementConsts MolybdenumConsts = {
     0.138    //!< kW/m K at 20 degrees celsius
 };
 
+/** @brief Vapour pressure of molybdenum in Pa at \p Temperature
+ */
+static double vapourpressure(double Temperature){
+    return 101325*pow(10,11.529 -34626/Temperature -
+        1.1331*log10(Temperature));
+}
+
 Molybdenum::Molybdenum():
 Matter(MolybdenumConsts){
     E_Debug("\n\nIn Molybdenum::Molybdenum():Matter(MolybdenumConsts)\n\n");
@@ -207,15 +214,16 @@ void Molybdenum::update_vapourpressure(){
 double Molybdenum::probe_vapourpressure(double Temperature)const{
     E_Debug("\n\n\tIn Molybdenum::probe_vapourpressure(double Temperature)"
         << "const");
+    static const PropertyTable Table(vapourpressure,
+        {298,MolybdenumConsts.MeltingTemp},Tabulation::Arrhenius);
     double VapourPressure(0.0);
     
     if( Temperature < Ec.MeltingTemp ){
-        VapourPressure = 101325*pow(10,11.529 -34626/Temperature -
-            1.1331*log10(Temperature));
+        if( !Table.lookup(Temperature,VapourPressure) )
+            VapourPressure = vapourpressure(Temperature);
     }else{
-        VapourPressure = 101325*pow(10,11.529 -34626/Temperature -
-            1.1331*log10(Temperature));
-        static bool runOnce = true;
+        VapourPressure = vapourpressure(Temperature);
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Molybdenum::probe_vapourpressure():\n";
         WarningMessage += "Extending model outside temperature range!";
         WarningMessage += " ( from St.MeltingTemp > to St.BoilingTemp > )";
@@ -13,7 +13,7 @@ namespace Flux{
 //!< Introduction to Dusty Plasma Physics (CRC Press, 2015).
 //!< Equation (2.2.6) and (2.2.7).
 double OMLIonFlux(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential){
+        const PlasmaData &Pdata, const double Potential){
     PF_Debug("\n\t\tIn OMLIonFlux:Term()");
 
     double IonFlux(0.0);
@@ -22,14 +22,14 @@ double OMLIonFlux(const Matter* Sample,
         //!< P. K. Shukla and A. A. Mamun, 
         //!< Introduction to Dusty Plasma Physics (CRC Press, 2015).
         //!< Equation (2.2.6).
-        IonFlux = Pdata->IonDensity*sqrt(Kb*Pdata->IonTemp/(2*PI*Pdata->mi))*
-            (1+Pdata->Z*Potential*(Pdata->ElectronTemp/Pdata->IonTemp));
+        IonFlux = Pdata.Derived.IonThermalFlux*
+            (1+Pdata.Z*Potential/Pdata.Derived.TiTe);
     else
         //!< P. K. Shukla and A. A. Mamun, 
         //!< Introduction to Dusty Plasma Physics (CRC Press, 2015).
         //!< Equation (2.2.7).
-        IonFlux = Pdata->IonDensity*sqrt(Kb*Pdata->IonTemp/(2*PI*Pdata->mi))
-                *exp(Potential*(Pdata->ElectronTemp/Pdata->IonTemp));
+        IonFlux = Pdata.Derived.IonThermalFlux
+                *exp(Potential/Pdata.Derived.TiTe);
 
     //!< Sanity check sensible return value
     if(IonFlux >= Underflows::Flux && IonFlux != INFINITY && IonFlux == IonFlux 
@@ -37,16 +37,16 @@ double OMLIonFlux(const Matter* Sample,
         return IonFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
 
     std::string Warning = "\nError in OMLIonFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nOMLIonFlux() Return value: IonFlux = " << IonFlux);
-    PF_Debug("\nPdata->IonDensity*sqrt(Kb*Pdata->IonTemp/(2*PI*Pdata->mi))= " 
-        << Pdata->IonDensity*sqrt(Kb*Pdata->IonTemp/(2*PI*Pdata->mi)));
-    PF_Debug("\nPotential*(Pdata->ElectronTemp/Pdata->IonTemp)= " 
-        << Potential*(Pdata->ElectronTemp/Pdata->IonTemp));
+    PF_Debug("\nPdata.IonDensity*sqrt(Kb*Pdata.IonTemp/(2*PI*Pdata.mi))= " 
+        << Pdata.IonDensity*sqrt(Kb*Pdata.IonTemp/(2*PI*Pdata.mi)));
+    PF_Debug("\nPotential*(Pdata.ElectronTemp/Pdata.IonTemp)= " 
+        << Potential*(Pdata.ElectronTemp/Pdata.IonTemp));
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -58,20 +58,17 @@ double OMLIonFlux(const Matter* Sample,
 //!< Equation (3).
 //!< For positively charged dust, we resort to OML
 double MOMLIonFlux(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential){
+        const PlasmaData &Pdata, const double Potential){
     PF_Debug("\n\t\tIn MOMLIonFlux:Term()");
 
     double IonFlux(0.0);
-    double HeatCapacityRatio(5.0/3.0);
 
     if( Potential >= 0 ){
         //!< C. T. N. Willis, M. Coppins, M. Bacharis, and J. E. Allen, 
         //!< Phys. Rev. E - Stat. Nonlinear, Soft Matter Phys. 85, (2012).
         //!< Equation (3).
-        IonFlux = Pdata->IonDensity*sqrt(Kb*Pdata->IonTemp/(2*PI*Pdata->mi))
-            *(1.0-(Pdata->ElectronTemp/Pdata->IonTemp)*
-            (-Pdata->Z*Potential-0.5*log((2.0*PI*Me/Pdata->mi)*
-            (1.0+HeatCapacityRatio*Pdata->IonTemp/Pdata->ElectronTemp))));
+        IonFlux = Pdata.Derived.IonThermalFlux*(1.0-(1.0/Pdata.Derived.TiTe)*
+            (-Pdata.Z*Potential-Pdata.Derived.MOMLPotential));
     }else
         //!< For positively charged dust, we resort to OML
         IonFlux = OMLIonFlux(Sample,Pdata,Potential);
@@ -81,20 +78,17 @@ double MOMLIonFlux(const Matter* Sample,
         return IonFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in MOMLIonFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nMOMLIonFlux() Return value: IonFlux = " << IonFlux);
-    PF_Debug("\nPdata->IonDensity*sqrt(Kb*Pdata->IonTemp/(2*PI*Pdata->mi))= " 
-        << Pdata->IonDensity*sqrt(Kb*Pdata->IonTemp/(2*PI*Pdata->mi)));
-    PF_Debug("\n(Pdata->ElectronTemp/Pdata->IonTemp)= " 
-        << (Pdata->ElectronTemp/Pdata->IonTemp));
-    PF_Debug("\nPdata->Z*Potential = " << Pdata->Z*Potential);
-    PF_Debug("\nlog( arg ) = " << log((2.0*PI*Me/Pdata->mi)*
-        (1.0+HeatCapacityRatio*Pdata->IonTemp/Pdata->ElectronTemp)));
-    PF_Debug("\narg = " << (2.0*PI*Me/Pdata->mi)*
-        (1.0+HeatCapacityRatio*Pdata->IonTemp/Pdata->ElectronTemp));
+    PF_Debug("\nPdata.IonDensity*sqrt(Kb*Pdata.IonTemp/(2*PI*Pdata.mi))= " 
+        << Pdata.IonDensity*sqrt(Kb*Pdata.IonTemp/(2*PI*Pdata.mi)));
+    PF_Debug("\n(Pdata.ElectronTemp/Pdata.IonTemp)= " 
+        << (Pdata.ElectronTemp/Pdata.IonTemp));
+    PF_Debug("\nPdata.Z*Potential = " << Pdata.Z*Potential);
+    PF_Debug("\n0.5*log( arg ) = " << Pdata.Derived.MOMLPotential);
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -117,16 +111,15 @@ double MOMLIonFlux(const Matter* Sample,
 
 //!< For the case of no flow, to avoid dividing by zero we return OMLIonFlux.
 double SOMLIonFlux(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential){
+        const PlasmaData &Pdata, const double Potential){
     PF_Debug( "\n\t\tIn SOMLIonFlux:Term()\n\n");
     
-    //!< Calculate the Ion Thermal Velocity
-    double IonThermalVelocity = sqrt((2.0*Kb*Pdata->IonTemp)/Pdata->mi);
+    double IonThermalVelocity = Pdata.Derived.IonThermalSpeed;
     //!< uz is the relative velocity normalised to ion thermal speed
-    double uz = (Pdata->PlasmaVel-Sample->get_velocity()).mag3()
+    double uz = (Pdata.PlasmaVel-Sample->get_velocity()).mag3()
         /IonThermalVelocity;
     //!< Tau is the ion to electron temperature ratio
-    double Tau = Pdata->IonTemp/Pdata->ElectronTemp;
+    double Tau = Pdata.Derived.TiTe;
     double IonFlux(0.0);
     if( uz == 0.0 ){
         //!< For no flow case, avoid dividing by zero return OMLIonFlux.
@@ -144,45 +137,45 @@ double SOMLIonFlux(const Matter* Sample,
             double s1 = sqrt(PI)*(1.0+2.0*uz*uz)*erf(uz)/(4.0*uz)+
                 exp(-uz*uz)/2.0;
             double s2 = sqrt(PI)*erf(uz)/(2.0*uz);
-            IonFlux = Pdata->IonDensity*
+            IonFlux = Pdata.IonDensity*
                 (IonThermalVelocity/sqrt(4.0*PI))*
-                (s1+s2*Pdata->Z*Potential/Tau);
+                (s1+s2*Pdata.Z*Potential/Tau);
         }else{
             //!< For the case of positively charged dust:
             //!< R. D. Smirnov, A. Y. Pigarov, M. Rosenberg, 
             //!< S. I. Krasheninnikov, and D. a Mendis, Plasma Phys. Control. 
             //!< Fusion 49, 347 (2007).
             //!< Equation (2).
-            double uzp = uz+sqrt(-Pdata->Z*Potential/Tau);
-            double uzm = uz-sqrt(-Pdata->Z*Potential/Tau);
-            IonFlux = Pdata->IonDensity*IonThermalVelocity*
+            double uzp = uz+sqrt(-Pdata.Z*Potential/Tau);
+            double uzm = uz-sqrt(-Pdata.Z*Potential/Tau);
+            IonFlux = Pdata.IonDensity*IonThermalVelocity*
                 (1.0/(4.0*uz))*
-                ((1.0+2.0*(uz*uz+Pdata->Z*Potential/Tau))*
+                ((1.0+2.0*(uz*uz+Pdata.Z*Potential/Tau))*
                 (erf(uzp)+erf(uzm))+(2.0/sqrt(PI))*
                 (uzp*exp(-uzm*uzm)+uzm*exp(-uzp*uzp)));
         }
     }
-    PF_Debug("\nPdata->IonDensity = " << Pdata->IonDensity);
+    PF_Debug("\nPdata.IonDensity = " << Pdata.IonDensity);
     PF_Debug("\nIonThermalVelocity = " << IonThermalVelocity);
     PF_Debug("\nuz = " << uz);
     PF_Debug("\nTau = " << Tau);
-    PF_Debug("\nPdata->Z*Potential = " << Pdata->Z*Potential);
+    PF_Debug("\nPdata.Z*Potential = " << Pdata.Z*Potential);
     //!< Sanity check sensible return value
     if(IonFlux >= Underflows::Flux && IonFlux != INFINITY && IonFlux == IonFlux 
         && IonFlux < Overflows::Flux ){
         return IonFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in SOMLIonFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nSOMLIonFlux() Return value: IonFlux = " << IonFlux);
-    PF_Debug("\nPdata->IonDensity = " << Pdata->IonDensity);
+    PF_Debug("\nPdata.IonDensity = " << Pdata.IonDensity);
     PF_Debug("\nIonThermalVelocity = " << IonThermalVelocity);
     PF_Debug("\nuz = " << uz);
     PF_Debug("\nTau = " << Tau);
-    PF_Debug("\nPdata->Z*Potential = " << Pdata->Z*Potential);
+    PF_Debug("\nPdata.Z*Potential = " << Pdata.Z*Potential);
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -197,16 +190,14 @@ double SOMLIonFlux(const Matter* Sample,
 //!< For no flow case, avoid dividing by zero return MOMLIonFlux.
 //!< For Positive dust case, do SOML
 double SMOMLIonFlux(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential){
+        const PlasmaData &Pdata, const double Potential){
     PF_Debug( "\n\t\tIn SMOMLIonFlux:Term()\n\n");
-    double MassRatio = Pdata->mi/Me;
-    //!< Calculate the Ion Thermal Velocity
-    double IonThermalVelocity = sqrt((2.0*Kb*Pdata->IonTemp)/Pdata->mi);
+    double IonThermalVelocity = Pdata.Derived.IonThermalSpeed;
     //!< uz is the relative velocity normalised to ion thermal speed
-    double uz = (Pdata->PlasmaVel-Sample->get_velocity()).mag3()
+    double uz = (Pdata.PlasmaVel-Sample->get_velocity()).mag3()
         /IonThermalVelocity;
     //!< Tau is the ion to electron temperature ratio
-    double Tau = Pdata->IonTemp/Pdata->ElectronTemp;
+    double Tau = Pdata.Derived.TiTe;
     double IonFlux(0.0);
     if( uz == 0.0 ){ 
         //!< For no flow case, avoid dividing by zero return MOMLIonFlux.
@@ -217,13 +208,12 @@ double SMOMLIonFlux(const Matter* Sample,
             //!< D. Thomas, Theory and Simulation of the Charging of Dust in 
             //!< Plasmas, 2016.
             //!< Equation (2.133), (2.133) and (2.139)
-            double HeatCapacityRatio = 5.0/3.0;
             double s1 = sqrt(PI)*(1.0+2.0*uz*uz)*erf(uz)/(4.0*uz)+
                 exp(-uz*uz)/2.0;
             double s2 = sqrt(PI)*erf(uz)/(2.0*uz);
-            IonFlux = Pdata->IonDensity*(IonThermalVelocity/sqrt(4.0*PI))*
-                (s1-(s2/Tau)*(-Potential*Pdata->Z-
-                0.5*log(2.0*PI*(1.0+HeatCapacityRatio*Tau)/MassRatio)));
+            IonFlux = Pdata.IonDensity*(IonThermalVelocity/sqrt(4.0*PI))*
+                (s1-(s2/Tau)*(-Potential*Pdata.Z-
+                Pdata.Derived.MOMLPotential));
         }else{ 
             //!< For Positive dust, resort to SOML
             IonFlux = Flux::SOMLIonFlux(Sample,Pdata,Potential);
@@ -235,17 +225,17 @@ double SMOMLIonFlux(const Matter* Sample,
         return IonFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in SMOMLIonFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nSMOMLIonFlux() Return value: IonFlux = " << IonFlux);
-    PF_Debug("\nPdata->IonDensity = " << Pdata->IonDensity);
+    PF_Debug("\nPdata.IonDensity = " << Pdata.IonDensity);
     PF_Debug("\nIonThermalVelocity = " << IonThermalVelocity);
     PF_Debug("\nuz = " << uz);
-    PF_Debug("\nMassRatio = " << MassRatio);
+    PF_Debug("\nMassRatio = " << Pdata.mi/Me);
     PF_Debug("\nTau = " << Tau);
-    PF_Debug("\nPdata->Z*Potential = " << Pdata->Z*Potential);
+    PF_Debug("\nPdata.Z*Potential = " << Pdata.Z*Potential);
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -257,30 +247,28 @@ double SMOMLIonFlux(const Matter* Sample,
 
 //!< For Positive dust case, do OML
 double PHLElectronFlux(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential){
+        const PlasmaData &Pdata, const double Potential){
     PF_Debug( "\n\t\tIn PHLElectronFlux:Term()\n\n");
 
     //!< Tau is the ion to electron temperature ratio
-    double Tau = Pdata->ElectronTemp/Pdata->IonTemp;
+    double Tau = Pdata.ElectronTemp/Pdata.IonTemp;
     //!< Beta is the dust radius to ion gyro-radius ratio
     double Beta = Sample->get_radius()
-            /(sqrt(PI*Pdata->ElectronTemp*Me)/(2.0*echarge*echarge*
-            Pdata->MagneticField*Pdata->MagneticField));
-    double MassRatio = Pdata->mi/Me;
+            /(sqrt(PI*Pdata.ElectronTemp*Me)/(2.0*echarge*echarge*
+            Pdata.MagneticField*Pdata.MagneticField));
+    double MassRatio = Pdata.mi/Me;
 
     if( Beta/MassRatio > 0.01 ){
         //!< PHL give a limited range for their model
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string Warning = "Beta/MassRatio > 0.01 in solvePHL! Model may ";
         Warning += "not be valid in this range! see Fig 11. of  L. Patacchini,";
         Warning += " I. H. Hutchinson, and G. Lapenta, ";
         Warning += "Phys. Plasmas 14, (2007).";
         WarnOnce(runOnce,Warning);
     }
-    double AtomicNumber = Pdata->Z; 
-    //!< Calculate the electron debye length of the plasma
-    double DebyeLength=sqrt((epsilon0*Kb*Pdata->ElectronTemp)
-        /(Pdata->ElectronDensity*pow(echarge,2)));
+    double AtomicNumber = Pdata.Z; 
+    double DebyeLength = Pdata.Derived.DebyeLength;
 
     //!< Calculate the result of equation (8)
     double z = Beta/(1.0+Beta);
@@ -309,8 +297,7 @@ double PHLElectronFlux(const Matter* Sample,
     if( Potential >= 0.0 ){ 
         //!< For negatively charged dust, the formula can be found in:
         //!< Solve equation (13)
-        ElecFlux = Pdata->ElectronDensity*
-            sqrt(Kb*Pdata->ElectronTemp/(2.0*PI*Me))*(A+(1.0-A)*i_star)*
+        ElecFlux = Pdata.Derived.ElectronThermalFlux*(A+(1.0-A)*i_star)*
             exp(-Potential);
     }else{ //!< For positive dust, do OML
         ElecFlux = Flux::OMLElectronFlux(Pdata,Potential);
@@ -321,7 +308,7 @@ double PHLElectronFlux(const Matter* Sample,
         return ElecFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in PHLElectronFlux()!";
     Warning += " Return value badly specified\nReturning zero!\n";
     WarnOnce(runOnce,Warning);
@@ -333,7 +320,7 @@ double PHLElectronFlux(const Matter* Sample,
 //!< M. Bacharis, M. Coppins, and J. E. Allen, Phys. Plasmas 17, (2010).
 //!< Equations (8), (9) and (10)
 double DTOKSIonFlux(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential){
+        const PlasmaData &Pdata, const double Potential){
     PF_Debug("\n\t\tIn DTOKSIonFlux:Term()\n\n");
     double IonFlux=0;
 
@@ -349,7 +336,7 @@ double DTOKSIonFlux(const Matter* Sample,
         return IonFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in DTOKSIonFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
@@ -364,27 +351,26 @@ double DTOKSIonFlux(const Matter* Sample,
 //!< The equations defining the flux can be found in:
 //!< M. Bacharis, M. Coppins, and J. E. Allen, Phys. Plasmas 17, (2010).
 //!< Equations (8), (9) and (10)
-double DTOKSElectronFlux(const std::shared_ptr<PlasmaData> Pdata, 
+double DTOKSElectronFlux(const PlasmaData &Pdata, 
         const double Potential){
     PF_Debug("\n\t\tIn DTOKSElectronFlux:Term()\n\n");
     double ElecFlux(0.0);
 
-    ElecFlux = Pdata->ElectronDensity*exp(-Potential)*
-        sqrt(Kb*Pdata->ElectronTemp/(2*PI*Me));
+    ElecFlux = Pdata.Derived.ElectronThermalFlux*exp(-Potential);
 
     if(ElecFlux >= Underflows::Flux && ElecFlux != INFINITY 
         && ElecFlux == ElecFlux && ElecFlux < Overflows::Flux ){
         return ElecFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in DTOKSElectronFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nDTOKSElectronFlux() Return value: ElecFlux = " << ElecFlux);
-    PF_Debug("\nElectronThermalVel = " << sqrt(Kb*Pdata->ElectronTemp/(2*PI*Me)));
+    PF_Debug("\nElectronThermalVel = " << sqrt(Kb*Pdata.ElectronTemp/(2*PI*Me)));
     PF_Debug("\nPotential = " << Potential);
-    PF_Debug("\nDensity = " << Pdata->ElectronDensity);
+    PF_Debug("\nDensity = " << Pdata.ElectronDensity);
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -394,7 +380,7 @@ double DTOKSElectronFlux(const std::shared_ptr<PlasmaData> Pdata,
 //!< P. K. Shukla and A. A. Mamun, 
 //!< Introduction to Dusty Plasma Physics (CRC Press, 2015).
 //!< Equation (2.2.6) and (2.2.7).
-double OMLElectronFlux(const std::shared_ptr<PlasmaData> Pdata, 
+double OMLElectronFlux(const PlasmaData &Pdata, 
         const double Potential){
     PF_Debug("\n\t\tIn OMLElectronFlux:Term()\n\n");
 
@@ -403,14 +389,12 @@ double OMLElectronFlux(const std::shared_ptr<PlasmaData> Pdata,
         //!< P. K. Shukla and A. A. Mamun, 
         //!< Introduction to Dusty Plasma Physics (CRC Press, 2015).
         //!< Equation (2.2.6).
-        ElecFlux = Pdata->ElectronDensity*
-            sqrt(Kb*Pdata->ElectronTemp/(2*PI*Me))*(1-Potential);
+        ElecFlux = Pdata.Derived.ElectronThermalFlux*(1-Potential);
     else
         //!< P. K. Shukla and A. A. Mamun, 
         //!< Introduction to Dusty Plasma Physics (CRC Press, 2015).
         //!< Equation (2.2.7).
-        ElecFlux = Pdata->ElectronDensity*exp(-Potential)*
-            sqrt(Kb*Pdata->ElectronTemp/(2*PI*Me));
+        ElecFlux = Pdata.Derived.ElectronThermalFlux*exp(-Potential);
     
     //!< Sanity check sensible return value
     if(ElecFlux >= Underflows::Flux && ElecFlux != INFINITY 
@@ -418,15 +402,15 @@ double OMLElectronFlux(const std::shared_ptr<PlasmaData> Pdata,
         return ElecFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in OMLElectronFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nOMLElectronFlux() Return value: ElecFlux = " << ElecFlux);
-    PF_Debug("\nElectronThermalVel = " << sqrt(Kb*Pdata->ElectronTemp/(2*PI*Me)));
-    PF_Debug("\nElectronTemp = " << Pdata->ElectronTemp);
+    PF_Debug("\nElectronThermalVel = " << sqrt(Kb*Pdata.ElectronTemp/(2*PI*Me)));
+    PF_Debug("\nElectronTemp = " << Pdata.ElectronTemp);
     PF_Debug("\nPotential = " << Potential);
-    PF_Debug("\nDensity = " << Pdata->ElectronDensity);
+    PF_Debug("\nDensity = " << Pdata.ElectronDensity);
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -436,11 +420,10 @@ double OMLElectronFlux(const std::shared_ptr<PlasmaData> Pdata,
 //!< A. Y. Pigarov, S. I. Krasheninnikov, T. K. Soboleva, and T. D. Rognlien, 
 //!< Phys. Plasmas 12, 1 (2005).
 //!< Pg. 7, top right hand side of page
-double NeutralFlux(const std::shared_ptr<PlasmaData> Pdata){
+double NeutralFlux(const PlasmaData &Pdata){
     PF_Debug("\n\t\tIn NeutralFlux:Term()\n\n");
 
-    double NeutFlux = Pdata->NeutralDensity*
-            sqrt(Kb*Pdata->NeutralTemp/(2*PI*Pdata->mi));
+    double NeutFlux = Pdata.Derived.NeutralThermalFlux;
 
     //!< Sanity check sensible return value
     if(NeutFlux >= Underflows::Flux && NeutFlux != INFINITY 
@@ -448,13 +431,13 @@ double NeutralFlux(const std::shared_ptr<PlasmaData> Pdata){
         return NeutFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in NeutralFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nNeutralFlux() Return value: NeutFlux = " << NeutFlux);
-    PF_Debug("\nNeutralThermalVel = " << sqrt(Kb*Pdata->NeutralTemp/(2*PI*Pdata->mi)));
-    PF_Debug("\nDensity = " << Pdata->NeutralDensity);
+    PF_Debug("\nNeutralThermalVel = " << sqrt(Kb*Pdata.NeutralTemp/(2*PI*Pdata.mi)));
+    PF_Debug("\nDensity = " << Pdata.NeutralDensity);
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -465,9 +448,9 @@ double NeutralFlux(const std::shared_ptr<PlasmaData> Pdata){
 //!< Equation (35)
 //!< Note here that the ambient vapour pressure has also been accounted for
 double EvaporationFlux(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double DustTemperature){
+        const PlasmaData &Pdata, const double DustTemperature){
     PF_Debug("\n\t\tIn EvaporationFlux:Term()\n\n");
-    double AmbientPressure = Pdata->NeutralDensity*Kb*Pdata->NeutralTemp;
+    double AmbientPressure = Pdata.NeutralDensity*Kb*Pdata.NeutralTemp;
 
     double StickCoeff = 1.0;
     double EvapFlux = (StickCoeff*Sample->get_surfacearea()*AvNo*
@@ -481,7 +464,7 @@ double EvaporationFlux(const Matter* Sample,
         return EvapFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in EvaporationFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
@@ -502,7 +485,7 @@ double EvaporationFlux(const Matter* Sample,
 //!< The equations defining the yield can be found in:
 //!< M. Bacharis, M. Coppins, and J. E. Allen, Phys. Plasmas 17, (2010).
 //!< Equations (5) and (7)
-double DeltaTherm(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata){
+double DeltaTherm(const Matter* Sample, const PlasmaData &Pdata){
     C_Debug("\n\t\tIn DeltaTherm:Term()\n\n");
 
     double dtherm = (Richardson*Sample->get_temperature()*
@@ -515,7 +498,7 @@ double DeltaTherm(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata)
         return dtherm;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in DeltaTherm()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
@@ -551,7 +534,7 @@ double ThermFlux(const Matter* Sample){
         return ThermFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in ThermFlux()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
@@ -574,7 +557,7 @@ double ThermFlux(const Matter* Sample){
 //!< D. a Mendis, Plasma Phys. Control. Fusion 49, 347 (2007).
 //!< Equation (3) with zero potential
 double ThermFluxSchottky(const Matter* Sample, 
-        const std::shared_ptr<PlasmaData> Pdata, const double Potential ){
+        const PlasmaData &Pdata, const double Potential ){
     C_Debug("\n\t\tIn DeltaTherm:Term()\n\n");
     //!< Returns the flux of electrons due to Thermionic emission
     //!< Following the Richard-Dushmann formula with Schottky Correction.
@@ -591,9 +574,9 @@ double ThermFluxSchottky(const Matter* Sample,
 
         ThermFlux = Richardson*Sample->get_temperature()*
             Sample->get_temperature()*(1.0-Potential
-            *(Pdata->ElectronTemp/Sample->get_temperature()))
+            *(Pdata.ElectronTemp/Sample->get_temperature()))
             *exp((-echarge*Sample->get_workfunction()-
-            Potential*Kb*Pdata->ElectronTemp)/(Kb*Sample->get_temperature()))/
+            Potential*Kb*Pdata.ElectronTemp)/(Kb*Sample->get_temperature()))/
             echarge;
     }
     //!< Sanity check sensible return value
@@ -602,7 +585,7 @@ double ThermFluxSchottky(const Matter* Sample,
         return ThermFlux;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in ThermFluxSchottky()!";
     Warning += " Return value badly specified\n";
     WarnOnce(runOnce,Warning);
@@ -612,11 +595,11 @@ double ThermFluxSchottky(const Matter* Sample,
     PF_Debug("\nSample->get_workfunction() = " << Sample->get_workfunction());
     PF_Debug("\nSample->get_temperature() = " << Sample->get_temperature());
     PF_Debug("\nPotential = " << Potential);
-    PF_Debug("\nTe/Td = " << (Pdata->ElectronTemp/Sample->get_temperature()));
+    PF_Debug("\nTe/Td = " << (Pdata.ElectronTemp/Sample->get_temperature()));
     PF_Debug("\nexp( arg ) = " << exp((-echarge*Sample->get_workfunction()-
-            Potential*Kb*Pdata->ElectronTemp)/(Kb*Sample->get_temperature())));
+            Potential*Kb*Pdata.ElectronTemp)/(Kb*Sample->get_temperature())));
     PF_Debug("\narg = " << (-echarge*Sample->get_workfunction()-
-            Potential*Kb*Pdata->ElectronTemp)/(Kb*Sample->get_temperature()));
+            Potential*Kb*Pdata.ElectronTemp)/(Kb*Sample->get_temperature()));
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
@@ -625,25 +608,25 @@ double ThermFluxSchottky(const Matter* Sample,
 //!< The equations defining the yield can be found in:
 //!< M. Bacharis, M. Coppins, and J. E. Allen, Phys. Plasmas 17, (2010).
 //!< Equation (1-4)
-double DeltaSec(const Matter* Sample, const std::shared_ptr<PlasmaData> Pdata){
+double DeltaSec(const Matter* Sample, const PlasmaData &Pdata){
     C_Debug("\n\t\tIn DeltaSec:Term()\n\n");
     double ConvertKtoev(8.6173303e-5);
-    double DeltaSec = sec(Pdata->ElectronTemp*ConvertKtoev,Sample->get_elem());
+    double DeltaSec = sec(Pdata.ElectronTemp*ConvertKtoev,Sample->get_elem());
     //!< Sanity check sensible return value
     if(DeltaSec >= 0.0 && DeltaSec == DeltaSec && DeltaSec != INFINITY ){
         return DeltaSec;
     }
     //!< If return value is not well defined, print error and return 0.
-    static bool runOnce = true;
+    static std::atomic<bool> runOnce(true);
     std::string Warning = "\nError in DeltaSec()!";
     Warning += " Return value badly specified\nReturning zero!\n";
     WarnOnce(runOnce,Warning);
     PF_Debug("\n\nDeltaSec() Return value: DeltaSec = " << DeltaSec);
     PF_Debug("\nSample->get_elem() = " << Sample->get_elem());
-    PF_Debug("\nPdata->ElectronTemp*ConvertKtoev = " 
-        << Pdata->ElectronTemp*ConvertKtoev);
-    PF_Debug("\nsec(Pdata->ElectronTemp*ConvertKtoev,Sample->get_elem()) = " 
-        << sec(Pdata->ElectronTemp*ConvertKtoev,Sample->get_elem()));
+    PF_Debug("\nPdata.ElectronTemp*ConvertKtoev = " 
+        << Pdata.ElectronTemp*ConvertKtoev);
+    PF_Debug("\nsec(Pdata.ElectronTemp*ConvertKtoev,Sample->get_elem()) = " 
+        << sec(Pdata.ElectronTemp*ConvertKtoev,Sample->get_elem()));
     PF_Debug("\nReturning zero!\n");
     return 0.0;
 }
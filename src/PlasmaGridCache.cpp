@@ -0,0 +1,351 @@
+/** @file PlasmaGridCache.cpp
+ *  @brief Implementation of the binary cache of a plasma grid
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <fstream>
+#include <array>
+#include <cstdio>
+#include <cstdint>
+#include <sys/mman.h>   //!< mmap()
+#include <sys/stat.h>   //!< stat()
+#include <fcntl.h>      //!< open()
+#include <unistd.h>     //!< close()
+
+#include "PlasmaGridCache.h"
+#include "Constants.h"
+
+namespace{
+//!< Identifies a grid cache, followed by the format version
+const char GridCacheMagic[8] = {'D','T','O','K','S','G','R','D'};
+const uint32_t GridCacheVersion = 2;
+//!< Written in native byte order so that the reader can detect a mismatch
+const uint32_t ByteOrderMark = 0x01020304;
+const unsigned int NumDoubleFields = 20;
+//!< The double fields, gridflag, Cells and Stencils
+const unsigned int NumSections = NumDoubleFields+3;
+const unsigned int MaxSources = 4;
+
+/** @brief The header at the start of every grid cache
+ *
+ *  The grid and the inputs it was made from, followed by the offset in bytes
+ *  and number of cells of each field. \p HeaderChecksum covers the header
+ *  with itself zeroed, \p DataChecksum every byte after the header.
+ */
+struct GridCacheHeader{
+    char Magic[8];
+    uint32_t Version;
+    uint32_t ByteOrder;
+    uint32_t HeaderSize;    //!< sizeof(GridCacheHeader), guards the layout
+    uint32_t CellSize;      //!< sizeof(PlasmaCell), guards the layout
+    int32_t gridx;
+    int32_t gridz;
+    int32_t gridtheta;
+    int32_t ReadStatus;     //!< Status returned when reading the grid
+    char device;
+    char interpolation;
+    char Padding[6];
+    double gridxmin;
+    double gridxmax;
+    double gridzmin;
+    double gridzmax;
+    double dlx;
+    double dlz;
+    double AmbientTemp;     //!< K, ambient temperature of every cell
+    double NeutralTemp;     //!< K, neutral temperature of every cell
+    double NeutralDensity;  //!< m^-3, neutral density of every cell
+    uint64_t NumSources;
+    uint64_t SourceSize[MaxSources];    //!< Bytes of each source file
+    int64_t SourceTime[MaxSources];     //!< Modification time of each, s
+    int64_t SourceTimeNsec[MaxSources]; //!< and its nanoseconds
+    uint64_t Offset[NumSections];
+    uint64_t Count[NumSections];
+    uint64_t FileSize;
+    uint64_t DataChecksum;
+    uint64_t HeaderChecksum;
+};
+
+//!< Bytes before the first field, which starts aligned
+const size_t DataStart = (sizeof(GridCacheHeader)+GridAlignment-1)
+    /GridAlignment*GridAlignment;
+
+/** @brief 64 bit checksum of a stream of bytes
+ *
+ *  FNV-1a over 64 bit words in four independent lanes, so that checking a
+ *  large grid costs little more than reading it.
+ */
+class GridChecksum{
+    private:
+        static const uint64_t Prime = 0x100000001b3ULL;
+        uint64_t Lanes[4];
+        char Pending[32];       //!< Bytes waiting for a whole block
+        size_t NumPending;
+        uint64_t Length;
+
+        static void block(uint64_t *lanes, const char *data){
+            for( unsigned int l = 0; l < 4; l ++ ){
+                uint64_t Word;
+                std::memcpy(&Word,data+8*l,8);
+                uint64_t Mixed = (lanes[l]^Word)*Prime;
+                lanes[l] = (Mixed<<29)|(Mixed>>35);
+            }
+        }
+
+    public:
+        GridChecksum():NumPending(0),Length(0){
+            for( unsigned int l = 0; l < 4; l ++ )
+                Lanes[l] = 0xcbf29ce484222325ULL+l;
+        }
+
+        void add(const char *data, size_t length){
+            Length += length;
+            while( NumPending > 0 && length > 0 ){
+                Pending[NumPending++] = *data++;
+                length --;
+                if( NumPending == sizeof(Pending) ){
+                    block(Lanes,Pending);
+                    NumPending = 0;
+                }
+            }
+            //!< Local lanes, as the bytes read could otherwise alias them
+            uint64_t Local[4] = {Lanes[0],Lanes[1],Lanes[2],Lanes[3]};
+            for( ; length >= sizeof(Pending); length -= sizeof(Pending) ){
+                block(Local,data);
+                data += sizeof(Pending);
+            }
+            std::memcpy(Lanes,Local,sizeof(Lanes));
+            std::memcpy(Pending,data,length);
+            NumPending = length;
+        }
+
+        uint64_t value(){
+            if( NumPending > 0 ){
+                std::memset(Pending+NumPending,0,sizeof(Pending)-NumPending);
+                block(Lanes,Pending);
+                NumPending = 0;
+            }
+            uint64_t Value = Length;
+            for( unsigned int l = 0; l < 4; l ++ )
+                Value = (Value^Lanes[l])*Prime;
+            return Value;
+        }
+};
+
+//!< Every field of doubles of \p pgrid, in the order they are cached
+template<typename Grid> auto double_fields(Grid &pgrid)
+-> std::array<decltype(&pgrid.Te),NumDoubleFields>{
+    return {{ &pgrid.Te, &pgrid.Ti, &pgrid.Tn, &pgrid.Ta, &pgrid.na0,
+        &pgrid.na1, &pgrid.na2, &pgrid.po, &pgrid.ua0, &pgrid.ua1, &pgrid.bx,
+        &pgrid.by, &pgrid.bz, &pgrid.x, &pgrid.z, &pgrid.Er, &pgrid.Ez,
+        &pgrid.vpx, &pgrid.vpy, &pgrid.vpz }};
+}
+
+//!< Size in bytes of a cell of each section
+uint64_t section_cellsize(unsigned int n){
+    if( n < NumDoubleFields ) return sizeof(double);
+    if( n == NumDoubleFields ) return sizeof(int);
+    if( n == NumDoubleFields+1 ) return sizeof(PlasmaCell);
+    return sizeof(char);
+}
+
+//!< Fill the grid and input fields of \p header, which is zeroed
+void fill_key(GridCacheHeader &header, const PlasmaGrid_Data &pgrid,
+const PlasmaData &pdata, const std::vector<std::string> &sources){
+    std::memset(&header,0,sizeof(header));
+    std::memcpy(header.Magic,GridCacheMagic,sizeof(GridCacheMagic));
+    header.Version = GridCacheVersion;
+    header.ByteOrder = ByteOrderMark;
+    header.HeaderSize = sizeof(GridCacheHeader);
+    header.CellSize = sizeof(PlasmaCell);
+    header.gridx = pgrid.gridx;
+    header.gridz = pgrid.gridz;
+    header.gridtheta = pgrid.gridtheta;
+    header.device = pgrid.device;
+    header.interpolation = pgrid.interpolation;
+    header.gridxmin = pgrid.gridxmin;
+    header.gridxmax = pgrid.gridxmax;
+    header.gridzmin = pgrid.gridzmin;
+    header.gridzmax = pgrid.gridzmax;
+    header.dlx = pgrid.dlx;
+    header.dlz = pgrid.dlz;
+    header.AmbientTemp = pdata.AmbientTemp;
+    header.NeutralTemp = pdata.NeutralTemp;
+    header.NeutralDensity = pdata.NeutralDensity;
+    header.NumSources = sources.size();
+    for( unsigned int s = 0; s < sources.size() && s < MaxSources; s ++ ){
+        struct stat Status;
+        if( stat(sources[s].c_str(),&Status) != 0 ){
+            header.SourceTime[s] = -1;
+            continue;
+        }
+        header.SourceSize[s] = Status.st_size;
+        header.SourceTime[s] = Status.st_mtim.tv_sec;
+        header.SourceTimeNsec[s] = Status.st_mtim.tv_nsec;
+    }
+}
+
+//!< Checksum of \p header with its own checksum zeroed
+uint64_t header_checksum(GridCacheHeader header){
+    header.HeaderChecksum = 0;
+    GridChecksum Sum;
+    Sum.add(reinterpret_cast<const char*>(&header),sizeof(header));
+    return Sum.value();
+}
+}
+
+int write_gridcache(const PlasmaGrid_Data &pgrid, const PlasmaData &pdata,
+int readstatus, const std::vector<std::string> &sources,
+std::string filename){
+    P_Debug("\tIn write_gridcache(const PlasmaGrid_Data &pgrid, const "
+        << "PlasmaData &pdata, int readstatus, const std::vector<std::string> "
+        << "&sources, std::string filename)\n\n");
+    if( sources.size() > MaxSources ) return 1;
+
+    std::array<const char*,NumSections> Sections;
+    auto Fields = double_fields(pgrid);
+    for( unsigned int n = 0; n < NumDoubleFields; n ++ )
+        Sections[n] = reinterpret_cast<const char*>(Fields[n]->data());
+    Sections[NumDoubleFields]
+        = reinterpret_cast<const char*>(pgrid.gridflag.data());
+    Sections[NumDoubleFields+1]
+        = reinterpret_cast<const char*>(pgrid.Cells.data());
+    Sections[NumDoubleFields+2] = pgrid.Stencils.data();
+    std::array<int,NumSections> Sizes;
+    for( unsigned int n = 0; n < NumDoubleFields; n ++ )
+        Sizes[n] = Fields[n]->size();
+    Sizes[NumDoubleFields] = pgrid.gridflag.size();
+    Sizes[NumDoubleFields+1] = pgrid.Cells.size();
+    Sizes[NumDoubleFields+2] = pgrid.Stencils.size();
+
+    //!< Lay out the fields one after another, each starting aligned
+    GridCacheHeader Header;
+    fill_key(Header,pgrid,pdata,sources);
+    Header.ReadStatus = readstatus;
+    uint64_t Offset = DataStart;
+    for( unsigned int n = 0; n < NumSections; n ++ ){
+        if( Sizes[n] != pgrid.gridx*pgrid.gridz ) return 1;
+        Header.Offset[n] = Offset;
+        Header.Count[n] = Sizes[n];
+        Offset += (Sizes[n]*section_cellsize(n)+GridAlignment-1)
+            /GridAlignment*GridAlignment;
+    }
+    Header.FileSize = Offset;
+
+    const char Zeroes[GridAlignment] = {};
+    GridChecksum DataSum;
+    for( unsigned int n = 0; n < NumSections; n ++ ){
+        uint64_t Bytes = Header.Count[n]*section_cellsize(n);
+        uint64_t End = n+1 < NumSections ? Header.Offset[n+1] : Offset;
+        DataSum.add(Sections[n],Bytes);
+        DataSum.add(Zeroes,End-Header.Offset[n]-Bytes);
+    }
+    Header.DataChecksum = DataSum.value();
+    Header.HeaderChecksum = header_checksum(Header);
+
+    //!< Written in full under a temporary name so that no run maps half a file
+    std::string Temporary = filename+".tmp";
+    {
+        std::ofstream CacheFile(Temporary,
+            std::ofstream::binary|std::ofstream::trunc);
+        if( !CacheFile.is_open() ) return 1;
+        CacheFile.write(reinterpret_cast<const char*>(&Header),sizeof(Header));
+        CacheFile.write(Zeroes,DataStart-sizeof(Header));
+        for( unsigned int n = 0; n < NumSections; n ++ ){
+            uint64_t Bytes = Header.Count[n]*section_cellsize(n);
+            uint64_t End = n+1 < NumSections ? Header.Offset[n+1] : Offset;
+            CacheFile.write(Sections[n],Bytes);
+            CacheFile.write(Zeroes,End-Header.Offset[n]-Bytes);
+        }
+        CacheFile.flush();
+        if( !CacheFile ){
+            std::remove(Temporary.c_str());
+            return 1;
+        }
+    }
+    return std::rename(Temporary.c_str(),filename.c_str()) == 0 ? 0 : 1;
+}
+
+int read_gridcache(PlasmaGrid_Data &pgrid, const PlasmaData &pdata,
+int &readstatus, const std::vector<std::string> &sources,
+std::string filename){
+    P_Debug("\tIn read_gridcache(PlasmaGrid_Data &pgrid, const PlasmaData "
+        << "&pdata, int &readstatus, const std::vector<std::string> &sources, "
+        << "std::string filename)\n\n");
+    int File = open(filename.c_str(),O_RDONLY);
+    if( File < 0 ) return 1;
+    struct stat Status;
+    if( fstat(File,&Status) != 0 || (uint64_t)Status.st_size < DataStart ){
+        close(File);
+        return 2;
+    }
+    size_t Length = Status.st_size;
+    void *Address = mmap(nullptr,Length,PROT_READ,MAP_SHARED,File,0);
+    close(File); //!< The mapping remains after the file is closed
+    if( Address == MAP_FAILED ) return 1;
+    std::shared_ptr<const void> Mapping(Address,[Length](const void *p){
+        munmap(const_cast<void*>(p),Length); });
+    const char *Data = static_cast<const char*>(Address);
+
+    GridCacheHeader Header;
+    std::memcpy(&Header,Data,sizeof(Header));
+    if( std::memcmp(Header.Magic,GridCacheMagic,sizeof(GridCacheMagic)) != 0
+        || Header.Version != GridCacheVersion
+        || Header.ByteOrder != ByteOrderMark
+        || Header.HeaderSize != sizeof(GridCacheHeader)
+        || Header.CellSize != sizeof(PlasmaCell)
+        || Header.HeaderChecksum != header_checksum(Header)
+        || Header.FileSize != Length ) return 2;
+    for( unsigned int n = 0; n < NumSections; n ++ ){
+        if( Header.Offset[n] % GridAlignment != 0
+            || Header.Offset[n] < DataStart || Header.Offset[n] > Length
+            || Header.Count[n] != (uint64_t)Header.gridx*Header.gridz
+            || (Length-Header.Offset[n])/section_cellsize(n) < Header.Count[n])
+            return 2;
+    }
+
+    //!< Compare the inputs before reading the fields, a stale cache is rebuilt
+    GridCacheHeader Expected;
+    fill_key(Expected,pgrid,pdata,sources);
+    if( sources.size() > MaxSources
+        || Header.gridx != Expected.gridx || Header.gridz != Expected.gridz
+        || Header.gridtheta != Expected.gridtheta
+        || Header.device != Expected.device
+        || Header.interpolation != Expected.interpolation
+        || Header.gridxmin != Expected.gridxmin
+        || Header.gridxmax != Expected.gridxmax
+        || Header.gridzmin != Expected.gridzmin
+        || Header.gridzmax != Expected.gridzmax
+        || Header.dlx != Expected.dlx || Header.dlz != Expected.dlz
+        || Header.AmbientTemp != Expected.AmbientTemp
+        || Header.NeutralTemp != Expected.NeutralTemp
+        || Header.NeutralDensity != Expected.NeutralDensity
+        || Header.NumSources != Expected.NumSources
+        || std::memcmp(Header.SourceSize,Expected.SourceSize,
+            sizeof(Header.SourceSize)) != 0
+        || std::memcmp(Header.SourceTime,Expected.SourceTime,
+            sizeof(Header.SourceTime)) != 0
+        || std::memcmp(Header.SourceTimeNsec,Expected.SourceTimeNsec,
+            sizeof(Header.SourceTimeNsec)) != 0 ) return 3;
+
+    GridChecksum DataSum;
+    DataSum.add(Data+DataStart,Length-DataStart);
+    if( DataSum.value() != Header.DataChecksum ) return 2;
+
+    int nx = Header.gridx, nz = Header.gridz;
+    auto Fields = double_fields(pgrid);
+    for( unsigned int n = 0; n < NumDoubleFields; n ++ ){
+        *Fields[n] = GridField<double>(nx,nz,
+            reinterpret_cast<const double*>(Data+Header.Offset[n]),Mapping);
+    }
+    pgrid.gridflag = GridField<int>(nx,nz,reinterpret_cast<const int*>(
+        Data+Header.Offset[NumDoubleFields]),Mapping);
+    pgrid.Cells = GridField<PlasmaCell>(nx,nz,
+        reinterpret_cast<const PlasmaCell*>(
+        Data+Header.Offset[NumDoubleFields+1]),Mapping);
+    pgrid.Stencils = GridField<char>(nx,nz,
+        Data+Header.Offset[NumDoubleFields+2],Mapping);
+    readstatus = Header.ReadStatus;
+    return 0;
+}
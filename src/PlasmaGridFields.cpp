@@ -0,0 +1,166 @@
+/** @file PlasmaGridFields.cpp
+ *  @brief Implementation of the fields derived from the plasma grid
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+
+#include "PlasmaGridFields.h"
+#include "Constants.h"
+
+//!< Return true if cell (i,k) is within \p pgrid and in the plasma
+static inline bool inplasma(const PlasmaGrid_Data &pgrid, int i, int k){
+    if( i < 0 || k < 0 || i >= pgrid.gridx || k >= pgrid.gridz ) return false;
+    return pgrid.gridflag[i][k] == 1;
+}
+
+//!< Version of derive_plasmafields(), to be increased whenever it changes
+static const unsigned int DerivationVersion = 1;
+
+//!< Hash of every field read by derive_plasmafields(), identifying the
+//!< plasma the derived fields were computed from
+static uint64_t derivation_inputs(const PlasmaGrid_Data &pgrid){
+    const GridField<double> *Inputs[] = { &pgrid.po, &pgrid.na0, &pgrid.na1,
+        &pgrid.ua0, &pgrid.ua1, &pgrid.bx, &pgrid.by, &pgrid.bz };
+    uint64_t Hash = 14695981039346656037ULL; //!< FNV-1a offset basis
+    auto mix = [&Hash](uint64_t Word){
+        Hash = (Hash^Word)*1099511628211ULL; //!< FNV-1a prime
+    };
+    for( const GridField<double> *Field : Inputs ){
+        for( int n = 0; n < Field->size(); n ++ ){
+            uint64_t Word;
+            std::memcpy(&Word,Field->data()+n,sizeof(Word));
+            mix(Word);
+        }
+    }
+    for( int n = 0; n < pgrid.gridflag.size(); n ++ )
+        mix(uint64_t(uint32_t(pgrid.gridflag.data()[n])));
+    return Hash;
+}
+
+void derive_plasmafields(PlasmaGrid_Data &pgrid){
+    P_Debug("\tIn derive_plasmafields(PlasmaGrid_Data &pgrid)\n\n");
+    pgrid.Er  = GridField<double>(pgrid.gridx,pgrid.gridz);
+    pgrid.Ez  = pgrid.Er;
+    pgrid.vpx = pgrid.Er;
+    pgrid.vpy = pgrid.Er;
+    pgrid.vpz = pgrid.Er;
+
+    for( int i = 0; i < pgrid.gridx; i ++ ){
+        for( int k = 0; k < pgrid.gridz; k ++ ){
+            //!< Average plasma velocity, parallel to the B field
+            double aveu(0.0);
+            double na0 = pgrid.na0[i][k];
+            double na1 = pgrid.na1[i][k];
+            if( (na0 > 0.0) || (na1 > 0.0) )
+                aveu = (na0*pgrid.ua0[i][k]+na1*pgrid.ua1[i][k])/(na0+na1);
+            threevector Bunit = threevector(pgrid.bx[i][k],pgrid.by[i][k],
+                pgrid.bz[i][k]).getunit();
+            pgrid.vpx[i][k] = aveu*Bunit.getx();
+            pgrid.vpy[i][k] = aveu*Bunit.gety();
+            pgrid.vpz[i][k] = aveu*Bunit.getz();
+
+            //!< Electric field from potential at adjacent cells
+            if( pgrid.gridflag[i][k] != 1 ) continue;
+            bool Left  = inplasma(pgrid,i-1,k);
+            bool Right = inplasma(pgrid,i+1,k);
+            bool Down  = inplasma(pgrid,i,k-1);
+            bool Up    = inplasma(pgrid,i,k+1);
+            if( Right && Left ){
+                pgrid.Er[i][k] = -(pgrid.po[i+1][k]-pgrid.po[i-1][k])
+                    /(2.0*pgrid.dlx);
+            }else if( Right ){
+                pgrid.Er[i][k] = -(pgrid.po[i+1][k]-pgrid.po[i][k])/pgrid.dlx;
+            }else if( Left ){
+                pgrid.Er[i][k] = -(pgrid.po[i][k]-pgrid.po[i-1][k])/pgrid.dlx;
+            }
+            if( Up && Down ){
+                pgrid.Ez[i][k] = -(pgrid.po[i][k+1]-pgrid.po[i][k-1])
+                    /(2.0*pgrid.dlz);
+            }else if( Up ){
+                pgrid.Ez[i][k] = -(pgrid.po[i][k+1]-pgrid.po[i][k])/pgrid.dlz;
+            }else if( Down ){
+                pgrid.Ez[i][k] = -(pgrid.po[i][k]-pgrid.po[i][k-1])/pgrid.dlz;
+            }
+        }
+    }
+}
+
+int write_derivedfields(const PlasmaGrid_Data &pgrid, std::string filename){
+    P_Debug("\tIn write_derivedfields(const PlasmaGrid_Data &pgrid, "
+        << "std::string filename)\n\n");
+    std::ofstream FieldFile(filename);
+    if( !FieldFile.is_open() ) return 1;
+    FieldFile << std::scientific << std::setprecision(16);
+    FieldFile << "#gridx\tgridz\tdlx\tdlz\tversion\tinputs\n" << pgrid.gridx
+        << "\t" << pgrid.gridz << "\t" << pgrid.dlx << "\t" << pgrid.dlz
+        << "\t" << DerivationVersion << "\t" << derivation_inputs(pgrid)
+        << "\n";
+    FieldFile << "#i\tk\tEr\tEz\tvpx\tvpy\tvpz\n";
+    for( int i = 0; i < pgrid.gridx; i ++ ){
+        for( int k = 0; k < pgrid.gridz; k ++ ){
+            FieldFile << i << "\t" << k << "\t" << pgrid.Er[i][k] << "\t"
+                << pgrid.Ez[i][k] << "\t" << pgrid.vpx[i][k] << "\t"
+                << pgrid.vpy[i][k] << "\t" << pgrid.vpz[i][k] << "\n";
+        }
+    }
+    FieldFile.close();
+    return FieldFile.fail() ? 1 : 0;
+}
+
+int read_derivedfields(PlasmaGrid_Data &pgrid, std::string filename){
+    P_Debug("\tIn read_derivedfields(PlasmaGrid_Data &pgrid, "
+        << "std::string filename)\n\n");
+    std::ifstream FieldFile(filename);
+    if( !FieldFile.is_open() ) return 1;
+    std::string Header;
+    int gridx(0), gridz(0);
+    double dlx(0.0), dlz(0.0);
+    unsigned int Version(0);
+    uint64_t Inputs(0);
+    std::getline(FieldFile,Header);
+    FieldFile >> gridx >> gridz >> dlx >> dlz >> Version >> Inputs;
+    if( !FieldFile ) return 2;
+    std::getline(FieldFile,Header); //!< Finish line of dimensions
+    std::getline(FieldFile,Header);
+    if( gridx != pgrid.gridx || gridz != pgrid.gridz
+        || dlx != pgrid.dlx || dlz != pgrid.dlz ) return 2;
+    //!< Fields derived differently or from another plasma are out of date
+    if( Version != DerivationVersion || Inputs != derivation_inputs(pgrid) )
+        return 3;
+
+    GridField<double> Er(gridx,gridz), Ez(Er), vpx(Er), vpy(Er), vpz(Er);
+    int i(0), k(0);
+    for( int n = 0; n < gridx*gridz; n ++ ){
+        double er, ez, vx, vy, vz;
+        if( !(FieldFile >> i >> k >> er >> ez >> vx >> vy >> vz) ) return 2;
+        if( i < 0 || k < 0 || i >= gridx || k >= gridz ) return 2;
+        Er[i][k] = er; Ez[i][k] = ez;
+        vpx[i][k] = vx; vpy[i][k] = vy; vpz[i][k] = vz;
+    }
+    pgrid.Er  = std::move(Er);
+    pgrid.Ez  = std::move(Ez);
+    pgrid.vpx = std::move(vpx);
+    pgrid.vpy = std::move(vpy);
+    pgrid.vpz = std::move(vpz);
+    return 0;
+}
+
+int load_derivedfields(PlasmaGrid_Data &pgrid, std::string filename,
+    bool save){
+    P_Debug("\tIn load_derivedfields(PlasmaGrid_Data &pgrid, "
+        << "std::string filename, bool save)\n\n");
+    int Status(1);
+    if( filename != "" ) Status = read_derivedfields(pgrid,filename);
+    if( Status == 0 ) return 0;
+
+    derive_plasmafields(pgrid);
+    if( save && filename != "" && write_derivedfields(pgrid,filename) != 0 )
+        return 4;
+    return Status;
+}
@@ -0,0 +1,424 @@
+/** @file PlasmaGridReader.cpp
+ *  @brief Implementation of the readers of b2processed plasma grids
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <fstream>
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+#include "PlasmaGridReader.h"
+#include "Constants.h"
+#include "Functions.h"
+
+//!< Factors converting the temperatures of the files to K
+static const double convertJtoK = 7.242971666667e22;
+static const double converteVtoK = 11604.5250061657;
+
+void allocate_plasmafields(PlasmaGrid_Data &pgrid){
+    P_Debug("\tIn allocate_plasmafields(PlasmaGrid_Data &pgrid)\n\n");
+    pgrid.Te  = GridField<double>(pgrid.gridx,pgrid.gridz);
+    pgrid.Ti  = pgrid.Te;
+    pgrid.Tn  = pgrid.Te;
+    pgrid.Ta  = pgrid.Te;
+    pgrid.na0 = pgrid.Te;
+    pgrid.na1 = pgrid.Te;
+    pgrid.na2 = pgrid.Te;
+    pgrid.po  = pgrid.Te;
+    pgrid.ua0 = pgrid.Te;
+    pgrid.ua1 = pgrid.Te;
+    pgrid.bx  = pgrid.Te;
+    pgrid.by  = pgrid.Te;
+    pgrid.bz  = pgrid.Te;
+    pgrid.x   = pgrid.Te;
+    pgrid.z   = pgrid.Te;
+    pgrid.gridflag = GridField<int>(pgrid.gridx,pgrid.gridz);
+}
+
+int read_b2processed_reference(PlasmaGrid_Data &pgrid,
+const PlasmaData &pdata, std::string plasma_dirname){
+    P_Debug("\tIn read_b2processed_reference(PlasmaGrid_Data &pgrid, "
+        << "const PlasmaData &pdata, std::string plasma_dirname)\n\n");
+    allocate_plasmafields(pgrid);
+    int ReStat = 0;
+    std::ifstream scalars,threevectors,gridflagfile;
+    scalars.open(plasma_dirname+"b2processed.dat");
+    threevectors.open(plasma_dirname+"b2processed2.dat");
+    gridflagfile.open(plasma_dirname+"locate.dat");
+
+    //!< Open files to read
+    assert( scalars.is_open() );
+    assert( threevectors.is_open() );
+    assert( gridflagfile.is_open() );
+
+    //!< Throw away variables which read in data which is unimportant.
+    char dummy_char;
+    double dummy_dub;
+    //!< Ignore first line of file
+    for(unsigned int i=0; i<=19; i++){
+        scalars >> dummy_char;
+        threevectors >> dummy_char;
+    }
+    //!< Now loop over the grid and feed in the data into the vectors
+    for(int k=0; k<=pgrid.gridz-1; k++){
+        for(int i=0; i<=pgrid.gridx-1; i++){
+            //!< This is the read-in format without neutrals
+            scalars >> pgrid.x[i][k] >> pgrid.z[i][k] >> pgrid.Te[i][k]
+                >> pgrid.Ti[i][k] >> pgrid.na0[i][k] >> pgrid.na1[i][k]
+                >> pgrid.po[i][k] >> pgrid.ua0[i][k] >> pgrid.ua1[i][k];
+/*          //!< This is the read-in format with neutrals
+            scalars >> pgrid.x[i][k] >> pgrid.z[i][k] >> pgrid.Te[i][k]
+                >> pgrid.Ti[i][k] >> pgrid.Tn[i][k] >> pgrid.na0[i][k]
+                >> pgrid.na1[i][k] >> pgrid.na2[i][k] >> pgrid.po[i][k]
+                >> pgrid.ua0[i][k] >> pgrid.ua1[i][k] >> pgrid.ua2[i][k];*/
+            threevectors >> dummy_dub >> dummy_dub >> pgrid.bx[i][k] >>
+                pgrid.bz[i][k] >> pgrid.by[i][k];
+            gridflagfile >> dummy_dub >> dummy_dub >> pgrid.gridflag[i][k];
+
+            pgrid.Te[i][k] = convertJtoK*pgrid.Te[i][k];
+            pgrid.Ti[i][k] = convertJtoK*pgrid.Ti[i][k];
+            pgrid.Tn[i][k] = convertJtoK*pgrid.Tn[i][k];
+
+            //!< For some reason, very small non-zero values are being
+            //!< assigned to the 'zero' values being read in.
+            //!< This should correct for this...
+
+            if( pgrid.device != 'j' && pgrid.device != 'i' ){
+                    pgrid.Te[i][k] = converteVtoK*pgrid.Te[i][k];
+                    pgrid.Ti[i][k] = converteVtoK*pgrid.Ti[i][k];
+                    pgrid.Tn[i][k] = converteVtoK*pgrid.Tn[i][k];
+            }
+            if( fabs(pgrid.bx[i][k]) > Overflows::Field
+                || fabs(pgrid.bx[i][k]) < Underflows::Field ){ ReStat = 1; }
+            if( fabs(pgrid.by[i][k]) > Overflows::Field
+                || fabs(pgrid.by[i][k]) < Underflows::Field ){ ReStat = 1; }
+            if( fabs(pgrid.bz[i][k]) > Overflows::Field
+                || fabs(pgrid.bz[i][k]) < Underflows::Field ){ ReStat = 1; }
+            if( pgrid.Te[i][k] > Overflows::Temperature
+                || pgrid.Te[i][k] < Underflows::Temperature ){ ReStat = 1; }
+            if( pgrid.Ti[i][k] > Overflows::Temperature
+                || pgrid.Ti[i][k] < Underflows::Temperature ){ ReStat = 1; }
+            if( pgrid.na0[i][k] > Overflows::Density
+                || pgrid.na0[i][k] < Underflows::Density )   { ReStat = 1; }
+            if( pgrid.na1[i][k] > Overflows::Density
+                || pgrid.na1[i][k] < Underflows::Density )   { ReStat = 1; }
+            if( fabs(pgrid.ua0[i][k]) > Overflows::PlasmaVel
+                || fabs(pgrid.ua0[i][k]) < Underflows::PlasmaVel )
+                { ReStat = 1; }
+            if( fabs(pgrid.ua1[i][k]) > Overflows::PlasmaVel
+                || fabs(pgrid.ua1[i][k]) < Underflows::PlasmaVel )
+                { ReStat = 1; }
+            pgrid.Ta[i][k] = pdata.AmbientTemp;
+            pgrid.Tn[i][k] = pdata.NeutralTemp;
+            pgrid.na2[i][k] = pdata.NeutralDensity;
+        }
+    }
+    scalars.close();
+    threevectors.close();
+    gridflagfile.close();
+    return ReStat; //!< return success!
+}
+
+//!< True for the characters skipped before a value by formatted extraction
+static inline bool is_space(char c){
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v'
+        || c == '\f';
+}
+
+static inline bool is_digit(char c){ return c >= '0' && c <= '9'; }
+
+/** @brief Parse the number at \p pos as formatted extraction of a double
+ *
+ *  Accepts the same characters as std::istream, an optional sign, digits
+ *  with an optional decimal point and an optional exponent, and gives the
+ *  same, correctly rounded, value. Numbers of up to 19 significant digits
+ *  and a decimal exponent within 22 are exact products or quotients of two
+ *  doubles, so are converted with one operation, others with strtod().
+ *  @param pos the first character, moved past the number
+ *  @param end one past the last character of the text
+ *  @param value set to the number parsed
+ *  @return false if there is no number at \p pos or it overflows
+ */
+static bool parse_double(const char *&pos, const char *end, double &value){
+    //!< Exact powers of ten representable as doubles
+    static const double Powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+        1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+        1e20, 1e21, 1e22 };
+    const char *Start = pos;
+    const char *p = pos;
+    bool Negative = false;
+    if( p < end && (*p == '+' || *p == '-') ){
+        Negative = *p == '-';
+        p ++;
+    }
+    uint64_t Mantissa = 0;
+    int Significant = 0;    //!< Digits in Mantissa, after leading zeros
+    int Exponent = 0;
+    bool Digits = false;
+    bool Exact = true;      //!< Mantissa holds every significant digit
+    for( ; p < end && is_digit(*p); p ++ ){
+        Digits = true;
+        if( Significant == 0 && *p == '0' ) continue;
+        if( Significant < 19 ){
+            Mantissa = 10*Mantissa+(*p-'0');
+            Significant ++;
+        }else{
+            Exact = false;
+        }
+    }
+    if( p < end && *p == '.' ){
+        for( p ++; p < end && is_digit(*p); p ++ ){
+            Digits = true;
+            if( Significant == 0 && *p == '0' ){
+                Exponent --;
+                continue;
+            }
+            if( Significant < 19 ){
+                Mantissa = 10*Mantissa+(*p-'0');
+                Significant ++;
+                Exponent --;
+            }else{
+                Exact = false;
+            }
+        }
+    }
+    if( !Digits ) return false;
+    if( p < end && (*p == 'e' || *p == 'E') ){
+        p ++;
+        bool NegativeExponent = false;
+        if( p < end && (*p == '+' || *p == '-') ){
+            NegativeExponent = *p == '-';
+            p ++;
+        }
+        //!< An exponent without digits fails extraction
+        if( p == end || !is_digit(*p) ) return false;
+        int Power = 0;
+        for( ; p < end && is_digit(*p); p ++ )
+            if( Power < 100000 ) Power = 10*Power+(*p-'0');
+        Exponent += NegativeExponent ? -Power : Power;
+    }
+    pos = p;
+
+    if( Exact && Mantissa <= (uint64_t(1)<<53)
+        && Exponent >= -22 && Exponent <= 22 ){
+        value = (double)Mantissa;
+        if( Exponent < 0 )  value /= Powers[-Exponent];
+        else                value *= Powers[Exponent];
+        if( Negative ) value = -value;
+        return true;
+    }
+    char Buffer[64];
+    std::string Long;
+    const char *Text = Buffer;
+    size_t Length = p-Start;
+    if( Length < sizeof(Buffer) ){
+        std::memcpy(Buffer,Start,Length);
+        Buffer[Length] = '\0';
+    }else{
+        Long.assign(Start,Length);
+        Text = Long.c_str();
+    }
+    value = strtod(Text,nullptr);
+    return !std::isinf(value);
+}
+
+namespace{
+//!< A line-aligned part of one of the files, parsed by one thread
+struct TextChunk{
+    unsigned int File;
+    const char *Begin;
+    const char *End;
+    std::vector<double> Values;
+    size_t First;   //!< Number of values in the file before this chunk
+    bool Failed;
+};
+
+//!< Call \p fn for every index below \p count on \p threads threads
+template<typename Function> void parallel_for(size_t count,
+unsigned int threads, Function fn){
+    std::atomic<size_t> Next(0);
+    auto Worker = [&](){
+        for( size_t n = Next++; n < count; n = Next++ ) fn(n);
+    };
+    std::vector<std::thread> Pool;
+    for( unsigned int t = 1; t < threads && t < count; t ++ )
+        Pool.push_back(std::thread(Worker));
+    Worker();
+    for( auto &Thread : Pool ) Thread.join();
+}
+}
+
+int read_b2processed(PlasmaGrid_Data &pgrid, const PlasmaData &pdata,
+std::string plasma_dirname, unsigned int threads){
+    P_Debug("\tIn read_b2processed(PlasmaGrid_Data &pgrid, const PlasmaData "
+        << "&pdata, std::string plasma_dirname, unsigned int threads)\n\n");
+    if( threads == 0 ) threads = 1;
+    const unsigned int NumFiles = 3;
+    const std::array<std::string,NumFiles> Names = {{ "b2processed.dat",
+        "b2processed2.dat", "locate.dat" }};
+    const std::array<unsigned int,NumFiles> Columns = {{ 9, 5, 3 }};
+    //!< Characters of the header of each file, skipped as by operator>>
+    const std::array<unsigned int,NumFiles> Headers = {{ 20, 20, 0 }};
+
+    //!< Read the files concurrently
+    std::array<std::string,NumFiles> Text;
+    std::array<bool,NumFiles> Opened;
+    parallel_for(NumFiles,NumFiles,[&](size_t f){
+        std::ifstream File(plasma_dirname+Names[f],std::ifstream::binary);
+        Opened[f] = File.is_open();
+        if( !Opened[f] ) return;
+        File.seekg(0,std::ifstream::end);
+        Text[f].resize(File.tellg());
+        File.seekg(0,std::ifstream::beg);
+        File.read(&Text[f][0],Text[f].size());
+    });
+    for( unsigned int f = 0; f < NumFiles; f ++ ) if( !Opened[f] ) return 2;
+
+    //!< Split each file after its header into chunks ending at a line end,
+    //!< sized so that every thread has several to balance the load
+    size_t TotalSize = Text[0].size()+Text[1].size()+Text[2].size();
+    size_t ChunkSize = TotalSize/(4*threads)+1;
+    std::vector<TextChunk> Chunks;
+    for( unsigned int f = 0; f < NumFiles; f ++ ){
+        const char *p = Text[f].data();
+        const char *End = p+Text[f].size();
+        for( unsigned int c = 0; c < Headers[f]; c ++ ){
+            while( p < End && is_space(*p) ) p ++;
+            if( p < End ) p ++;
+        }
+        while( p < End ){
+            const char *Split = End-p > (long)ChunkSize ? p+ChunkSize : End;
+            while( Split < End && *Split != '\n' ) Split ++;
+            Chunks.push_back(TextChunk{f,p,Split,{},0,false});
+            p = Split;
+        }
+    }
+
+    parallel_for(Chunks.size(),threads,[&](size_t n){
+        TextChunk &Chunk = Chunks[n];
+        Chunk.Values.reserve((Chunk.End-Chunk.Begin)/8);
+        const char *p = Chunk.Begin;
+        while( true ){
+            while( p < Chunk.End && is_space(*p) ) p ++;
+            if( p == Chunk.End ) break;
+            double Value;
+            if( !parse_double(p,Chunk.End,Value) ){
+                Chunk.Failed = true;
+                break;
+            }
+            Chunk.Values.push_back(Value);
+        }
+    });
+
+    //!< Files the reference reads differently, or not in full, are left to it
+    unsigned int Cells = pgrid.gridx*pgrid.gridz;
+    std::array<size_t,NumFiles> Count = {{ 0, 0, 0 }};
+    std::array<bool,NumFiles> Failed = {{ false, false, false }};
+    for( TextChunk &Chunk : Chunks ){
+        Chunk.First = Count[Chunk.File];
+        Count[Chunk.File] += Chunk.Values.size();
+        //!< Values after a failure are never reached by the reference
+        if( Chunk.Failed && Count[Chunk.File] < Columns[Chunk.File]*Cells )
+            Failed[Chunk.File] = true;
+    }
+    for( unsigned int f = 0; f < NumFiles; f ++ ){
+        if( Failed[f] || Count[f] < Columns[f]*Cells ){
+            static std::atomic<bool> runOnce(true);
+            WarnOnce(runOnce,"\nPlasma grid files not in the expected format,"
+                " reading them with file streams");
+            return read_b2processed_reference(pgrid,pdata,plasma_dirname);
+        }
+    }
+
+    //!< Scatter each value to its field, the files list cells with z in the
+    //!< outer loop while the fields store them with x in the outer loop
+    allocate_plasmafields(pgrid);
+    const std::array<double*,9> Scalars = {{ pgrid.x.data(), pgrid.z.data(),
+        pgrid.Te.data(), pgrid.Ti.data(), pgrid.na0.data(), pgrid.na1.data(),
+        pgrid.po.data(), pgrid.ua0.data(), pgrid.ua1.data() }};
+    const std::array<double*,5> Vectors = {{ nullptr, nullptr,
+        pgrid.bx.data(), pgrid.bz.data(), pgrid.by.data() }};
+    int *Flags = pgrid.gridflag.data();
+    const int gridx = pgrid.gridx, gridz = pgrid.gridz;
+    std::atomic<bool> NonInteger(false);
+    parallel_for(Chunks.size(),threads,[&](size_t n){
+        const TextChunk &Chunk = Chunks[n];
+        unsigned int Width = Columns[Chunk.File];
+        size_t Last = std::min(Chunk.Values.size(),
+            Width*Cells-std::min<size_t>(Chunk.First,Width*Cells));
+        for( size_t v = 0; v < Last; v ++ ){
+            size_t Index = Chunk.First+v;
+            unsigned int Cell = Index/Width, Column = Index%Width;
+            size_t Offset = (size_t)(Cell%gridx)*gridz+Cell/gridx;
+            if( Chunk.File == 0 ){
+                Scalars[Column][Offset] = Chunk.Values[v];
+            }else if( Chunk.File == 1 ){
+                if( Column >= 2 ) Vectors[Column][Offset] = Chunk.Values[v];
+            }else if( Column == 2 ){
+                //!< Grid flags are read as integers by the reference
+                double Flag = Chunk.Values[v];
+                if( Flag < INT_MIN || Flag > INT_MAX 
+                    || Flag != std::trunc(Flag) ){
+                    NonInteger = true;
+                    continue;
+                }
+                Flags[Offset] = (int)Flag;
+            }
+        }
+    });
+    if( NonInteger )
+        return read_b2processed_reference(pgrid,pdata,plasma_dirname);
+
+    //!< Convert and check whole fields, in the order of the reference so that
+    //!< the results are identical, without branches so that loops vectorise
+    double *Te = pgrid.Te.data(), *Ti = pgrid.Ti.data();
+    for( unsigned int c = 0; c < Cells; c ++ ){
+        Te[c] = convertJtoK*Te[c];
+        Ti[c] = convertJtoK*Ti[c];
+    }
+    if( pgrid.device != 'j' && pgrid.device != 'i' ){
+        for( unsigned int c = 0; c < Cells; c ++ ){
+            Te[c] = converteVtoK*Te[c];
+            Ti[c] = converteVtoK*Ti[c];
+        }
+    }
+    const double *bx = pgrid.bx.data(), *by = pgrid.by.data();
+    const double *bz = pgrid.bz.data();
+    const double *na0 = pgrid.na0.data(), *na1 = pgrid.na1.data();
+    const double *ua0 = pgrid.ua0.data(), *ua1 = pgrid.ua1.data();
+    int Outside = 0;
+    for( unsigned int c = 0; c < Cells; c ++ ){
+        Outside |= (std::fabs(bx[c]) > Overflows::Field)
+            | (std::fabs(bx[c]) < Underflows::Field)
+            | (std::fabs(by[c]) > Overflows::Field)
+            | (std::fabs(by[c]) < Underflows::Field)
+            | (std::fabs(bz[c]) > Overflows::Field)
+            | (std::fabs(bz[c]) < Underflows::Field)
+            | (Te[c] > Overflows::Temperature)
+            | (Te[c] < Underflows::Temperature)
+            | (Ti[c] > Overflows::Temperature)
+            | (Ti[c] < Underflows::Temperature)
+            | (na0[c] > Overflows::Density) | (na0[c] < Underflows::Density)
+            | (na1[c] > Overflows::Density) | (na1[c] < Underflows::Density)
+            | (std::fabs(ua0[c]) > Overflows::PlasmaVel)
+            | (std::fabs(ua0[c]) < Underflows::PlasmaVel)
+            | (std::fabs(ua1[c]) > Overflows::PlasmaVel)
+            | (std::fabs(ua1[c]) < Underflows::PlasmaVel);
+    }
+    std::fill(pgrid.Ta.data(),pgrid.Ta.data()+Cells,pdata.AmbientTemp);
+    std::fill(pgrid.Tn.data(),pgrid.Tn.data()+Cells,pdata.NeutralTemp);
+    std::fill(pgrid.na2.data(),pgrid.na2.data()+Cells,pdata.NeutralDensity);
+    return Outside ? 1 : 0;
+}
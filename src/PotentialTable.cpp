@@ -0,0 +1,226 @@
+/** @file PotentialTable.cpp
+ *  @brief Implementation of the tabulated floating potentials
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+#include "PotentialTable.h"
+
+//!< Identifies a potential table file, followed by the format version
+static const char TableMagic[8] = {'D','T','O','K','S','P','O','T'};
+static const uint32_t TableVersion = 1;
+//!< Written in native byte order so that the reader can detect a mismatch
+static const uint32_t ByteOrderMark = 0x01020304;
+//!< Most axes of a table, so that a cell has at most 8 corners
+static const uint32_t MaxDimensions = 3;
+
+PotentialTable::PotentialTable(char model, double massratio,
+    double ionization, const std::vector<std::vector<double>> &axes):
+    Model(model),MassRatio(massratio),Ionization(ionization),Axes(axes){
+    assert( !Axes.empty() && Axes.size() <= MaxDimensions );
+    size_t Nodes(1), Cells(1);
+    for( const std::vector<double> &Axis : Axes ){
+        assert( Axis.size() >= 2
+            && std::is_sorted(Axis.begin(),Axis.end()) );
+        Nodes *= Axis.size();
+        Cells *= Axis.size()-1;
+    }
+    Values.assign(Nodes,NAN);
+    Valid.assign(Cells,1);
+}
+
+void PotentialTable::node(size_t index, double *x)const{
+    for( size_t d = Axes.size(); d-- > 0; ){
+        x[d] = Axes[d][index%Axes[d].size()];
+        index /= Axes[d].size();
+    }
+}
+
+void PotentialTable::centre(size_t index, double *x)const{
+    for( size_t d = Axes.size(); d-- > 0; ){
+        size_t i = index%(Axes[d].size()-1);
+        x[d] = 0.5*(Axes[d][i]+Axes[d][i+1]);
+        index /= Axes[d].size()-1;
+    }
+}
+
+bool PotentialTable::lookup(const double *x, double &value)const{
+    if( Values.empty() ) return false;
+    size_t Lower[MaxDimensions];
+    double Weight[MaxDimensions];
+    size_t Cell(0);
+    for( size_t d = 0; d < Axes.size(); d ++ ){
+        const std::vector<double> &Axis = Axes[d];
+        if( !(x[d] >= Axis.front() && x[d] <= Axis.back()) ) return false;
+        size_t i = std::upper_bound(Axis.begin(),Axis.end(),x[d])
+            -Axis.begin()-1;
+        if( i > Axis.size()-2 ) i = Axis.size()-2;
+        Lower[d] = i;
+        Weight[d] = (x[d]-Axis[i])/(Axis[i+1]-Axis[i]);
+        Cell = Cell*(Axis.size()-1) + i;
+    }
+    if( !Valid[Cell] ) return false;
+
+    //!< Sum over the corners of the cell, bit d of c selecting the upper
+    //!< node of axis d
+    double Sum(0.0);
+    for( size_t c = 0; c < (1u<<Axes.size()); c ++ ){
+        size_t Index(0);
+        double w(1.0);
+        for( size_t d = 0; d < Axes.size(); d ++ ){
+            bool Upper = (c>>d)&1;
+            Index = Index*Axes[d].size() + Lower[d] + Upper;
+            w *= Upper ? Weight[d] : 1.0-Weight[d];
+        }
+        Sum += w*Values[Index];
+    }
+    value = Sum;
+    return true;
+}
+
+bool PotentialTable::matches(char model, double massratio,
+    double ionization)const{
+    return model == Model && ionization == Ionization
+        && fabs(massratio-MassRatio)
+        <= PotentialTables::MassTolerance*MassRatio;
+}
+
+//!< Append the bytes of \p value to \p out
+template<typename T> static inline void write_value(std::ostream &out,
+    const T &value){
+    out.write(reinterpret_cast<const char*>(&value),sizeof(T));
+}
+
+//!< Read a value of type T from \p in, returning false on failure
+template<typename T> static inline bool read_value(std::istream &in,
+    T &value){
+    return bool(in.read(reinterpret_cast<char*>(&value),sizeof(T)));
+}
+
+int PotentialTable::write(std::string filename)const{
+    std::ofstream File(filename,std::ofstream::binary|std::ofstream::trunc);
+    if( !File.is_open() ) return 1;
+
+    File.write(TableMagic,sizeof(TableMagic));
+    write_value(File,TableVersion);
+    write_value(File,ByteOrderMark);
+    write_value(File,Model);
+    write_value(File,MassRatio);
+    write_value(File,Ionization);
+    uint32_t NumAxes = Axes.size();
+    write_value(File,NumAxes);
+    for( const std::vector<double> &Axis : Axes ){
+        uint32_t AxisSize = Axis.size();
+        write_value(File,AxisSize);
+        File.write(reinterpret_cast<const char*>(Axis.data()),
+            Axis.size()*sizeof(double));
+    }
+    File.write(reinterpret_cast<const char*>(Values.data()),
+        Values.size()*sizeof(double));
+    File.write(reinterpret_cast<const char*>(Valid.data()),Valid.size());
+    return File ? 0 : 1;
+}
+
+int PotentialTable::read(std::string filename){
+    std::ifstream File(filename,std::ifstream::binary);
+    if( !File.is_open() ) return 1;
+
+    char Magic[sizeof(TableMagic)];
+    uint32_t Version(0), ByteOrder(0), NumAxes(0);
+    if( !File.read(Magic,sizeof(Magic))
+        || std::memcmp(Magic,TableMagic,sizeof(Magic)) != 0 ) return 2;
+    if( !read_value(File,Version) || Version != TableVersion ) return 2;
+    if( !read_value(File,ByteOrder) || ByteOrder != ByteOrderMark ) return 2;
+
+    char NewModel(0);
+    double NewMassRatio(0.0), NewIonization(0.0);
+    if( !read_value(File,NewModel) || !read_value(File,NewMassRatio)
+        || !read_value(File,NewIonization) || !read_value(File,NumAxes)
+        || NumAxes == 0 || NumAxes > MaxDimensions ) return 2;
+
+    std::vector<std::vector<double>> NewAxes(NumAxes);
+    size_t Nodes(1), Cells(1);
+    for( std::vector<double> &Axis : NewAxes ){
+        uint32_t AxisSize(0);
+        if( !read_value(File,AxisSize) || AxisSize < 2 ) return 2;
+        Axis.resize(AxisSize);
+        if( !File.read(reinterpret_cast<char*>(Axis.data()),
+            AxisSize*sizeof(double)) ) return 2;
+        if( !std::is_sorted(Axis.begin(),Axis.end()) ) return 2;
+        Nodes *= AxisSize;
+        Cells *= AxisSize-1;
+    }
+    std::vector<double> NewValues(Nodes);
+    std::vector<unsigned char> NewValid(Cells);
+    if( !File.read(reinterpret_cast<char*>(NewValues.data()),
+            Nodes*sizeof(double))
+        || !File.read(reinterpret_cast<char*>(NewValid.data()),Cells) )
+        return 2;
+    //!< Anything left over is not part of the table
+    if( File.peek() != std::ifstream::traits_type::eof() ) return 2;
+
+    Model = NewModel;
+    MassRatio = NewMassRatio;
+    Ionization = NewIonization;
+    Axes = std::move(NewAxes);
+    Values = std::move(NewValues);
+    Valid = std::move(NewValid);
+    return 0;
+}
+
+std::string PotentialTable::filename(char model, double massratio,
+    double ionization){
+    std::stringstream Name;
+    Name << PotentialTables::Directory << "/"
+        << (model == PotentialTables::MOMLEM ? "MOMLEM" : "MOMLWEM")
+        << "_mu" << lround(massratio) << "_Z" << ionization << ".tab";
+    return Name.str();
+}
+
+std::shared_ptr<const PotentialTable> PotentialTable::shared(char model,
+    double massratio, double ionization){
+    static std::mutex TablesMutex;
+    static std::map<std::tuple<char,double,double>,
+        std::shared_ptr<const PotentialTable>> Tables;
+
+    std::lock_guard<std::mutex> Lock(TablesMutex);
+    auto Key = std::make_tuple(model,massratio,ionization);
+    auto Found = Tables.find(Key);
+    if( Found != Tables.end() ) return Found->second;
+
+    std::shared_ptr<PotentialTable> Table(new PotentialTable());
+    if( Table->read(filename(model,massratio,ionization)) != 0
+        || !Table->matches(model,massratio,ionization) ){
+        //!< An empty table of this plasma, so that it is not read again
+        Table.reset(new PotentialTable());
+        Table->Model = model;
+        Table->MassRatio = massratio;
+        Table->Ionization = ionization;
+    }
+    Tables[Key] = Table;
+    return Table;
+}
+
+const PotentialTable &PotentialTable::local(char model, double massratio,
+    double ionization){
+    assert(model == PotentialTables::MOMLEM
+        || model == PotentialTables::MOMLWEM);
+    thread_local std::shared_ptr<const PotentialTable> Tables[2];
+    std::shared_ptr<const PotentialTable> &Table =
+        Tables[model == PotentialTables::MOMLEM ? 0 : 1];
+    if( !Table || !Table->matches(model,massratio,ionization) )
+        Table = shared(model,massratio,ionization);
+    return *Table;
+}
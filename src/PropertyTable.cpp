@@ -0,0 +1,79 @@
+/** @file PropertyTable.cpp
+ *  @brief Implementation of the tabulated temperature dependence of a property
+ *
+ *  @author Luke Simons (ls5115@ic.ac.uk)
+ *  @bug bugs, they definitely exist
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "PropertyTable.h"
+
+//!< Fraction of a piece by which its end nodes are moved inside it, so that
+//!< they take the model of the piece rather than that of its neighbour
+static const double EdgeOffset = 1e-12;
+
+PropertyTable::PropertyTable(std::function<double(double)> model,
+    const std::vector<double> &bounds, char scale, double tolerance):
+Scale(scale),MaxError(0.0){
+    assert( scale == Tabulation::Linear || scale == Tabulation::Arrhenius );
+    //!< Value stored for the model at temperature T, false if unusable
+    auto stored = [&](double T, double &v){
+        double f = model(T);
+        if( Scale == Tabulation::Arrhenius ){
+            if( !(f > 0.0) || !std::isfinite(f) ) return false;
+            v = log(f);
+        }else{
+            if( !std::isfinite(f) ) return false;
+            v = f;
+        }
+        return true;
+    };
+
+    for( size_t b = 0; b+1 < bounds.size(); b ++ ){
+        Piece P;
+        P.TMin = bounds[b];
+        P.TMax = bounds[b+1];
+        assert( P.TMin < P.TMax && P.TMin > 0.0 );
+        double Width = P.TMax-P.TMin;
+        double TLow = P.TMin+EdgeOffset*Width;
+        double THigh = P.TMax-EdgeOffset*Width;
+        //!< Inverse temperature decreases along the piece
+        P.XMin = std::min(abscissa(P.TMin),abscissa(P.TMax));
+        double XMax = std::max(abscissa(P.TMin),abscissa(P.TMax));
+
+        bool Usable(false);
+        double PieceError(0.0);
+        for( unsigned int N = 16; N <= Tabulation::MaxIntervals && !Usable;
+            N *= 2 ){
+            double Step = (XMax-P.XMin)/N;
+            P.InvStep = 1.0/Step;
+            P.Values.resize(N+1);
+            bool Finite(true);
+            for( unsigned int i = 0; i <= N && Finite; i ++ ){
+                double x = P.XMin+i*Step;
+                double T = Scale == Tabulation::Arrhenius ? 1.0/x : x;
+                T = std::min(std::max(T,TLow),THigh);
+                Finite = stored(T,P.Values[i]);
+            }
+            if( !Finite ) break;
+
+            //!< Compare to the model at the midpoint of every interval
+            PieceError = 0.0;
+            for( unsigned int i = 0; i < N && PieceError <= tolerance; i ++ ){
+                double x = P.XMin+(i+0.5)*Step;
+                double T = Scale == Tabulation::Arrhenius ? 1.0/x : x;
+                double f = model(T);
+                double v = 0.5*(P.Values[i]+P.Values[i+1]);
+                if( Scale == Tabulation::Arrhenius ) v = exp(v);
+                double Error = f == 0.0 ? fabs(v) : fabs(v-f)/fabs(f);
+                if( !(Error <= PieceError) ) PieceError = Error;
+            }
+            Usable = PieceError <= tolerance;
+        }
+        if( !Usable ) continue;
+        MaxError = std::max(MaxError,PieceError);
+        Pieces.push_back(P);
+    }
+}
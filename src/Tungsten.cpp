@@ -33,6 +33,33 @@ const struct ElementConsts TungstenConsts = {
     0.163         //!< kW/m K, at 20 degrees celsius
 };
 
+/** @brief Heat capacity of tungsten in J/(mol K) at \p Temperature
+ */
+static double heatcapacity(double Temperature){
+    if( Temperature < 300 || 
+        (Temperature > 300 && Temperature < TungstenConsts.MeltingTemp) ){ 
+        //!< http://nvlpubs.nist.gov/nistpubs/jres/75a/jresv75an4p283_a1b.pdf
+        return 24.943 - 7.72e4*pow(Temperature,-2) + 2.33e-3*Temperature 
+            + 1.18e-13*pow(Temperature,4);
+    }
+    //!< http://webbook.nist.gov/cgi/inchi?ID=C7440337&Mask=2
+    double t = Temperature/1000;
+    return 35.56404 -1.551741e-7*t + 2.915253e-8*pow(t,2)
+        -1.891725e-9*pow(t,3)-4.107702e-7*pow(t,-2);
+}
+
+/** @brief Vapour pressure of tungsten in Pa at \p Temperature
+ */
+static double vapourpressure(double Temperature){
+    if( Temperature < 2500 ){
+        //!< http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
+        return 101325*pow(10,2.945 - 44094/Temperature +
+            1.3677*log10(Temperature));
+    }
+    //!< E. R. Plante and A. B. Sessoms
+    return 101325*pow(10,7.871-45385/Temperature);
+}
+
 Tungsten::Tungsten():
 Matter(TungstenConsts){
     E_Debug("\n\nIn Tungsten::Tungsten():Matter(&TungstenConsts)\n\n");
@@ -119,28 +146,19 @@ void Tungsten::set_defaults(){
 
 void Tungsten::update_heatcapacity(){
     E_Debug("\n\n\tIn Tungsten::update_heatcapacity()");
+    static const PropertyTable Table(heatcapacity,
+        {300,TungstenConsts.MeltingTemp,2*TungstenConsts.BoilingTemp},
+        Tabulation::Linear);
 
     if( St.Temperature < 300 ){ 
-
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Tungsten::update_heatcapacity():\n";
         WarningMessage += "Extending heat capacity model outside temperature";
         WarningMessage += " range! T < 300K";
         WarnOnce(runOnce,WarningMessage);
-
-        St.HeatCapacity = 24.943 - 7.72e4*pow(St.Temperature,-2) + 
-            2.33e-3*St.Temperature + 1.18e-13*pow(St.Temperature,4);
-    }else if( St.Temperature > 300 && St.Temperature < Ec.MeltingTemp ){ 
-        //!< http://nvlpubs.nist.gov/nistpubs/jres/75a/jresv75an4p283_a1b.pdf
-        St.HeatCapacity = 24.943 - 7.72e4*pow(St.Temperature,-2) +
-            2.33e-3*St.Temperature + 1.18e-13*pow(St.Temperature,4);
-    }else{
-        //!< http://webbook.nist.gov/cgi/inchi?ID=C7440337&Mask=2
-
-        double t = St.Temperature/1000;
-                St.HeatCapacity = 35.56404 -1.551741e-7*t + 2.915253e-8*pow(t,2)
-                -1.891725e-9*pow(t,3)-4.107702e-7*pow(t,-2);
     }
+    if( !Table.lookup(St.Temperature,St.HeatCapacity) )
+        St.HeatCapacity = heatcapacity(St.Temperature);
 
     E1_Debug("\n\tTemperature is : " << St.Temperature << "\n\tSt.Gas = " 
         << St.Gas << "\n\tSt.Liquid = " << St.Liquid << "\n\tCv of Solid: " 
@@ -152,7 +170,7 @@ void Tungsten::update_heatcapacity(){
 void Tungsten::update_radius(){
     E_Debug("\n\n\tIn Tungsten::update_radius()");
     if( St.Temperature > 173 && St.Temperature <= 1500 ){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Tungsten::update_radius():\n";
         WarningMessage += "Extending model outside temperature range!";
         WarningMessage += " (from 738K to 1500K)";
@@ -190,28 +208,25 @@ void Tungsten::update_vapourpressure(){
 double Tungsten::probe_vapourpressure(double Temperature)const{
     E_Debug("\n\n\tIn Tungsten::probe_vapourpressure(double Temperature)"
         << "const");
+    static const PropertyTable Table(vapourpressure,
+        {298,2500,2*TungstenConsts.BoilingTemp},Tabulation::Arrhenius);
     double VapourPressure(0.0);
-    //!< Vapour pressure model:
-    //!< // http://mmrc.caltech.edu/PVD/manuals/Metals%20Vapor%20pressure.pdf
+    if( Table.lookup(Temperature,VapourPressure) ) return VapourPressure;
+
     if( Temperature < 298 ){
-        static bool runOnce = true;
+        static std::atomic<bool> runOnce(true);
         std::string WarningMessage = "In Tungsten::update_vapourpressure():\n";
         WarningMessage += "Extending model outside temperature range!";
         WarningMessage += " (from 298K< to 0K<)";
         WarnOnce(runOnce,WarningMessage);
 
-        VapourPressure = 101325*pow(10,2.945 - 44094/Temperature +
-            1.3677*log10(Temperature)); 
-    }else if( Temperature >= 298 && Temperature < 2500 ){
-        VapourPressure = 101325*pow(10,2.945 - 44094/Temperature +
-        1.3677*log10(Temperature));
-    }else if( Temperature >= 2500 ){
-        //!< E. R. Plante and A. B. Sessoms
-        VapourPressure = 101325*pow(10,7.871-45385/Temperature);
+        VapourPressure = vapourpressure(Temperature);
+    }else if( Temperature >= 298 ){
+        VapourPressure = vapourpressure(Temperature);
     }else{
         std::cerr << "\nError! Negative Temperature in" 
             << "Tungsten::probe_vapourpressure(double Temperature)";
     }
     
     return VapourPressure;
-}
\ No newline at end of file
+}
@@ -1,7 +1,11 @@
 #include "solveMOMLEM.h"
+#include "Functions.h"
+#include "Constants.h"
 #include <math.h>
 #include <iostream>
 #include <assert.h>
+#include <algorithm>
+#include <cmath>
 
 // Equation for PI_1 as defined in equation (47)
 // See the paper by Minas and Nikoleta,
@@ -226,160 +230,199 @@ double FindCriticalVal(const double FirstFixedValue, const double SecondFixedVal
 	return Minx;
 }
 
-double solveWellCase( double &phis, double & phic, double &phiw, double tau, double chi, double delta, double mu){
-//	std::cout << "\n\n* IN double solveWellCase(const double FirstFixedValue, const double SecondFixedValue, double MassRatio, char CritValue ) *\n";
-
-//	phis = -1.85;
-//	phic = -2.1;
-	double steps = 0.0001;
-//	phiw = phic-steps;
-	double dx = steps;
-	double dy = steps;
-	double dz = steps;
-
-	double s = fabs(WDB_f(phis,phic,phiw,tau,chi,delta)) + fabs(WIB_f(phis,phiw,tau,chi,delta))
-                + fabs(WFB_f(phic,phiw,tau,chi,delta,mu));
-	double Diffs[6];
-	int StepNumber(0.0);
-
-	// CURRENTLY:
-	// phis can only get more positive starting from -1.85
-	// phiw can only get more negative starting from phic
-	
-	double s1(0.0), s2(0.0), s3(0.0), s4(0.0), s5(0.0), s6(0.0);
-	while( s > 0.0001 ){
-		 // In this case, don't step in these directions as we'll get a assertion failure
-		if( phis-dx < phiw || phis < phiw+dz ){
-			s1 = fabs(WDB_f(phis+dx,phic,phiw,tau,chi,delta)) + fabs(WIB_f(phis+dx,phiw,tau,chi,delta))
-					+ fabs(WFB_f(phic,phiw,tau,chi,delta,mu));
-			if( fabs(s1) < fabs(s) ){
-				Diffs[0] = fabs(s-s1);
-			}else{
-				Diffs[0] = 0.0;
-			}
-			s2 = fabs(WDB_f(phis,phic+dy,phiw,tau,chi,delta)) + fabs(WIB_f(phis,phiw,tau,chi,delta))
-					+ fabs(WFB_f(phic+dy,phiw,tau,chi,delta,mu));
-			if( fabs(s2) < fabs(s) ){
-				Diffs[1] = fabs(s-s2);
-			}else{
-				Diffs[1] = 0.0;
-			}
+// Residuals of equations (53), (55) and (54) at x = (phis, phic, phiw) for the well case.
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou, A. P. L. Robinson, M. Coppins, and M. Bacharis, Phys. Plasmas 21, (2014).
+// Returns false where the residuals are undefined, which is outside of phiw < phis < 0 
+// and phiw < phic, or where they do not evaluate to finite numbers.
+static bool WellResiduals(const double x[3], double tau, double chi, double delta, double mu, 
+		double F[3]){
+	if( !(x[2] < x[0] && x[0] < 0.0 && x[2] < x[1]) ) return false;
+	F[0] = WDB_f(x[0],x[1],x[2],tau,chi,delta);
+	F[1] = WIB_f(x[0],x[2],tau,chi,delta);
+	F[2] = WFB_f(x[1],x[2],tau,chi,delta,mu);
+	for( int i = 0; i < 3; i ++ )
+		if( !std::isfinite(F[i]) ) return false;
+	return true;
+}
 
-			Diffs[2] = 0.0;
-			Diffs[3] = 0.0;
-			
-			s5 = fabs(WDB_f(phis,phic-dy,phiw,tau,chi,delta)) + fabs(WIB_f(phis,phiw,tau,chi,delta))
-					+ fabs(WFB_f(phic-dy,phiw,tau,chi,delta,mu));
-                	if( fabs(s5) < fabs(s) ){
-                	        Diffs[4] = fabs(s-s5);
-                	}else{
-				Diffs[4] = 0.0;
-			}
+// Solve the 3x3 system A.x = b by Gaussian elimination with partial pivoting.
+// Returns false if A is singular.
+static bool Solve3(double A[3][3], double b[3], double x[3]){
+	for( int k = 0; k < 3; k ++ ){
+		int Pivot = k;
+		for( int i = k+1; i < 3; i ++ )
+			if( fabs(A[i][k]) > fabs(A[Pivot][k]) ) Pivot = i;
+		if( A[Pivot][k] == 0.0 ) return false;
+		for( int j = 0; j < 3; j ++ ) std::swap(A[k][j],A[Pivot][j]);
+		std::swap(b[k],b[Pivot]);
+		for( int i = k+1; i < 3; i ++ ){
+			double Factor = A[i][k]/A[k][k];
+			for( int j = k; j < 3; j ++ ) A[i][j] -= Factor*A[k][j];
+			b[i] -= Factor*b[k];
+		}
+	}
+	for( int i = 2; i >= 0; i -- ){
+		x[i] = b[i];
+		for( int j = i+1; j < 3; j ++ ) x[i] -= A[i][j]*x[j];
+		x[i] /= A[i][i];
+	}
+	return true;
+}
 
-			s6 = fabs(WDB_f(phis,phic,phiw-dz,tau,chi,delta)) + fabs(WIB_f(phis,phiw-dz,tau,chi,delta))
-                	                + fabs(WFB_f(phic,phiw-dz,tau,chi,delta,mu));
-                	if( fabs(s6) < fabs(s) ){
-                	        Diffs[5] = fabs(s-s6);
-                	}else{
-				Diffs[5] = 0.0;
-			}
-			
-		}else{ // in this case, keep stepping, everything is fine!
-
-			s1 = fabs(WDB_f(phis+dx,phic,phiw,tau,chi,delta)) + fabs(WIB_f(phis+dx,phiw,tau,chi,delta))
-					+ fabs(WFB_f(phic,phiw,tau,chi,delta,mu));
-			if( fabs(s1) < fabs(s) ){
-				Diffs[0] = fabs(s-s1);
-			}else{
-				Diffs[0] = 0.0;
-			}
-			s2 = fabs(WDB_f(phis,phic+dy,phiw,tau,chi,delta)) + fabs(WIB_f(phis,phiw,tau,chi,delta))
-					+ fabs(WFB_f(phic+dy,phiw,tau,chi,delta,mu));
-			if( fabs(s2) < fabs(s) ){
-				Diffs[1] = fabs(s-s2);
-			}else{
-				Diffs[1] = 0.0;
+// Solve equations [53-55] for the well case with the Levenberg-Marquardt method, a Newton 
+// method damped towards gradient descent whenever a full step fails to reduce the residuals.
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou, A. P. L. Robinson, M. Coppins, and M. Bacharis, Phys. Plasmas 21, (2014).
+// phis, phic and phiw hold the initial guess and are set to the solution, which must satisfy
+// phiw < phis < 0 and phiw < phic. The Jacobian is found by finite differences.
+// iterations	: Set to the number of iterations taken
+// Returns the sum of the absolute residuals at the solution, as did the previous 
+// coordinate search which this replaces.
+double solveWellCase( double &phis, double & phic, double &phiw, double tau, double chi, double delta, 
+		double mu, int &iterations){
+	const int MaxIterations = 100;
+	const double Tolerance = 1e-10;		// Sum of absolute residuals accepted as a root
+	const double Difference = 1e-7;		// Relative step of the finite differences
+
+	double x[3] = {phis, phic, phiw};
+	double F[3], Trial[3], FTrial[3], J[3][3];
+	iterations = 0;
+	if( !WellResiduals(x,tau,chi,delta,mu,F) ) return HUGE_VAL;
+	double s = fabs(F[0]) + fabs(F[1]) + fabs(F[2]);
+	double SumSquares = F[0]*F[0] + F[1]*F[1] + F[2]*F[2];
+	double Lambda = 1e-3;
+	while( s > Tolerance && iterations < MaxIterations ){
+		iterations ++;
+		// Forward differences, or backward ones where the forward step leaves the domain
+		for( int j = 0; j < 3; j ++ ){
+			double h = Difference*std::max(1.0,fabs(x[j]));
+			for( int k = 0; k < 3; k ++ ) Trial[k] = x[k];
+			Trial[j] = x[j]+h;
+			if( !WellResiduals(Trial,tau,chi,delta,mu,FTrial) ){
+				h = -h;
+				Trial[j] = x[j]+h;
+				if( !WellResiduals(Trial,tau,chi,delta,mu,FTrial) ){
+					// Jacobian undefined, return the point reached
+					phis = x[0]; phic = x[1]; phiw = x[2];
+					return s;
+				}
 			}
+			for( int i = 0; i < 3; i ++ ) J[i][j] = (FTrial[i]-F[i])/h;
+		}
 
-			s3 = fabs(WDB_f(phis,phic,phiw+dz,tau,chi,delta)) + fabs(WIB_f(phis,phiw+dz,tau,chi,delta))
-					+ fabs(WFB_f(phic,phiw+dz,tau,chi,delta,mu));
-                	if( fabs(s3) < fabs(s) ){
-                	        Diffs[2] = fabs(s-s3);
-                	}else{
-				Diffs[2] = 0.0;
-			}	
-
-			s4 = fabs(WDB_f(phis-dx,phic,phiw,tau,chi,delta)) + fabs(WIB_f(phis-dx,phiw,tau,chi,delta))
-					+ fabs(WFB_f(phic,phiw,tau,chi,delta,mu));
-                	if( fabs(s4) < fabs(s) ){
-                	        Diffs[3] = fabs(s-s4);
-                	}else{
-				Diffs[3] = 0.0;
-			}
-			
-			s5 = fabs(WDB_f(phis,phic-dy,phiw,tau,chi,delta)) + fabs(WIB_f(phis,phiw,tau,chi,delta))
-					+ fabs(WFB_f(phic-dy,phiw,tau,chi,delta,mu));
-                	if( fabs(s5) < fabs(s) ){
-                	        Diffs[4] = fabs(s-s5);
-                	}else{
-				Diffs[4] = 0.0;
+		// Gauss-Newton normal equations, J^T.J.dx = -J^T.F
+		double JTJ[3][3], JTF[3];
+		for( int i = 0; i < 3; i ++ ){
+			JTF[i] = 0.0;
+			for( int k = 0; k < 3; k ++ ) JTF[i] += J[k][i]*F[k];
+			for( int j = 0; j < 3; j ++ ){
+				JTJ[i][j] = 0.0;
+				for( int k = 0; k < 3; k ++ ) JTJ[i][j] += J[k][i]*J[k][j];
 			}
+		}
 
-			s6 = fabs(WDB_f(phis,phic,phiw-dz,tau,chi,delta)) + fabs(WIB_f(phis,phiw-dz,tau,chi,delta))
-                	                + fabs(WFB_f(phic,phiw-dz,tau,chi,delta,mu));
-                	if( fabs(s6) < fabs(s) ){
-                	        Diffs[5] = fabs(s-s6);
-                	}else{
-				Diffs[5] = 0.0;
+		// Increase the damping until a step reduces the residuals while staying in the domain
+		bool Stepped = false;
+		while( !Stepped && Lambda < 1e10 ){
+			double A[3][3], b[3], dx[3];
+			for( int i = 0; i < 3; i ++ ){
+				for( int j = 0; j < 3; j ++ ) A[i][j] = JTJ[i][j];
+				A[i][i] += Lambda*(JTJ[i][i] > 0.0 ? JTJ[i][i] : 1.0);
+				b[i] = -JTF[i];
 			}
-		}
-		// Find smallest diff and record value and index
-		unsigned int index(10);
-		double temp(0.0);
-		for( int i = 0; i < 6; i ++){
-//			std::cout << "\nDiffs[" << i << "] = " << Diffs[i];
-			if( Diffs[i] > temp ){
-				temp = Diffs[i];
-				index = i;
+			if( Solve3(A,b,dx) ){
+				for( int k = 0; k < 3; k ++ ) Trial[k] = x[k]+dx[k];
+				if( WellResiduals(Trial,tau,chi,delta,mu,FTrial) ){
+					double TrialSumSquares = FTrial[0]*FTrial[0] + FTrial[1]*FTrial[1]
+						+ FTrial[2]*FTrial[2];
+					if( TrialSumSquares < SumSquares ){
+						for( int k = 0; k < 3; k ++ ){
+							x[k] = Trial[k];
+							F[k] = FTrial[k];
+						}
+						SumSquares = TrialSumSquares;
+						Stepped = true;
+					}
+				}
 			}
+			Lambda = Stepped ? std::max(Lambda/10.0,1e-12) : Lambda*10.0;
 		}
-		if( index == 0 ){
-			phis = phis+dx;
-			s = s1;
-		}else if( index == 1 ){
-			phic = phic+dy;
-			s = s2;
-		}else if( index == 2 ){
-			phiw = phiw+dz;
-			s = s3;
-		}else if( index == 3 ){
-			phis = phis-dx;
-			s = s4;
-		}else if( index == 4 ){
-			phic = phic-dy;
-			s = s5;
-		}else if( index == 5 ){
-			phiw = phiw-dz;
-			s = s6;
-		}else{
-			std::cerr << "\nERROR! MINIMISATION FAILED!!";
-			std::cerr << "\n" << index << ":\t" << s << " < " << s1 << ", " << s2 << ", ";
-			std::cerr << s3 << ", " << s4 << ", " << s5 << ", " << s6;
-			std::cin.get();
-			return s;
-		}
-		
-//		std::cout << "\n" << StepNumber << " " << index << " " << phis << " " << phic << " " << phiw;
-//		std::cout << " " << s << " " << s1 << " " << s2 << " " << s3 << " " << s4;
-//		std::cout << " " << s5 << " " << s6;
-//		std::cout << " " << WDB_f(phis,phic,phiw,tau,chi,delta) << " " << WFB_f(phic,phiw,tau,chi,delta,mu)
-//			<< " " << WIB_f(phis,phiw,tau,chi,delta);
-		StepNumber ++;
+		s = fabs(F[0]) + fabs(F[1]) + fabs(F[2]);
+		// The residuals can no longer be reduced, this is a local minimum and not a root
+		if( !Stepped ) break;
 	}
 
+	phis = x[0];
+	phic = x[1];
+	phiw = x[2];
 	return s;
 }
 
+// Whether a potential well forms in front of the dust, which is when no sheath edge potential 
+// satisfying equation (22) lies between the wall potential Phic and zero. This is the test of 
+// CWP_f(), locating the sign change of NWSP_f() on a coarser grid.
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou, A. P. L. Robinson, M. Coppins, and M. Bacharis, Phys. Plasmas 21, (2014).
+static bool WellFormed(double Tau, double Chi, double Delta, double Phic){
+	const double Step = 0.01;
+	double Phis(-0.0001);
+	double Previous = NWSP_f(Phis,Tau,Chi,Delta,Phic);
+	while( Phis > Phic ){
+		if( fabs(Previous) <= 0.001 ) return false;
+		Phis = std::max(Phis-Step,Phic);
+		double NWSP = NWSP_f(Phis,Tau,Chi,Delta,Phic);
+		if( (NWSP > 0.0) != (Previous > 0.0) ) return false;
+		Previous = NWSP;
+	}
+	return fabs(Previous) > 0.001;
+}
+
+// Solve the well case from a series of initial guesses, as from a single guess the solver 
+// can settle on the boundary phiw = phic. The wall potential is started from its value without
+// emission, and the sheath edge potential from each of SheathGuesses in turn.
+// Returns true and sets phis, phic and phiw if a root is found.
+static bool solveWellCaseGuesses(double &phis, double &phic, double &phiw, double Tau, double Chi, 
+		double Delta, double Mu, int &Iterations){
+	const double SheathGuesses[] = {-0.5, -1.0, -2.0, -0.25};
+	const double Tolerance = 1e-9;
+	Iterations = 0;
+	for( double Guess : SheathGuesses ){
+		double Wall = log(sqrt(Tau*Mu))-0.05;
+		double x[3] = {std::max(Guess,Wall+0.1), 0.0, Wall};
+		x[1] = x[0]+0.1;
+		int GuessIterations(0);
+		double s = solveWellCase(x[0],x[1],x[2],Tau,Chi,Delta,Mu,GuessIterations);
+		Iterations += GuessIterations;
+		if( s < Tolerance ){
+			phis = x[0];
+			phic = x[1];
+			phiw = x[2];
+			return true;
+		}
+	}
+	return false;
+}
+
+// Solve the Modified orbital motion limited potential for large emitting dust grains.
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou, A. P. L. Robinson, M. Coppins, and M. Bacharis, Phys. Plasmas 21, (2014).
+// Returns the normalised potential of the dust surface, which without a well is given by 
+// equation (24) and with a well is phiw of equations [53-55].
+double solveMOMLEM(double Tau, double MassRatio, double Chi, double Delta, int &Iterations){
+	double Mu = 1.0/MassRatio;
+	double Phic = log(sqrt(Tau*Mu)+Chi*sqrt(Delta));
+	Iterations = 0;
+	if( Phic >= 0.0 || !WellFormed(Tau,Chi,Delta,Phic) ) return Phic;
+
+	double Phis(0.0), Phiw(0.0);
+	if( solveWellCaseGuesses(Phis,Phic,Phiw,Tau,Chi,Delta,Mu,Iterations) ) return Phiw;
+	// Without a root the well is taken to be just forming, where phiw = phic
+	static std::atomic<bool> runOnce(true);
+	WarnOnce(runOnce,"\nWARNING IN solveMOMLEM()! WELL CASE HAS NO SOLUTION, RETURNING phic\n");
+	return Phic;
+}
+
 // Solve the Modified orbital motion limited potential for large emitting dust grains.
 // See the paper by Minas and Nikoleta, equation (1) and (2)
 // N. Rizopoulou and M. Bacharis, Phys. Plasmas 25, (2018).
@@ -394,9 +437,25 @@ double solveDeltaMOMLEM(double Tau, double MassRatio, double Chi, double Delta){
 		return exp(Phic);
 	}else{ // In this case, there is a well!
 		
-		double GoodnessOfFit = solveWellCase(Phis,Phic,Phiw,Tau,Chi,Delta,Mu);
+		int Iterations(0);
+		if( !solveWellCaseGuesses(Phis,Phic,Phiw,Tau,Chi,Delta,Mu,Iterations) ){
+			// Without a root the well is taken to be just forming, where phiw = phic
+			static std::atomic<bool> runOnce(true);
+			WarnOnce(runOnce,"\nWARNING IN solveDeltaMOMLEM()! WELL CASE HAS NO SOLUTION, USING phic\n");
+			Phiw = Phic;
+		}
 		return exp((Phiw-Phic)/Delta)/exp(Phiw);
 	}
 
 	return Phis;
 }
+
+// Floating potential of large emitting dust grains with a potential well, equation (1) and (2)
+// See the paper by Minas and Nikoleta,
+// N. Rizopoulou and M. Bacharis, Phys. Plasmas 25, (2018).
+double solveMOMLWEM(double Tau, double MassRatio, double Ionization, double DeltaTot){
+	double HeatCapacityRatio = 1.0;
+	double Delta_Phi_em = 0.5*log((2.0*PI/MassRatio)*(1+HeatCapacityRatio*Tau)/pow(1.0-DeltaTot,2.0));
+	double Arg = sqrt(2*PI*Tau*(1+HeatCapacityRatio*Tau))*exp(Tau);
+	return -1.0*(Tau/Ionization+Delta_Phi_em/Ionization-LambertW(Arg));
+}